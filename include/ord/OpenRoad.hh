@@ -136,6 +136,7 @@ class ICeWall;
 
 namespace utl {
 class Logger;
+class Executor;
 }
 
 namespace dst {
@@ -235,6 +236,8 @@ class OpenRoad
   void setThreadCount(int threads, bool printInfo = true);
   void setThreadCount(const char* threads, bool printInfo = true);
   int getThreadCount();
+  // Worker threads shared by all the tools; sized by setThreadCount.
+  utl::Executor* getExecutor() { return executor_; }
 
   // Observer interface
   class Observer
@@ -292,6 +295,7 @@ class OpenRoad
   std::set<Observer*> observers_;
 
   int threads_;
+  utl::Executor* executor_;
 };
 
 int tclAppInit(Tcl_Interp* interp);
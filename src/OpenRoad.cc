@@ -85,6 +85,7 @@
 #include "stt/MakeSteinerTreeBuilder.h"
 #include "tap/MakeTapcell.h"
 #include "triton_route/MakeTritonRoute.h"
+#include "utl/Executor.h"
 #include "utl/Logger.h"
 #include "utl/MakeLogger.h"
 
@@ -151,9 +152,11 @@ OpenRoad::OpenRoad()
       distributer_(nullptr),
       stt_builder_(nullptr),
       dft_(nullptr),
-      threads_(1)
+      threads_(1),
+      executor_(nullptr)
 {
   db_ = dbDatabase::create();
+  executor_ = new utl::Executor(threads_);
 }
 
 OpenRoad::~OpenRoad()
@@ -188,6 +191,7 @@ OpenRoad::~OpenRoad()
   deleteDistributed(distributer_);
   deleteSteinerTreeBuilder(stt_builder_);
   dft::deleteDft(dft_);
+  delete executor_;
   delete logger_;
 }
 
@@ -503,7 +507,7 @@ void OpenRoad::readVerilog(const char* filename)
 void OpenRoad::linkDesign(const char* design_name)
 
 {
-  dbLinkDesign(design_name, verilog_network_, db_, logger_);
+  dbLinkDesign(design_name, verilog_network_, db_, logger_, executor_);
   for (Observer* observer : observers_) {
     observer->postReadDb(db_);
   }
@@ -568,6 +572,7 @@ void OpenRoad::setThreadCount(int threads, bool printInfo)
 
   // place limits on tools with threads
   sta_->setThreadCount(threads_);
+  executor_->setNumThreads(threads_);
 }
 
 void OpenRoad::setThreadCount(const char* threads, bool printInfo)
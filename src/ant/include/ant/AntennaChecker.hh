@@ -32,6 +32,7 @@
 #pragma once
 
 #include <map>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "odb/db.h"
@@ -42,6 +43,10 @@ namespace grt {
 class GlobalRouter;
 }
 
+namespace utl {
+class Executor;
+}
+
 namespace ant {
 
 using std::vector;
@@ -60,6 +65,7 @@ using utl::Logger;
 struct PARinfo;
 struct ARinfo;
 struct AntennaModel;
+struct NetReport;
 
 struct Violation
 {
@@ -76,7 +82,8 @@ class AntennaChecker
 
   void init(odb::dbDatabase* db,
             grt::GlobalRouter* global_router,
-            utl::Logger* logger);
+            utl::Logger* logger,
+            utl::Executor* executor);
 
   // net nullptr -> check all nets
   int checkAntennas(dbNet* net = nullptr, bool verbose = false);
@@ -141,8 +148,10 @@ class AntennaChecker
       const vector<PARinfo>& VIA_PARtable,
       const vector<dbWireGraph::Node*>& gate_iterms);
 
-  vector<dbWireGraph::Node*> findWireRoots(dbWire* wire);
+  // The nodes returned are owned by graph.
+  vector<dbWireGraph::Node*> findWireRoots(dbWire* wire, dbWireGraph& graph);
   void findWireRoots(dbWire* wire,
+                     dbWireGraph& graph,
                      // Return values.
                      vector<dbWireGraph::Node*>& wire_roots,
                      vector<dbWireGraph::Node*>& gate_iterms);
@@ -150,34 +159,42 @@ class AntennaChecker
   std::pair<bool, bool> checkWirePar(const ARinfo& AntennaRatio,
                                      bool report,
                                      bool verbose,
-                                     std::ofstream& report_file);
+                                     NetReport& net_report);
   std::pair<bool, bool> checkWireCar(const ARinfo& AntennaRatio,
                                      bool par_checked,
                                      bool report,
                                      bool verbose,
-                                     std::ofstream& report_file);
+                                     NetReport& net_report);
   bool checkViaPar(const ARinfo& AntennaRatio,
                    bool report,
                    bool verbose,
-                   std::ofstream& report_file);
+                   NetReport& net_report);
   bool checkViaCar(const ARinfo& AntennaRatio,
                    bool report,
                    bool verbose,
-                   std::ofstream& report_file);
+                   NetReport& net_report);
 
+  void checkNets(const vector<dbNet*>& nets,
+                 bool verbose,
+                 std::ofstream& report_file,
+                 // Return values.
+                 int& net_violation_count,
+                 int& pin_violation_count);
   void checkNet(dbNet* net,
                 bool report_if_no_violation,
                 bool verbose,
-                std::ofstream& report_file,
+                dbWireGraph& graph,
                 // Return values.
+                NetReport& net_report,
                 int& net_violation_count,
                 int& pin_violation_count);
+  void reportNet(const NetReport& net_report, std::ofstream& report_file);
   void checkGate(dbWireGraph::Node* gate,
                  vector<ARinfo>& CARtable,
                  vector<ARinfo>& VIA_CARtable,
                  bool report,
                  bool verbose,
-                 std::ofstream& report_file,
+                 NetReport& net_report,
                  // Return values.
                  bool& violation,
                  std::unordered_set<dbWireGraph::Node*>& violated_gates);
@@ -189,6 +206,8 @@ class AntennaChecker
                           vector<dbITerm*>& gates);
   double diffArea(dbMTerm* mterm);
   double gateArea(dbMTerm* mterm);
+  double computeDiffArea(dbMTerm* mterm);
+  double computeGateArea(dbMTerm* mterm);
 
   vector<std::pair<double, vector<dbITerm*>>> parMaxWireLength(dbNet* net,
                                                                int layer);
@@ -201,7 +220,10 @@ class AntennaChecker
   int dbu_per_micron_{0};
   grt::GlobalRouter* global_router_{nullptr};
   utl::Logger* logger_{nullptr};
+  utl::Executor* executor_{nullptr};  // serial if not set
   std::map<odb::dbTechLayer*, AntennaModel> layer_info_;
+  // mterm -> (gate area, diff area)
+  std::unordered_map<dbMTerm*, std::pair<double, double>> mterm_areas_;
   int net_violation_count_{0};
   float ratio_margin_{0};
   std::string report_file_name_;
@@ -45,6 +45,7 @@
 #include "odb/dbWireGraph.h"
 #include "odb/wOrder.h"
 #include "sta/StaMain.hh"
+#include "utl/Executor.h"
 #include "utl/Logger.h"
 
 namespace ant {
@@ -125,6 +126,18 @@ struct AntennaModel
   double diff_metal_reduce_factor;
 };
 
+// Report lines of one net. They are buffered so that nets can be checked
+// concurrently and still be reported in net order.
+struct NetReport
+{
+  void add(const std::string& line, bool to_file = true)
+  {
+    lines.emplace_back(line, to_file);
+  }
+
+  vector<std::pair<std::string, bool>> lines;
+};
+
 extern "C" {
 extern int Ant_Init(Tcl_Interp* interp);
 }
@@ -134,11 +147,13 @@ AntennaChecker::~AntennaChecker() = default;
 
 void AntennaChecker::init(odb::dbDatabase* db,
                           grt::GlobalRouter* global_router,
-                          Logger* logger)
+                          Logger* logger,
+                          utl::Executor* executor)
 {
   db_ = db;
   global_router_ = global_router;
   logger_ = logger;
+  executor_ = executor;
 }
 
 double AntennaChecker::dbuToMicrons(int value)
@@ -222,6 +237,16 @@ void AntennaChecker::initAntennaRules()
                                   diff_metal_reduce_factor};
     layer_info_[tech_layer] = layer_antenna;
   }
+
+  // The gate and diff areas are looked up for every pin of every net.
+  mterm_areas_.clear();
+  for (odb::dbLib* lib : db_->getLibs()) {
+    for (odb::dbMaster* master : lib->getMasters()) {
+      for (dbMTerm* mterm : master->getMTerms()) {
+        mterm_areas_[mterm] = {computeGateArea(mterm), computeDiffArea(mterm)};
+      }
+    }
+  }
 }
 
 dbWireGraph::Node* AntennaChecker::findSegmentRoot(dbWireGraph::Node* node,
@@ -701,6 +726,15 @@ vector<PARinfo> AntennaChecker::buildWireParTable(
 }
 
 double AntennaChecker::gateArea(dbMTerm* mterm)
+{
+  auto itr = mterm_areas_.find(mterm);
+  if (itr != mterm_areas_.end()) {
+    return itr->second.first;
+  }
+  return computeGateArea(mterm);
+}
+
+double AntennaChecker::computeGateArea(dbMTerm* mterm)
 {
   double max_gate_area = 0;
   if (mterm->hasDefaultAntennaModel()) {
@@ -747,7 +781,7 @@ void AntennaChecker::calculateParInfo(PARinfo& par_info)
 {
   dbWireGraph::Node* wire_root = par_info.wire_root;
   odb::dbTechLayer* tech_layer = wire_root->layer();
-  AntennaModel& am = layer_info_[tech_layer];
+  const AntennaModel& am = layer_info_.at(tech_layer);
 
   double metal_factor = am.metal_factor;
   double diff_metal_factor = am.diff_metal_factor;
@@ -995,7 +1029,7 @@ vector<PARinfo> AntennaChecker::buildViaParTable(
       dbTechLayer* layer = getViaLayer(
           findVia(wire_root, wire_root->layer()->getRoutingLevel()));
 
-      AntennaModel& am = layer_info_[layer];
+      const AntennaModel& am = layer_info_.at(layer);
       diff_metal_reduce_factor = am.diff_metal_reduce_factor;
       if (layer->hasDefaultAntennaRule()) {
         const dbTechLayerAntennaRule* antenna_rule
@@ -1097,7 +1131,7 @@ vector<ARinfo> AntennaChecker::buildViaCarTable(
 std::pair<bool, bool> AntennaChecker::checkWirePar(const ARinfo& AntennaRatio,
                                                    bool report,
                                                    bool verbose,
-                                                   std::ofstream& report_file)
+                                                   NetReport& net_report)
 {
   dbTechLayer* layer = AntennaRatio.par_info.wire_root->layer();
   const double par = AntennaRatio.par_info.PAR;
@@ -1166,10 +1200,7 @@ std::pair<bool, bool> AntennaChecker::checkWirePar(const ARinfo& AntennaRatio,
               PAR_ratio,
               par_violation ? "(VIOLATED)" : "");
 
-          if (report_file.is_open()) {
-            report_file << par_report << "\n";
-          }
-          logger_->report("{}", par_report);
+          net_report.add(par_report);
         }
       } else {
         if (diff_par_violation || verbose) {
@@ -1181,10 +1212,7 @@ std::pair<bool, bool> AntennaChecker::checkWirePar(const ARinfo& AntennaRatio,
               diffPAR_PWL_ratio,
               diff_par_violation ? "(VIOLATED)" : "");
 
-          if (report_file.is_open()) {
-            report_file << par_report << "\n";
-          }
-          logger_->report("{}", par_report);
+          net_report.add(par_report);
         }
       }
 
@@ -1198,10 +1226,7 @@ std::pair<bool, bool> AntennaChecker::checkWirePar(const ARinfo& AntennaRatio,
               PSR_ratio,
               psr_violation ? "(VIOLATED)" : "");
 
-          if (report_file.is_open()) {
-            report_file << par_report << "\n";
-          }
-          logger_->report("{}", par_report);
+          net_report.add(par_report);
         }
       } else {
         if (diff_psr_violation || verbose) {
@@ -1213,10 +1238,7 @@ std::pair<bool, bool> AntennaChecker::checkWirePar(const ARinfo& AntennaRatio,
               diffPSR_PWL_ratio,
               diff_psr_violation ? "(VIOLATED)" : "");
 
-          if (report_file.is_open()) {
-            report_file << par_report << "\n";
-          }
-          logger_->report("{}", par_report);
+          net_report.add(par_report);
         }
       }
     }
@@ -1228,7 +1250,7 @@ std::pair<bool, bool> AntennaChecker::checkWireCar(const ARinfo& AntennaRatio,
                                                    bool par_checked,
                                                    bool report,
                                                    bool verbose,
-                                                   std::ofstream& report_file)
+                                                   NetReport& net_report)
 {
   dbTechLayer* layer = AntennaRatio.par_info.wire_root->layer();
   const double car = AntennaRatio.CAR;
@@ -1296,10 +1318,7 @@ std::pair<bool, bool> AntennaChecker::checkWireCar(const ARinfo& AntennaRatio,
               CAR_ratio,
               car_violation ? "(VIOLATED)" : "");
 
-          if (report_file.is_open()) {
-            report_file << car_report << "\n";
-          }
-          logger_->report("{}", car_report);
+          net_report.add(car_report);
         }
       } else {
         if (diff_car_violation || verbose) {
@@ -1311,10 +1330,7 @@ std::pair<bool, bool> AntennaChecker::checkWireCar(const ARinfo& AntennaRatio,
               diffCAR_PWL_ratio,
               diff_car_violation ? "(VIOLATED)" : "");
 
-          if (report_file.is_open()) {
-            report_file << car_report << "\n";
-          }
-          logger_->report("{}", car_report);
+          net_report.add(car_report);
         }
       }
 
@@ -1328,10 +1344,7 @@ std::pair<bool, bool> AntennaChecker::checkWireCar(const ARinfo& AntennaRatio,
               CSR_ratio,
               csr_violation ? "(VIOLATED)" : "");
 
-          if (report_file.is_open()) {
-            report_file << car_report << "\n";
-          }
-          logger_->report("{}", car_report);
+          net_report.add(car_report);
         }
       } else {
         if (diff_car_violation || verbose) {
@@ -1343,10 +1356,7 @@ std::pair<bool, bool> AntennaChecker::checkWireCar(const ARinfo& AntennaRatio,
               diffCSR_PWL_ratio,
               diff_csr_violation ? "(VIOLATED)" : "");
 
-          if (report_file.is_open()) {
-            report_file << car_report << "\n";
-          }
-          logger_->report("{}", car_report);
+          net_report.add(car_report);
         }
       }
     }
@@ -1357,7 +1367,7 @@ std::pair<bool, bool> AntennaChecker::checkWireCar(const ARinfo& AntennaRatio,
 bool AntennaChecker::checkViaPar(const ARinfo& AntennaRatio,
                                  bool report,
                                  bool verbose,
-                                 std::ofstream& report_file)
+                                 NetReport& net_report)
 {
   const dbTechLayer* layer = getViaLayer(
       findVia(AntennaRatio.par_info.wire_root,
@@ -1401,10 +1411,7 @@ bool AntennaChecker::checkViaPar(const ARinfo& AntennaRatio,
               PAR_ratio,
               par_violation ? "(VIOLATED)" : "");
 
-          if (report_file.is_open()) {
-            report_file << par_report << "\n";
-          }
-          logger_->report("{}", par_report);
+          net_report.add(par_report);
         }
       } else {
         if (diff_par_violation || verbose) {
@@ -1416,10 +1423,7 @@ bool AntennaChecker::checkViaPar(const ARinfo& AntennaRatio,
               diffPAR_PWL_ratio,
               diff_par_violation ? "(VIOLATED)" : "");
 
-          if (report_file.is_open()) {
-            report_file << par_report << "\n";
-          }
-          logger_->report("{}", par_report);
+          net_report.add(par_report);
         }
       }
     }
@@ -1431,7 +1435,7 @@ bool AntennaChecker::checkViaPar(const ARinfo& AntennaRatio,
 bool AntennaChecker::checkViaCar(const ARinfo& AntennaRatio,
                                  bool report,
                                  bool verbose,
-                                 std::ofstream& report_file)
+                                 NetReport& net_report)
 {
   dbTechLayer* layer = getViaLayer(
       findVia(AntennaRatio.par_info.wire_root,
@@ -1476,10 +1480,7 @@ bool AntennaChecker::checkViaCar(const ARinfo& AntennaRatio,
               CAR_ratio,
               car_violation ? "(VIOLATED)" : "");
 
-          if (report_file.is_open()) {
-            report_file << car_report << "\n";
-          }
-          logger_->report("{}", car_report);
+          net_report.add(car_report);
         }
       } else {
         if (diff_car_violation || verbose) {
@@ -1491,10 +1492,7 @@ bool AntennaChecker::checkViaCar(const ARinfo& AntennaRatio,
               diffCAR_PWL_ratio,
               diff_car_violation ? "(VIOLATED)" : "");
 
-          if (report_file.is_open()) {
-            report_file << car_report << "\n";
-          }
-          logger_->report("{}", car_report);
+          net_report.add(car_report);
         }
       }
     }
@@ -1502,20 +1500,21 @@ bool AntennaChecker::checkViaCar(const ARinfo& AntennaRatio,
   return violated;
 }
 
-vector<dbWireGraph::Node*> AntennaChecker::findWireRoots(dbWire* wire)
+vector<dbWireGraph::Node*> AntennaChecker::findWireRoots(dbWire* wire,
+                                                         dbWireGraph& graph)
 {
   vector<dbWireGraph::Node*> wire_roots;
   vector<dbWireGraph::Node*> gate_iterms;
-  findWireRoots(wire, wire_roots, gate_iterms);
+  findWireRoots(wire, graph, wire_roots, gate_iterms);
   return wire_roots;
 }
 
 void AntennaChecker::findWireRoots(dbWire* wire,
+                                   dbWireGraph& graph,
                                    // Return values.
                                    vector<dbWireGraph::Node*>& wire_roots,
                                    vector<dbWireGraph::Node*>& gate_iterms)
 {
-  dbWireGraph graph;
   graph.decode(wire);
   dbWireGraph::node_iterator node_itr;
   for (node_itr = graph.begin_nodes(); node_itr != graph.end_nodes();
@@ -1553,8 +1552,9 @@ void AntennaChecker::findWireRoots(dbWire* wire,
 void AntennaChecker::checkNet(dbNet* net,
                               bool report_if_no_violation,
                               bool verbose,
-                              std::ofstream& report_file,
+                              dbWireGraph& graph,
                               // Return values.
+                              NetReport& net_report,
                               int& net_violation_count,
                               int& pin_violation_count)
 {
@@ -1562,7 +1562,7 @@ void AntennaChecker::checkNet(dbNet* net,
   if (wire) {
     vector<dbWireGraph::Node*> wire_roots;
     vector<dbWireGraph::Node*> gate_nodes;
-    findWireRoots(wire, wire_roots, gate_nodes);
+    findWireRoots(wire, graph, wire_roots, gate_nodes);
 
     vector<PARinfo> PARtable = buildWireParTable(wire_roots);
     vector<PARinfo> VIA_PARtable = buildViaParTable(wire_roots);
@@ -1579,7 +1579,7 @@ void AntennaChecker::checkNet(dbNet* net,
                 VIA_CARtable,
                 false,
                 verbose,
-                report_file,
+                net_report,
                 violation,
                 violated_gates);
     }
@@ -1593,10 +1593,7 @@ void AntennaChecker::checkNet(dbNet* net,
     if (violation || report_if_no_violation) {
       std::string net_name = fmt::format("Net: {}", net->getConstName());
 
-      if (report_file.is_open()) {
-        report_file << net_name << "\n";
-      }
-      logger_->report("{}", net_name);
+      net_report.add(net_name);
 
       for (dbWireGraph::Node* gate : gate_nodes) {
         checkGate(gate,
@@ -1604,11 +1601,11 @@ void AntennaChecker::checkNet(dbNet* net,
                   VIA_CARtable,
                   true,
                   verbose,
-                  report_file,
+                  net_report,
                   violation,
                   violated_gates);
       }
-      logger_->report("");
+      net_report.add("", false);
     }
   }
 }
@@ -1619,7 +1616,7 @@ void AntennaChecker::checkGate(
     vector<ARinfo>& VIA_CARtable,
     bool report,
     bool verbose,
-    std::ofstream& report_file,
+    NetReport& net_report,
     // Return values.
     bool& violation,
     unordered_set<dbWireGraph::Node*>& violated_gates)
@@ -1627,10 +1624,10 @@ void AntennaChecker::checkGate(
   bool first_pin_violation = true;
   for (const auto& ar : CARtable) {
     if (ar.GateNode == gate) {
-      auto wire_PAR_violation = checkWirePar(ar, false, verbose, report_file);
+      auto wire_PAR_violation = checkWirePar(ar, false, verbose, net_report);
 
       auto wire_CAR_violation = checkWireCar(
-          ar, wire_PAR_violation.second, false, verbose, report_file);
+          ar, wire_PAR_violation.second, false, verbose, net_report);
       bool wire_violation
           = wire_PAR_violation.first || wire_CAR_violation.first;
       violation |= wire_violation;
@@ -1650,37 +1647,27 @@ void AntennaChecker::checkGate(
                               mterm->getConstName(),
                               mterm->getMaster()->getConstName());
 
-            if (report_file.is_open()) {
-              report_file << mterm_info << "\n";
-            }
-            logger_->report("{}", mterm_info);
+            net_report.add(mterm_info);
           }
 
           std::string layer_name = fmt::format(
               "    Layer: {}", ar.par_info.wire_root->layer()->getConstName());
 
-          if (report_file.is_open()) {
-            report_file << layer_name << "\n";
-          }
-          logger_->report("{}", layer_name);
+          net_report.add(layer_name);
           first_pin_violation = false;
         }
-        checkWirePar(ar, true, verbose, report_file);
-        checkWireCar(ar, wire_PAR_violation.second, true, verbose, report_file);
+        checkWirePar(ar, true, verbose, net_report);
+        checkWireCar(ar, wire_PAR_violation.second, true, verbose, net_report);
         if (wire_violation || verbose) {
-          if (report_file.is_open()) {
-            report_file << "\n";
-          }
-
-          logger_->report("");
+          net_report.add("");
         }
       }
     }
   }
   for (const auto& via_ar : VIA_CARtable) {
     if (via_ar.GateNode == gate) {
-      bool VIA_PAR_violation = checkViaPar(via_ar, false, verbose, report_file);
-      bool VIA_CAR_violation = checkViaCar(via_ar, false, verbose, report_file);
+      bool VIA_PAR_violation = checkViaPar(via_ar, false, verbose, net_report);
+      bool VIA_CAR_violation = checkViaCar(via_ar, false, verbose, net_report);
       bool via_violation = VIA_PAR_violation || VIA_CAR_violation;
       violation |= via_violation;
       if (via_violation) {
@@ -1695,19 +1682,12 @@ void AntennaChecker::checkGate(
 
           std::string via_name
               = fmt::format("    Via: {}", getViaName(via).c_str());
-          if (report_file.is_open()) {
-            report_file << via_name << "\n";
-          }
-          logger_->report("{}", via_name);
+          net_report.add(via_name);
         }
-        checkViaPar(via_ar, true, verbose, report_file);
-        checkViaCar(via_ar, true, verbose, report_file);
+        checkViaPar(via_ar, true, verbose, net_report);
+        checkViaCar(via_ar, true, verbose, net_report);
         if (via_violation || verbose) {
-          if (report_file.is_open()) {
-            report_file << "\n";
-          }
-
-          logger_->report("");
+          net_report.add("");
         }
       }
     }
@@ -1745,27 +1725,29 @@ int AntennaChecker::checkAntennas(dbNet* net, bool verbose)
 
   if (net) {
     if (!net->isSpecial()) {
+      dbWireGraph graph;
+      NetReport net_report;
       checkNet(net,
                true,
                verbose,
-               report_file,
+               graph,
+               net_report,
                net_violation_count,
                pin_violation_count);
+      reportNet(net_report, report_file);
     } else {
       logger_->error(
           ANT, 14, "Skipped net {} because it is special.", net->getName());
     }
   } else {
+    vector<dbNet*> nets;
     for (dbNet* net : block_->getNets()) {
       if (!net->isSpecial()) {
-        checkNet(net,
-                 false,
-                 verbose,
-                 report_file,
-                 net_violation_count,
-                 pin_violation_count);
+        nets.push_back(net);
       }
     }
+    checkNets(
+        nets, verbose, report_file, net_violation_count, pin_violation_count);
   }
 
   logger_->info(ANT, 2, "Found {} net violations.", net_violation_count);
@@ -1785,6 +1767,63 @@ int AntennaChecker::checkAntennas(dbNet* net, bool verbose)
   return net_violation_count;
 }
 
+void AntennaChecker::checkNets(const vector<dbNet*>& nets,
+                               bool verbose,
+                               std::ofstream& report_file,
+                               // Return values.
+                               int& net_violation_count,
+                               int& pin_violation_count)
+{
+  const int net_count = nets.size();
+  vector<NetReport> net_reports(net_count);
+  vector<int> net_violations(net_count, 0);
+  vector<int> pin_violations(net_count, 0);
+
+  // Nets are checked in a few chunks per thread; each chunk reuses one
+  // wire graph.
+  const int thread_count = executor_ ? executor_->getNumThreads() : 1;
+  const int chunk_count = std::min(net_count, thread_count * 4);
+  auto check_nets = [&](int chunk) {
+    dbWireGraph graph;
+    const int begin = static_cast<int64_t>(net_count) * chunk / chunk_count;
+    const int end = static_cast<int64_t>(net_count) * (chunk + 1) / chunk_count;
+    for (int i = begin; i < end; i++) {
+      checkNet(nets[i],
+               false,
+               verbose,
+               graph,
+               net_reports[i],
+               net_violations[i],
+               pin_violations[i]);
+    }
+  };
+  if (executor_) {
+    executor_->parallelFor(0, chunk_count, check_nets);
+  } else {
+    for (int chunk = 0; chunk < chunk_count; chunk++) {
+      check_nets(chunk);
+    }
+  }
+
+  // Merge in net order so the report does not depend on the thread count.
+  for (int i = 0; i < net_count; i++) {
+    net_violation_count += net_violations[i];
+    pin_violation_count += pin_violations[i];
+    reportNet(net_reports[i], report_file);
+  }
+}
+
+void AntennaChecker::reportNet(const NetReport& net_report,
+                               std::ofstream& report_file)
+{
+  for (const auto& [line, to_file] : net_report.lines) {
+    if (to_file && report_file.is_open()) {
+      report_file << line << "\n";
+    }
+    logger_->report("{}", line);
+  }
+}
+
 int AntennaChecker::antennaViolationCount() const
 {
   return net_violation_count_;
@@ -1826,10 +1865,8 @@ vector<std::pair<double, vector<dbITerm*>>> AntennaChecker::parMaxWireLength(
   dbWire* wire = net->getWire();
   if (wire != nullptr) {
     dbWireGraph graph;
-    graph.decode(wire);
-
     std::set<dbWireGraph::Node*> level_nodes;
-    vector<dbWireGraph::Node*> wire_roots = findWireRoots(wire);
+    vector<dbWireGraph::Node*> wire_roots = findWireRoots(wire, graph);
     for (dbWireGraph::Node* wire_root : wire_roots) {
       odb::dbTechLayer* tech_layer = wire_root->layer();
       if (level_nodes.find(wire_root) == level_nodes.end()
@@ -1972,7 +2009,7 @@ vector<Violation> AntennaChecker::getAntennaViolations(dbNet* net,
   dbWire* wire = net->getWire();
   dbWireGraph graph;
   if (wire) {
-    auto wire_roots = findWireRoots(wire);
+    auto wire_roots = findWireRoots(wire, graph);
 
     vector<PARinfo> PARtable = buildWireParTable(wire_roots);
     for (PARinfo& par_info : PARtable) {
@@ -2021,6 +2058,15 @@ bool AntennaChecker::antennaRatioDiffDependent(dbTechLayer* layer)
 }
 
 double AntennaChecker::diffArea(dbMTerm* mterm)
+{
+  auto itr = mterm_areas_.find(mterm);
+  if (itr != mterm_areas_.end()) {
+    return itr->second.second;
+  }
+  return computeDiffArea(mterm);
+}
+
+double AntennaChecker::computeDiffArea(dbMTerm* mterm)
 {
   double max_diff_area = 0.0;
   vector<std::pair<double, dbTechLayer*>> diff_areas;
@@ -2042,7 +2088,7 @@ AntennaChecker::getViolatedWireLength(dbNet* net, int routing_level)
 
   dbWireGraph graph;
   std::set<dbWireGraph::Node*> level_nodes;
-  for (dbWireGraph::Node* wire_root : findWireRoots(wire)) {
+  for (dbWireGraph::Node* wire_root : findWireRoots(wire, graph)) {
     odb::dbTechLayer* tech_layer = wire_root->layer();
     if (level_nodes.find(wire_root) == level_nodes.end()
         && tech_layer->getRoutingLevel() == routing_level) {
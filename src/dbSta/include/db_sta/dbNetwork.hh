@@ -166,6 +166,7 @@ class dbNetwork : public ConcreteNetwork
   Instance* topInstance() const override;
   // Name local to containing cell/instance.
   const char* name(const Instance* instance) const override;
+  const char* pathName(const Instance* instance) const override;
   ObjectId id(const Instance *instance) const override;
   Cell* cell(const Instance* instance) const override;
   Instance* parent(const Instance* instance) const override;
@@ -204,6 +205,7 @@ class dbNetwork : public ConcreteNetwork
                             // Return value.
                             NetSeq& nets) const override;
   const char* name(const Net* net) const override;
+  const char* pathName(const Net* net) const override;
   Instance* instance(const Net* net) const override;
   bool isPower(const Net* net) const override;
   bool isGround(const Net* net) const override;
@@ -249,6 +251,7 @@ class dbNetwork : public ConcreteNetwork
   using Network::libertyPort;
   using Network::name;
   using Network::netIterator;
+  using Network::pathName;
   using NetworkReader::makeCell;
   using NetworkReader::makeLibrary;
  
@@ -39,6 +39,7 @@
 #include "sta/VerilogReader.hh"
 
 namespace utl {
+class Executor;
 class Logger;
 }
 
@@ -90,6 +91,7 @@ void dbReadVerilog(const char* filename, dbVerilogNetwork* verilog_network);
 void dbLinkDesign(const char* top_cell_name,
                   dbVerilogNetwork* verilog_network,
                   dbDatabase* db,
-                  utl::Logger* logger);
+                  utl::Logger* logger,
+                  utl::Executor* executor);
 
 }  // namespace ord
@@ -71,15 +71,6 @@ using odb::dbPlacementStatus;
 using odb::dbSet;
 using odb::dbSigType;
 
-// TODO: move to StringUtil
-char*
-tmpStringCopy(const char* str)
-{
-  char* tmp = makeTmpString(strlen(str) + 1);
-  strcpy(tmp, str);
-  return tmp;
-}
-
 class DbLibraryIterator1 : public Iterator<Library*>
 {
 public:
@@ -441,20 +432,37 @@ ObjectId dbNetwork::id(const Instance* instance) const
   return staToDb(instance)->getId();
 }
 
+// Names point into the odb name storage; nothing is copied.
 const char*
 dbNetwork::name(const Instance* instance) const
 {
   if (instance == top_instance_)
-    return tmpStringCopy(block_->getConstName());
+    return block_->getConstName();
   else {
     dbInst* db_inst;
     dbModInst* mod_inst;
     staToDb(instance, db_inst, mod_inst);
     if (db_inst) {
-      return tmpStringCopy(db_inst->getConstName());
+      return db_inst->getConstName();
+    }
+    return mod_inst->getConstName();
+  }
+}
+
+const char*
+dbNetwork::pathName(const Instance* instance) const
+{
+  if (instance != top_instance_) {
+    dbInst* db_inst;
+    dbModInst* mod_inst;
+    staToDb(instance, db_inst, mod_inst);
+    // Leaf instances are children of the top instance and carry their
+    // full (flattened) path name.
+    if (db_inst) {
+      return db_inst->getConstName();
     }
-    return tmpStringCopy(mod_inst->getName().c_str());
   }
+  return Network::pathName(instance);
 }
 
 Cell*
@@ -536,8 +544,9 @@ dbNetwork::findChild(const Instance* parent, const char* name) const
     return dbToSta(child_inst);
   }
   // Look for a leaf instance
-  std::string full_name = mod_inst->getHierarchicalName();
-  full_name += pathDivider() + std::string(name);
+  std::string full_name = pathName(parent);
+  full_name += pathDivider();
+  full_name += name;
   dbInst* inst = block_->findInst(full_name.c_str());
   return dbToSta(inst);
 }
@@ -814,9 +823,14 @@ ObjectId dbNetwork::id(const Net* net) const
 const char*
 dbNetwork::name(const Net* net) const
 {
-  dbNet* dnet = staToDb(net);
-  const char* name = dnet->getConstName();
-  return tmpStringCopy(name);
+  return staToDb(net)->getConstName();
+}
+
+const char*
+dbNetwork::pathName(const Net* net) const
+{
+  // Nets are children of the top instance.
+  return name(net);
 }
 
 Instance*
@@ -37,6 +37,8 @@
 
 #include <map>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "db_sta/dbNetwork.hh"
 #include "odb/db.h"
@@ -46,6 +48,7 @@
 #include "sta/PortDirection.hh"
 #include "sta/Vector.hh"
 #include "sta/VerilogReader.hh"
+#include "utl/Executor.h"
 #include "utl/Logger.h"
 
 namespace ord {
@@ -149,32 +152,54 @@ dbReadVerilog(const char* filename, dbVerilogNetwork* verilog_network)
 class Verilog2db
 {
 public:
-  Verilog2db(Network* verilog_network, dbDatabase* db, Logger* logger);
+  Verilog2db(Network* verilog_network,
+             dbDatabase* db,
+             Logger* logger,
+             utl::Executor* executor);
   void makeBlock();
   void makeDbNetlist();
 
 protected:
+  // Pins of a net to connect in odb.
+  struct NetPins
+  {
+    bool make_net = false;
+    PinSeq pins;
+  };
+
   void makeDbModule(Instance* inst, dbModule* parent);
   dbIoType staToDb(PortDirection* dir);
   void recordBusPortsOrder();
   void makeDbNets(const Instance* inst);
+  void findNetPins(Net* net, bool is_top, NetPins& net_pins) const;
+  void makeDbNet(Net* net, const PinSeq& net_pins);
   bool hasTerminals(Net* net) const;
   dbMaster* getMaster(Cell* cell);
+  dbMTerm* getMTerm(dbInst* db_inst, const Pin* pin);
   dbModule* makeUniqueDbModule(const char* name);
 
   Network* network_;
   dbDatabase* db_;
   dbBlock* block_;
   Logger* logger_;
+  utl::Executor* executor_;
   std::map<Cell*, dbMaster*> master_map_;
   std::map<std::string, int> uniquify_id_;  // key: module name
+  // Leaf instances made by makeDbModule.
+  std::unordered_map<const Instance*, dbInst*> inst_map_;
+  std::unordered_map<const Port*, dbMTerm*> mterm_map_;
+
+  // Number of nets whose pins are gathered concurrently before their odb
+  // objects are made.
+  static constexpr size_t net_batch_size_ = 4096;
 };
 
 void
 dbLinkDesign(const char* top_cell_name,
              dbVerilogNetwork* verilog_network,
              dbDatabase* db,
-             Logger* logger)
+             Logger* logger,
+             utl::Executor* executor)
 {
   bool link_make_black_boxes = true;
   bool success = verilog_network->linkNetwork(
@@ -182,15 +207,26 @@ dbLinkDesign(const char* top_cell_name,
       link_make_black_boxes,
       verilog_network->report());
   if (success) {
-    Verilog2db v2db(verilog_network, db, logger);
+    // The linked network does not reference the parsed modules, so they
+    // are freed before the odb netlist is made.
+    deleteVerilogReader();
+    Verilog2db v2db(verilog_network, db, logger, executor);
     v2db.makeBlock();
     v2db.makeDbNetlist();
-    deleteVerilogReader();
+    // The linked network is not used once it has been copied to odb.
+    verilog_network->deleteTopInstance();
   }
 }
 
-Verilog2db::Verilog2db(Network* network, dbDatabase* db, Logger* logger) :
-  network_(network), db_(db), block_(nullptr), logger_(logger)
+Verilog2db::Verilog2db(Network* network,
+                       dbDatabase* db,
+                       Logger* logger,
+                       utl::Executor* executor) :
+  network_(network),
+  db_(db),
+  block_(nullptr),
+  logger_(logger),
+  executor_(executor)
 {
 }
 
@@ -233,6 +269,7 @@ void
 Verilog2db::makeDbNetlist()
 {
   recordBusPortsOrder();
+  inst_map_.reserve(network_->leafInstanceCount());
   makeDbModule(network_->topInstance(), /* parent */ nullptr);
   makeDbNets(network_->topInstance());
 }
@@ -328,6 +365,7 @@ Verilog2db::makeDbModule(Instance* inst, dbModule* parent)
         continue;
       }
       module->addInst(db_inst);
+      inst_map_[child] = db_inst;
     }
   }
   delete child_iter;
@@ -355,53 +393,38 @@ Verilog2db::staToDb(PortDirection* dir)
     return dbIoType::INOUT;
 }
 
+// Nets are handled in batches. The pins of the nets in a batch are found
+// and sorted concurrently since that only reads the verilog network; the
+// odb objects are then made serially in net order.
 void
 Verilog2db::makeDbNets(const Instance* inst)
 {
   bool is_top = (inst == network_->topInstance());
   NetIterator* net_iter = network_->netIterator(inst);
+  std::vector<Net*> nets;
+  std::vector<NetPins> net_pins;
   while (net_iter->hasNext()) {
-    Net* net = net_iter->next();
-    const char* net_name = network_->pathName(net);
-    if (is_top || !hasTerminals(net)) {
-      dbNet* db_net = dbNet::create(block_, net_name);
-
-      if (network_->isPower(net))
-        db_net->setSigType(odb::dbSigType::POWER);
-      if (network_->isGround(net))
-        db_net->setSigType(odb::dbSigType::GROUND);
-
-      // Sort connected pins for regression stability.
-      PinSeq net_pins;
-      NetConnectedPinIterator* pin_iter = network_->connectedPinIterator(net);
-      while (pin_iter->hasNext()) {
-        const Pin* pin = pin_iter->next();
-        net_pins.push_back(pin);
-      }
-      delete pin_iter;
-      sort(net_pins, PinPathNameLess(network_));
-
-      for (const Pin* pin : net_pins) {
-        if (network_->isTopLevelPort(pin)) {
-          const char* port_name = network_->portName(pin);
-          if (block_->findBTerm(port_name) == nullptr) {
-            dbBTerm* bterm = dbBTerm::create(db_net, port_name);
-            dbIoType io_type = staToDb(network_->direction(pin));
-            bterm->setIoType(io_type);
-          }
-        }
-        else if (network_->isLeaf(pin)) {
-          const char* port_name = network_->portName(pin);
-          Instance* inst = network_->instance(pin);
-          const char* inst_name = network_->pathName(inst);
-          dbInst* db_inst = block_->findInst(inst_name);
-          if (db_inst) {
-            dbMaster* master = db_inst->getMaster();
-            dbMTerm* mterm = master->findMTerm(block_, port_name);
-            if (mterm)
-              db_inst->getITerm(mterm)->connect(db_net);
-          }
-        }
+    nets.clear();
+    while (net_iter->hasNext() && nets.size() < net_batch_size_)
+      nets.push_back(net_iter->next());
+    const int net_count = nets.size();
+
+    net_pins.clear();
+    net_pins.resize(net_count);
+    auto find_pins = [&](int i) { findNetPins(nets[i], is_top, net_pins[i]); };
+    if (executor_)
+      executor_->parallelFor(0, net_count, find_pins);
+    else {
+      for (int i = 0; i < net_count; i++)
+        find_pins(i);
+    }
+
+    for (int i = 0; i < net_count; i++) {
+      if (net_pins[i].make_net) {
+        // Sort connected pins for regression stability. Path names are
+        // built in shared string buffers, so this is not done in parallel.
+        sort(net_pins[i].pins, PinPathNameLess(network_));
+        makeDbNet(nets[i], net_pins[i].pins);
       }
     }
   }
@@ -415,6 +438,52 @@ Verilog2db::makeDbNets(const Instance* inst)
   delete child_iter;
 }
 
+void
+Verilog2db::findNetPins(Net* net, bool is_top, NetPins& net_pins) const
+{
+  net_pins.make_net = is_top || !hasTerminals(net);
+  if (net_pins.make_net) {
+    NetConnectedPinIterator* pin_iter = network_->connectedPinIterator(net);
+    while (pin_iter->hasNext()) {
+      const Pin* pin = pin_iter->next();
+      net_pins.pins.push_back(pin);
+    }
+    delete pin_iter;
+  }
+}
+
+void
+Verilog2db::makeDbNet(Net* net, const PinSeq& net_pins)
+{
+  const char* net_name = network_->pathName(net);
+  dbNet* db_net = dbNet::create(block_, net_name);
+
+  if (network_->isPower(net))
+    db_net->setSigType(odb::dbSigType::POWER);
+  if (network_->isGround(net))
+    db_net->setSigType(odb::dbSigType::GROUND);
+
+  for (const Pin* pin : net_pins) {
+    if (network_->isTopLevelPort(pin)) {
+      const char* port_name = network_->portName(pin);
+      if (block_->findBTerm(port_name) == nullptr) {
+        dbBTerm* bterm = dbBTerm::create(db_net, port_name);
+        dbIoType io_type = staToDb(network_->direction(pin));
+        bterm->setIoType(io_type);
+      }
+    }
+    else if (network_->isLeaf(pin)) {
+      auto inst_iter = inst_map_.find(network_->instance(pin));
+      if (inst_iter != inst_map_.end()) {
+        dbInst* db_inst = inst_iter->second;
+        dbMTerm* mterm = getMTerm(db_inst, pin);
+        if (mterm)
+          db_inst->getITerm(mterm)->connect(db_net);
+      }
+    }
+  }
+}
+
 bool
 Verilog2db::hasTerminals(Net* net) const
 {
@@ -460,4 +529,19 @@ Verilog2db::getMaster(Cell* cell)
   }
 }
 
+// Ports of a cell map to the mterms of its master, so the lookup by
+// name is only done once per port.
+dbMTerm*
+Verilog2db::getMTerm(dbInst* db_inst, const Pin* pin)
+{
+  const Port* port = network_->port(pin);
+  auto mterm_iter = mterm_map_.find(port);
+  if (mterm_iter != mterm_map_.end())
+    return mterm_iter->second;
+  dbMaster* master = db_inst->getMaster();
+  dbMTerm* mterm = master->findMTerm(block_, network_->portName(pin));
+  mterm_map_[port] = mterm;
+  return mterm;
+}
+
 }  // namespace ord
@@ -35,6 +35,8 @@
 
 #include "dbSdcNetwork.hh"
 
+#include <cstring>
+
 #include "sta/ParseBus.hh"
 #include "sta/PatternMatch.hh"
 
@@ -95,12 +97,23 @@ dbSdcNetwork::findInstancesMatching1(const PatternMatch* pattern,
   InstanceChildIterator* child_iter = childIterator(topInstance());
   while (child_iter->hasNext()) {
     Instance* child = child_iter->next();
-    if (pattern->match(staToSdc(name(child))))
+    const char* child_name = network_->name(child);
+    if (isSdcName(child_name) ? pattern->match(child_name)
+                              : pattern->match(staToSdc(name(child))))
       insts.push_back(child);
   }
   delete child_iter;
 }
 
+// Name translation only touches escapes and bus brackets, so names
+// without them are matched in place instead of through temporary copies.
+bool
+dbSdcNetwork::isSdcName(const char* sta_name) const
+{
+  const char special[] = {pathEscape(), '[', ']', '\0'};
+  return strpbrk(sta_name, special) == nullptr;
+}
+
 NetSeq
 dbSdcNetwork::findNetsMatching(const Instance*,
                                const PatternMatch* pattern) const
@@ -132,7 +145,9 @@ dbSdcNetwork::findNetsMatching1(const PatternMatch* pattern,
   NetIterator* net_iter = netIterator(topInstance());
   while (net_iter->hasNext()) {
     Net* net = net_iter->next();
-    if (pattern->match(staToSdc(name(net))))
+    const char* net_name = network_->name(net);
+    if (isSdcName(net_name) ? pattern->match(net_name)
+                            : pattern->match(staToSdc(name(net))))
       nets.push_back(net);
   }
   delete net_iter;
@@ -55,6 +55,7 @@ protected:
   void findInstancesMatching1(const PatternMatch* pattern,
                               InstanceSeq& insts) const;
   void findNetsMatching1(const PatternMatch* pattern, NetSeq& nets) const;
+  bool isSdcName(const char* sta_name) const;
   void findMatchingPins(const Instance* instance,
                         const PatternMatch* port_pattern,
                         PinSeq& pins) const;
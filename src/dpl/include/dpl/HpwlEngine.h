@@ -0,0 +1,174 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// BSD 3-Clause License
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace dpl {
+
+// Incremental half perimeter wire length of a netlist of movable cells.
+//
+// Pins are stored as flat arrays of offsets from their cell's reference
+// point (usually its center) and each net caches its bounding box
+// along with the second most extreme pin coordinate on every side.
+// Moving a single pin of a net can then be evaluated in constant time
+// without rescanning the net; nets with several moving pins are
+// rescanned. Delta evaluation never modifies the engine, so callers
+// evaluate trial moves and commit only the ones they accept.
+class HpwlEngine
+{
+ public:
+  struct Move
+  {
+    int cell;
+    double x;
+    double y;
+    // Mirror the pin x offsets about the cell reference point.
+    bool flip_x = false;
+  };
+
+  void clear();
+  int addCell(double x, double y);
+  int addNet();
+  // Pins are numbered by net, in the order they were added within a net.
+  void addPin(int net, int cell, double offset_x, double offset_y);
+  // Build the flat pin arrays and net boxes after the netlist is added.
+  void build();
+
+  int getNumCells() const { return cell_x_.size(); }
+  int getNumNets() const { return boxes_.size(); }
+  double getCellX(int cell) const { return cell_x_[cell]; }
+  double getCellY(int cell) const { return cell_y_[cell]; }
+  int getPinCell(int pin) const { return pin_cell_[pin]; }
+  double getPinOffsetX(int pin) const { return pin_offset_x_[pin]; }
+  double getPinOffsetY(int pin) const { return pin_offset_y_[pin]; }
+  double getPinX(int pin) const;
+  double getPinY(int pin) const;
+  // Pins of a net.
+  int netPinBegin(int net) const { return net_pin_start_[net]; }
+  int netPinEnd(int net) const { return net_pin_start_[net + 1]; }
+
+  double hpwl() const;
+  double hpwl(int net) const;
+  double xMin(int net) const { return boxes_[net].x.min; }
+  double xMax(int net) const { return boxes_[net].x.max; }
+  double yMin(int net) const { return boxes_[net].y.min; }
+  double yMax(int net) const { return boxes_[net].y.max; }
+  // HPWL of the nets of a cell.
+  double cellHpwl(int cell);
+
+  // Change in HPWL if the cells are moved (new - old).
+  double delta(const std::vector<Move>& moves);
+  void delta(const std::vector<Move>& moves, double& delta_x, double& delta_y);
+  // Change in HPWL if a single cell is moved.
+  double delta(int cell, double x, double y, bool flip_x = false);
+  // Change in HPWL if two cells exchange their positions.
+  double swapDelta(int cell1, int cell2);
+
+  // Update the cell positions and the boxes of their nets.
+  void commit(const std::vector<Move>& moves);
+  void moveCell(int cell, double x, double y, bool flip_x = false);
+  // Replace a pin offset, eg after a cell changes orientation.
+  void setPinOffset(int pin, double offset_x, double offset_y);
+  // Pins of a cell.
+  int cellPinBegin(int cell) const { return cell_pin_start_[cell]; }
+  int cellPinEnd(int cell) const { return cell_pin_start_[cell + 1]; }
+  int cellPin(int index) const { return cell_pins_[index]; }
+
+ private:
+  // Extremes of the pin coordinates along one axis. min2 is the
+  // minimum after removing one pin at min (equal to min if several
+  // pins share it), likewise for max2.
+  struct Extremes
+  {
+    double min;
+    double min2;
+    double max;
+    double max2;
+
+    void reset();
+    void add(double coord);
+  };
+
+  struct NetBox
+  {
+    Extremes x;
+    Extremes y;
+  };
+
+  void updateNetBox(int net);
+  void markMoves(const std::vector<Move>& moves);
+  void unmarkMoves(const std::vector<Move>& moves);
+  double movedPinX(int pin, const std::vector<Move>& moves) const;
+  double movedPinY(int pin, const std::vector<Move>& moves) const;
+  static double span(const Extremes& ext);
+  static double moveOne(const Extremes& ext, double from, double to);
+
+  // Cells.
+  std::vector<double> cell_x_;
+  std::vector<double> cell_y_;
+  std::vector<int> cell_pin_start_;
+  std::vector<int> cell_pins_;
+  // Pins, grouped by net.
+  std::vector<int> net_pin_start_;
+  std::vector<int> pin_net_;
+  std::vector<int> pin_cell_;
+  std::vector<double> pin_offset_x_;
+  std::vector<double> pin_offset_y_;
+  std::vector<NetBox> boxes_;
+
+  // Pins before build().
+  struct PendingPin
+  {
+    int net;
+    int cell;
+    double offset_x;
+    double offset_y;
+  };
+  std::vector<PendingPin> pending_pins_;
+  int net_count_ = 0;
+
+  // Delta evaluation scratch state, reset lazily with stamps.
+  // Index of the move of a cell, or -1.
+  std::vector<int> cell_move_;
+  std::vector<int> net_stamp_;
+  std::vector<int> net_moved_pins_;
+  int stamp_ = 0;
+  std::vector<int> touched_nets_;
+  std::vector<Move> single_move_;
+};
+
+}  // namespace dpl
@@ -39,6 +39,7 @@
 
 #pragma once
 
+#include <deque>
 #include <functional>
 #include <map>
 #include <memory>
@@ -47,14 +48,18 @@
 #include <utility>  // pair
 #include <vector>
 
+#include "dpl/HpwlEngine.h"
 #include "odb/db.h"
+#include "odb/dbBlockCallBackObj.h"
 
 namespace utl {
+class Executor;
 class Logger;
 }
 
 namespace dpl {
 
+using std::deque;
 using std::map;
 using std::pair;
 using std::set;
@@ -82,6 +87,7 @@ using odb::Rect;
 struct Pixel;
 struct Group;
 class DplObserver;
+class IncrementalDPlace;
 
 using Grid = Pixel**;
 using dbMasterSeq = vector<dbMaster*>;
@@ -125,30 +131,47 @@ struct Pixel
 {
   Cell* cell;
   Group* group_;
-  double util;
   dbOrientType orient_;
   bool is_valid;     // false for dummy cells
   bool is_hopeless;  // too far from sites for diamond search
 };
 
-// For optimize mirroring.
-class NetBox
+// Free (valid and unoccupied) sites of one grid row stored as disjoint
+// [begin, end) site intervals keyed by begin.  Abutting intervals with
+// the same group are merged so a gap query is a single map lookup
+// instead of a pixel scan.
+class RowIntervals
 {
  public:
-  NetBox() = default;
-  NetBox(dbNet* net, Rect box, bool ignore);
-  int64_t hpwl();
-  void saveBox();
-  void restoreBox();
-
-  dbNet* net_ = nullptr;
-  Rect box_;
-  Rect box_saved_;
-  bool ignore_ = false;
-};
+  struct Interval
+  {
+    int begin;
+    int end;
+    Group* group;
+  };
+
+  void clear() { intervals_.clear(); }
+  bool empty() const { return intervals_.empty(); }
+  int size() const { return intervals_.size(); }
+  // Add [begin, end) as free sites. The range must not overlap
+  // any existing interval.
+  void insert(int begin, int end, Group* group);
+  // Remove [begin, end) from the free sites, splitting intervals as needed.
+  void erase(int begin, int end);
+  // Interval containing site x or nullptr.
+  const Interval* find(int x) const;
+  // True if [begin, end) is inside one free interval of group.
+  bool isFree(int begin, int end, const Group* group) const;
+
+  map<int, Interval>::const_iterator begin() const
+  {
+    return intervals_.begin();
+  }
+  map<int, Interval>::const_iterator end() const { return intervals_.end(); }
 
-using NetBoxMap = unordered_map<dbNet*, NetBox>;
-using NetBoxes = vector<NetBox*>;
+ private:
+  map<int, Interval> intervals_;
+};
 
 ////////////////////////////////////////////////////////////////
 
@@ -173,13 +196,23 @@ class Opendp
   Opendp(const Opendp&&) = delete;
   Opendp& operator=(const Opendp&&) = delete;
 
-  void init(dbDatabase* db, Logger* logger);
+  void init(dbDatabase* db, Logger* logger, utl::Executor* executor);
   void initBlock();
   // legalize/report
   // max_displacment is in sites. use zero for defaults.
+  // parallel legalizes bands of rows concurrently on the executor.
   void detailedPlacement(int max_displacement_x,
                          int max_displacement_y,
-                         bool disallow_one_site_gaps = false);
+                         bool disallow_one_site_gaps = false,
+                         bool parallel = false);
+  // Legalize only the instances created, resized or moved since the
+  // previous call. The first call builds the grid from the current
+  // placement and starts tracking db changes; detailedPlacement and
+  // other full imports of the db stop it. The legalization stats cover
+  // the cells moved by this call.
+  void incrementalPlacement(int max_displacement_x,
+                            int max_displacement_y,
+                            bool disallow_one_site_gaps = false);
   void reportLegalizationStats() const;
   void setPaddingGlobal(int left, int right);
   void setPadding(dbMaster* master, int left, int right);
@@ -201,7 +234,18 @@ class Opendp
   void findDisplacementStats();
   void optimizeMirroring();
 
-  const vector<Cell>& getCells() const { return cells_; }
+  // Incremental placement functions. See class IncrementalDPlace.
+  void initIncremental(int max_displacement_x, int max_displacement_y);
+  // Clear the footprint of inst before it moves or changes master.
+  void eraseInst(dbInst* inst);
+  // Repaint inst before its placement status makes it fixed or movable.
+  void changeInstStatus(dbInst* inst, bool fixed);
+  void addDirtyInst(dbInst* inst);
+  void removeInst(dbInst* inst);
+  void legalizeDirtyInsts();
+  void endIncremental();
+
+  const deque<Cell>& getCells() const { return cells_; }
   Rect getCore() const { return core_; }
   int getRowHeight() const { return row_height_; }
   int getSiteWidth() const { return site_width_; }
@@ -210,12 +254,22 @@ class Opendp
 
  private:
   friend class OpendpTest_IsPlaced_Test;
+  friend class OpendpPlaceTest_LazyGridRows_Test;
   void importDb();
   void importClear();
   Rect getBbox(dbInst* inst);
   void makeMacros();
   void examineRows();
   void makeCells();
+  Cell* makeCell(dbInst* db_inst);
+  void updateCellGeometry(Cell& cell);
+  Master& findMaster(dbMaster* db_master);
+  void setMaxDisplacement(int max_displacement_x, int max_displacement_y);
+  void updateDbInstLocation(Cell& cell);
+  void retargetCell(Cell* from, Cell* to);
+  void eraseFixedCell(Cell* cell);
+  void paintFixedCell(Cell* cell);
+  void syncFreeIntervals(const Cell* cell);
   static bool isPlacedType(dbMasterType type);
   void makeGroups();
   double dbuToMicrons(int64_t dbu) const;
@@ -238,6 +292,12 @@ class Opendp
                         // grid indices
                         int x,
                         int y) const;
+  PixelPt diamondSearch(const Cell* cell,
+                        // grid indices
+                        int x,
+                        int y,
+                        int row_min,
+                        int row_max) const;
   void diamondSearchSide(const Cell* cell,
                          int x,
                          int y,
@@ -247,10 +307,15 @@ class Opendp
                          int y_max,
                          int x_offset,
                          int y_offset,
+                         int row_max,
                          // Return values
                          PixelPt& best_pt,
                          int& best_dist) const;
-  PixelPt binSearch(int x, const Cell* cell, int bin_x, int bin_y) const;
+  PixelPt binSearch(int x,
+                    const Cell* cell,
+                    int bin_x,
+                    int bin_y,
+                    int row_max) const;
   bool checkPixels(const Cell* cell, int x, int y, int x_end, int y_end) const;
   void shiftMove(Cell* cell);
   bool mapMove(Cell* cell);
@@ -271,6 +336,7 @@ class Opendp
   void prePlace();
   void prePlaceGroups();
   void place();
+  void placeRowBands(const vector<Cell*>& sorted_cells);
   void placeGroups2();
   void brickPlace1(const Group* group);
   void brickPlace2(const Group* group);
@@ -295,6 +361,9 @@ class Opendp
   void groupInitPixels2();
   void erasePixel(Cell* cell);
   void paintPixel(Cell* cell, int grid_x, int grid_y);
+  void initFreeIntervals();
+  void freeIntervalsErase(int x, int y, int x_end, int y_end);
+  void freeIntervalsInsert(int x, int y, int x_end, int y_end);
 
   // checkPlacement
   static bool isPlaced(const Cell* cell);
@@ -327,6 +396,8 @@ class Opendp
   void checkOneSiteDbMaster();
   void deleteGrid();
   Pixel* gridPixel(int x, int y) const;
+  bool isValidPixel(int x, int y) const;
+  bool isHopelessPixel(int x, int y) const;
   // Cell initial location wrt core origin.
   int gridX(int x) const;
   int gridY(int y) const;
@@ -367,23 +438,21 @@ class Opendp
 
   // Optimizing mirroring
   void findNetBoxes();
-  vector<dbInst*> findMirrorCandidates(NetBoxes& net_boxes);
+  int mirrorCell(dbInst* inst);
+  vector<dbInst*> findMirrorCandidates();
   int mirrorCandidates(vector<dbInst*>& mirror_candidates);
-  // Sum of ITerm hpwl's.
-  int64_t hpwl(dbInst* inst);
-  void updateNetBoxes(dbInst* inst);
-  void saveNetBoxes(dbInst* inst);
-  void restoreNetBoxes(dbInst* inst);
 
   Logger* logger_ = nullptr;
   dbDatabase* db_ = nullptr;
+  utl::Executor* executor_ = nullptr;  // serial if not set
   dbBlock* block_ = nullptr;
   int pad_left_ = 0;
   int pad_right_ = 0;
   InstPaddingMap inst_padding_map_;
   MasterPaddingMap master_padding_map_;
 
-  vector<Cell> cells_;
+  // deque so cells added incrementally do not move existing cells.
+  deque<Cell> cells_;
   vector<Group> groups_;
 
   map<const dbMaster*, Master> db_master_map_;
@@ -398,11 +467,19 @@ class Opendp
   int max_displacement_x_ = 0;  // sites
   int max_displacement_y_ = 0;  // sites
   bool disallow_one_site_gaps_ = false;
+  bool parallel_ = false;
   vector<dbInst*> placement_failures_;
 
-  // 2D pixel grid
+  // 2D pixel grid.  Rows without sites, cells or group regions are
+  // not allocated (nullptr) and read as invalid, unoccupied pixels.
   Grid grid_ = nullptr;
+  // Hopeless grid rectangles, consulted for the unallocated rows.
+  vector<Rect> hopeless_rects_;
   Cell dummy_cell_;
+  // Free site intervals per row, kept in sync with the pixel grid
+  // by paintPixel/erasePixel. They index gap queries; the pixels stay
+  // the occupancy store.
+  vector<RowIntervals> free_intervals_;
 
   // Filler placement.
   // gap (in sites) -> seq of masters
@@ -418,7 +495,21 @@ class Opendp
   int64_t displacement_max_ = 0;
 
   // Optimiize mirroring.
-  NetBoxMap net_box_map_;
+  // Pins are relative to the instance bbox centers.
+  HpwlEngine mirror_hpwl_;
+  // Engine cell -> instance, nullptr for bterm pins.
+  vector<dbInst*> mirror_insts_;
+  unordered_map<dbInst*, int> mirror_cells_;
+
+  // Incremental placement.
+  bool incremental_ = false;
+  // Ignore db callbacks while writing locations back to the db.
+  bool updating_db_ = false;
+  std::set<Cell*> dirty_cells_;
+  // Cells painted by legalizeDirtyInsts, including shifted neighbors.
+  vector<Cell*> moved_cells_;
+  // Session started by incrementalPlacement.
+  std::unique_ptr<IncrementalDPlace> incr_dp_;
 
   std::unique_ptr<DplObserver> debug_observer_;
 
@@ -427,11 +518,64 @@ class Opendp
   static constexpr double group_refine_percent_ = .05;
   static constexpr double refine_percent_ = .02;
   static constexpr int rand_seed_ = 777;
+  // Row bands for parallel placement.
+  static constexpr int band_rows_ = 100;
+  static constexpr int band_halo_rows_ = 10;
   // Net bounding box siaz on nets with more instance terminals
   // than this are ignored.
   static constexpr int mirror_max_iterm_count_ = 100;
 };
 
+// Marks instances touched by ECO changes dirty in Opendp.
+class DplDbCbk : public odb::dbBlockCallBackObj
+{
+ public:
+  explicit DplDbCbk(Opendp* opendp);
+  void inDbInstCreate(dbInst* inst) override;
+  void inDbInstCreate(dbInst* inst, odb::dbRegion* region) override;
+  void inDbInstDestroy(dbInst* inst) override;
+  void inDbInstPlacementStatusBefore(
+      dbInst* inst,
+      const odb::dbPlacementStatus& status) override;
+  void inDbInstSwapMasterBefore(dbInst* inst, dbMaster* master) override;
+  void inDbInstSwapMasterAfter(dbInst* inst) override;
+  void inDbPreMoveInst(dbInst* inst) override;
+  void inDbPostMoveInst(dbInst* inst) override;
+
+ private:
+  Opendp* opendp_;
+};
+
+// Incremental legalization:
+//  IncrementalDPlace incr_dp(opendp, block);
+//  <create/resize/move instances>
+//  incr_dp.legalize();
+//  <more changes>
+//  incr_dp.legalize();
+// The grid is built once from the current placement and only
+// dirty instances and the neighbors they displace are moved.
+class IncrementalDPlace
+{
+ public:
+  // Builds the grid from the current placement and enables db callbacks.
+  // max_displacment is in sites. use zero for defaults.
+  IncrementalDPlace(Opendp* opendp,
+                    dbBlock* block,
+                    int max_displacement_x = 0,
+                    int max_displacement_y = 0);
+  // Legalize dirty instances.
+  void legalize();
+  // True while the callbacks are registered on block.
+  bool isTracking(dbBlock* block) const;
+  // Disables db callbacks.
+  ~IncrementalDPlace();
+
+ private:
+  Opendp* opendp_;
+  dbBlock* block_;
+  DplDbCbk db_cbk_;
+};
+
 int divRound(int dividend, int divisor);
 int divCeil(int dividend, int divisor);
 int divFloor(int dividend, int divisor);
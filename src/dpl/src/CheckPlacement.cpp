@@ -56,6 +56,8 @@ void Opendp::checkPlacement(bool verbose)
   vector<Cell*> site_align_failures;
 
   initGrid();
+  // Nothing is painted yet so the free intervals are the row sites.
+  initFreeIntervals();
   for (Cell& cell : cells_) {
     if (isStdCell(&cell)) {
       // Site alignment check
@@ -143,13 +145,12 @@ bool Opendp::checkInRows(const Cell& cell) const
   int x_ur = gridEndX(&cell);
   int y_ll = gridY(&cell);
   int y_ur = gridEndY(&cell);
+  if (y_ll < 0 || y_ur > row_count_) {
+    return false;  // outside core
+  }
   for (int y = y_ll; y < y_ur; y++) {
-    for (int x = x_ll; x < x_ur; x++) {
-      Pixel* pixel = gridPixel(x, y);
-      if (pixel == nullptr  // outside core
-          || !pixel->is_valid) {
-        return false;
-      }
+    if (!free_intervals_[y].isFree(x_ll, x_ur, nullptr)) {
+      return false;
     }
   }
   return true;
@@ -62,6 +62,7 @@ void Opendp::fillerPlacement(dbMasterSeq* filler_masters, const char* prefix)
   filler_count_ = 0;
   initGrid();
   setGridCells();
+  initFreeIntervals();
 
   for (int row = 0; row < row_count_; row++) {
     placeRowFillers(row, prefix, filler_masters);
@@ -82,54 +83,41 @@ void Opendp::placeRowFillers(int row,
                              const char* prefix,
                              dbMasterSeq* filler_masters)
 {
-  int j = 0;
-  while (j < row_site_count_) {
-    Pixel* pixel = gridPixel(j, row);
-    const dbOrientType orient = pixel->orient_;
-    if (pixel->cell == nullptr && pixel->is_valid) {
-      int k = j;
-      while (k < row_site_count_ && gridPixel(k, row)->cell == nullptr
-             && gridPixel(k, row)->is_valid) {
-        k++;
-      }
-      int gap = k - j;
-      // printf("filling row %d gap %d %d:%d\n", row, gap, j, k - 1);
-      dbMasterSeq& fillers = gapFillers(gap, filler_masters);
-      if (fillers.empty()) {
-        int x = core_.xMin() + j * site_width_;
+  for (const auto& [begin, interval] : free_intervals_[row]) {
+    const int j = interval.begin;
+    const int k = interval.end;
+    const dbOrientType orient = gridPixel(j, row)->orient_;
+    int gap = k - j;
+    dbMasterSeq& fillers = gapFillers(gap, filler_masters);
+    if (fillers.empty()) {
+      int x = core_.xMin() + j * site_width_;
+      int y = core_.yMin() + row * row_height_;
+      logger_->error(
+          DPL,
+          2,
+          "could not fill gap of size {} at {},{} dbu between {} and {}",
+          gap,
+          x,
+          y,
+          gridInstName(row, j - 1),
+          gridInstName(row, k + 1));
+    } else {
+      int site = j;
+      for (dbMaster* master : fillers) {
+        string inst_name = prefix + to_string(row) + "_" + to_string(site);
+        dbInst* inst = dbInst::create(block_,
+                                      master,
+                                      inst_name.c_str(),
+                                      /* physical_only */ true);
+        int x = core_.xMin() + site * site_width_;
         int y = core_.yMin() + row * row_height_;
-        logger_->error(
-            DPL,
-            2,
-            "could not fill gap of size {} at {},{} dbu between {} and {}",
-            gap,
-            x,
-            y,
-            gridInstName(row, j - 1),
-            gridInstName(row, k + 1));
-      } else {
-        k = j;
-        for (dbMaster* master : fillers) {
-          string inst_name = prefix + to_string(row) + "_" + to_string(k);
-          // printf(" filler %s %d\n", inst_name.c_str(), master->getWidth() /
-          // site_width_);
-          dbInst* inst = dbInst::create(block_,
-                                        master,
-                                        inst_name.c_str(),
-                                        /* physical_only */ true);
-          int x = core_.xMin() + k * site_width_;
-          int y = core_.yMin() + row * row_height_;
-          inst->setOrient(orient);
-          inst->setLocation(x, y);
-          inst->setPlacementStatus(dbPlacementStatus::PLACED);
-          inst->setSourceType(odb::dbSourceType::DIST);
-          filler_count_++;
-          k += master->getWidth() / site_width_;
-        }
-        j += gap;
+        inst->setOrient(orient);
+        inst->setLocation(x, y);
+        inst->setPlacementStatus(dbPlacementStatus::PLACED);
+        inst->setSourceType(odb::dbSourceType::DIST);
+        filler_count_++;
+        site += master->getWidth() / site_width_;
       }
-    } else {
-      j++;
     }
   }
 }
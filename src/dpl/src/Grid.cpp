@@ -40,6 +40,7 @@
 #include <boost/polygon/polygon.hpp>
 #include <cmath>
 #include <limits>
+#include <unordered_map>
 
 #include "dpl/Opendp.h"
 #include "odb/dbTransform.h"
@@ -57,21 +58,51 @@ using odb::dbTransform;
 
 void Opendp::initGrid()
 {
+  // Only rows that can hold sites, cells or group regions get pixels.
+  std::vector<bool> used_rows(row_count_, false);
+  auto useRows = [&](int y_begin, int y_end) {
+    for (int y = max(0, y_begin); y < min(row_count_, y_end); y++) {
+      used_rows[y] = true;
+    }
+  };
+  for (auto db_row : block_->getRows()) {
+    if (db_row->getSite()->getClass() == odb::dbSiteClass::PAD) {
+      continue;
+    }
+    int orig_x, orig_y;
+    db_row->getOrigin(orig_x, orig_y);
+    const int y_row = (orig_y - core_.yMin()) / row_height_;
+    useRows(y_row, y_row + 1);
+  }
+  for (const Cell& cell : cells_) {
+    useRows(gridY(&cell), gridEndY(&cell));
+  }
+  for (const Group& group : groups_) {
+    for (const Rect& rect : group.regions) {
+      useRows(divFloor(rect.yMin(), row_height_),
+              divCeil(rect.yMax(), row_height_));
+    }
+  }
+
   // Make pixel grid
   if (grid_ == nullptr) {
-    grid_ = new Pixel*[row_count_];
-    for (int y = 0; y < row_count_; y++) {
+    grid_ = new Pixel*[row_count_]();
+  }
+  for (int y = 0; y < row_count_; y++) {
+    if (used_rows[y] && grid_[y] == nullptr) {
       grid_[y] = new Pixel[row_site_count_];
     }
   }
 
   // Init pixels.
   for (int y = 0; y < row_count_; y++) {
+    if (grid_[y] == nullptr) {
+      continue;
+    }
     for (int x = 0; x < row_site_count_; x++) {
       Pixel& pixel = grid_[y][x];
       pixel.cell = nullptr;
       pixel.group_ = nullptr;
-      pixel.util = 0.0;
       pixel.is_valid = false;
       pixel.is_hopeless = false;
     }
@@ -115,8 +146,14 @@ void Opendp::initGrid()
 
   std::vector<gtl::rectangle_data<int>> rects;
   hopeless.get_rectangles(rects);
+  hopeless_rects_.clear();
   for (const auto& rect : rects) {
+    hopeless_rects_.emplace_back(
+        gtl::xl(rect), gtl::yl(rect), gtl::xh(rect), gtl::yh(rect));
     for (int y = gtl::yl(rect); y < gtl::yh(rect); y++) {
+      if (grid_[y] == nullptr) {
+        continue;
+      }
       for (int x = gtl::xl(rect); x < gtl::xh(rect); x++) {
         grid_[y][x].is_hopeless = true;
       }
@@ -138,13 +175,34 @@ void Opendp::deleteGrid()
 Pixel* Opendp::gridPixel(int grid_x, int grid_y) const
 {
   if (grid_x >= 0 && grid_x < row_site_count_ && grid_y >= 0
-      && grid_y < row_count_) {
+      && grid_y < row_count_ && grid_[grid_y] != nullptr) {
     return &grid_[grid_y][grid_x];
   }
 
   return nullptr;
 }
 
+bool Opendp::isValidPixel(int grid_x, int grid_y) const
+{
+  const Pixel* pixel = gridPixel(grid_x, grid_y);
+  return pixel && pixel->is_valid;
+}
+
+bool Opendp::isHopelessPixel(int grid_x, int grid_y) const
+{
+  const Pixel* pixel = gridPixel(grid_x, grid_y);
+  if (pixel) {
+    return pixel->is_hopeless;
+  }
+  for (const Rect& rect : hopeless_rects_) {
+    if (grid_x >= rect.xMin() && grid_x < rect.xMax() && grid_y >= rect.yMin()
+        && grid_y < rect.yMax()) {
+      return true;
+    }
+  }
+  return false;
+}
+
 ////////////////////////////////////////////////////////////////
 
 void Opendp::visitCellPixels(
@@ -282,7 +340,6 @@ void Opendp::setFixedGridCells()
 void Opendp::setGridCell(Cell& cell, Pixel* pixel)
 {
   pixel->cell = &cell;
-  pixel->util = 1.0;
   if (isBlock(&cell)) {
     // Try the is_hopeless strategy to get off of a block
     pixel->is_hopeless = true;
@@ -296,7 +353,7 @@ void Opendp::groupAssignCellRegions()
     for (int x = 0; x < row_site_count_; x++) {
       for (int y = 0; y < row_count_; y++) {
         Pixel* pixel = gridPixel(x, y);
-        if (pixel->is_valid && pixel->group_ == &group) {
+        if (pixel && pixel->is_valid && pixel->group_ == &group) {
           site_count++;
         }
       }
@@ -324,16 +381,18 @@ void Opendp::groupInitPixels2()
 {
   for (int x = 0; x < row_site_count_; x++) {
     for (int y = 0; y < row_count_; y++) {
+      Pixel* pixel = gridPixel(x, y);
+      if (pixel == nullptr) {
+        continue;
+      }
       Rect sub;
       sub.init(x * site_width_,
                y * row_height_,
                (x + 1) * site_width_,
                (y + 1) * row_height_);
-      Pixel* pixel = gridPixel(x, y);
       for (Group& group : groups_) {
         for (Rect& rect : group.regions) {
           if (!isInside(sub, rect) && checkOverlap(sub, rect)) {
-            pixel->util = 0.0;
             pixel->cell = &dummy_cell_;
             pixel->is_valid = false;
           }
@@ -358,12 +417,12 @@ bool Opendp::checkOverlap(const Rect& cell, const Rect& box)
 
 void Opendp::groupInitPixels()
 {
-  for (int x = 0; x < row_site_count_; x++) {
-    for (int y = 0; y < row_count_; y++) {
-      Pixel* pixel = gridPixel(x, y);
-      pixel->util = 0.0;
-    }
-  }
+  // Fraction of each site covered by group regions. Only sites under a
+  // region have an entry, so pixels do not carry it.
+  std::unordered_map<int64_t, double> util;
+  auto siteUtil = [&](int x, int y) -> double& {
+    return util[static_cast<int64_t>(y) * row_site_count_ + x];
+  };
 
   for (Group& group : groups_) {
     for (Rect& rect : group.regions) {
@@ -375,18 +434,16 @@ void Opendp::groupInitPixels()
         int col_end = divFloor(rect.xMax(), site_width_);
 
         for (int l = col_start; l < col_end; l++) {
-          Pixel* pixel = gridPixel(l, k);
-          pixel->util += 1.0;
+          siteUtil(l, k) += 1.0;
         }
         if (rect.xMin() % site_width_ != 0) {
-          Pixel* pixel = gridPixel(col_start, k);
-          pixel->util
+          siteUtil(col_start, k)
               -= (rect.xMin() % site_width_) / static_cast<double>(site_width_);
         }
         if (rect.xMax() % site_width_ != 0) {
-          Pixel* pixel = gridPixel(col_end - 1, k);
-          pixel->util -= ((site_width_ - rect.xMax()) % site_width_)
-                         / static_cast<double>(site_width_);
+          siteUtil(col_end - 1, k)
+              -= ((site_width_ - rect.xMax()) % site_width_)
+                 / static_cast<double>(site_width_);
         }
       }
     }
@@ -401,14 +458,14 @@ void Opendp::groupInitPixels()
         // Assign group to each pixel.
         for (int l = col_start; l < col_end; l++) {
           Pixel* pixel = gridPixel(l, k);
-          if (pixel->util == 1.0) {
+          double& site_util = siteUtil(l, k);
+          if (site_util == 1.0) {
             pixel->group_ = &group;
             pixel->is_valid = true;
-            pixel->util = 1.0;
-          } else if (pixel->util > 0.0 && pixel->util < 1.0) {
+          } else if (site_util > 0.0 && site_util < 1.0) {
             pixel->cell = &dummy_cell_;
-            pixel->util = 0.0;
             pixel->is_valid = false;
+            site_util = 0.0;
           }
         }
       }
@@ -419,15 +476,17 @@ void Opendp::groupInitPixels()
 void Opendp::erasePixel(Cell* cell)
 {
   if (!(isFixed(cell) || !cell->is_placed_)) {
+    int x_begin = gridPaddedX(cell);
     int x_end = gridPaddedEndX(cell);
+    int y_begin = gridY(cell);
     int y_end = gridEndY(cell);
-    for (int x = gridPaddedX(cell); x < x_end; x++) {
-      for (int y = gridY(cell); y < y_end; y++) {
+    for (int x = x_begin; x < x_end; x++) {
+      for (int y = y_begin; y < y_end; y++) {
         Pixel* pixel = gridPixel(x, y);
         pixel->cell = nullptr;
-        pixel->util = 0;
       }
     }
+    freeIntervalsInsert(x_begin, y_begin, x_end, y_end);
     cell->is_placed_ = false;
     cell->hold_ = false;
   }
@@ -442,6 +501,9 @@ void Opendp::paintPixel(Cell* cell, int grid_x, int grid_y)
 
   setGridPaddedLoc(cell, grid_x, grid_y);
   cell->is_placed_ = true;
+  if (incremental_) {
+    moved_cells_.push_back(cell);
+  }
 
   debugPrint(logger_,
              DPL,
@@ -462,13 +524,58 @@ void Opendp::paintPixel(Cell* cell, int grid_x, int grid_y)
             DPL, 13, "Cannot paint grid because it is already occupied.");
       } else {
         pixel->cell = cell;
-        pixel->util = 1.0;
       }
     }
   }
+  freeIntervalsErase(grid_x, grid_y, x_end, y_end);
 
   // This is most likely broken for multi-row cells
   cell->orient_ = gridPixel(grid_x, grid_y)->orient_;
 }
 
+////////////////////////////////////////////////////////////////
+
+// Build the free site intervals from the pixel grid. Sites are free
+// if they are valid and not occupied by a cell or dummy cell.
+void Opendp::initFreeIntervals()
+{
+  free_intervals_.clear();
+  free_intervals_.resize(row_count_);
+  freeIntervalsInsert(0, 0, row_site_count_, row_count_);
+}
+
+// Add the free pixels in the grid rectangle to the free intervals.
+void Opendp::freeIntervalsInsert(int x, int y, int x_end, int y_end)
+{
+  for (int y1 = y; y1 < y_end; y1++) {
+    if (grid_[y1] == nullptr) {
+      continue;
+    }
+    RowIntervals& row = free_intervals_[y1];
+    int x1 = x;
+    while (x1 < x_end) {
+      const Pixel& pixel = grid_[y1][x1];
+      if (pixel.cell == nullptr && pixel.is_valid) {
+        int run_end = x1 + 1;
+        while (run_end < x_end && grid_[y1][run_end].cell == nullptr
+               && grid_[y1][run_end].is_valid
+               && grid_[y1][run_end].group_ == pixel.group_) {
+          run_end++;
+        }
+        row.insert(x1, run_end, pixel.group_);
+        x1 = run_end;
+      } else {
+        x1++;
+      }
+    }
+  }
+}
+
+void Opendp::freeIntervalsErase(int x, int y, int x_end, int y_end)
+{
+  for (int y1 = y; y1 < y_end; y1++) {
+    free_intervals_[y1].erase(x, x_end);
+  }
+}
+
 }  // namespace dpl
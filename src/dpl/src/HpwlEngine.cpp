@@ -0,0 +1,358 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// BSD 3-Clause License
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "dpl/HpwlEngine.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace dpl {
+
+void HpwlEngine::Extremes::reset()
+{
+  min = min2 = std::numeric_limits<double>::max();
+  max = max2 = std::numeric_limits<double>::lowest();
+}
+
+void HpwlEngine::Extremes::add(double coord)
+{
+  if (coord < min) {
+    min2 = min;
+    min = coord;
+  } else if (coord < min2) {
+    min2 = coord;
+  }
+  if (coord > max) {
+    max2 = max;
+    max = coord;
+  } else if (coord > max2) {
+    max2 = coord;
+  }
+}
+
+////////////////////////////////////////////////////////////////
+
+void HpwlEngine::clear()
+{
+  cell_x_.clear();
+  cell_y_.clear();
+  cell_pin_start_.clear();
+  cell_pins_.clear();
+  net_pin_start_.clear();
+  pin_net_.clear();
+  pin_cell_.clear();
+  pin_offset_x_.clear();
+  pin_offset_y_.clear();
+  boxes_.clear();
+  pending_pins_.clear();
+  net_count_ = 0;
+  cell_move_.clear();
+  net_stamp_.clear();
+  net_moved_pins_.clear();
+  stamp_ = 0;
+}
+
+int HpwlEngine::addCell(double x, double y)
+{
+  cell_x_.push_back(x);
+  cell_y_.push_back(y);
+  return cell_x_.size() - 1;
+}
+
+int HpwlEngine::addNet()
+{
+  return net_count_++;
+}
+
+void HpwlEngine::addPin(int net, int cell, double offset_x, double offset_y)
+{
+  pending_pins_.push_back({net, cell, offset_x, offset_y});
+}
+
+void HpwlEngine::build()
+{
+  const int cell_count = cell_x_.size();
+  const int pin_count = pending_pins_.size();
+
+  // Counting sort of the pins by net.
+  net_pin_start_.assign(net_count_ + 1, 0);
+  for (const PendingPin& pin : pending_pins_) {
+    net_pin_start_[pin.net + 1]++;
+  }
+  for (int net = 0; net < net_count_; net++) {
+    net_pin_start_[net + 1] += net_pin_start_[net];
+  }
+  pin_net_.resize(pin_count);
+  pin_cell_.resize(pin_count);
+  pin_offset_x_.resize(pin_count);
+  pin_offset_y_.resize(pin_count);
+  std::vector<int> next(net_pin_start_.begin(), net_pin_start_.end() - 1);
+  for (const PendingPin& pending : pending_pins_) {
+    const int pin = next[pending.net]++;
+    pin_net_[pin] = pending.net;
+    pin_cell_[pin] = pending.cell;
+    pin_offset_x_[pin] = pending.offset_x;
+    pin_offset_y_[pin] = pending.offset_y;
+  }
+  pending_pins_.clear();
+  pending_pins_.shrink_to_fit();
+
+  cell_pin_start_.assign(cell_count + 1, 0);
+  for (int pin = 0; pin < pin_count; pin++) {
+    cell_pin_start_[pin_cell_[pin] + 1]++;
+  }
+  for (int cell = 0; cell < cell_count; cell++) {
+    cell_pin_start_[cell + 1] += cell_pin_start_[cell];
+  }
+  cell_pins_.resize(pin_count);
+  next.assign(cell_pin_start_.begin(), cell_pin_start_.end() - 1);
+  for (int pin = 0; pin < pin_count; pin++) {
+    cell_pins_[next[pin_cell_[pin]]++] = pin;
+  }
+
+  boxes_.resize(net_count_);
+  for (int net = 0; net < net_count_; net++) {
+    updateNetBox(net);
+  }
+
+  cell_move_.assign(cell_count, -1);
+  net_stamp_.assign(net_count_, 0);
+  net_moved_pins_.assign(net_count_, 0);
+  stamp_ = 0;
+}
+
+double HpwlEngine::getPinX(int pin) const
+{
+  return cell_x_[pin_cell_[pin]] + pin_offset_x_[pin];
+}
+
+double HpwlEngine::getPinY(int pin) const
+{
+  return cell_y_[pin_cell_[pin]] + pin_offset_y_[pin];
+}
+
+void HpwlEngine::updateNetBox(int net)
+{
+  NetBox& box = boxes_[net];
+  box.x.reset();
+  box.y.reset();
+  for (int pin = net_pin_start_[net]; pin < net_pin_start_[net + 1]; pin++) {
+    box.x.add(getPinX(pin));
+    box.y.add(getPinY(pin));
+  }
+}
+
+double HpwlEngine::span(const Extremes& ext)
+{
+  return (ext.max >= ext.min) ? ext.max - ext.min : 0.0;
+}
+
+// Span of ext after one of its coordinates moves from -> to.
+double HpwlEngine::moveOne(const Extremes& ext, double from, double to)
+{
+  const double min = std::min((from == ext.min) ? ext.min2 : ext.min, to);
+  const double max = std::max((from == ext.max) ? ext.max2 : ext.max, to);
+  return max - min;
+}
+
+double HpwlEngine::hpwl() const
+{
+  double hpwl_sum = 0;
+  for (const NetBox& box : boxes_) {
+    hpwl_sum += span(box.x) + span(box.y);
+  }
+  return hpwl_sum;
+}
+
+double HpwlEngine::hpwl(int net) const
+{
+  return span(boxes_[net].x) + span(boxes_[net].y);
+}
+
+double HpwlEngine::cellHpwl(int cell)
+{
+  stamp_++;
+  double hpwl_sum = 0;
+  for (int i = cell_pin_start_[cell]; i < cell_pin_start_[cell + 1]; i++) {
+    const int net = pin_net_[cell_pins_[i]];
+    if (net_stamp_[net] != stamp_) {
+      net_stamp_[net] = stamp_;
+      hpwl_sum += hpwl(net);
+    }
+  }
+  return hpwl_sum;
+}
+
+////////////////////////////////////////////////////////////////
+
+// Index the moved cells and count the moved pins of each net.
+void HpwlEngine::markMoves(const std::vector<Move>& moves)
+{
+  stamp_++;
+  touched_nets_.clear();
+  for (int i = 0; i < moves.size(); i++) {
+    const int cell = moves[i].cell;
+    cell_move_[cell] = i;
+    for (int j = cell_pin_start_[cell]; j < cell_pin_start_[cell + 1]; j++) {
+      const int net = pin_net_[cell_pins_[j]];
+      if (net_stamp_[net] != stamp_) {
+        net_stamp_[net] = stamp_;
+        net_moved_pins_[net] = 0;
+        touched_nets_.push_back(net);
+      }
+      net_moved_pins_[net]++;
+    }
+  }
+}
+
+void HpwlEngine::unmarkMoves(const std::vector<Move>& moves)
+{
+  for (const Move& move : moves) {
+    cell_move_[move.cell] = -1;
+  }
+}
+
+double HpwlEngine::movedPinX(int pin, const std::vector<Move>& moves) const
+{
+  const int move = cell_move_[pin_cell_[pin]];
+  if (move < 0) {
+    return getPinX(pin);
+  }
+  const double offset = pin_offset_x_[pin];
+  return moves[move].x + (moves[move].flip_x ? -offset : offset);
+}
+
+double HpwlEngine::movedPinY(int pin, const std::vector<Move>& moves) const
+{
+  const int move = cell_move_[pin_cell_[pin]];
+  if (move < 0) {
+    return getPinY(pin);
+  }
+  return moves[move].y + pin_offset_y_[pin];
+}
+
+void HpwlEngine::delta(const std::vector<Move>& moves,
+                       double& delta_x,
+                       double& delta_y)
+{
+  delta_x = 0;
+  delta_y = 0;
+  markMoves(moves);
+  for (const Move& move : moves) {
+    const int cell = move.cell;
+    for (int j = cell_pin_start_[cell]; j < cell_pin_start_[cell + 1]; j++) {
+      const int pin = cell_pins_[j];
+      const int net = pin_net_[pin];
+      const NetBox& box = boxes_[net];
+      const int moved_pins = net_moved_pins_[net];
+      if (moved_pins == 1) {
+        delta_x += moveOne(box.x, getPinX(pin), movedPinX(pin, moves))
+                   - span(box.x);
+        delta_y += moveOne(box.y, getPinY(pin), movedPinY(pin, moves))
+                   - span(box.y);
+      } else if (moved_pins > 1) {
+        // Several pins of the net move; rescan it once.
+        Extremes x, y;
+        x.reset();
+        y.reset();
+        for (int p = net_pin_start_[net]; p < net_pin_start_[net + 1]; p++) {
+          x.add(movedPinX(p, moves));
+          y.add(movedPinY(p, moves));
+        }
+        delta_x += span(x) - span(box.x);
+        delta_y += span(y) - span(box.y);
+        net_moved_pins_[net] = 0;
+      }
+    }
+  }
+  unmarkMoves(moves);
+}
+
+double HpwlEngine::delta(const std::vector<Move>& moves)
+{
+  double delta_x, delta_y;
+  delta(moves, delta_x, delta_y);
+  return delta_x + delta_y;
+}
+
+double HpwlEngine::delta(int cell, double x, double y, bool flip_x)
+{
+  single_move_.assign(1, {cell, x, y, flip_x});
+  return delta(single_move_);
+}
+
+double HpwlEngine::swapDelta(int cell1, int cell2)
+{
+  single_move_.clear();
+  single_move_.push_back({cell1, cell_x_[cell2], cell_y_[cell2]});
+  single_move_.push_back({cell2, cell_x_[cell1], cell_y_[cell1]});
+  return delta(single_move_);
+}
+
+////////////////////////////////////////////////////////////////
+
+void HpwlEngine::commit(const std::vector<Move>& moves)
+{
+  markMoves(moves);
+  for (const Move& move : moves) {
+    const int cell = move.cell;
+    cell_x_[cell] = move.x;
+    cell_y_[cell] = move.y;
+    if (move.flip_x) {
+      for (int j = cell_pin_start_[cell]; j < cell_pin_start_[cell + 1]; j++) {
+        const int pin = cell_pins_[j];
+        pin_offset_x_[pin] = -pin_offset_x_[pin];
+      }
+    }
+  }
+  unmarkMoves(moves);
+  for (int net : touched_nets_) {
+    updateNetBox(net);
+  }
+}
+
+void HpwlEngine::moveCell(int cell, double x, double y, bool flip_x)
+{
+  single_move_.assign(1, {cell, x, y, flip_x});
+  commit(single_move_);
+}
+
+void HpwlEngine::setPinOffset(int pin, double offset_x, double offset_y)
+{
+  pin_offset_x_[pin] = offset_x;
+  pin_offset_y_[pin] = offset_y;
+  updateNetBox(pin_net_[pin]);
+}
+
+}  // namespace dpl
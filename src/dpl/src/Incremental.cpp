@@ -0,0 +1,451 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// BSD 3-Clause License
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstring>
+
+#include "dpl/Opendp.h"
+#include "utl/Logger.h"
+
+namespace dpl {
+
+using std::sort;
+using std::vector;
+
+using utl::DPL;
+
+// Build the grid from the current placement. Placed cells that are
+// legal where they sit are painted in place; the rest start dirty.
+void Opendp::initIncremental(int max_displacement_x, int max_displacement_y)
+{
+  importDb();
+  setMaxDisplacement(max_displacement_x, max_displacement_y);
+  placement_failures_.clear();
+  dirty_cells_.clear();
+  moved_cells_.clear();
+
+  initGrid();
+  setFixedGridCells();
+  groupInitPixels2();
+  groupInitPixels();
+  initFreeIntervals();
+  if (!groups_.empty()) {
+    groupAssignCellRegions();
+  }
+
+  for (Cell& cell : cells_) {
+    if (isFixed(&cell) || !isStdCell(&cell)) {
+      continue;
+    }
+    if (isPlaced(&cell) && cell.x_ % site_width_ == 0
+        && cell.y_ % row_height_ == 0) {
+      const int grid_x = gridPaddedX(&cell);
+      const int grid_y = gridY(&cell);
+      const int x_end = grid_x + gridPaddedWidth(&cell);
+      const int y_end = grid_y + gridHeight(&cell);
+      if (grid_x >= 0 && grid_y >= 0 && y_end <= row_count_
+          && checkPixels(&cell, grid_x, grid_y, x_end, y_end)) {
+        paintPixel(&cell, grid_x, grid_y);
+        continue;
+      }
+    }
+    dirty_cells_.insert(&cell);
+  }
+  incremental_ = true;
+  debugPrint(logger_,
+             DPL,
+             "incr",
+             1,
+             "Incremental placement with {} cells, {} dirty.",
+             cells_.size(),
+             dirty_cells_.size());
+}
+
+// The cell still has the location and master its footprint was painted
+// with, so padding and obstructions match the grid.
+void Opendp::eraseInst(dbInst* inst)
+{
+  if (!incremental_ || updating_db_) {
+    return;
+  }
+  auto cell_itr = db_inst_map_.find(inst);
+  if (cell_itr == db_inst_map_.end()) {
+    return;
+  }
+  Cell* cell = cell_itr->second;
+  if (isFixed(cell)) {
+    eraseFixedCell(cell);
+  } else {
+    erasePixel(cell);
+  }
+}
+
+// odb only moves unfixed instances, so a fixed instance is moved by
+// unfixing it first and fixing it again afterwards.
+void Opendp::changeInstStatus(dbInst* inst, bool fixed)
+{
+  if (!incremental_ || updating_db_) {
+    return;
+  }
+  auto cell_itr = db_inst_map_.find(inst);
+  if (cell_itr == db_inst_map_.end()) {
+    return;
+  }
+  Cell* cell = cell_itr->second;
+  if (isFixed(cell) == fixed) {
+    return;
+  }
+  if (fixed) {
+    // The db still has the cell as movable.
+    erasePixel(cell);
+    dirty_cells_.erase(cell);
+    paintFixedCell(cell);
+  } else {
+    eraseFixedCell(cell);
+    cell->is_placed_ = false;
+    if (isStdCell(cell)) {
+      dirty_cells_.insert(cell);
+    }
+  }
+}
+
+// Movable cells are legalized later; fixed cells are repainted now.
+void Opendp::addDirtyInst(dbInst* inst)
+{
+  if (!incremental_ || updating_db_) {
+    return;
+  }
+  auto cell_itr = db_inst_map_.find(inst);
+  if (cell_itr == db_inst_map_.end()) {
+    if (inst->getMaster()->isCoreAutoPlaceable() && !inst->isFixed()) {
+      dirty_cells_.insert(makeCell(inst));
+    }
+  } else if (isFixed(cell_itr->second)) {
+    paintFixedCell(cell_itr->second);
+  } else {
+    dirty_cells_.insert(cell_itr->second);
+  }
+}
+
+void Opendp::removeInst(dbInst* inst)
+{
+  if (!incremental_) {
+    return;
+  }
+  auto cell_itr = db_inst_map_.find(inst);
+  if (cell_itr == db_inst_map_.end()) {
+    return;
+  }
+  Cell* cell = cell_itr->second;
+  if (isFixed(cell)) {
+    eraseFixedCell(cell);
+  } else {
+    erasePixel(cell);
+  }
+  dirty_cells_.erase(cell);
+  db_inst_map_.erase(cell_itr);
+  Group* group = cell->group_;
+  if (group) {
+    auto& group_cells = group->cells_;
+    group_cells.erase(std::remove(group_cells.begin(), group_cells.end(), cell),
+                      group_cells.end());
+  }
+
+  // Fill the hole with the last cell so other cells do not move.
+  Cell* last = &cells_.back();
+  if (cell != last) {
+    retargetCell(last, cell);
+    *cell = *last;
+  }
+  cells_.pop_back();
+}
+
+// Fixed cells are painted by visitCellPixels; clear what they own.
+void Opendp::eraseFixedCell(Cell* cell)
+{
+  visitCellPixels(*cell, true, [&](Pixel* pixel) {
+    if (pixel->cell == cell) {
+      pixel->cell = nullptr;
+    }
+  });
+  syncFreeIntervals(cell);
+}
+
+// Paint a fixed cell where it is now. Movable cells under it are
+// erased and legalized with the other dirty cells.
+void Opendp::paintFixedCell(Cell* cell)
+{
+  updateCellGeometry(*cell);
+  set<Cell*> covered;
+  visitCellPixels(*cell, true, [&](Pixel* pixel) {
+    if (pixel->cell && !isFixed(pixel->cell)) {
+      covered.insert(pixel->cell);
+    }
+  });
+  for (Cell* other : covered) {
+    erasePixel(other);
+    dirty_cells_.insert(other);
+  }
+  visitCellPixels(
+      *cell, true, [&](Pixel* pixel) { setGridCell(*cell, pixel); });
+  cell->is_placed_ = true;
+  syncFreeIntervals(cell);
+}
+
+// Rebuild the free intervals over the padded bbox of cell; with
+// obstructions only part of it is painted.
+void Opendp::syncFreeIntervals(const Cell* cell)
+{
+  const int x_begin = std::max(0, gridPaddedX(cell));
+  const int y_begin = std::max(0, gridY(cell));
+  const int x_end = std::min(row_site_count_, gridPaddedEndX(cell));
+  const int y_end = std::min(row_count_, gridEndY(cell));
+  if (x_begin < x_end && y_begin < y_end) {
+    freeIntervalsErase(x_begin, y_begin, x_end, y_end);
+    freeIntervalsInsert(x_begin, y_begin, x_end, y_end);
+  }
+}
+
+// Point references to cell from at cell to.
+void Opendp::retargetCell(Cell* from, Cell* to)
+{
+  auto retarget = [&](Pixel* pixel) {
+    if (pixel->cell == from) {
+      pixel->cell = to;
+    }
+  };
+  if (isFixed(from)) {
+    visitCellPixels(*from, true, retarget);
+  } else if (from->is_placed_) {
+    const int x_end = gridPaddedEndX(from);
+    const int y_end = gridEndY(from);
+    for (int x = gridPaddedX(from); x < x_end; x++) {
+      for (int y = gridY(from); y < y_end; y++) {
+        Pixel* pixel = gridPixel(x, y);
+        if (pixel) {
+          retarget(pixel);
+        }
+      }
+    }
+  }
+  db_inst_map_[from->db_inst_] = to;
+  if (dirty_cells_.erase(from)) {
+    dirty_cells_.insert(to);
+  }
+  Group* group = from->group_;
+  if (group) {
+    std::replace(group->cells_.begin(), group->cells_.end(), from, to);
+  }
+}
+
+void Opendp::legalizeDirtyInsts()
+{
+  displacement_sum_ = 0;
+  displacement_max_ = 0;
+  displacement_avg_ = 0;
+  if (!incremental_ || dirty_cells_.empty()) {
+    return;
+  }
+  placement_failures_.clear();
+  moved_cells_.clear();
+
+  vector<Cell*> sorted_cells(dirty_cells_.begin(), dirty_cells_.end());
+  dirty_cells_.clear();
+  for (Cell* cell : sorted_cells) {
+    // The old footprint was erased by eraseInst before the change.
+    updateCellGeometry(*cell);
+  }
+  sort(sorted_cells.begin(), sorted_cells.end(), [](Cell* cell1, Cell* cell2) {
+    const int64_t area1 = cell1->area();
+    const int64_t area2 = cell2->area();
+    return area1 > area2
+           || (area1 == area2
+               && strcmp(cell1->name(), cell2->name()) < 0);
+  });
+
+  debugPrint(logger_,
+             DPL,
+             "incr",
+             1,
+             "Legalizing {} dirty cells.",
+             sorted_cells.size());
+  // Place multi-row instances first.
+  for (int multi_row = 1; multi_row >= 0; multi_row--) {
+    for (Cell* cell : sorted_cells) {
+      if (isMultiRow(cell) == multi_row && !cell->is_placed_
+          && cellFitsInCore(cell)) {
+        if (!mapMove(cell)) {
+          shiftMove(cell);
+        }
+      }
+    }
+  }
+
+  // shiftMove may paint a cell more than once.
+  sort(moved_cells_.begin(), moved_cells_.end());
+  moved_cells_.erase(std::unique(moved_cells_.begin(), moved_cells_.end()),
+                     moved_cells_.end());
+
+  // Cells that did not move add nothing to the displacement, so only
+  // the moved cells are visited; the db still has their old locations.
+  for (Cell* cell : moved_cells_) {
+    const int displacement = disp(cell);
+    displacement_sum_ += displacement;
+    displacement_max_ = std::max<int64_t>(displacement_max_, displacement);
+  }
+  displacement_avg_ = displacement_sum_ / cells_.size();
+
+  // Write back the dirty cells and any neighbors shiftMove displaced.
+  updating_db_ = true;
+  for (Cell* cell : moved_cells_) {
+    updateDbInstLocation(*cell);
+  }
+  updating_db_ = false;
+  moved_cells_.clear();
+
+  if (!placement_failures_.empty()) {
+    logger_->info(DPL,
+                  40,
+                  "Incremental placement failed on the following {} "
+                  "instances:",
+                  placement_failures_.size());
+    for (auto inst : placement_failures_) {
+      logger_->info(DPL, 41, " {}", inst->getName());
+    }
+    logger_->error(DPL, 42, "Incremental detailed placement failed.");
+  }
+}
+
+void Opendp::incrementalPlacement(int max_displacement_x,
+                                  int max_displacement_y,
+                                  bool disallow_one_site_gaps)
+{
+  dbBlock* block = db_->getChip()->getBlock();
+  if (incremental_ && incr_dp_ && incr_dp_->isTracking(block)) {
+    setMaxDisplacement(max_displacement_x, max_displacement_y);
+  } else {
+    // End the old session before the new one imports the db.
+    incr_dp_.reset();
+    incr_dp_ = std::make_unique<IncrementalDPlace>(
+        this, block, max_displacement_x, max_displacement_y);
+  }
+  disallow_one_site_gaps_ = disallow_one_site_gaps;
+  hpwl_before_ = hpwl();
+  incr_dp_->legalize();
+}
+
+void Opendp::endIncremental()
+{
+  incremental_ = false;
+  dirty_cells_.clear();
+  moved_cells_.clear();
+}
+
+////////////////////////////////////////////////////////////////
+
+DplDbCbk::DplDbCbk(Opendp* opendp) : opendp_(opendp)
+{
+}
+
+void DplDbCbk::inDbInstCreate(dbInst* inst)
+{
+  opendp_->addDirtyInst(inst);
+}
+
+void DplDbCbk::inDbInstCreate(dbInst* inst, odb::dbRegion*)
+{
+  opendp_->addDirtyInst(inst);
+}
+
+void DplDbCbk::inDbInstDestroy(dbInst* inst)
+{
+  opendp_->removeInst(inst);
+}
+
+void DplDbCbk::inDbInstPlacementStatusBefore(
+    dbInst* inst,
+    const odb::dbPlacementStatus& status)
+{
+  opendp_->changeInstStatus(inst, status.isFixed());
+}
+
+void DplDbCbk::inDbInstSwapMasterBefore(dbInst* inst, dbMaster*)
+{
+  opendp_->eraseInst(inst);
+}
+
+void DplDbCbk::inDbInstSwapMasterAfter(dbInst* inst)
+{
+  opendp_->addDirtyInst(inst);
+}
+
+void DplDbCbk::inDbPreMoveInst(dbInst* inst)
+{
+  opendp_->eraseInst(inst);
+}
+
+void DplDbCbk::inDbPostMoveInst(dbInst* inst)
+{
+  opendp_->addDirtyInst(inst);
+}
+
+////////////////////////////////////////////////////////////////
+
+IncrementalDPlace::IncrementalDPlace(Opendp* opendp,
+                                     dbBlock* block,
+                                     int max_displacement_x,
+                                     int max_displacement_y)
+    : opendp_(opendp), block_(block), db_cbk_(opendp)
+{
+  opendp_->initIncremental(max_displacement_x, max_displacement_y);
+  db_cbk_.addOwner(block);
+}
+
+void IncrementalDPlace::legalize()
+{
+  opendp_->legalizeDirtyInsts();
+}
+
+bool IncrementalDPlace::isTracking(dbBlock* block) const
+{
+  // A destroyed block removes its callbacks.
+  return block_ == block && db_cbk_.hasOwner();
+}
+
+IncrementalDPlace::~IncrementalDPlace()
+{
+  db_cbk_.removeOwner();
+  opendp_->endIncremental();
+}
+
+}  // namespace dpl
@@ -92,13 +92,15 @@ Opendp::Opendp()
 
 Opendp::~Opendp()
 {
+  incr_dp_.reset();
   deleteGrid();
 }
 
-void Opendp::init(dbDatabase* db, Logger* logger)
+void Opendp::init(dbDatabase* db, Logger* logger, utl::Executor* executor)
 {
   db_ = db;
   logger_ = logger;
+  executor_ = executor;
 }
 
 void Opendp::initBlock()
@@ -136,7 +138,8 @@ void Opendp::setDebug(std::unique_ptr<DplObserver>& observer)
 
 void Opendp::detailedPlacement(int max_displacement_x,
                                int max_displacement_y,
-                               bool disallow_one_site_gaps)
+                               bool disallow_one_site_gaps,
+                               bool parallel)
 {
   importDb();
 
@@ -144,15 +147,9 @@ void Opendp::detailedPlacement(int max_displacement_x,
     logger_->warn(DPL, 37, "Use remove_fillers before detailed placement.");
   }
 
-  if (max_displacement_x == 0 || max_displacement_y == 0) {
-    // defaults
-    max_displacement_x_ = 500;
-    max_displacement_y_ = 100;
-  } else {
-    max_displacement_x_ = max_displacement_x;
-    max_displacement_y_ = max_displacement_y;
-  }
+  setMaxDisplacement(max_displacement_x, max_displacement_y);
   disallow_one_site_gaps_ = disallow_one_site_gaps;
+  parallel_ = parallel;
   if (!have_one_site_cells_) {
     // If 1-site fill cell is not detected && no disallow_one_site_gaps flag:
     // warn the user then continue as normal
@@ -180,22 +177,40 @@ void Opendp::detailedPlacement(int max_displacement_x,
   }
 }
 
+void Opendp::setMaxDisplacement(int max_displacement_x,
+                                int max_displacement_y)
+{
+  if (max_displacement_x == 0 || max_displacement_y == 0) {
+    // defaults
+    max_displacement_x_ = 500;
+    max_displacement_y_ = 100;
+  } else {
+    max_displacement_x_ = max_displacement_x;
+    max_displacement_y_ = max_displacement_y;
+  }
+}
+
 void Opendp::updateDbInstLocations()
 {
   for (Cell& cell : cells_) {
-    if (!isFixed(&cell) && isStdCell(&cell)) {
-      dbInst* db_inst_ = cell.db_inst_;
-      // Only move the instance if necessary to avoid triggering callbacks.
-      if (db_inst_->getOrient() != cell.orient_) {
-        db_inst_->setOrient(cell.orient_);
-      }
-      int x = core_.xMin() + cell.x_;
-      int y = core_.yMin() + cell.y_;
-      int inst_x, inst_y;
-      db_inst_->getLocation(inst_x, inst_y);
-      if (x != inst_x || y != inst_y) {
-        db_inst_->setLocation(x, y);
-      }
+    updateDbInstLocation(cell);
+  }
+}
+
+void Opendp::updateDbInstLocation(Cell& cell)
+{
+  if (!isFixed(&cell) && isStdCell(&cell)) {
+    dbInst* db_inst_ = cell.db_inst_;
+    // Only move the instance if necessary to avoid triggering callbacks.
+    if (db_inst_->getOrient() != cell.orient_) {
+      db_inst_->setOrient(cell.orient_);
+    }
+    int x = core_.xMin() + cell.x_;
+    int y = core_.yMin() + cell.y_;
+    int inst_x, inst_y;
+    db_inst_->getLocation(inst_x, inst_y);
+    if (x != inst_x || y != inst_y) {
+      db_inst_->setLocation(x, y);
     }
   }
 }
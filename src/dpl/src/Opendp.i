@@ -97,9 +97,21 @@ namespace dpl {
 void
 detailed_placement_cmd(int max_displacment_x,
                        int max_displacment_y,
-                       bool disallow_one_site_gaps){
+                       bool disallow_one_site_gaps,
+                       bool parallel){
   dpl::Opendp *opendp = ord::OpenRoad::openRoad()->getOpendp();
-  opendp->detailedPlacement(max_displacment_x, max_displacment_y, disallow_one_site_gaps);
+  opendp->detailedPlacement(max_displacment_x, max_displacment_y,
+                            disallow_one_site_gaps, parallel);
+}
+
+void
+incremental_placement_cmd(int max_displacment_x,
+                          int max_displacment_y,
+                          bool disallow_one_site_gaps)
+{
+  dpl::Opendp *opendp = ord::OpenRoad::openRoad()->getOpendp();
+  opendp->incrementalPlacement(max_displacment_x, max_displacment_y,
+                               disallow_one_site_gaps);
 }
 
 void
@@ -32,13 +32,18 @@
 ## POSSIBILITY OF SUCH DAMAGE.
 #############################################################################
 
-sta::define_cmd_args "detailed_placement" {[-max_displacement disp|{disp_x disp_y}] [-disallow_one_site_gaps]}
+sta::define_cmd_args "detailed_placement" {[-max_displacement disp|{disp_x disp_y}] [-disallow_one_site_gaps] [-parallel] [-incremental]}
 
 proc detailed_placement { args } {
   sta::parse_key_args "detailed_placement" args \
-    keys {-max_displacement} flags {-disallow_one_site_gaps}
+    keys {-max_displacement} flags {-disallow_one_site_gaps -parallel -incremental}
 
 set disallow_one_site_gaps [info exists flags(-disallow_one_site_gaps)]
+  set parallel [info exists flags(-parallel)]
+  set incremental [info exists flags(-incremental)]
+  if { $incremental && $parallel } {
+    utl::error DPL 43 "-parallel is not supported with -incremental."
+  }
   if { [info exists keys(-max_displacement)] } {
     set max_displacement $keys(-max_displacement)
     if { [llength $max_displacement] == 1 } {
@@ -66,8 +71,13 @@ set disallow_one_site_gaps [info exists flags(-disallow_one_site_gaps)]
                               / [$site getWidth]]
     set max_displacement_y [expr [ord::microns_to_dbu $max_displacement_y] \
                               / [$site getHeight]]
-    dpl::detailed_placement_cmd $max_displacement_x $max_displacement_y \
-                                $disallow_one_site_gaps
+    if { $incremental } {
+      dpl::incremental_placement_cmd $max_displacement_x $max_displacement_y \
+                                     $disallow_one_site_gaps
+    } else {
+      dpl::detailed_placement_cmd $max_displacement_x $max_displacement_y \
+                                  $disallow_one_site_gaps $parallel
+    }
     dpl::report_legalization_stats
   } else {
     utl::error "DPL" 27 "no rows defined in design. Use initialize_floorplan to add rows."
@@ -33,9 +33,11 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <cstdlib>
+#include <numeric>
 #include <unordered_set>
 
 #include "dpl/Opendp.h"
+#include "odb/dbConnectivity.h"
 #include "odb/dbTypes.h"
 #include "utl/Logger.h"
 
@@ -46,51 +48,20 @@ using utl::DPL;
 using std::sort;
 using std::unordered_set;
 
+using odb::dbBPin;
+using odb::dbBTerm;
+using odb::dbBox;
 using odb::dbITerm;
 using odb::dbOrientType;
 
 static dbOrientType orientMirrorY(const dbOrientType& orient);
 
-NetBox::NetBox(dbNet* net, Rect box, bool ignore)
-    : net_(net), box_(box), ignore_(ignore)
-{
-}
-
-int64_t NetBox::hpwl()
-{
-  return box_.dy() + box_.dx();
-}
-
-void NetBox::saveBox()
-{
-  box_saved_ = box_;
-}
-
-void NetBox::restoreBox()
-{
-  box_ = box_saved_;
-}
-
-////////////////////////////////////////////////////////////////
-
 void Opendp::optimizeMirroring()
 {
   block_ = db_->getChip()->getBlock();
   findNetBoxes();
 
-  NetBoxes sorted_boxes;
-  for (auto& net_box : net_box_map_) {
-    sorted_boxes.push_back(&net_box.second);
-  }
-
-  // Sort net boxes by net hpwl.
-  sort(sorted_boxes.begin(),
-       sorted_boxes.end(),
-       [](NetBox* net_box1, NetBox* net_box2) -> bool {
-         return net_box1->hpwl() > net_box2->hpwl();
-       });
-
-  vector<dbInst*> mirror_candidates = findMirrorCandidates(sorted_boxes);
+  vector<dbInst*> mirror_candidates = findMirrorCandidates();
   int64_t hpwl_before = hpwl();
   int mirror_count = mirrorCandidates(mirror_candidates);
 
@@ -106,55 +77,110 @@ void Opendp::optimizeMirroring()
                             : 0.0;
     logger_->info(DPL, 23, "HPWL delta           {:8.1f} %", hpwl_delta);
   }
+  mirror_hpwl_.clear();
+  mirror_insts_.clear();
+  mirror_cells_.clear();
 }
 
+// Load the nets into the hpwl engine with pins relative to the
+// instance centers so mirroring negates their x offsets.
 void Opendp::findNetBoxes()
 {
-  net_box_map_.clear();
+  mirror_hpwl_.clear();
+  mirror_insts_.clear();
+  mirror_cells_.clear();
+  // Cell for the bterm pins, which never move.
+  mirror_hpwl_.addCell(0, 0);
+  mirror_insts_.push_back(nullptr);
+
+  const odb::dbConnectivity* connectivity
+      = odb::dbConnectivity::get(block_, executor_);
   auto nets = block_->getNets();
   for (dbNet* net : nets) {
     bool ignore = net->getSigType().isSupply()
                   || net->isSpecial()
                   // Reducing HPWL on large nets (like clocks) is irrelevant
                   // to mirroring criterra.
-                  // Note that getITerms().size() iteractes through the iterms
-                  // so it has to be checked once here instead of where it is
-                  // needed.
-                  || net->getITerms().size() > mirror_max_iterm_count_;
+                  || connectivity->getITermCount(net) > mirror_max_iterm_count_;
     if (ignore) {
       debugPrint(
           logger_, DPL, "opt_mirror", 2, "ignore {}", net->getConstName());
+      continue;
+    }
+    const int net_index = mirror_hpwl_.addNet();
+    for (dbITerm* iterm : connectivity->getITerms(net)) {
+      dbInst* inst = iterm->getInst();
+      const int cell = mirrorCell(inst);
+      const double center_x = mirror_hpwl_.getCellX(cell);
+      const double center_y = mirror_hpwl_.getCellY(cell);
+      int x, y;
+      if (!iterm->getAvgXY(&x, &y)) {
+        x = center_x;
+        y = center_y;
+      }
+      mirror_hpwl_.addPin(net_index, cell, x - center_x, y - center_y);
     }
-    net_box_map_[net] = NetBox(net, net->getTermBBox(), ignore);
+    for (dbBTerm* bterm : connectivity->getBTerms(net)) {
+      for (dbBPin* bpin : bterm->getBPins()) {
+        if (bpin->getPlacementStatus().isPlaced()) {
+          Rect pin_bbox = bpin->getBBox();
+          mirror_hpwl_.addPin(net_index,
+                              0,
+                              (pin_bbox.xMin() + pin_bbox.xMax()) / 2,
+                              (pin_bbox.yMin() + pin_bbox.yMax()) / 2);
+        }
+      }
+    }
+  }
+  mirror_hpwl_.build();
+}
+
+// Engine cell of inst, located at the center of its bbox.
+int Opendp::mirrorCell(dbInst* inst)
+{
+  auto itr = mirror_cells_.find(inst);
+  if (itr != mirror_cells_.end()) {
+    return itr->second;
   }
+  dbBox* bbox = inst->getBBox();
+  const int cell = mirror_hpwl_.addCell((bbox->xMin() + bbox->xMax()) / 2.0,
+                                        (bbox->yMin() + bbox->yMax()) / 2.0);
+  mirror_insts_.push_back(inst);
+  mirror_cells_[inst] = cell;
+  return cell;
 }
 
-vector<dbInst*> Opendp::findMirrorCandidates(NetBoxes& net_boxes)
+vector<dbInst*> Opendp::findMirrorCandidates()
 {
+  vector<int> sorted_nets(mirror_hpwl_.getNumNets());
+  std::iota(sorted_nets.begin(), sorted_nets.end(), 0);
+  // Sort nets by hpwl.
+  sort(sorted_nets.begin(), sorted_nets.end(), [this](int net1, int net2) {
+    return mirror_hpwl_.hpwl(net1) > mirror_hpwl_.hpwl(net2);
+  });
+
   vector<dbInst*> mirror_candidates;
   unordered_set<dbInst*> existing;
   // Find inst terms on the boundary of the net boxes.
-  for (NetBox* net_box : net_boxes) {
-    if (!net_box->ignore_) {
-      dbNet* net = net_box->net_;
-      Rect& box = net_box->box_;
-      for (dbITerm* iterm : net->getITerms()) {
-        dbInst* inst = iterm->getInst();
-        int x, y;
-        if (inst->isCore() && !inst->isFixed() && iterm->getAvgXY(&x, &y)
-            && (x == box.xMin() || x == box.xMax() || y == box.yMin()
-                || y == box.yMax())) {
-          dbInst* inst = iterm->getInst();
-          if (existing.find(inst) == existing.end()) {
-            mirror_candidates.push_back(inst);
-            existing.insert(inst);
-            debugPrint(logger_,
-                       DPL,
-                       "opt_mirror",
-                       1,
-                       "candidate {}",
-                       inst->getConstName());
-          }
+  for (int net : sorted_nets) {
+    for (int pin = mirror_hpwl_.netPinBegin(net);
+         pin < mirror_hpwl_.netPinEnd(net);
+         pin++) {
+      dbInst* inst = mirror_insts_[mirror_hpwl_.getPinCell(pin)];
+      const double x = mirror_hpwl_.getPinX(pin);
+      const double y = mirror_hpwl_.getPinY(pin);
+      if (inst && inst->isCore() && !inst->isFixed()
+          && (x == mirror_hpwl_.xMin(net) || x == mirror_hpwl_.xMax(net)
+              || y == mirror_hpwl_.yMin(net) || y == mirror_hpwl_.yMax(net))) {
+        if (existing.find(inst) == existing.end()) {
+          mirror_candidates.push_back(inst);
+          existing.insert(inst);
+          debugPrint(logger_,
+                     DPL,
+                     "opt_mirror",
+                     1,
+                     "candidate {}",
+                     inst->getConstName());
         }
       }
     }
@@ -166,20 +192,14 @@ int Opendp::mirrorCandidates(vector<dbInst*>& mirror_candidates)
 {
   int mirror_count = 0;
   for (dbInst* inst : mirror_candidates) {
-    // Use hpwl of all nets connected to the instance terms
-    // before/after to determine incremental change to total hpwl.
-    int64_t hpwl_before = hpwl(inst);
-    saveNetBoxes(inst);
-    dbOrientType orient = inst->getOrient();
-    dbOrientType orient_my = orientMirrorY(orient);
-    inst->setLocationOrient(orient_my);
-    updateNetBoxes(inst);
-    int64_t hpwl_after = hpwl(inst);
-    if (hpwl_after > hpwl_before) {
-      // Undo mirroring if hpwl is worse.
-      inst->setLocationOrient(orient);
-      restoreNetBoxes(inst);
-    } else {
+    // Mirroring about the Y axis keeps the instance bbox in place and
+    // negates the pin x offsets from its center.
+    const int cell = mirror_cells_[inst];
+    const double x = mirror_hpwl_.getCellX(cell);
+    const double y = mirror_hpwl_.getCellY(cell);
+    if (mirror_hpwl_.delta(cell, x, y, true) <= 0) {
+      inst->setLocationOrient(orientMirrorY(inst->getOrient()));
+      mirror_hpwl_.moveCell(cell, x, y, true);
       debugPrint(
           logger_, DPL, "opt_mirror", 1, "mirror {}", inst->getConstName());
       mirror_count++;
@@ -214,52 +234,4 @@ static dbOrientType orientMirrorY(const dbOrientType& orient)
   return dbOrientType::R0;
 }
 
-int64_t Opendp::hpwl(dbInst* inst)
-{
-  int64_t inst_hpwl = 0;
-  for (dbITerm* iterm : inst->getITerms()) {
-    dbNet* net = iterm->getNet();
-    if (net) {
-      NetBox& net_box = net_box_map_[net];
-      if (!net_box.ignore_) {
-        inst_hpwl += net_box.hpwl();
-      }
-    }
-  }
-  return inst_hpwl;
-}
-
-void Opendp::updateNetBoxes(dbInst* inst)
-{
-  for (dbITerm* iterm : inst->getITerms()) {
-    dbNet* net = iterm->getNet();
-    if (net) {
-      NetBox& net_box = net_box_map_[net];
-      if (!net_box.ignore_) {
-        net_box_map_[net].box_ = net->getTermBBox();
-      }
-    }
-  }
-}
-
-void Opendp::saveNetBoxes(dbInst* inst)
-{
-  for (dbITerm* iterm : inst->getITerms()) {
-    dbNet* net = iterm->getNet();
-    if (net) {
-      net_box_map_[net].saveBox();
-    }
-  }
-}
-
-void Opendp::restoreNetBoxes(dbInst* inst)
-{
-  for (dbITerm* iterm : inst->getITerms()) {
-    dbNet* net = iterm->getNet();
-    if (net) {
-      net_box_map_[net].restoreBox();
-    }
-  }
-}
-
 }  // namespace dpl
@@ -45,6 +45,7 @@
 
 #include "DplObserver.h"
 #include "dpl/Opendp.h"
+#include "utl/Executor.h"
 #include "utl/Logger.h"
 
 // #define ODP_DEBUG
@@ -75,6 +76,7 @@ void Opendp::detailedPlacement()
   groupInitPixels2();
   // y axis dummycell insertion
   groupInitPixels();
+  initFreeIntervals();
 
   if (!groups_.empty()) {
     placeGroups();
@@ -322,8 +324,13 @@ void Opendp::place()
       }
     }
   }
+  // paintPixel records moved cells for incremental placement, which
+  // the bands would race on.
+  if (parallel_ && !debug_observer_ && !incremental_) {
+    placeRowBands(sorted_cells);
+  }
   for (Cell* cell : sorted_cells) {
-    if (!isMultiRow(cell) && cellFitsInCore(cell)) {
+    if (!isMultiRow(cell) && !cell->is_placed_ && cellFitsInCore(cell)) {
       if (!mapMove(cell)) {
         shiftMove(cell);
       }
@@ -333,6 +340,69 @@ void Opendp::place()
   // anneal();
 }
 
+// Legalize single-row cells in bands of rows concurrently.
+// Each band searches only its own rows, less one row next to the
+// neighboring bands that checkPixels reads for one site gaps, so
+// bands never touch the same pixels or free intervals. Cells within
+// band_halo_rows_ of a band boundary and cells that do not fit in
+// their band are left for the serial pass, which still searches the
+// full max displacement window.
+void Opendp::placeRowBands(const vector<Cell*>& sorted_cells)
+{
+  const int band_count = divCeil(row_count_, band_rows_);
+  if (band_count < 2) {
+    return;
+  }
+
+  vector<vector<pair<Cell*, Point>>> band_cells(band_count);
+  for (Cell* cell : sorted_cells) {
+    if (isMultiRow(cell) || !cellFitsInCore(cell)) {
+      continue;
+    }
+    // Legal points only depend on fixed cells so they can be found
+    // before any band is placed.
+    const Point grid_pt = legalGridPt(cell, true);
+    const int band = min(grid_pt.getY() / band_rows_, band_count - 1);
+    const int band_begin = band * band_rows_;
+    const int band_end = min(row_count_, band_begin + band_rows_);
+    if (grid_pt.getY() >= band_begin + band_halo_rows_
+        && grid_pt.getY() + gridHeight(cell) <= band_end - band_halo_rows_) {
+      band_cells[band].emplace_back(cell, grid_pt);
+    }
+  }
+
+  auto place_band = [&](int band) {
+    const int band_begin = band * band_rows_;
+    const int band_end = min(row_count_, band_begin + band_rows_);
+    const int row_min = (band == 0) ? 0 : band_begin + 1;
+    const int row_max = (band == band_count - 1) ? band_end : band_end - 1;
+    for (auto& [cell, grid_pt] : band_cells[band]) {
+      PixelPt pixel_pt = diamondSearch(
+          cell, grid_pt.getX(), grid_pt.getY(), row_min, row_max);
+      if (pixel_pt.pixel) {
+        paintPixel(cell, pixel_pt.pt.getX(), pixel_pt.pt.getY());
+      }
+    }
+  };
+
+  int thread_count = 1;
+  if (executor_) {
+    thread_count = min(executor_->getNumThreads(), band_count);
+    executor_->parallelFor(0, band_count, place_band);
+  } else {
+    for (int band = 0; band < band_count; band++) {
+      place_band(band);
+    }
+  }
+  debugPrint(logger_,
+             DPL,
+             "place",
+             1,
+             "Placed {} row bands with {} threads.",
+             band_count,
+             thread_count);
+}
+
 bool Opendp::cellFitsInCore(Cell* cell)
 {
   return gridPaddedWidth(cell) <= row_site_count_
@@ -684,6 +754,17 @@ PixelPt Opendp::diamondSearch(const Cell* cell,
                               // grid
                               int x,
                               int y) const
+{
+  return diamondSearch(cell, x, y, 0, row_count_);
+}
+
+// Diamond search restricted to grid rows [row_min, row_max).
+PixelPt Opendp::diamondSearch(const Cell* cell,
+                              // grid
+                              int x,
+                              int y,
+                              int row_min,
+                              int row_max) const
 {
   // Diamond search limits.
   int x_min = x - max_displacement_x_;
@@ -709,9 +790,9 @@ PixelPt Opendp::diamondSearch(const Cell* cell,
 
   // Clip diamond limits to grid bounds.
   x_min = max(0, x_min);
-  y_min = max(0, y_min);
+  y_min = max(row_min, y_min);
   x_max = min(row_site_count_, x_max);
-  y_max = min(row_count_, y_max);
+  y_max = min(row_max, y_max);
 
   debugPrint(logger_,
              DPL,
@@ -727,7 +808,7 @@ PixelPt Opendp::diamondSearch(const Cell* cell,
              y_max - 1);
 
   // Check the bin at the initial position first.
-  PixelPt avail_pt = binSearch(x, cell, x, y);
+  PixelPt avail_pt = binSearch(x, cell, x, y, row_max);
   if (avail_pt.pixel) {
     return avail_pt;
   }
@@ -753,6 +834,7 @@ PixelPt Opendp::diamondSearch(const Cell* cell,
                           y_max,
                           x_offset,
                           y_offset,
+                          row_max,
                           best_pt,
                           best_dist);
       }
@@ -776,6 +858,7 @@ PixelPt Opendp::diamondSearch(const Cell* cell,
                           y_max,
                           x_offset,
                           y_offset,
+                          row_max,
                           best_pt,
                           best_dist);
       }
@@ -796,13 +879,14 @@ void Opendp::diamondSearchSide(const Cell* cell,
                                int y_max,
                                int x_offset,
                                int y_offset,
+                               int row_max,
                                // Return values
                                PixelPt& best_pt,
                                int& best_dist) const
 {
   int bin_x = min(x_max, max(x_min, x + x_offset * bin_search_width_));
   int bin_y = min(y_max, max(y_min, y + y_offset));
-  PixelPt avail_pt = binSearch(x, cell, bin_x, bin_y);
+  PixelPt avail_pt = binSearch(x, cell, bin_x, bin_y, row_max);
   if (avail_pt.pixel) {
     int avail_dist = abs(x - avail_pt.pt.getX()) * site_width_
                      + abs(y - avail_pt.pt.getY()) * row_height_;
@@ -813,7 +897,11 @@ void Opendp::diamondSearchSide(const Cell* cell,
   }
 }
 
-PixelPt Opendp::binSearch(int x, const Cell* cell, int bin_x, int bin_y) const
+PixelPt Opendp::binSearch(int x,
+                          const Cell* cell,
+                          int bin_x,
+                          int bin_y,
+                          int row_max) const
 {
   debugPrint(logger_,
              DPL,
@@ -834,7 +922,7 @@ PixelPt Opendp::binSearch(int x, const Cell* cell, int bin_x, int bin_y) const
     debug_observer_->binSearch(cell, bin_x, bin_y, x_end, y_end);
   }
 
-  if (y_end > row_count_) {
+  if (y_end > row_max) {
     return PixelPt();
   }
 
@@ -865,13 +953,8 @@ bool Opendp::checkPixels(const Cell* cell,
     return false;
   }
   for (int y1 = y; y1 < y_end; y1++) {
-    for (int x1 = x; x1 < x_end; x1++) {
-      Pixel* pixel = gridPixel(x1, y1);
-      if (pixel == nullptr || pixel->cell || !pixel->is_valid
-          || (cell->inGroup() && pixel->group_ != cell->group_)
-          || (!cell->inGroup() && pixel->group_)) {
-        return false;
-      }
+    if (!free_intervals_[y1].isFree(x, x_end, cell->group_)) {
+      return false;
     }
     if (disallow_one_site_gaps_) {
       // here we need to check for abutting first, if there is an abutting cell
@@ -985,7 +1068,7 @@ bool Opendp::moveHopeless(const Cell* cell, int& grid_x, int& grid_y) const
   int best_y = grid_y;
   int best_dist = std::numeric_limits<int>::max();
   for (int x = grid_x - 1; x >= 0; --x) {  // left
-    if (grid_[grid_y][x].is_valid) {
+    if (isValidPixel(x, grid_y)) {
       best_dist = (grid_x - x - 1) * site_width_;
       best_x = x;
       best_y = grid_y;
@@ -993,7 +1076,7 @@ bool Opendp::moveHopeless(const Cell* cell, int& grid_x, int& grid_y) const
     }
   }
   for (int x = grid_x + 1; x < row_site_count_; ++x) {  // right
-    if (grid_[grid_y][x].is_valid) {
+    if (isValidPixel(x, grid_y)) {
       const int dist = (x - grid_x) * site_width_ - cell->width_;
       if (dist < best_dist) {
         best_dist = dist;
@@ -1004,7 +1087,7 @@ bool Opendp::moveHopeless(const Cell* cell, int& grid_x, int& grid_y) const
     }
   }
   for (int y = grid_y - 1; y >= 0; --y) {  // below
-    if (grid_[y][grid_x].is_valid) {
+    if (isValidPixel(grid_x, y)) {
       const int dist = (grid_y - y - 1) * row_height_;
       if (dist < best_dist) {
         best_dist = dist;
@@ -1015,7 +1098,7 @@ bool Opendp::moveHopeless(const Cell* cell, int& grid_x, int& grid_y) const
     }
   }
   for (int y = grid_y + 1; y < row_count_; ++y) {  // above
-    if (grid_[y][grid_x].is_valid) {
+    if (isValidPixel(grid_x, y)) {
       const int dist = (y - grid_y) * row_height_ - cell->height_;
       if (dist < best_dist) {
         best_dist = dist;
@@ -1049,14 +1132,13 @@ Point Opendp::legalPt(const Cell* cell, bool padded) const
   int grid_x = gridX(legal_pt.getX());
   int grid_y = gridY(legal_pt.getY());
 
-  Pixel* pixel = gridPixel(grid_x, grid_y);
-  if (pixel) {
-    // Move std cells off of macros.  First try the is_hopeless strategy
-    if (pixel->is_hopeless && moveHopeless(cell, grid_x, grid_y)) {
-      legal_pt = Point(grid_x * site_width_, grid_y * row_height_);
-      pixel = gridPixel(grid_x, grid_y);
-    }
+  // Move std cells off of macros.  First try the is_hopeless strategy
+  if (isHopelessPixel(grid_x, grid_y) && moveHopeless(cell, grid_x, grid_y)) {
+    legal_pt = Point(grid_x * site_width_, grid_y * row_height_);
+  }
 
+  const Pixel* pixel = gridPixel(grid_x, grid_y);
+  if (pixel) {
     const Cell* block = pixel->cell;
 
     // If that didn't do the job fall back on the old move to nearest
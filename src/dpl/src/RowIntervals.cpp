@@ -0,0 +1,105 @@
+/////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// BSD 3-Clause License
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <iterator>
+
+#include "dpl/Opendp.h"
+
+namespace dpl {
+
+void RowIntervals::insert(int begin, int end, Group* group)
+{
+  if (begin >= end) {
+    return;
+  }
+  auto next = intervals_.lower_bound(begin);
+  if (next != intervals_.begin()) {
+    auto prev = std::prev(next);
+    if (prev->second.end == begin && prev->second.group == group) {
+      begin = prev->first;
+      intervals_.erase(prev);
+    }
+  }
+  if (next != intervals_.end() && next->first == end
+      && next->second.group == group) {
+    end = next->second.end;
+    intervals_.erase(next);
+  }
+  intervals_[begin] = {begin, end, group};
+}
+
+void RowIntervals::erase(int begin, int end)
+{
+  if (begin >= end) {
+    return;
+  }
+  auto itr = intervals_.upper_bound(begin);
+  if (itr != intervals_.begin()) {
+    auto prev = std::prev(itr);
+    if (prev->second.end > begin) {
+      itr = prev;
+    }
+  }
+  while (itr != intervals_.end() && itr->first < end) {
+    const Interval interval = itr->second;
+    itr = intervals_.erase(itr);
+    if (interval.begin < begin) {
+      intervals_[interval.begin] = {interval.begin, begin, interval.group};
+    }
+    if (interval.end > end) {
+      intervals_[end] = {end, interval.end, interval.group};
+    }
+  }
+}
+
+const RowIntervals::Interval* RowIntervals::find(int x) const
+{
+  auto itr = intervals_.upper_bound(x);
+  if (itr == intervals_.begin()) {
+    return nullptr;
+  }
+  --itr;
+  if (itr->second.end > x) {
+    return &itr->second;
+  }
+  return nullptr;
+}
+
+bool RowIntervals::isFree(int begin, int end, const Group* group) const
+{
+  const Interval* interval = find(begin);
+  return interval != nullptr && interval->end >= end
+         && interval->group == group;
+}
+
+}  // namespace dpl
@@ -56,6 +56,10 @@ static bool swapWidthHeight(const dbOrientType& orient);
 
 void Opendp::importDb()
 {
+  // The cells are rebuilt, so an incremental session cannot continue.
+  incr_dp_.reset();
+  endIncremental();
+
   block_ = db_->getChip()->getBlock();
   core_ = block_->getCoreArea();
   have_fillers_ = false;
@@ -75,6 +79,8 @@ void Opendp::importClear()
   cells_.clear();
   groups_.clear();
   db_inst_map_.clear();
+  dirty_cells_.clear();
+  moved_cells_.clear();
   deleteGrid();
   have_multi_row_cells_ = false;
 }
@@ -141,30 +147,10 @@ void Opendp::examineRows()
 void Opendp::makeCells()
 {
   auto db_insts = block_->getInsts();
-  cells_.reserve(db_insts.size());
   for (auto db_inst : db_insts) {
     dbMaster* db_master = db_inst->getMaster();
     if (db_master->isCoreAutoPlaceable()) {
-      cells_.emplace_back();
-      Cell& cell = cells_.back();
-      cell.db_inst_ = db_inst;
-      db_inst_map_[db_inst] = &cell;
-
-      Rect bbox = getBbox(db_inst);
-      cell.width_ = bbox.dx();
-      cell.height_ = bbox.dy();
-      cell.x_ = bbox.xMin();
-      cell.y_ = bbox.yMin();
-      cell.orient_ = db_inst->getOrient();
-      // Cell is already placed if it is FIXED.
-      cell.is_placed_ = isFixed(&cell);
-
-      Master& master = db_master_map_[db_master];
-      // We only want to set this if we have multi-row cells to
-      // place and not whenever we see a placed block.
-      if (master.is_multi_row && db_master->isCore()) {
-        have_multi_row_cells_ = true;
-      }
+      makeCell(db_inst);
     }
     if (isFiller(db_inst)) {
       have_fillers_ = true;
@@ -172,6 +158,48 @@ void Opendp::makeCells()
   }
 }
 
+Cell* Opendp::makeCell(dbInst* db_inst)
+{
+  cells_.emplace_back();
+  Cell& cell = cells_.back();
+  cell.db_inst_ = db_inst;
+  db_inst_map_[db_inst] = &cell;
+  updateCellGeometry(cell);
+  // Cell is already placed if it is FIXED.
+  cell.is_placed_ = isFixed(&cell);
+  return &cell;
+}
+
+Master& Opendp::findMaster(dbMaster* db_master)
+{
+  auto itr = db_master_map_.find(db_master);
+  if (itr == db_master_map_.end()) {
+    // Master first used after importDb (ECO).
+    itr = db_master_map_.emplace(db_master, Master()).first;
+    makeMaster(&itr->second, db_master);
+  }
+  return itr->second;
+}
+
+void Opendp::updateCellGeometry(Cell& cell)
+{
+  Rect bbox = getBbox(cell.db_inst_);
+  cell.width_ = bbox.dx();
+  cell.height_ = bbox.dy();
+  cell.x_ = bbox.xMin();
+  cell.y_ = bbox.yMin();
+  cell.orient_ = cell.db_inst_->getOrient();
+
+  // The master may be new after a swap master (ECO).
+  dbMaster* db_master = cell.db_inst_->getMaster();
+  Master& master = findMaster(db_master);
+  // We only want to set this if we have multi-row cells to
+  // place and not whenever we see a placed block.
+  if (master.is_multi_row && db_master->isCore()) {
+    have_multi_row_cells_ = true;
+  }
+}
+
 Rect Opendp::getBbox(dbInst* inst)
 {
   dbMaster* master = inst->getMaster();
@@ -1,11 +1,19 @@
 #include <unistd.h>
 
+#include <cstdlib>
+#include <list>
+#include <map>
 #include <memory>
+#include <random>
+#include <string>
+#include <vector>
 
+#include "dpl/HpwlEngine.h"
 #include "dpl/Opendp.h"
 #include "gtest/gtest.h"
 #include "odb/db.h"
 #include "odb/lefin.h"
+#include "utl/Executor.h"
 #include "utl/Logger.h"
 
 namespace dpl {
@@ -42,6 +50,63 @@ class OpendpTest : public ::testing::Test
   OdbUniquePtr<odb::dbBlock> block_{nullptr, &odb::dbBlock::destroy};
 };
 
+// Placement fixture with the sky130hd tech so masters have sites.
+class OpendpPlaceTest : public ::testing::Test
+{
+ protected:
+  void SetUp() override
+  {
+    db_ = odb::dbDatabase::create();
+    odb::lefin lef_reader(db_, &logger_, /*ignore_non_routing_layers=*/false);
+    std::list<std::string> lef_files{"sky130hd/sky130hd.tlef",
+                                     "sky130hd/sky130hd_std_cell.lef"};
+    lib_ = lef_reader.createTechAndLib("sky130hd", lef_files);
+    site_ = lib_->findSite("unithd");
+
+    odb::dbChip* chip = odb::dbChip::create(db_);
+    block_ = odb::dbBlock::create(chip, "top");
+    block_->setDefUnits(lib_->getTech()->getLefUnits());
+    block_->setDieArea(odb::Rect(0, 0, 100000, 200000));
+    opendp_.init(db_, &logger_, nullptr);
+  }
+
+  void TearDown() override { odb::dbDatabase::destroy(db_); }
+
+  // Make rows [row_begin, row_end) of site_count sites.
+  void makeRows(int row_begin, int row_end, int site_count)
+  {
+    for (int row = row_begin; row < row_end; row++) {
+      const std::string name = "row" + std::to_string(row);
+      odb::dbRow::create(block_,
+                         name.c_str(),
+                         site_,
+                         0,
+                         row * site_->getHeight(),
+                         row % 2 ? odb::dbOrientType::MX
+                                 : odb::dbOrientType::R0,
+                         odb::dbRowDir::HORIZONTAL,
+                         site_count,
+                         site_->getWidth());
+    }
+  }
+
+  odb::dbInst* makeInst(const char* master, const char* name, int x, int y)
+  {
+    odb::dbInst* inst
+        = odb::dbInst::create(block_, lib_->findMaster(master), name);
+    inst->setLocation(x, y);
+    inst->setPlacementStatus(odb::dbPlacementStatus::PLACED);
+    return inst;
+  }
+
+  utl::Logger logger_;
+  odb::dbDatabase* db_ = nullptr;
+  odb::dbLib* lib_ = nullptr;
+  odb::dbSite* site_ = nullptr;
+  odb::dbBlock* block_ = nullptr;
+  Opendp opendp_;
+};
+
 TEST_F(OpendpTest, IsPlaced)
 {
   odb::dbMaster* and_gate = lib_->findMaster("sky130_fd_sc_hd__and2_1");
@@ -58,4 +123,305 @@ TEST_F(OpendpTest, IsPlaced)
   ASSERT_TRUE(Opendp::isPlaced(&placed));
 }
 
+// Rows without sites or cells get no pixels; placement is unchanged.
+TEST_F(OpendpPlaceTest, LazyGridRows)
+{
+  makeRows(0, 10, 100);
+  makeRows(30, 40, 100);
+  const int row_height = site_->getHeight();
+  for (int i = 0; i < 20; i++) {
+    const std::string name = "inv" + std::to_string(i);
+    makeInst("sky130_fd_sc_hd__inv_1",
+             name.c_str(),
+             (i * 7 % 90) * site_->getWidth() + 13,
+             (i % 2 ? 2 : 33) * row_height + 17);
+  }
+  odb::dbInst* lost = makeInst("sky130_fd_sc_hd__inv_1",
+                               "lost",
+                               50 * site_->getWidth(),
+                               12 * row_height);
+  opendp_.initBlock();
+  opendp_.detailedPlacement(0, 0);
+
+  EXPECT_NE(opendp_.gridPixel(0, 0), nullptr);
+  // The lost cell's row is painted, the rest of the gap is not.
+  EXPECT_NE(opendp_.gridPixel(0, 12), nullptr);
+  EXPECT_EQ(opendp_.gridPixel(0, 20), nullptr);
+  const int lost_row = lost->getLocation().y() / row_height;
+  EXPECT_TRUE(lost_row < 10 || lost_row >= 30);
+  EXPECT_NO_THROW(opendp_.checkPlacement(false));
+}
+
+// Legalizing row bands in parallel stays close to the serial result.
+TEST_F(OpendpPlaceTest, ParallelBands)
+{
+  // Enough rows for a few bands.
+  const int row_count = 350;
+  makeRows(0, row_count, 150);
+  const char* masters[] = {"sky130_fd_sc_hd__inv_1",
+                           "sky130_fd_sc_hd__nand2_1",
+                           "sky130_fd_sc_hd__and2_1",
+                           "sky130_fd_sc_hd__dfxtp_1"};
+  std::mt19937 rand(42);
+  std::uniform_int_distribution<int> rand_x(0, 140 * site_->getWidth());
+  std::uniform_int_distribution<int> rand_y(
+      0, (row_count - 1) * site_->getHeight());
+  std::vector<std::pair<odb::dbInst*, odb::Point>> init_locs;
+  for (int i = 0; i < 6000; i++) {
+    const std::string name = "u" + std::to_string(i);
+    odb::dbInst* inst
+        = makeInst(masters[i % 4], name.c_str(), rand_x(rand), rand_y(rand));
+    init_locs.emplace_back(inst, inst->getLocation());
+  }
+
+  // Total and max displacement from the initial locations.
+  auto legalize = [&](bool parallel) {
+    for (auto& [inst, loc] : init_locs) {
+      inst->setLocation(loc.x(), loc.y());
+    }
+    opendp_.detailedPlacement(0, 0, false, parallel);
+    EXPECT_NO_THROW(opendp_.checkPlacement(false));
+    int64_t sum = 0;
+    int64_t max = 0;
+    for (auto& [inst, loc] : init_locs) {
+      const odb::Point legal = inst->getLocation();
+      const int64_t disp
+          = std::abs(legal.x() - loc.x()) + std::abs(legal.y() - loc.y());
+      sum += disp;
+      max = std::max(max, disp);
+    }
+    return std::make_pair(sum, max);
+  };
+
+  utl::Executor executor(4);
+  opendp_.init(db_, &logger_, &executor);
+  opendp_.initBlock();
+  const auto [serial_sum, serial_max] = legalize(false);
+  const auto [parallel_sum, parallel_max] = legalize(true);
+  EXPECT_LE(parallel_sum, serial_sum * 1.05);
+  EXPECT_LE(parallel_max, serial_max * 1.5);
+}
+
+// Incremental legalization only moves the changed instances.
+TEST_F(OpendpPlaceTest, IncrementalDPlace)
+{
+  makeRows(0, 20, 100);
+  const int site_width = site_->getWidth();
+  const int row_height = site_->getHeight();
+  for (int i = 0; i < 100; i++) {
+    const std::string name = "u" + std::to_string(i);
+    makeInst("sky130_fd_sc_hd__inv_1",
+             name.c_str(),
+             (i % 10) * 10 * site_width,
+             (i / 10) * 2 * row_height);
+  }
+  opendp_.initBlock();
+  opendp_.detailedPlacement(0, 0);
+
+  std::map<odb::dbInst*, odb::Point> legal_locs;
+  for (odb::dbInst* inst : block_->getInsts()) {
+    legal_locs[inst] = inst->getLocation();
+  }
+
+  odb::dbInst* resized = block_->findInst("u11");
+  odb::dbInst* moved = block_->findInst("u22");
+  {
+    IncrementalDPlace incr_dp(&opendp_, block_);
+    // Off grid, on top of u33.
+    odb::dbInst* created = odb::dbInst::create(
+        block_, lib_->findMaster("sky130_fd_sc_hd__nand2_1"), "created");
+    const odb::Point u33 = block_->findInst("u33")->getLocation();
+    created->setLocation(u33.x() + 7, u33.y() + 11);
+    created->setPlacementStatus(odb::dbPlacementStatus::PLACED);
+    resized->swapMaster(lib_->findMaster("sky130_fd_sc_hd__inv_4"));
+    const odb::Point u44 = block_->findInst("u44")->getLocation();
+    moved->setLocation(u44.x() + site_width, u44.y());
+    incr_dp.legalize();
+  }
+
+  EXPECT_NO_THROW(opendp_.checkPlacement(false));
+  for (auto& [inst, loc] : legal_locs) {
+    if (inst != resized && inst != moved) {
+      EXPECT_EQ(inst->getLocation(), loc) << inst->getName();
+    }
+  }
+}
+
+TEST_F(OpendpPlaceTest, IncrementalPlacement)
+{
+  makeRows(0, 20, 100);
+  const int site_width = site_->getWidth();
+  const int row_height = site_->getHeight();
+  for (int i = 0; i < 100; i++) {
+    const std::string name = "u" + std::to_string(i);
+    makeInst("sky130_fd_sc_hd__inv_1",
+             name.c_str(),
+             (i % 10) * 10 * site_width,
+             (i / 10) * 2 * row_height);
+  }
+  opendp_.initBlock();
+  opendp_.detailedPlacement(0, 0);
+  // Starts tracking; nothing to legalize yet.
+  opendp_.incrementalPlacement(0, 0);
+
+  std::map<odb::dbInst*, odb::Point> legal_locs;
+  for (odb::dbInst* inst : block_->getInsts()) {
+    legal_locs[inst] = inst->getLocation();
+  }
+
+  odb::dbInst* resized = block_->findInst("u11");
+  resized->swapMaster(lib_->findMaster("sky130_fd_sc_hd__inv_4"));
+  odb::dbInst* moved = block_->findInst("u22");
+  const odb::Point u33 = block_->findInst("u33")->getLocation();
+  moved->setLocation(u33.x(), u33.y());
+  opendp_.incrementalPlacement(0, 0);
+  EXPECT_NO_THROW(opendp_.checkPlacement(false));
+  for (auto& [inst, loc] : legal_locs) {
+    if (inst != resized && inst != moved) {
+      EXPECT_EQ(inst->getLocation(), loc) << inst->getName();
+    }
+  }
+
+  // check_placement ended the session; the next call starts a new one
+  // from the current placement and still legalizes the overlap.
+  odb::dbInst* moved2 = block_->findInst("u55");
+  const odb::Point u66 = block_->findInst("u66")->getLocation();
+  moved2->setLocation(u66.x(), u66.y());
+  opendp_.incrementalPlacement(0, 0);
+  EXPECT_NO_THROW(opendp_.checkPlacement(false));
+  EXPECT_NE(moved2->getLocation(), block_->findInst("u66")->getLocation());
+}
+
+// Moving a fixed instance frees its old span and pushes the cells it
+// now covers aside.
+TEST_F(OpendpPlaceTest, IncrementalMoveFixed)
+{
+  makeRows(0, 20, 100);
+  const int site_width = site_->getWidth();
+  const int row_height = site_->getHeight();
+  for (int i = 0; i < 100; i++) {
+    const std::string name = "u" + std::to_string(i);
+    makeInst("sky130_fd_sc_hd__inv_1",
+             name.c_str(),
+             (i % 10) * 10 * site_width,
+             (i / 10) * 2 * row_height);
+  }
+  odb::dbInst* fixed = block_->findInst("u11");
+  fixed->swapMaster(lib_->findMaster("sky130_fd_sc_hd__inv_4"));
+  fixed->setPlacementStatus(odb::dbPlacementStatus::FIRM);
+  opendp_.initBlock();
+  opendp_.detailedPlacement(0, 0);
+  opendp_.incrementalPlacement(0, 0);
+
+  const odb::Point old_loc = fixed->getLocation();
+  const odb::Point u33 = block_->findInst("u33")->getLocation();
+  fixed->setPlacementStatus(odb::dbPlacementStatus::PLACED);
+  fixed->setLocation(u33.x(), u33.y());
+  fixed->setPlacementStatus(odb::dbPlacementStatus::FIRM);
+  // Only legal if the old span of the fixed instance was freed.
+  odb::dbInst* moved = block_->findInst("u22");
+  moved->setLocation(old_loc.x(), old_loc.y());
+  opendp_.incrementalPlacement(0, 0);
+
+  EXPECT_EQ(fixed->getLocation(), u33);
+  EXPECT_EQ(moved->getLocation(), old_loc);
+  EXPECT_NE(block_->findInst("u33")->getLocation(), u33);
+  EXPECT_NO_THROW(opendp_.checkPlacement(false));
+}
+
+// The old footprint of a resized instance is erased with the padding of
+// its old master.
+TEST_F(OpendpPlaceTest, IncrementalSwapMasterPadding)
+{
+  makeRows(0, 20, 100);
+  const int site_width = site_->getWidth();
+  const int row_height = site_->getHeight();
+  for (int i = 0; i < 100; i++) {
+    const std::string name = "u" + std::to_string(i);
+    makeInst("sky130_fd_sc_hd__inv_1",
+             name.c_str(),
+             (i % 10) * 10 * site_width,
+             (i / 10) * 2 * row_height);
+  }
+  opendp_.setPadding(lib_->findMaster("sky130_fd_sc_hd__inv_1"), 1, 1);
+  opendp_.initBlock();
+  opendp_.detailedPlacement(0, 0);
+  opendp_.incrementalPlacement(0, 0);
+
+  odb::dbInst* resized = block_->findInst("u11");
+  const odb::Point old_loc = resized->getLocation();
+  resized->swapMaster(lib_->findMaster("sky130_fd_sc_hd__inv_4"));
+  opendp_.incrementalPlacement(0, 0);
+  EXPECT_EQ(resized->getLocation(), old_loc);
+
+  // The left padding site of the old master is free again.
+  odb::dbInst* moved = block_->findInst("u22");
+  const int moved_x = old_loc.x() - 4 * site_width;
+  moved->setLocation(moved_x, old_loc.y());
+  opendp_.incrementalPlacement(0, 0);
+  EXPECT_EQ(moved->getLocation(), odb::Point(moved_x, old_loc.y()));
+  EXPECT_NO_THROW(opendp_.checkPlacement(false));
+}
+
+TEST(RowIntervalsTest, InsertEraseFind)
+{
+  RowIntervals row;
+  row.insert(0, 10, nullptr);
+  row.insert(10, 20, nullptr);
+  // Abutting intervals in the same group merge.
+  ASSERT_EQ(row.size(), 1);
+  ASSERT_TRUE(row.isFree(0, 20, nullptr));
+
+  row.erase(5, 8);
+  ASSERT_EQ(row.size(), 2);
+  ASSERT_FALSE(row.isFree(4, 6, nullptr));
+  ASSERT_TRUE(row.isFree(8, 20, nullptr));
+  ASSERT_EQ(row.find(6), nullptr);
+  ASSERT_EQ(row.find(3)->end, 5);
+
+  row.insert(5, 8, nullptr);
+  ASSERT_EQ(row.size(), 1);
+
+  // Intervals of different groups do not merge.
+  Group group;
+  row.insert(20, 30, &group);
+  ASSERT_EQ(row.size(), 2);
+  ASSERT_FALSE(row.isFree(15, 25, nullptr));
+  ASSERT_TRUE(row.isFree(20, 30, &group));
+  ASSERT_FALSE(row.isFree(20, 30, nullptr));
+}
+
+TEST(HpwlEngineTest, Delta)
+{
+  HpwlEngine engine;
+  const int c0 = engine.addCell(0, 0);
+  const int c1 = engine.addCell(10, 0);
+  const int c2 = engine.addCell(20, 10);
+  const int n0 = engine.addNet();
+  const int n1 = engine.addNet();
+  engine.addPin(n0, c0, 1, 0);
+  engine.addPin(n0, c1, -1, 0);
+  engine.addPin(n0, c2, 0, 0);
+  engine.addPin(n1, c0, 0, 1);
+  engine.addPin(n1, c0, 0, -1);
+  engine.addPin(n1, c2, 0, 0);
+  engine.build();
+  // n0: x [1, 20] y [0, 10], n1: x [0, 20] y [-1, 10]
+  ASSERT_EQ(engine.hpwl(n0), 29);
+  ASSERT_EQ(engine.hpwl(n1), 31);
+  ASSERT_EQ(engine.hpwl(), 60);
+
+  // Moving the extreme pin falls back to the second extreme.
+  ASSERT_EQ(engine.delta(c2, 5, 0), -21 - 24);
+  // c0 has two pins on n1, which is rescanned.
+  ASSERT_EQ(engine.delta(c0, 30, 0), 3 - 10);
+  ASSERT_EQ(engine.swapDelta(c0, c1), 2 - 10);
+  ASSERT_EQ(engine.delta(c0, 0, 0, true), 2);
+
+  engine.moveCell(c2, 5, 0);
+  ASSERT_EQ(engine.hpwl(), 15);
+  ASSERT_EQ(engine.xMax(n0), 9);
+  ASSERT_EQ(engine.cellHpwl(c2), 15);
+}
+
 }  // namespace dpl
@@ -39,6 +39,7 @@
 #include "detailed_hpwl.h"
 
 #include "detailed_orient.h"
+#include "utility.h"
 
 namespace dpo {
 
@@ -70,6 +71,9 @@ void DetailedHPWL::init()
   traversal_ = 0;
   edgeMask_.resize(network_->getNumEdges());
   std::fill(edgeMask_.begin(), edgeMask_.end(), traversal_);
+
+  Utility::hpwlEngine(network_, skipNetsLargerThanThis_, engine_, &enginePins_);
+  pending_.clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -85,31 +89,31 @@ void DetailedHPWL::init(DetailedMgr* mgrPtr, DetailedOrient* orientPtr)
 ////////////////////////////////////////////////////////////////////////////////
 double DetailedHPWL::curr()
 {
-  double hpwl = 0.;
-  Rectangle box;
-  for (int i = 0; i < network_->getNumEdges(); i++) {
-    const Edge* edi = network_->getEdge(i);
-
-    const int npins = edi->getNumPins();
-    if (npins <= 1 || npins >= skipNetsLargerThanThis_) {
-      continue;
-    }
-
-    box.reset();
-    for (const Pin* pinj : edi->getPins()) {
-      const Node* ndj = pinj->getNode();
-
-      const double x
-          = ndj->getLeft() + 0.5 * ndj->getWidth() + pinj->getOffsetX();
-      const double y
-          = ndj->getBottom() + 0.5 * ndj->getHeight() + pinj->getOffsetY();
+  // Reload the engine since nodes may have moved without being evaluated.
+  Utility::hpwlEngine(network_, skipNetsLargerThanThis_, engine_, &enginePins_);
+  pending_.clear();
+  return engine_.hpwl();
+}
 
-      box.addPt(x, y);
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+void DetailedHPWL::syncEngine(const Node* ndi)
+{
+  // Update the engine with the current position and pin offsets of a node.
+  const int id = ndi->getId();
+  for (int i = engine_.cellPinBegin(id); i < engine_.cellPinEnd(id); i++) {
+    const int pin = engine_.cellPin(i);
+    const Pin* pini = enginePins_[pin];
+    if (engine_.getPinOffsetX(pin) != pini->getOffsetX()
+        || engine_.getPinOffsetY(pin) != pini->getOffsetY()) {
+      engine_.setPinOffset(pin, pini->getOffsetX(), pini->getOffsetY());
     }
-
-    hpwl += (box.getWidth() + box.getHeight());
   }
-  return hpwl;
+  const double x = ndi->getLeft() + 0.5 * ndi->getWidth();
+  const double y = ndi->getBottom() + 0.5 * ndi->getHeight();
+  if (x != engine_.getCellX(id) || y != engine_.getCellY(id)) {
+    engine_.moveCell(id, x, y);
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -122,6 +126,52 @@ double DetailedHPWL::delta(const int n,
                            const std::vector<int>& newLeft,
                            const std::vector<int>& newBottom,
                            const std::vector<unsigned>& newOri)
+{
+  // The nodes of the previous move are where the manager left them after
+  // accepting or rejecting it.
+  for (const Node* ndi : pending_) {
+    syncEngine(ndi);
+  }
+  pending_.assign(nodes.begin(), nodes.begin() + n);
+
+  // Orientation changes move the pin offsets, so rescan those nets.
+  if (orientPtr_ != nullptr) {
+    for (int i = 0; i < n; i++) {
+      if (curOri[i] != newOri[i]) {
+        return deltaRescan(
+            n, nodes, curLeft, curBottom, curOri, newLeft, newBottom, newOri);
+      }
+    }
+  }
+
+  moves_.clear();
+  for (int i = 0; i < n; i++) {
+    const Node* ndi = nodes[i];
+    const double half_w = 0.5 * ndi->getWidth();
+    const double half_h = 0.5 * ndi->getHeight();
+    if (curLeft[i] + half_w != engine_.getCellX(ndi->getId())
+        || curBottom[i] + half_h != engine_.getCellY(ndi->getId())) {
+      engine_.moveCell(
+          ndi->getId(), curLeft[i] + half_w, curBottom[i] + half_h);
+    }
+    moves_.push_back(
+        {ndi->getId(), newLeft[i] + half_w, newBottom[i] + half_h});
+  }
+
+  // +ve means improvement.
+  return -engine_.delta(moves_);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+double DetailedHPWL::deltaRescan(const int n,
+                                 const std::vector<Node*>& nodes,
+                                 const std::vector<int>& curLeft,
+                                 const std::vector<int>& curBottom,
+                                 const std::vector<unsigned>& curOri,
+                                 const std::vector<int>& newLeft,
+                                 const std::vector<int>& newBottom,
+                                 const std::vector<unsigned>& newOri)
 {
   // Given a list of nodes with their old positions and new positions, compute
   // the change in WL. Note that we need to know the orientation information and
@@ -233,50 +283,8 @@ double DetailedHPWL::delta(const int n,
 double DetailedHPWL::delta(Node* ndi, double new_x, double new_y)
 {
   // Compute change in wire length for moving node to new position.
-
-  double old_wl = 0.;
-  double new_wl = 0.;
-  double x, y;
-  Rectangle old_box, new_box;
-
-  ++traversal_;
-  for (int pi = 0; pi < ndi->getNumPins(); pi++) {
-    Pin* pini = ndi->getPins()[pi];
-
-    Edge* edi = pini->getEdge();
-
-    int npins = edi->getNumPins();
-    if (npins <= 1 || npins >= skipNetsLargerThanThis_) {
-      continue;
-    }
-    if (edgeMask_[edi->getId()] == traversal_) {
-      continue;
-    }
-    edgeMask_[edi->getId()] = traversal_;
-
-    old_box.reset();
-    new_box.reset();
-    for (int pj = 0; pj < edi->getNumPins(); pj++) {
-      Pin* pinj = edi->getPins()[pj];
-
-      Node* ndj = pinj->getNode();
-
-      x = ndj->getLeft() + 0.5 * ndj->getWidth() + pinj->getOffsetX();
-      y = ndj->getBottom() + 0.5 * ndj->getHeight() + pinj->getOffsetY();
-
-      old_box.addPt(x, y);
-
-      if (ndj == ndi) {
-        x = new_x + pinj->getOffsetX();
-        y = new_y + pinj->getOffsetY();
-      }
-
-      new_box.addPt(x, y);
-    }
-    old_wl += (old_box.getWidth() + old_box.getHeight());
-    new_wl += (new_box.getWidth() + new_box.getHeight());
-  }
-  return old_wl - new_wl;
+  syncEngine(ndi);
+  return -engine_.delta(ndi->getId(), new_x, new_y);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -291,62 +299,9 @@ void DetailedHPWL::getCandidates(std::vector<Node*>& candidates)
 double DetailedHPWL::delta(Node* ndi, Node* ndj)
 {
   // Compute change in wire length for swapping the two nodes.
-
-  double old_wl = 0.;
-  double new_wl = 0.;
-  double x, y;
-  Rectangle old_box, new_box;
-  Node* nodes[2];
-  nodes[0] = ndi;
-  nodes[1] = ndj;
-
-  ++traversal_;
-  for (int c = 0; c <= 1; c++) {
-    Node* ndi = nodes[c];
-    for (int pi = 0; pi < ndi->getNumPins(); pi++) {
-      Pin* pini = ndi->getPins()[pi];
-
-      Edge* edi = pini->getEdge();
-
-      // int npins = edi->getNumPins();
-      int npins = edi->getNumPins();
-      if (npins <= 1 || npins >= skipNetsLargerThanThis_) {
-        continue;
-      }
-      if (edgeMask_[edi->getId()] == traversal_) {
-        continue;
-      }
-      edgeMask_[edi->getId()] = traversal_;
-
-      old_box.reset();
-      new_box.reset();
-      for (int pj = 0; pj < edi->getNumPins(); pj++) {
-        Pin* pinj = edi->getPins()[pj];
-
-        Node* ndj = pinj->getNode();
-
-        x = ndj->getLeft() + 0.5 * ndj->getWidth() + pinj->getOffsetX();
-        y = ndj->getBottom() + 0.5 * ndj->getHeight() + pinj->getOffsetY();
-
-        old_box.addPt(x, y);
-
-        if (ndj == nodes[0]) {
-          ndj = nodes[1];
-        } else if (ndj == nodes[1]) {
-          ndj = nodes[0];
-        }
-
-        x = ndj->getLeft() + 0.5 * ndj->getWidth() + pinj->getOffsetX();
-        y = ndj->getBottom() + 0.5 * ndj->getHeight() + pinj->getOffsetY();
-
-        new_box.addPt(x, y);
-      }
-
-      old_wl += (old_box.getWidth() + old_box.getHeight());
-      new_wl += (new_box.getWidth() + new_box.getHeight());
-    }
-  }
-  return old_wl - new_wl;
+  syncEngine(ndi);
+  syncEngine(ndj);
+  return -engine_.swapDelta(ndi->getId(), ndj->getId());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -358,59 +313,13 @@ double DetailedHPWL::delta(Node* ndi,
                            double target_xj,
                            double target_yj)
 {
-  // Compute change in wire length for swapping the two nodes.
-
-  double old_wl = 0.;
-  double new_wl = 0.;
-  double x, y;
-  Rectangle old_box, new_box;
-  Node* nodes[2];
-  nodes[0] = ndi;
-  nodes[1] = ndj;
-
-  ++traversal_;
-  for (int c = 0; c <= 1; c++) {
-    Node* ndi = nodes[c];
-    for (int pi = 0; pi < ndi->getNumPins(); pi++) {
-      Pin* pini = ndi->getPins()[pi];
-
-      Edge* edi = pini->getEdge();
-
-      int npins = edi->getNumPins();
-      if (npins <= 1 || npins >= skipNetsLargerThanThis_) {
-        continue;
-      }
-      if (edgeMask_[edi->getId()] == traversal_) {
-        continue;
-      }
-      edgeMask_[edi->getId()] = traversal_;
-
-      old_box.reset();
-      new_box.reset();
-      for (Pin* pinj : edi->getPins()) {
-        Node* curr = pinj->getNode();
-
-        x = curr->getLeft() + 0.5 * curr->getWidth() + pinj->getOffsetX();
-        y = curr->getBottom() + 0.5 * curr->getHeight() + pinj->getOffsetY();
-
-        old_box.addPt(x, y);
-
-        if (curr == nodes[0]) {
-          x = target_xi + pinj->getOffsetX();
-          y = target_yi + pinj->getOffsetY();
-        } else if (curr == nodes[1]) {
-          x = target_xj + pinj->getOffsetX();
-          y = target_yj + pinj->getOffsetY();
-        }
-
-        new_box.addPt(x, y);
-      }
-
-      old_wl += (old_box.getWidth() + old_box.getHeight());
-      new_wl += (new_box.getWidth() + new_box.getHeight());
-    }
-  }
-  return old_wl - new_wl;
+  // Compute change in wire length for moving the two nodes.
+  syncEngine(ndi);
+  syncEngine(ndj);
+  moves_.clear();
+  moves_.push_back({ndi->getId(), target_xi, target_yi});
+  moves_.push_back({ndj->getId(), target_xj, target_yj});
+  return -engine_.delta(moves_);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
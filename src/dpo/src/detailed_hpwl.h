@@ -42,6 +42,7 @@
 #include <vector>
 
 #include "detailed_objective.h"
+#include "dpl/HpwlEngine.h"
 
 namespace dpo {
 
@@ -61,7 +62,8 @@ class DetailedMgr;
 
 class DetailedHPWL : public DetailedObjective
 {
-  // For WL objective.
+  // For WL objective.  Nets are cached in an incremental hpwl engine that
+  // is kept in sync with the nodes of the previously evaluated move.
  public:
   explicit DetailedHPWL(Network* network);
 
@@ -92,6 +94,16 @@ class DetailedHPWL : public DetailedObjective
   ////////////////////////////////////////////////////////////////////////////////
 
  private:
+  void syncEngine(const Node* ndi);
+  double deltaRescan(int n,
+                     const std::vector<Node*>& nodes,
+                     const std::vector<int>& curLeft,
+                     const std::vector<int>& curBottom,
+                     const std::vector<unsigned>& curOri,
+                     const std::vector<int>& newLeft,
+                     const std::vector<int>& newBottom,
+                     const std::vector<unsigned>& newOri);
+
   Network* network_;
 
   DetailedMgr* mgrPtr_;
@@ -101,6 +113,13 @@ class DetailedHPWL : public DetailedObjective
   int skipNetsLargerThanThis_;
   int traversal_;
   std::vector<int> edgeMask_;
+
+  dpl::HpwlEngine engine_;
+  // Network pin of each engine pin.
+  std::vector<const Pin*> enginePins_;
+  std::vector<dpl::HpwlEngine::Move> moves_;
+  // Nodes of the last evaluated move, which may have been accepted.
+  std::vector<const Node*> pending_;
 };
 
 }  // namespace dpo
@@ -64,6 +64,7 @@
 #include "network.h"
 #include "rectangle.h"
 #include "router.h"
+#include "utility.h"
 #include "utl/Logger.h"
 
 using utl::DPO;
@@ -227,6 +228,10 @@ void DetailedMis::place()
   // Populate the grid.  Used for searching.
   populateGrid();
 
+  if (obj_ == DetailedMis::Hpwl) {
+    Utility::hpwlEngine(network_, skipEdgesLargerThanThis_ + 1, engine_);
+  }
+
   timesUsed_.resize(network_->getNumNodes());
   std::fill(timesUsed_.begin(), timesUsed_.end(), 0);
 
@@ -690,6 +695,11 @@ void DetailedMis::solveMatch()
         // Update the postion of cell "i".
         ndi->setLeft(pos[j].first);
         ndi->setBottom(pos[j].second);
+        if (obj_ == DetailedMis::Hpwl) {
+          engine_.moveCell(ndi->getId(),
+                           ndi->getLeft() + 0.5 * ndi->getWidth(),
+                           ndi->getBottom() + 0.5 * ndi->getHeight());
+        }
 
         // Determine new segments and add cell "i" to its new segments.
         const std::vector<DetailedSeg*>& new_segs = seg[j];
@@ -727,40 +737,8 @@ double DetailedMis::getHpwl(const Node* ndi, double xi, double yi)
   // Compute the HPWL of nets connected to ndi assuming ndi is at the
   // specified (xi,yi).
 
-  double hpwl = 0.;
-  Rectangle box;
-  for (int pi = 0; pi < ndi->getNumPins(); pi++) {
-    const Pin* pini = ndi->getPins()[pi];
-
-    const Edge* edi = pini->getEdge();
-
-    const int npins = edi->getNumPins();
-    if (npins <= 1 || npins > skipEdgesLargerThanThis_) {
-      continue;
-    }
-
-    box.reset();
-    for (int pj = 0; pj < edi->getNumPins(); pj++) {
-      const Pin* pinj = edi->getPins()[pj];
-
-      const Node* ndj = pinj->getNode();
-
-      const double x
-          = (ndj == ndi)
-                ? (xi + pinj->getOffsetX())
-                : (ndj->getLeft() + 0.5 * ndj->getWidth() + pinj->getOffsetX());
-      const double y = (ndj == ndi) ? (yi + pinj->getOffsetY())
-                                    : (ndj->getBottom() + 0.5 * ndj->getHeight()
-                                       + pinj->getOffsetY());
-
-      box.addPt(x, y);
-    }
-    if (box.xmax() >= box.xmin() && box.ymax() >= box.ymin()) {
-      hpwl += (box.getWidth() + box.getHeight());
-    }
-  }
-
-  return hpwl;
+  const int id = ndi->getId();
+  return engine_.cellHpwl(id) + engine_.delta(id, xi, yi);
 }
 
 }  // namespace dpo
@@ -42,6 +42,8 @@
 #include <string>
 #include <vector>
 
+#include "dpl/HpwlEngine.h"
+
 namespace dpo {
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -137,6 +139,9 @@ class DetailedMis
 
   std::vector<int> timesUsed_;
 
+  // Nets of the current placement for the wirelength objective.
+  dpl::HpwlEngine engine_;
+
   // Other.
   int skipEdgesLargerThanThis_;
   int maxProblemSize_;
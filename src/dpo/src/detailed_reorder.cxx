@@ -53,7 +53,6 @@ DetailedReorderer::DetailedReorderer(Architecture* arch, Network* network)
       network_(network),
       mgrPtr_(nullptr),
       skipNetsLargerThanThis_(100),
-      traversal_(0),
       windowSize_(3)
 {
 }
@@ -136,9 +135,7 @@ void DetailedReorderer::run(DetailedMgr* mgrPtr,
 ///////////////////////////////////////////////////////////////////////////////
 void DetailedReorderer::reorder()
 {
-  traversal_ = 0;
-  edgeMask_.resize(network_->getNumEdges());
-  std::fill(edgeMask_.begin(), edgeMask_.end(), traversal_);
+  Utility::hpwlEngine(network_, skipNetsLargerThanThis_, engine_);
 
   // Loop over each segment; find single height cells and reorder.
   for (int s = 0; s < mgrPtr_->getNumSegments(); s++) {
@@ -370,6 +367,9 @@ void DetailedReorderer::reorder(const std::vector<Node*>& nodes,
       mgrPtr_->sortCellsInSeg(segId, jstrt, jstop + 1);
     }
   }
+
+  // Cache the final placement of the window.
+  engine_.commit(moves(nodes, jstrt, jstop));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -378,45 +378,31 @@ double DetailedReorderer::cost(const std::vector<Node*>& nodes,
                                int istrt,
                                int istop)
 {
-  // Compute hpwl for the specified sequence of cells.
-
-  ++traversal_;
+  // Compute the change in hpwl of the nets of the specified sequence of
+  // cells from the cached placement.  Only the horizontal span is needed
+  // since the cells stay in their row.  The costs of permutations of the
+  // same window differ by a constant from their absolute hpwl.
+
+  double delta_x, delta_y;
+  engine_.delta(moves(nodes, istrt, istop), delta_x, delta_y);
+  return delta_x;
+}
 
-  double cost = 0.;
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+const std::vector<dpl::HpwlEngine::Move>& DetailedReorderer::moves(
+    const std::vector<Node*>& nodes,
+    int istrt,
+    int istop)
+{
+  moves_.clear();
   for (int i = istrt; i <= istop; i++) {
     const Node* ndi = nodes[i];
-
-    for (int pi = 0; pi < ndi->getNumPins(); pi++) {
-      const Pin* pini = ndi->getPins()[pi];
-
-      const Edge* edi = pini->getEdge();
-
-      const int npins = edi->getNumPins();
-      if (npins <= 1 || npins >= skipNetsLargerThanThis_) {
-        continue;
-      }
-      if (edgeMask_[edi->getId()] == traversal_) {
-        continue;
-      }
-      edgeMask_[edi->getId()] = traversal_;
-
-      double xmin = std::numeric_limits<double>::max();
-      double xmax = -std::numeric_limits<double>::max();
-      for (int pj = 0; pj < edi->getNumPins(); pj++) {
-        const Pin* pinj = edi->getPins()[pj];
-
-        const Node* ndj = pinj->getNode();
-
-        const double x
-            = ndj->getLeft() + 0.5 * ndj->getWidth() + pinj->getOffsetX();
-
-        xmin = std::min(xmin, x);
-        xmax = std::max(xmax, x);
-      }
-      cost += xmax - xmin;
-    }
+    moves_.push_back({ndi->getId(),
+                      ndi->getLeft() + 0.5 * ndi->getWidth(),
+                      ndi->getBottom() + 0.5 * ndi->getHeight()});
   }
-  return cost;
+  return moves_;
 }
 
 }  // namespace dpo
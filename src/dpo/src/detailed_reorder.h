@@ -35,6 +35,8 @@
 #include <string>
 #include <vector>
 
+#include "dpl/HpwlEngine.h"
+
 namespace dpo {
 
 class Architecture;
@@ -63,6 +65,10 @@ class DetailedReorderer
                int segId,
                int rowId);
   double cost(const std::vector<Node*>& nodes, int istrt, int istop);
+  const std::vector<dpl::HpwlEngine::Move>& moves(
+      const std::vector<Node*>& nodes,
+      int istrt,
+      int istop);
 
   // Standard stuff.
   Architecture* arch_;
@@ -73,9 +79,11 @@ class DetailedReorderer
 
   // Other.
   int skipNetsLargerThanThis_;
-  std::vector<int> edgeMask_;
-  int traversal_;
   int windowSize_;
+
+  // Nets of the placement before the current window.
+  dpl::HpwlEngine engine_;
+  std::vector<dpl::HpwlEngine::Move> moves_;
 };
 
 }  // namespace dpo
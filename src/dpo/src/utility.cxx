@@ -74,6 +74,40 @@ double Utility::hpwl(const Network* nw)
   return totWL;
 }
 
+void Utility::hpwlEngine(Network* nw,
+                         int maxPins,
+                         dpl::HpwlEngine& engine,
+                         std::vector<const Pin*>* pins)
+{
+  engine.clear();
+  if (pins != nullptr) {
+    pins->clear();
+  }
+  for (int i = 0; i < nw->getNumNodes(); i++) {
+    const Node* ndi = nw->getNode(i);
+    engine.addCell(ndi->getLeft() + 0.5 * ndi->getWidth(),
+                   ndi->getBottom() + 0.5 * ndi->getHeight());
+  }
+  // Engine pins are numbered in the order they are added.
+  for (int e = 0; e < nw->getNumEdges(); e++) {
+    const Edge* ed = nw->getEdge(e);
+
+    const int numPins = ed->getNumPins();
+    if (numPins <= 1 || numPins >= maxPins) {
+      continue;
+    }
+    const int net = engine.addNet();
+    for (const Pin* pin : ed->getPins()) {
+      engine.addPin(
+          net, pin->getNode()->getId(), pin->getOffsetX(), pin->getOffsetY());
+      if (pins != nullptr) {
+        pins->push_back(pin);
+      }
+    }
+  }
+  engine.build();
+}
+
 double Utility::hpwl(const Network* nw, double& hpwlx, double& hpwly)
 {
   hpwlx = 0.0;
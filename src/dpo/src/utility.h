@@ -40,6 +40,9 @@
 // Includes.
 ////////////////////////////////////////////////////////////////////////////////
 #include <boost/random/mersenne_twister.hpp>
+#include <vector>
+
+#include "dpl/HpwlEngine.h"
 
 ////////////////////////////////////////////////////////////////////////////////
 // Forward declarations.
@@ -57,6 +60,7 @@ using Placer_RNG = boost::mt19937;
 namespace dpo {
 class Edge;
 class Network;
+class Pin;
 
 ////////////////////////////////////////////////////////////////////////////////
 // Classes.
@@ -88,6 +92,15 @@ class Utility
   static double hpwl(const Network* nw, double& hpwlx, double& hpwly);
   static double hpwl(const Edge* ed);
   static double hpwl(const Edge*, double& hpwlx, double& hpwly);
+
+  // Load the placement into an incremental hpwl engine. Cells are the
+  // nodes by id, located at their centers. Only edges with more than
+  // one and fewer than maxPins pins are added. If pins is not null it
+  // is filled with the network pin of each engine pin.
+  static void hpwlEngine(Network* nw,
+                         int maxPins,
+                         dpl::HpwlEngine& engine,
+                         std::vector<const Pin*>* pins = nullptr);
 };
 
 }  // namespace dpo
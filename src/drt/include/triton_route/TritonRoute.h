@@ -56,6 +56,7 @@ class dbDatabase;
 class dbInst;
 }  // namespace odb
 namespace utl {
+class Executor;
 class Logger;
 }
 namespace gui {
@@ -102,7 +103,8 @@ class TritonRoute
             odb::dbDatabase* db,
             utl::Logger* logger,
             dst::Distributed* dist,
-            stt::SteinerTreeBuilder* stt_builder);
+            stt::SteinerTreeBuilder* stt_builder,
+            utl::Executor* executor);
 
   fr::frDesign* getDesign() const { return design_.get(); }
 
@@ -38,6 +38,26 @@ static inline int defdist(odb::dbBlock* block, int x)
          / (double) block->getDbUnitsPerMicron();
 }
 
+bool DesignCallBack::hasDesign() const
+{
+  auto design = router_->getDesign();
+  return design != nullptr && design->getTopBlock() != nullptr;
+}
+
+void DesignCallBack::addModifiedNet(odb::dbNet* net)
+{
+  if (net != nullptr && hasDesign()) {
+    modified_nets_.insert(net->getName());
+  }
+}
+
+void DesignCallBack::clearPendingUpdates()
+{
+  new_insts_.clear();
+  modified_nets_.clear();
+  needs_reload_ = false;
+}
+
 void DesignCallBack::inDbPostMoveInst(odb::dbInst* db_inst)
 {
   auto design = router_->getDesign();
@@ -59,8 +79,22 @@ void DesignCallBack::inDbPostMoveInst(odb::dbInst* db_inst)
   }
 }
 
+void DesignCallBack::inDbInstCreate(odb::dbInst* db_inst)
+{
+  if (hasDesign()) {
+    new_insts_.insert(db_inst);
+  }
+}
+
+void DesignCallBack::inDbInstCreate(odb::dbInst* db_inst,
+                                    odb::dbRegion* region)
+{
+  inDbInstCreate(db_inst);
+}
+
 void DesignCallBack::inDbInstDestroy(odb::dbInst* db_inst)
 {
+  new_insts_.erase(db_inst);
   auto design = router_->getDesign();
   if (design != nullptr && design->getTopBlock() != nullptr) {
     auto inst = design->getTopBlock()->getInst(db_inst->getName());
@@ -71,3 +105,116 @@ void DesignCallBack::inDbInstDestroy(odb::dbInst* db_inst)
     design->getTopBlock()->removeInst(inst);
   }
 }
+
+void DesignCallBack::inDbInstSwapMasterAfter(odb::dbInst* db_inst)
+{
+  if (!hasDesign()) {
+    return;
+  }
+  // the instance terms change with the master; recreate the instance
+  inDbInstDestroy(db_inst);
+  new_insts_.insert(db_inst);
+  for (auto iterm : db_inst->getITerms()) {
+    addModifiedNet(iterm->getNet());
+  }
+}
+
+void DesignCallBack::inDbNetCreate(odb::dbNet* net)
+{
+  addModifiedNet(net);
+}
+
+void DesignCallBack::inDbNetDestroy(odb::dbNet* net)
+{
+  addModifiedNet(net);
+}
+
+void DesignCallBack::inDbITermPostConnect(odb::dbITerm* iterm)
+{
+  addModifiedNet(iterm->getNet());
+}
+
+void DesignCallBack::inDbITermPreDisconnect(odb::dbITerm* iterm)
+{
+  addModifiedNet(iterm->getNet());
+}
+
+void DesignCallBack::inDbBTermCreate(odb::dbBTerm* bterm)
+{
+  needs_reload_ |= hasDesign();
+}
+
+void DesignCallBack::inDbBTermDestroy(odb::dbBTerm* bterm)
+{
+  needs_reload_ |= hasDesign();
+}
+
+void DesignCallBack::inDbBTermPostConnect(odb::dbBTerm* bterm)
+{
+  addModifiedNet(bterm->getNet());
+}
+
+void DesignCallBack::inDbBTermPreDisconnect(odb::dbBTerm* bterm)
+{
+  addModifiedNet(bterm->getNet());
+}
+
+void DesignCallBack::inDbObstructionCreate(odb::dbObstruction* obstruction)
+{
+  needs_reload_ |= hasDesign();
+}
+
+void DesignCallBack::inDbObstructionDestroy(odb::dbObstruction* obstruction)
+{
+  needs_reload_ |= hasDesign();
+}
+
+void DesignCallBack::inDbWireCreate(odb::dbWire* wire)
+{
+  addModifiedNet(wire->getNet());
+}
+
+void DesignCallBack::inDbWireDestroy(odb::dbWire* wire)
+{
+  addModifiedNet(wire->getNet());
+}
+
+void DesignCallBack::inDbWirePostAttach(odb::dbWire* wire)
+{
+  addModifiedNet(wire->getNet());
+}
+
+void DesignCallBack::inDbWirePostDetach(odb::dbWire* wire, odb::dbNet* net)
+{
+  addModifiedNet(net);
+}
+
+void DesignCallBack::inDbWirePostCopy(odb::dbWire* src, odb::dbWire* dst)
+{
+  addModifiedNet(dst->getNet());
+}
+
+void DesignCallBack::inDbWirePostAppend(odb::dbWire* src, odb::dbWire* dst)
+{
+  addModifiedNet(dst->getNet());
+}
+
+void DesignCallBack::inDbSWireCreate(odb::dbSWire* wire)
+{
+  addModifiedNet(wire->getNet());
+}
+
+void DesignCallBack::inDbSWireDestroy(odb::dbSWire* wire)
+{
+  addModifiedNet(wire->getNet());
+}
+
+void DesignCallBack::inDbSWireAddSBox(odb::dbSBox* box)
+{
+  addModifiedNet(box->getSWire()->getNet());
+}
+
+void DesignCallBack::inDbSWireRemoveSBox(odb::dbSBox* box)
+{
+  addModifiedNet(box->getSWire()->getNet());
+}
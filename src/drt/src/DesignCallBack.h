@@ -26,20 +26,68 @@
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <set>
+#include <string>
+
 #include "odb/db.h"
 #include "odb/dbBlockCallBackObj.h"
 namespace triton_route {
 class TritonRoute;
 }
 namespace fr {
+// Keeps the router's design in sync with odb between commands. Moves and
+// deletions are applied immediately; other edits are recorded and applied
+// by io::Parser::updateDesign the next time the design is initialized.
 class DesignCallBack : public odb::dbBlockCallBackObj
 {
  public:
   DesignCallBack(triton_route::TritonRoute* router) : router_(router) {}
   void inDbPostMoveInst(odb::dbInst* inst) override;
+  void inDbInstCreate(odb::dbInst* inst) override;
+  void inDbInstCreate(odb::dbInst* inst, odb::dbRegion* region) override;
   void inDbInstDestroy(odb::dbInst* inst) override;
+  void inDbInstSwapMasterAfter(odb::dbInst* inst) override;
+  void inDbNetCreate(odb::dbNet* net) override;
+  void inDbNetDestroy(odb::dbNet* net) override;
+  void inDbITermPostConnect(odb::dbITerm* iterm) override;
+  void inDbITermPreDisconnect(odb::dbITerm* iterm) override;
+  void inDbBTermCreate(odb::dbBTerm* bterm) override;
+  void inDbBTermDestroy(odb::dbBTerm* bterm) override;
+  void inDbBTermPostConnect(odb::dbBTerm* bterm) override;
+  void inDbBTermPreDisconnect(odb::dbBTerm* bterm) override;
+  void inDbObstructionCreate(odb::dbObstruction* obstruction) override;
+  void inDbObstructionDestroy(odb::dbObstruction* obstruction) override;
+  void inDbWireCreate(odb::dbWire* wire) override;
+  void inDbWireDestroy(odb::dbWire* wire) override;
+  void inDbWirePostAttach(odb::dbWire* wire) override;
+  void inDbWirePostDetach(odb::dbWire* wire, odb::dbNet* net) override;
+  void inDbWirePostCopy(odb::dbWire* src, odb::dbWire* dst) override;
+  void inDbWirePostAppend(odb::dbWire* src, odb::dbWire* dst) override;
+  void inDbSWireCreate(odb::dbSWire* wire) override;
+  void inDbSWireDestroy(odb::dbSWire* wire) override;
+  void inDbSWireAddSBox(odb::dbSBox* box) override;
+  void inDbSWireRemoveSBox(odb::dbSBox* box) override;
+
+  bool hasPendingUpdates() const
+  {
+    return !new_insts_.empty() || !modified_nets_.empty();
+  }
+  // true if a change can't be applied incrementally
+  bool needsReload() const { return needs_reload_; }
+  const std::set<odb::dbInst*>& getNewInsts() const { return new_insts_; }
+  const std::set<std::string>& getModifiedNets() const
+  {
+    return modified_nets_;
+  }
+  void clearPendingUpdates();
 
  private:
+  bool hasDesign() const;
+  void addModifiedNet(odb::dbNet* net);
+
   triton_route::TritonRoute* router_;
+  std::set<odb::dbInst*> new_insts_;
+  std::set<std::string> modified_nets_;
+  bool needs_reload_ = false;
 };
 }  // namespace fr
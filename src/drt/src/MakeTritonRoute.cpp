@@ -54,7 +54,8 @@ void initTritonRoute(OpenRoad* openroad)
                                    openroad->getDb(),
                                    openroad->getLogger(),
                                    openroad->getDistributed(),
-                                   openroad->getSteinerTreeBuilder());
+                                   openroad->getSteinerTreeBuilder(),
+                                   openroad->getExecutor());
 }
 
 }  // namespace ord
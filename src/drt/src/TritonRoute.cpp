@@ -326,18 +326,15 @@ static void deserializeUpdates(frDesign* design,
 
 void TritonRoute::updateDesign(const std::vector<std::string>& updatesStrs)
 {
-  omp_set_num_threads(ord::OpenRoad::openRoad()->getThreadCount());
   std::vector<std::vector<drUpdate>> updates(updatesStrs.size());
-#pragma omp parallel for schedule(dynamic)
-  for (int i = 0; i < updatesStrs.size(); i++) {
+  parallelFor(0, updatesStrs.size(), 0, [&](int i) {
     deserializeUpdate(design_.get(), updatesStrs.at(i), updates[i]);
-  }
+  });
   applyUpdates(updates);
 }
 
 void TritonRoute::updateDesign(const std::string& path)
 {
-  omp_set_num_threads(ord::OpenRoad::openRoad()->getThreadCount());
   std::vector<std::vector<drUpdate>> updates;
   deserializeUpdates(design_.get(), path, updates);
   applyUpdates(updates);
@@ -473,6 +470,7 @@ void TritonRoute::applyUpdates(
               frSegStyle style = updatedSeg.getStyle();
               seg->setStyle(style);
               regionQuery->addDRObj(seg);
+              net->setNeedsDbUpdate(true);
               break;
             }
             default:
@@ -488,12 +486,14 @@ void TritonRoute::init(Tcl_Interp* tcl_interp,
                        odb::dbDatabase* db,
                        Logger* logger,
                        dst::Distributed* dist,
-                       stt::SteinerTreeBuilder* stt_builder)
+                       stt::SteinerTreeBuilder* stt_builder,
+                       utl::Executor* executor)
 {
   db_ = db;
   logger_ = logger;
   dist_ = dist;
   stt_builder_ = stt_builder;
+  EXECUTOR = executor;
   design_ = std::make_unique<frDesign>(logger_);
   dist->addCallBack(new fr::RoutingCallBack(this, dist, logger));
   // Define swig TCL commands.
@@ -515,9 +515,19 @@ bool TritonRoute::initGuide()
 void TritonRoute::initDesign()
 {
   if (getDesign()->getTopBlock() != nullptr) {
-    getDesign()->getTopBlock()->removeDeletedInsts();
-    return;
+    if (!db_callback_->needsReload()) {
+      getDesign()->getTopBlock()->removeDeletedInsts();
+      if (db_callback_->hasPendingUpdates()) {
+        io::Parser parser(db_, getDesign(), logger_);
+        parser.updateDesign(db_callback_->getNewInsts(),
+                            db_callback_->getModifiedNets());
+        db_callback_->clearPendingUpdates();
+      }
+      return;
+    }
+    clearDesign();
   }
+  db_callback_->clearPendingUpdates();
   io::Parser parser(db_, getDesign(), logger_);
   parser.readDb();
   auto tech = getDesign()->getTech();
@@ -647,6 +657,8 @@ void TritonRoute::endFR()
   dr_.reset();
   io::Writer writer(getDesign(), logger_);
   writer.updateDb(db_);
+  // the design already has the routing just written
+  db_callback_->clearPendingUpdates();
   if (debug_->writeNetTracks)
     writer.updateTrackAssignment(db_->getChip()->getBlock());
 
@@ -803,13 +815,11 @@ void TritonRoute::sendDesignUpdates(const std::string& globals_path)
   else
     serializeTask = std::make_unique<ProfileTask>("DIST: SERIALIZE_UPDATES");
   const auto& designUpdates = design_->getUpdates();
-  omp_set_num_threads(MAX_THREADS);
   std::vector<std::string> updates(designUpdates.size());
-#pragma omp parallel for schedule(dynamic)
-  for (int i = 0; i < designUpdates.size(); i++) {
+  parallelFor(0, designUpdates.size(), MAX_THREADS, [&](int i) {
     updates[i] = fmt::format("{}updates_{}.bin", shared_volume_, i);
     serializeUpdatesBatch(designUpdates.at(i), updates[i]);
-  }
+  });
   serializeTask->done();
   std::unique_ptr<ProfileTask> task;
   if (design_->getVersion() == 0)
@@ -933,13 +943,11 @@ void TritonRoute::getDRCMarkers(frList<std::unique_ptr<frMarker>>& markers,
     }
   }
   std::map<MarkerId, frMarker*> mapMarkers;
-  omp_set_num_threads(MAX_THREADS);
   for (auto& workers : workersBatches) {
-#pragma omp parallel for schedule(dynamic)
-    for (int i = 0; i < workers.size(); i++) {
+    parallelFor(0, workers.size(), MAX_THREADS, [&](int i) {
       workers[i]->init(design_.get());
       workers[i]->main();
-    }
+    });
     for (const auto& worker : workers) {
       for (auto& marker : worker->getMarkers()) {
         Rect bbox = marker->getBBox();
@@ -96,6 +96,11 @@ class frMaster : public frBlockObject
     return nullptr;
   }
   dbMasterType getMasterType() { return masterType_; }
+  // signature of the unique instance behind each pin access index
+  const std::vector<std::string>& getPinAccessSignatures() const
+  {
+    return paSignatures_;
+  }
 
   // setters
   void addTerm(std::unique_ptr<frMTerm> in)
@@ -134,6 +139,10 @@ class frMaster : public frBlockObject
     blockages_.push_back(std::move(in));
   }
   void setMasterType(const dbMasterType& in) { masterType_ = in; }
+  void setPinAccessSignatures(const std::vector<std::string>& in)
+  {
+    paSignatures_ = in;
+  }
   // others
   frBlockObjectEnum typeId() const override { return frcMaster; }
 
@@ -144,6 +153,7 @@ class frMaster : public frBlockObject
   Rect dieBox_;
   frString name_;
   dbMasterType masterType_;
+  std::vector<std::string> paSignatures_;
 
   friend class io::Parser;
 };
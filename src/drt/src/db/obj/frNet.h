@@ -67,6 +67,7 @@ class frNet : public frBlockObject
         guides_(),
         type_(dbSigType::SIGNAL),
         modified_(false),
+        needsDbUpdate_(false),
         isFakeNet_(false),
         ndr_(nullptr),
         absPriorityLvl(0),
@@ -109,6 +110,8 @@ class frNet : public frBlockObject
     return guides_;
   }
   bool isModified() const { return modified_; }
+  // true if the routing differs from the net's wire in odb
+  bool needsDbUpdate() const { return needsDbUpdate_; }
   bool isFake() const { return isFakeNet_; }
   frNonDefaultRule* getNondefaultRule() const { return ndr_; }
   // setters
@@ -123,6 +126,15 @@ class frNet : public frBlockObject
     }
   }
   void addBTerm(frBTerm* in) { bterms_.push_back(in); }
+  void removeBTerm(frBTerm* in)
+  {
+    for (auto itr = bterms_.begin(); itr != bterms_.end(); itr++) {
+      if (*itr == in) {
+        bterms_.erase(itr);
+        return;
+      }
+    }
+  }
   void setName(const frString& stringIn) { name_ = stringIn; }
   void addShape(std::unique_ptr<frShape> in)
   {
@@ -132,6 +144,7 @@ class frNet : public frBlockObject
     shapes_.push_back(std::move(in));
     rptr->setIter(--shapes_.end());
     all_pinfigs_.push_back(rptr);
+    needsDbUpdate_ = true;
   }
   void addVia(std::unique_ptr<frVia> in)
   {
@@ -141,6 +154,7 @@ class frNet : public frBlockObject
     vias_.push_back(std::move(in));
     rptr->setIter(--vias_.end());
     all_pinfigs_.push_back(rptr);
+    needsDbUpdate_ = true;
   }
   void addPatchWire(std::unique_ptr<frShape> in)
   {
@@ -150,6 +164,7 @@ class frNet : public frBlockObject
     pwires_.push_back(std::move(in));
     rptr->setIter(--pwires_.end());
     all_pinfigs_.push_back(rptr);
+    needsDbUpdate_ = true;
   }
   void addGRShape(std::unique_ptr<grShape>& in)
   {
@@ -193,15 +208,45 @@ class frNet : public frBlockObject
     guides_.push_back(std::move(in));
   }
   void clearGuides() { guides_.clear(); }
-  void removeShape(frShape* in) { shapes_.erase(in->getIter()); }
-  void removeVia(frVia* in) { vias_.erase(in->getIter()); }
-  void removePatchWire(frShape* in) { pwires_.erase(in->getIter()); }
+  void removeShape(frShape* in)
+  {
+    shapes_.erase(in->getIter());
+    needsDbUpdate_ = true;
+  }
+  void removeVia(frVia* in)
+  {
+    vias_.erase(in->getIter());
+    needsDbUpdate_ = true;
+  }
+  void removePatchWire(frShape* in)
+  {
+    pwires_.erase(in->getIter());
+    needsDbUpdate_ = true;
+  }
+  // Drops all the routing and pin nodes of the net; the caller is
+  // responsible for removing them from the region query first.
+  void clearRouting()
+  {
+    shapes_.clear();
+    vias_.clear();
+    pwires_.clear();
+    all_pinfigs_.clear();
+    nodes_.clear();
+    root_ = nullptr;
+    rootGCellNode_ = nullptr;
+    firstNonRPinNode_ = nullptr;
+  }
   void removeGRShape(grShape* in) { grShapes_.erase(in->getIter()); }
   void clearGRShapes() { grShapes_.clear(); }
   void removeGRVia(grVia* in) { grVias_.erase(in->getIter()); }
   void clearGRVias() { grVias_.clear(); }
   void removeNode(frNode* in) { nodes_.erase(in->getIter()); }
-  void setModified(bool in) { modified_ = in; }
+  void setModified(bool in)
+  {
+    modified_ = in;
+    needsDbUpdate_ |= in;
+  }
+  void setNeedsDbUpdate(bool in) { needsDbUpdate_ = in; }
   void setIsFake(bool in) { isFakeNet_ = in; }
   // others
   dbSigType getType() const { return type_; }
@@ -262,6 +307,7 @@ class frNet : public frBlockObject
   std::vector<frRect> orig_guides_;
   dbSigType type_;
   bool modified_;
+  bool needsDbUpdate_;
   bool isFakeNet_;  // indicate floating PG nets
   frNonDefaultRule* ndr_;
   int absPriorityLvl;  // absolute priority level: will be checked in net
@@ -53,6 +53,13 @@ class frPin : public frBlockObject
   bool hasPinAccess() const { return !aps_.empty(); }
   frPinAccess* getPinAccess(int idx) const { return aps_[idx].get(); }
   void clearPinAccess() { aps_.clear(); }
+  // Moves the pin accesses out, leaving the pin without any.
+  std::vector<std::unique_ptr<frPinAccess>> releasePinAccess()
+  {
+    std::vector<std::unique_ptr<frPinAccess>> aps;
+    aps.swap(aps_);
+    return aps;
+  }
   // setters
   // cannot have setterm, must be available when creating
   void addPinFig(std::unique_ptr<frPinFig> in)
@@ -144,6 +144,10 @@ class frLayer
   void setUnidirectional(bool in) { unidirectional = in; }
   // getters
   odb::dbTechLayer* getDbLayer() const { return db_layer_; }
+  const frCollection<frConstraint*>& getConstraints() const
+  {
+    return constraints;
+  }
   bool isFakeCut() const { return fakeCut; }
   bool isFakeMasterslice() const { return fakeMasterslice; }
   frUInt4 getNumMasks() const
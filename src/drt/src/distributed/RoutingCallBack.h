@@ -27,7 +27,6 @@
  */
 
 #pragma once
-#include <omp.h>
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -45,7 +44,6 @@
 #include "dst/JobCallBack.h"
 #include "dst/JobMessage.h"
 #include "global.h"
-#include "ord/OpenRoad.hh"
 #include "triton_route/TritonRoute.h"
 #include "utl/Logger.h"
 
@@ -61,7 +59,7 @@ class RoutingCallBack : public dst::JobCallBack
   RoutingCallBack(triton_route::TritonRoute* router,
                   dst::Distributed* dist,
                   utl::Logger* logger)
-      : router_(router), dist_(dist), logger_(logger), init_(true)
+      : router_(router), dist_(dist), logger_(logger)
   {
   }
   void onRoutingJobReceived(dst::JobMessage& msg, dst::socket& sock) override
@@ -70,23 +68,19 @@ class RoutingCallBack : public dst::JobCallBack
       return;
     RoutingJobDescription* desc
         = static_cast<RoutingJobDescription*>(msg.getJobDescription());
-    if (init_) {
-      init_ = false;
-      omp_set_num_threads(ord::OpenRoad::openRoad()->getThreadCount());
-    }
     auto workers = desc->getWorkers();
     int size = workers.size();
     std::vector<std::pair<int, std::string>> results;
     asio::thread_pool reply_pool(1);
     int prev_perc = 0;
     int cnt = 0;
-#pragma omp parallel for schedule(dynamic)
-    for (int i = 0; i < workers.size(); i++) {
+    std::mutex results_mutex;
+    parallelFor(0, workers.size(), 0, [&](int i) {
       std::pair<int, std::string> result
           = {workers.at(i).first,
              router_->runDRWorker(workers.at(i).second, &via_data_)};
-#pragma omp critical
       {
+        std::lock_guard<std::mutex> lock(results_mutex);
         results.push_back(result);
         ++cnt;
         if (cnt * 1.0 / size >= prev_perc / 100.0 + 0.1 && prev_perc < 90) {
@@ -103,7 +97,7 @@ class RoutingCallBack : public dst::JobCallBack
           }
         }
       }
-    }
+    });
     reply_pool.join();
     sendResult(results, sock, true, cnt);
   }
@@ -168,7 +162,6 @@ class RoutingCallBack : public dst::JobCallBack
   utl::Logger* logger_;
   std::string design_path_;
   std::string globals_path_;
-  bool init_;
   FlexDRViaData via_data_;
 };
 
@@ -29,7 +29,6 @@
 #include "dr/FlexDR.h"
 
 #include <dst/JobMessage.h>
-#include <omp.h>
 #include <stdio.h>
 
 #include <boost/archive/text_iarchive.hpp>
@@ -38,6 +37,7 @@
 #include <chrono>
 #include <fstream>
 #include <iomanip>
+#include <mutex>
 #include <numeric>
 #include <sstream>
 
@@ -567,7 +567,6 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
     xIdx++;
   }
 
-  omp_set_num_threads(MAX_THREADS);
   int version = 0;
   increaseClipsize_ = false;
   numWorkUnits_ = 0;
@@ -593,15 +592,15 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
           ProfileTask task("DIST: PROCESS_BATCH");
           // multi thread
           ThreadException exception;
-#pragma omp parallel for schedule(dynamic)
-          for (int i = 0; i < (int) workersInBatch.size(); i++) {
+          std::mutex cnt_mutex;
+          parallelFor(0, workersInBatch.size(), MAX_THREADS, [&](int i) {
             try {
               if (dist_on_)
                 workersInBatch[i]->distributedMain(getDesign());
               else
                 workersInBatch[i]->main(getDesign());
-#pragma omp critical
               {
+                std::lock_guard<std::mutex> lock(cnt_mutex);
                 cnt++;
                 if (VERBOSE > 0) {
                   if (cnt * 1.0 / tot >= prev_perc / 100.0 + 0.1
@@ -623,7 +622,7 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
             } catch (...) {
               exception.capture();
             }
-          }
+          });
           exception.rethrow();
           if (dist_on_) {
             int j = 0;
@@ -638,21 +637,21 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
             }
             {
               ProfileTask task("DIST: SERIALIZE+SEND");
-#pragma omp parallel for schedule(dynamic)
-              for (int i = 0; i < distWorkerBatches.size(); i++)
+              const int numBatches = distWorkerBatches.size();
+              parallelFor(0, numBatches, MAX_THREADS, [&](int i) {
                 sendWorkers(distWorkerBatches.at(i), workersInBatch);
+              });
             }
             logger_->report("    Received Batches:{}.", t);
             std::vector<std::pair<int, std::string>> workers;
             router_->getWorkerResults(workers);
             {
               ProfileTask task("DIST: DESERIALIZING_BATCH");
-#pragma omp parallel for schedule(dynamic)
-              for (int i = 0; i < workers.size(); i++) {
+              parallelFor(0, workers.size(), MAX_THREADS, [&](int i) {
                 deserializeWorker(workersInBatch.at(workers.at(i).first).get(),
                                   design_,
                                   workers.at(i).second);
-              }
+              });
             }
             logger_->report("    Deserialized Batches:{}.", t);
           }
@@ -1003,9 +1002,8 @@ void FlexDR::reportGuideCoverage()
   std::vector<unsigned long long> totalCoveredAreaByLayerNum(numLayers, 0);
   map<frNet*, std::vector<float>> netsCoverage;
   const auto& nets = getDesign()->getTopBlock()->getNets();
-  omp_set_num_threads(MAX_THREADS);
-#pragma omp parallel for schedule(dynamic)
-  for (int i = 0; i < nets.size(); i++) {
+  std::mutex coverage_mutex;
+  parallelFor(0, nets.size(), MAX_THREADS, [&](int i) {
     const auto& net = nets.at(i);
     std::vector<gtl::polygon_90_set_data<frCoord>> routeSetByLayerNum(
         numLayers),
@@ -1053,14 +1051,14 @@ void FlexDR::reportGuideCoverage()
           coveredPercentage = (coveredArea / (double) routingArea) * 100;
       }
 
-#pragma omp critical
       {
+        std::lock_guard<std::mutex> lock(coverage_mutex);
         netsCoverage[net.get()].push_back(coveredPercentage);
         totalAreaByLayerNum[lNum] += routingArea;
         totalCoveredAreaByLayerNum[lNum] += coveredArea;
       }
     }
-  }
+  });
 
   ofstream file(GUIDE_REPORT_FILE);
   file << "Net,";
@@ -28,8 +28,6 @@
 
 #include "dr/FlexDR_conn.h"
 
-#include <omp.h>
-
 #include "dr/FlexDR.h"
 #include "frProfileTask.h"
 #include "io/io.h"
@@ -907,7 +905,6 @@ void FlexDRConnectivityChecker::splitPathSegs_commit(
       int segSpnIdx = splitSpanIdxs[currIdxSplitSpanIdxs];
       frPathSeg* ps
           = static_cast<frPathSeg*>(netRouteObjs[segSpans[segSpnIdx].second]);
-#pragma omp critical
       {
         getRegionQuery()->removeDRObj(ps);
         // set low
@@ -965,7 +962,6 @@ void FlexDRConnectivityChecker::splitPathSegs_commit(
       frPathSeg* ptr = newPs.get();
       netRouteObjs.push_back(ptr);
       highestPs->getNet()->addShape(std::move(newPs));
-#pragma omp critical
       getRegionQuery()->addDRObj(ptr);
     }
     sort(segSpans.begin() + first, segSpans.begin() + i);
@@ -1139,7 +1135,6 @@ void FlexDRConnectivityChecker::check(int iter)
   }
 
   const int numLayers = getTech()->getLayers().size();
-  omp_set_num_threads(MAX_THREADS);
   for (auto& batch : batches) {
     ProfileTask profile("batch");
     // prefix a = all batch
@@ -1164,8 +1159,7 @@ void FlexDRConnectivityChecker::check(int iter)
     ProfileTask init_parallel("init-parallel");
     // parallel
     ThreadException exception;
-#pragma omp parallel for schedule(static)
-    for (int i = 0; i < (int) batch.size(); i++) {
+    parallelFor(0, batch.size(), MAX_THREADS, [&](int i) {
       try {
         const auto net = batch[i];
         auto& initNetRouteObjs = aNetRouteObjs[i];
@@ -1189,7 +1183,7 @@ void FlexDRConnectivityChecker::check(int iter)
       } catch (...) {
         exception.capture();
       }
-    }
+    });
     exception.rethrow();
     init_parallel.done();
     ProfileTask merge_serial("merge-serial");
@@ -1225,9 +1219,8 @@ void FlexDRConnectivityChecker::check(int iter)
     merge_serial.done();
     ProfileTask astar_parallel("astar-parallel");
 
-// parallel
-#pragma omp parallel for schedule(static)
-    for (int i = 0; i < (int) batch.size(); i++) {
+    // parallel
+    parallelFor(0, batch.size(), MAX_THREADS, [&](int i) {
       try {
         const auto net = batch[i];
         auto& netRouteObjs = aNetRouteObjs[i];
@@ -1253,7 +1246,7 @@ void FlexDRConnectivityChecker::check(int iter)
       } catch (...) {
         exception.capture();
       }
-    }
+    });
     exception.rethrow();
     astar_parallel.done();
     ProfileTask finish_serial("finish-serial");
@@ -37,6 +37,7 @@
 #include "db/obj/frBlock.h"
 #include "db/obj/frMaster.h"
 #include "frDesign.h"
+#include "utl/Executor.h"
 
 using namespace std;
 using namespace fr;
@@ -52,6 +53,7 @@ double OR_K = 0;
 
 string DBPROCESSNODE = "";
 int MAX_THREADS = 1;
+utl::Executor* EXECUTOR = nullptr;
 int BATCHSIZE = 1024;
 int BATCHSIZETA = 8;
 int MTSAFEDIST = 2000;
@@ -490,4 +492,18 @@ ostream& operator<<(ostream& os, const frMarker& m)
   }
 }
 
+void parallelFor(int begin,
+                 int end,
+                 int num_threads,
+                 const std::function<void(int)>& func)
+{
+  if (EXECUTOR == nullptr || num_threads == 1) {
+    for (int i = begin; i < end; i++) {
+      func(i);
+    }
+    return;
+  }
+  EXECUTOR->parallelFor(begin, end, func, num_threads);
+}
+
 }  // end namespace fr
@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -35,6 +36,10 @@
 #include "db/obj/frMarker.h"
 #include "frBaseTypes.h"
 
+namespace utl {
+class Executor;
+}
+
 extern std::string DBPROCESSNODE;
 extern std::string OUT_MAZE_FILE;
 extern std::string DRC_RPT_FILE;
@@ -45,6 +50,8 @@ extern int OR_SEED;
 extern double OR_K;
 
 extern int MAX_THREADS;
+// Shared pool the parallel loops run on; set by TritonRoute::init.
+extern utl::Executor* EXECUTOR;
 extern int BATCHSIZE;
 extern int BATCHSIZETA;
 extern int MTSAFEDIST;
@@ -134,6 +141,14 @@ frCoord getGCELLGRIDY();
 frCoord getGCELLOFFSETX();
 frCoord getGCELLOFFSETY();
 
+// Runs func(i) for every i in [begin, end) with at most num_threads threads
+// of EXECUTOR, or all of them if num_threads is 0.  Runs serially if there
+// is no executor.
+void parallelFor(int begin,
+                 int end,
+                 int num_threads,
+                 const std::function<void(int)>& func);
+
 class frViaDef;
 class frBlock;
 class frMaster;
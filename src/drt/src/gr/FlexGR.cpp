@@ -28,8 +28,6 @@
 
 #include "FlexGR.h"
 
-#include <omp.h>
-
 #include <cmath>
 #include <fstream>
 #include <iostream>
@@ -351,9 +349,6 @@ void FlexGR::searchRepair(int iter,
       xIdx++;
     }
 
-    omp_set_num_threads(min(8, MAX_THREADS));
-    // omp_set_num_threads(1);
-
     // parallel execution
     for (auto& workerBatch : workers) {
       for (auto& workersInBatch : workerBatch) {
@@ -364,14 +359,13 @@ void FlexGR::searchRepair(int iter,
         }
         // multi thread
         ThreadException exception;
-#pragma omp parallel for schedule(dynamic)
-        for (int i = 0; i < (int) workersInBatch.size(); i++) {
+        parallelFor(0, workersInBatch.size(), min(8, MAX_THREADS), [&](int i) {
           try {
             workersInBatch[i]->main_mt();
           } catch (...) {
             exception.capture();
           }
-        }
+        });
         exception.rethrow();
         // single thread
         for (int i = 0; i < (int) workersInBatch.size(); i++) {
@@ -126,46 +126,51 @@ void io::Parser::setTracks(odb::dbBlock* block)
 void io::Parser::setInsts(odb::dbBlock* block)
 {
   for (auto inst : block->getInsts()) {
-    if (design_->name2master_.find(inst->getMaster()->getName())
-        == design_->name2master_.end())
-      logger_->error(
-          DRT, 95, "Library cell {} not found.", inst->getMaster()->getName());
-    if (tmpBlock_->name2inst_.find(inst->getName())
-        != tmpBlock_->name2inst_.end())
-      logger_->error(DRT, 96, "Same cell name: {}.", inst->getName());
-    frMaster* master = design_->name2master_.at(inst->getMaster()->getName());
-    auto uInst = make_unique<frInst>(inst->getName(), master);
-    auto tmpInst = uInst.get();
-    tmpInst->setId(numInsts_);
-    numInsts_++;
-
-    int x, y;
-    inst->getLocation(x, y);
-    tmpInst->setOrigin(Point(x, y));
-    tmpInst->setOrient(inst->getOrient());
-    int numInstTerms = 0;
-    tmpInst->setPinAccessIdx(inst->getPinAccessIdx());
-    for (auto& uTerm : tmpInst->getMaster()->getTerms()) {
-      auto term = uTerm.get();
-      unique_ptr<frInstTerm> instTerm = make_unique<frInstTerm>(tmpInst, term);
-      instTerm->setId(numTerms_++);
-      instTerm->setIndexInOwner(numInstTerms++);
-      int pinCnt = term->getPins().size();
-      instTerm->setAPSize(pinCnt);
-      tmpInst->addInstTerm(std::move(instTerm));
-    }
-    for (auto& uBlk : tmpInst->getMaster()->getBlockages()) {
-      auto blk = uBlk.get();
-      unique_ptr<frInstBlockage> instBlk
-          = make_unique<frInstBlockage>(tmpInst, blk);
-      instBlk->setId(numBlockages_);
-      numBlockages_++;
-      tmpInst->addInstBlockage(std::move(instBlk));
-    }
-    tmpBlock_->addInst(std::move(uInst));
+    setInst(tmpBlock_.get(), inst);
   }
 }
 
+frInst* io::Parser::setInst(frBlock* block, odb::dbInst* inst)
+{
+  if (design_->name2master_.find(inst->getMaster()->getName())
+      == design_->name2master_.end())
+    logger_->error(
+        DRT, 95, "Library cell {} not found.", inst->getMaster()->getName());
+  if (block->name2inst_.find(inst->getName()) != block->name2inst_.end())
+    logger_->error(DRT, 96, "Same cell name: {}.", inst->getName());
+  frMaster* master = design_->name2master_.at(inst->getMaster()->getName());
+  auto uInst = make_unique<frInst>(inst->getName(), master);
+  auto tmpInst = uInst.get();
+  tmpInst->setId(numInsts_);
+  numInsts_++;
+
+  int x, y;
+  inst->getLocation(x, y);
+  tmpInst->setOrigin(Point(x, y));
+  tmpInst->setOrient(inst->getOrient());
+  int numInstTerms = 0;
+  tmpInst->setPinAccessIdx(inst->getPinAccessIdx());
+  for (auto& uTerm : tmpInst->getMaster()->getTerms()) {
+    auto term = uTerm.get();
+    unique_ptr<frInstTerm> instTerm = make_unique<frInstTerm>(tmpInst, term);
+    instTerm->setId(numTerms_++);
+    instTerm->setIndexInOwner(numInstTerms++);
+    int pinCnt = term->getPins().size();
+    instTerm->setAPSize(pinCnt);
+    tmpInst->addInstTerm(std::move(instTerm));
+  }
+  for (auto& uBlk : tmpInst->getMaster()->getBlockages()) {
+    auto blk = uBlk.get();
+    unique_ptr<frInstBlockage> instBlk
+        = make_unique<frInstBlockage>(tmpInst, blk);
+    instBlk->setId(numBlockages_);
+    numBlockages_++;
+    tmpInst->addInstBlockage(std::move(instBlk));
+  }
+  block->addInst(std::move(uInst));
+  return tmpInst;
+}
+
 void io::Parser::setObstructions(odb::dbBlock* block)
 {
   for (auto blockage : block->getObstructions()) {
@@ -499,219 +504,296 @@ void io::Parser::getSBoxCoords(odb::dbSBox* box,
 void io::Parser::setNets(odb::dbBlock* block)
 {
   for (auto net : block->getNets()) {
-    bool is_special = net->isSpecial();
-    if (!is_special && net->getSigType().isSupply()) {
+    unique_ptr<frNet> uNetIn = createNet(net);
+    setNet(tmpBlock_.get(), net, uNetIn.get());
+    if (net->isSpecial())
+      tmpBlock_->addSNet(std::move(uNetIn));
+    else
+      tmpBlock_->addNet(std::move(uNetIn));
+  }
+}
+
+unique_ptr<frNet> io::Parser::createNet(odb::dbNet* net)
+{
+  bool is_special = net->isSpecial();
+  if (!is_special && net->getSigType().isSupply()) {
+    logger_->error(DRT,
+                   305,
+                   "Net {} of signal type {} is not routable by TritonRoute. "
+                   "Move to special nets.",
+                   net->getName(),
+                   net->getSigType().getString());
+  }
+  unique_ptr<frNet> uNetIn = make_unique<frNet>(net->getName());
+  if (net->getNonDefaultRule())
+    uNetIn->updateNondefaultRule(design_->getTech()->getNondefaultRule(
+        net->getNonDefaultRule()->getName()));
+  if (net->getSigType() == dbSigType::CLOCK)
+    uNetIn->updateIsClock(true);
+  if (is_special)
+    uNetIn->setIsSpecial(true);
+  uNetIn->setId(numNets_);
+  numNets_++;
+  uNetIn->setType(net->getSigType());
+  return uNetIn;
+}
+
+// Fills netIn with the pins and the routing of net.
+void io::Parser::setNet(frBlock* block, odb::dbNet* net, frNet* netIn)
+{
+  bool is_special = net->isSpecial();
+  for (auto term : net->getBTerms()) {
+    if (term->getSigType().isSupply() && !net->getSigType().isSupply())
       logger_->error(DRT,
-                     305,
-                     "Net {} of signal type {} is not routable by TritonRoute. "
-                     "Move to special nets.",
+                     306,
+                     "Net {} of signal type {} cannot be connected to bterm "
+                     "{} with signal type {}",
                      net->getName(),
-                     net->getSigType().getString());
-    }
-    unique_ptr<frNet> uNetIn = make_unique<frNet>(net->getName());
-    auto netIn = uNetIn.get();
-    if (net->getNonDefaultRule())
-      uNetIn->updateNondefaultRule(design_->getTech()->getNondefaultRule(
-          net->getNonDefaultRule()->getName()));
-    if (net->getSigType() == dbSigType::CLOCK)
-      uNetIn->updateIsClock(true);
-    if (is_special)
-      uNetIn->setIsSpecial(true);
-    netIn->setId(numNets_);
-    numNets_++;
-    for (auto term : net->getBTerms()) {
-      if (term->getSigType().isSupply() && !net->getSigType().isSupply())
-        logger_->error(DRT,
-                       306,
-                       "Net {} of signal type {} cannot be connected to bterm "
-                       "{} with signal type {}",
-                       net->getName(),
-                       net->getSigType().getString(),
-                       term->getName(),
-                       term->getSigType().getString());
-      if (tmpBlock_->name2term_.find(term->getName())
-          == tmpBlock_->name2term_.end())
-        logger_->error(DRT, 104, "Terminal {} not found.", term->getName());
-      auto frbterm = tmpBlock_->name2term_[term->getName()];  // frBTerm*
-      frbterm->addToNet(netIn);
-      netIn->addBTerm(frbterm);
-      if (!is_special) {
-        // graph enablement
-        auto termNode = make_unique<frNode>();
-        termNode->setPin(frbterm);
-        termNode->setType(frNodeTypeEnum::frcPin);
-        netIn->addNode(termNode);
+                     net->getSigType().getString(),
+                     term->getName(),
+                     term->getSigType().getString());
+    if (block->name2term_.find(term->getName()) == block->name2term_.end())
+      logger_->error(DRT, 104, "Terminal {} not found.", term->getName());
+    auto frbterm = block->name2term_[term->getName()];  // frBTerm*
+    frbterm->addToNet(netIn);
+    netIn->addBTerm(frbterm);
+    if (!is_special) {
+      // graph enablement
+      auto termNode = make_unique<frNode>();
+      termNode->setPin(frbterm);
+      termNode->setType(frNodeTypeEnum::frcPin);
+      netIn->addNode(termNode);
+    }
+  }
+  for (auto term : net->getITerms()) {
+    if (term->getSigType().isSupply() && !net->getSigType().isSupply())
+      logger_->error(DRT,
+                     307,
+                     "Net {} of signal type {} cannot be connected to iterm "
+                     "{}/{} with signal type {}",
+                     net->getName(),
+                     net->getSigType().getString(),
+                     term->getInst()->getName(),
+                     term->getMTerm()->getName(),
+                     term->getSigType().getString());
+    if (block->name2inst_.find(term->getInst()->getName())
+        == block->name2inst_.end())
+      logger_->error(
+          DRT, 105, "Component {} not found.", term->getInst()->getName());
+    auto inst = block->name2inst_[term->getInst()->getName()];
+    // gettin inst term
+    auto frterm = inst->getMaster()->getTerm(term->getMTerm()->getName());
+    if (frterm == nullptr)
+      logger_->error(DRT,
+                     106,
+                     "Component pin {}/{} not found.",
+                     term->getInst()->getName(),
+                     term->getMTerm()->getName());
+    int idx = frterm->getIndexInOwner();
+    auto& instTerms = inst->getInstTerms();
+    auto instTerm = instTerms[idx].get();
+    assert(instTerm->getTerm()->getName() == term->getMTerm()->getName());
+
+    instTerm->addToNet(netIn);
+    netIn->addInstTerm(instTerm);
+    if (!is_special) {
+      // graph enablement
+      auto instTermNode = make_unique<frNode>();
+      instTermNode->setPin(instTerm);
+      instTermNode->setType(frNodeTypeEnum::frcPin);
+      netIn->addNode(instTermNode);
+    }
+  }
+  // initialize
+  string layerName = "";
+  string viaName = "";
+  string shape = "";
+  bool hasBeginPoint = false;
+  bool hasEndPoint = false;
+  frCoord beginX = -1;
+  frCoord beginY = -1;
+  frCoord beginExt = -1;
+  frCoord endX = -1;
+  frCoord endY = -1;
+  frCoord endExt = -1;
+  bool hasRect = false;
+  frCoord left = -1;
+  frCoord bottom = -1;
+  frCoord right = -1;
+  frCoord top = -1;
+  frCoord width = 0;
+  odb::dbWireDecoder decoder;
+
+  if (!net->isSpecial() && net->getWire() != nullptr) {
+    decoder.begin(net->getWire());
+    odb::dbWireDecoder::OpCode pathId = decoder.next();
+    while (pathId != odb::dbWireDecoder::END_DECODE) {
+      // for each path start
+      layerName = "";
+      viaName = "";
+      shape = "";
+      hasBeginPoint = false;
+      hasEndPoint = false;
+      beginX = -1;
+      beginY = -1;
+      beginExt = -1;
+      endX = -1;
+      endY = -1;
+      endExt = -1;
+      hasRect = false;
+      left = -1;
+      bottom = -1;
+      right = -1;
+      top = -1;
+      width = 0;
+      bool endpath = false;
+      do {
+        switch (pathId) {
+          case odb::dbWireDecoder::PATH:
+          case odb::dbWireDecoder::JUNCTION:
+          case odb::dbWireDecoder::SHORT:
+          case odb::dbWireDecoder::VWIRE:
+            layerName = decoder.getLayer()->getName();
+            if (tech_->name2layer.find(layerName) == tech_->name2layer.end())
+              logger_->error(DRT, 107, "Unsupported layer {}.", layerName);
+            break;
+          case odb::dbWireDecoder::POINT:
+
+            if (!hasBeginPoint) {
+              decoder.getPoint(beginX, beginY);
+              hasBeginPoint = true;
+            } else {
+              decoder.getPoint(endX, endY);
+              hasEndPoint = true;
+            }
+            break;
+          case odb::dbWireDecoder::POINT_EXT:
+            if (!hasBeginPoint) {
+              decoder.getPoint(beginX, beginY, beginExt);
+              hasBeginPoint = true;
+            } else {
+              decoder.getPoint(endX, endY, endExt);
+              hasEndPoint = true;
+            }
+            break;
+          case odb::dbWireDecoder::VIA:
+            viaName = string(decoder.getVia()->getName());
+            break;
+          case odb::dbWireDecoder::TECH_VIA:
+            viaName = string(decoder.getTechVia()->getName());
+            break;
+          case odb::dbWireDecoder::RECT:
+            decoder.getRect(left, bottom, right, top);
+            hasRect = true;
+            break;
+          case odb::dbWireDecoder::ITERM:
+          case odb::dbWireDecoder::BTERM:
+          case odb::dbWireDecoder::RULE:
+          case odb::dbWireDecoder::END_DECODE:
+            break;
+          default:
+            break;
+        }
+        pathId = decoder.next();
+        if ((int) pathId <= 3 || pathId == odb::dbWireDecoder::END_DECODE)
+          endpath = true;
+      } while (!endpath);
+      auto layerNum = tech_->name2layer[layerName]->getLayerNum();
+      if (hasRect) {
+        continue;
       }
-    }
-    for (auto term : net->getITerms()) {
-      if (term->getSigType().isSupply() && !net->getSigType().isSupply())
-        logger_->error(DRT,
-                       307,
-                       "Net {} of signal type {} cannot be connected to iterm "
-                       "{}/{} with signal type {}",
-                       net->getName(),
-                       net->getSigType().getString(),
-                       term->getInst()->getName(),
-                       term->getMTerm()->getName(),
-                       term->getSigType().getString());
-      if (tmpBlock_->name2inst_.find(term->getInst()->getName())
-          == tmpBlock_->name2inst_.end())
-        logger_->error(
-            DRT, 105, "Component {} not found.", term->getInst()->getName());
-      auto inst = tmpBlock_->name2inst_[term->getInst()->getName()];
-      // gettin inst term
-      auto frterm = inst->getMaster()->getTerm(term->getMTerm()->getName());
-      if (frterm == nullptr)
-        logger_->error(DRT,
-                       106,
-                       "Component pin {}/{} not found.",
-                       term->getInst()->getName(),
-                       term->getMTerm()->getName());
-      int idx = frterm->getIndexInOwner();
-      auto& instTerms = inst->getInstTerms();
-      auto instTerm = instTerms[idx].get();
-      assert(instTerm->getTerm()->getName() == term->getMTerm()->getName());
-
-      instTerm->addToNet(netIn);
-      netIn->addInstTerm(instTerm);
-      if (!is_special) {
-        // graph enablement
-        auto instTermNode = make_unique<frNode>();
-        instTermNode->setPin(instTerm);
-        instTermNode->setType(frNodeTypeEnum::frcPin);
-        netIn->addNode(instTermNode);
+      if (hasEndPoint) {
+        auto tmpP = make_unique<frPathSeg>();
+        if (beginX > endX || beginY > endY) {
+          tmpP->setPoints(Point(endX, endY), Point(beginX, beginY));
+          swap(beginExt, endExt);
+        } else {
+          tmpP->setPoints(Point(beginX, beginY), Point(endX, endY));
+        }
+        tmpP->addToNet(netIn);
+        tmpP->setLayerNum(layerNum);
+
+        width = (width) ? width : tech_->name2layer[layerName]->getWidth();
+        auto defaultBeginExt = width / 2;
+        auto defaultEndExt = width / 2;
+
+        frEndStyleEnum tmpBeginEnum;
+        if (beginExt == -1) {
+          tmpBeginEnum = frcExtendEndStyle;
+        } else if (beginExt == 0) {
+          tmpBeginEnum = frcTruncateEndStyle;
+        } else {
+          tmpBeginEnum = frcVariableEndStyle;
+        }
+        frEndStyle tmpBeginStyle(tmpBeginEnum);
+
+        frEndStyleEnum tmpEndEnum;
+        if (endExt == -1) {
+          tmpEndEnum = frcExtendEndStyle;
+        } else if (endExt == 0) {
+          tmpEndEnum = frcTruncateEndStyle;
+        } else {
+          tmpEndEnum = frcVariableEndStyle;
+        }
+        frEndStyle tmpEndStyle(tmpEndEnum);
+
+        frSegStyle tmpSegStyle;
+        tmpSegStyle.setWidth(width);
+        tmpSegStyle.setBeginStyle(
+            tmpBeginStyle,
+            tmpBeginEnum == frcExtendEndStyle ? defaultBeginExt : beginExt);
+        tmpSegStyle.setEndStyle(
+            tmpEndStyle,
+            tmpEndEnum == frcExtendEndStyle ? defaultEndExt : endExt);
+        tmpP->setStyle(tmpSegStyle);
+        netIn->addShape(std::move(tmpP));
       }
-    }
-    // initialize
-    string layerName = "";
-    string viaName = "";
-    string shape = "";
-    bool hasBeginPoint = false;
-    bool hasEndPoint = false;
-    frCoord beginX = -1;
-    frCoord beginY = -1;
-    frCoord beginExt = -1;
-    frCoord endX = -1;
-    frCoord endY = -1;
-    frCoord endExt = -1;
-    bool hasRect = false;
-    frCoord left = -1;
-    frCoord bottom = -1;
-    frCoord right = -1;
-    frCoord top = -1;
-    frCoord width = 0;
-    odb::dbWireDecoder decoder;
-
-    if (!net->isSpecial() && net->getWire() != nullptr) {
-      decoder.begin(net->getWire());
-      odb::dbWireDecoder::OpCode pathId = decoder.next();
-      while (pathId != odb::dbWireDecoder::END_DECODE) {
-        // for each path start
-        layerName = "";
-        viaName = "";
-        shape = "";
-        hasBeginPoint = false;
-        hasEndPoint = false;
-        beginX = -1;
-        beginY = -1;
-        beginExt = -1;
-        endX = -1;
-        endY = -1;
-        endExt = -1;
-        hasRect = false;
-        left = -1;
-        bottom = -1;
-        right = -1;
-        top = -1;
-        width = 0;
-        bool endpath = false;
-        do {
-          switch (pathId) {
-            case odb::dbWireDecoder::PATH:
-            case odb::dbWireDecoder::JUNCTION:
-            case odb::dbWireDecoder::SHORT:
-            case odb::dbWireDecoder::VWIRE:
-              layerName = decoder.getLayer()->getName();
-              if (tech_->name2layer.find(layerName) == tech_->name2layer.end())
-                logger_->error(DRT, 107, "Unsupported layer {}.", layerName);
-              break;
-            case odb::dbWireDecoder::POINT:
-
-              if (!hasBeginPoint) {
-                decoder.getPoint(beginX, beginY);
-                hasBeginPoint = true;
-              } else {
-                decoder.getPoint(endX, endY);
-                hasEndPoint = true;
-              }
-              break;
-            case odb::dbWireDecoder::POINT_EXT:
-              if (!hasBeginPoint) {
-                decoder.getPoint(beginX, beginY, beginExt);
-                hasBeginPoint = true;
-              } else {
-                decoder.getPoint(endX, endY, endExt);
-                hasEndPoint = true;
-              }
-              break;
-            case odb::dbWireDecoder::VIA:
-              viaName = string(decoder.getVia()->getName());
-              break;
-            case odb::dbWireDecoder::TECH_VIA:
-              viaName = string(decoder.getTechVia()->getName());
-              break;
-            case odb::dbWireDecoder::RECT:
-              decoder.getRect(left, bottom, right, top);
-              hasRect = true;
-              break;
-            case odb::dbWireDecoder::ITERM:
-            case odb::dbWireDecoder::BTERM:
-            case odb::dbWireDecoder::RULE:
-            case odb::dbWireDecoder::END_DECODE:
-              break;
-            default:
-              break;
+      if (viaName != "") {
+        if (tech_->name2via.find(viaName) == tech_->name2via.end()) {
+          logger_->error(DRT, 108, "Unsupported via in db.");
+        } else {
+          Point p;
+          if (hasEndPoint) {
+            p = {endX, endY};
+          } else {
+            p = {beginX, beginY};
           }
-          pathId = decoder.next();
-          if ((int) pathId <= 3 || pathId == odb::dbWireDecoder::END_DECODE)
-            endpath = true;
-        } while (!endpath);
-        auto layerNum = tech_->name2layer[layerName]->getLayerNum();
-        if (hasRect) {
-          continue;
+          auto viaDef = tech_->name2via[viaName];
+          auto tmpP = make_unique<frVia>(viaDef);
+          tmpP->setOrigin(p);
+          tmpP->addToNet(netIn);
+          netIn->addVia(std::move(tmpP));
         }
-        if (hasEndPoint) {
+      }
+      // for each path end
+    }
+  }
+  if (net->isSpecial()) {
+    for (auto swire : net->getSWires()) {
+      for (auto box : swire->getWires()) {
+        if (!box->isVia()) {
+          getSBoxCoords(box, beginX, beginY, endX, endY, width);
+          auto layerNum = tech_->name2layer[box->getTechLayer()->getName()]
+                              ->getLayerNum();
           auto tmpP = make_unique<frPathSeg>();
-          if (beginX > endX || beginY > endY) {
-            tmpP->setPoints(Point(endX, endY), Point(beginX, beginY));
-            swap(beginExt, endExt);
-          } else {
-            tmpP->setPoints(Point(beginX, beginY), Point(endX, endY));
-          }
+          tmpP->setPoints(Point(beginX, beginY), Point(endX, endY));
           tmpP->addToNet(netIn);
           tmpP->setLayerNum(layerNum);
-
           width = (width) ? width : tech_->name2layer[layerName]->getWidth();
-          auto defaultBeginExt = width / 2;
-          auto defaultEndExt = width / 2;
+          auto defaultExt = width / 2;
 
           frEndStyleEnum tmpBeginEnum;
-          if (beginExt == -1) {
+          if (box->getWireShapeType() == odb::dbWireShapeType::NONE) {
             tmpBeginEnum = frcExtendEndStyle;
-          } else if (beginExt == 0) {
-            tmpBeginEnum = frcTruncateEndStyle;
           } else {
-            tmpBeginEnum = frcVariableEndStyle;
+            tmpBeginEnum = frcTruncateEndStyle;
           }
           frEndStyle tmpBeginStyle(tmpBeginEnum);
-
           frEndStyleEnum tmpEndEnum;
-          if (endExt == -1) {
+          if (box->getWireShapeType() == odb::dbWireShapeType::NONE) {
             tmpEndEnum = frcExtendEndStyle;
-          } else if (endExt == 0) {
-            tmpEndEnum = frcTruncateEndStyle;
           } else {
-            tmpEndEnum = frcVariableEndStyle;
+            tmpEndEnum = frcTruncateEndStyle;
           }
           frEndStyle tmpEndStyle(tmpEndEnum);
 
@@ -719,23 +801,23 @@ void io::Parser::setNets(odb::dbBlock* block)
           tmpSegStyle.setWidth(width);
           tmpSegStyle.setBeginStyle(
               tmpBeginStyle,
-              tmpBeginEnum == frcExtendEndStyle ? defaultBeginExt : beginExt);
+              tmpBeginEnum == frcExtendEndStyle ? defaultExt : 0);
           tmpSegStyle.setEndStyle(
-              tmpEndStyle,
-              tmpEndEnum == frcExtendEndStyle ? defaultEndExt : endExt);
+              tmpEndStyle, tmpEndEnum == frcExtendEndStyle ? defaultExt : 0);
           tmpP->setStyle(tmpSegStyle);
           netIn->addShape(std::move(tmpP));
-        }
-        if (viaName != "") {
-          if (tech_->name2via.find(viaName) == tech_->name2via.end()) {
-            logger_->error(DRT, 108, "Unsupported via in db.");
-          } else {
-            Point p;
-            if (hasEndPoint) {
-              p = {endX, endY};
-            } else {
-              p = {beginX, beginY};
-            }
+        } else {
+          if (box->getTechVia())
+            viaName = box->getTechVia()->getName();
+          else if (box->getBlockVia())
+            viaName = box->getBlockVia()->getName();
+
+          if (tech_->name2via.find(viaName) == tech_->name2via.end())
+            logger_->error(DRT, 109, "Unsupported via in db.");
+          else {
+            int x, y;
+            box->getViaXY(x, y);
+            Point p(x, y);
             auto viaDef = tech_->name2via[viaName];
             auto tmpP = make_unique<frVia>(viaDef);
             tmpP->setOrigin(p);
@@ -743,77 +825,107 @@ void io::Parser::setNets(odb::dbBlock* block)
             netIn->addVia(std::move(tmpP));
           }
         }
-        // for each path end
       }
     }
-    if (net->isSpecial()) {
-      for (auto swire : net->getSWires()) {
-        for (auto box : swire->getWires()) {
-          if (!box->isVia()) {
-            getSBoxCoords(box, beginX, beginY, endX, endY, width);
-            auto layerNum = tech_->name2layer[box->getTechLayer()->getName()]
-                                ->getLayerNum();
-            auto tmpP = make_unique<frPathSeg>();
-            tmpP->setPoints(Point(beginX, beginY), Point(endX, endY));
-            tmpP->addToNet(netIn);
-            tmpP->setLayerNum(layerNum);
-            width = (width) ? width : tech_->name2layer[layerName]->getWidth();
-            auto defaultExt = width / 2;
+  }
+}
 
-            frEndStyleEnum tmpBeginEnum;
-            if (box->getWireShapeType() == odb::dbWireShapeType::NONE) {
-              tmpBeginEnum = frcExtendEndStyle;
-            } else {
-              tmpBeginEnum = frcTruncateEndStyle;
-            }
-            frEndStyle tmpBeginStyle(tmpBeginEnum);
-            frEndStyleEnum tmpEndEnum;
-            if (box->getWireShapeType() == odb::dbWireShapeType::NONE) {
-              tmpEndEnum = frcExtendEndStyle;
-            } else {
-              tmpEndEnum = frcTruncateEndStyle;
-            }
-            frEndStyle tmpEndStyle(tmpEndEnum);
-
-            frSegStyle tmpSegStyle;
-            tmpSegStyle.setWidth(width);
-            tmpSegStyle.setBeginStyle(
-                tmpBeginStyle,
-                tmpBeginEnum == frcExtendEndStyle ? defaultExt : 0);
-            tmpSegStyle.setEndStyle(
-                tmpEndStyle, tmpEndEnum == frcExtendEndStyle ? defaultExt : 0);
-            tmpP->setStyle(tmpSegStyle);
-            netIn->addShape(std::move(tmpP));
-          } else {
-            if (box->getTechVia())
-              viaName = box->getTechVia()->getName();
-            else if (box->getBlockVia())
-              viaName = box->getBlockVia()->getName();
-
-            if (tech_->name2via.find(viaName) == tech_->name2via.end())
-              logger_->error(DRT, 109, "Unsupported via in db.");
-            else {
-              int x, y;
-              box->getViaXY(x, y);
-              Point p(x, y);
-              auto viaDef = tech_->name2via[viaName];
-              auto tmpP = make_unique<frVia>(viaDef);
-              tmpP->setOrigin(p);
-              tmpP->addToNet(netIn);
-              netIn->addVia(std::move(tmpP));
-            }
-          }
-        }
-      }
+void io::Parser::updateDesign(const std::set<odb::dbInst*>& insts,
+                              const std::set<std::string>& nets)
+{
+  ProfileTask profile("IO:updateDesign");
+  frBlock* block = design_->getTopBlock();
+  odb::dbBlock* db_block = db_->getChip()->getBlock();
+  auto regionQuery = design_->getRegionQuery();
+
+  // continue the numbering of the objects already in the design
+  numInsts_ = block->getInsts().size();
+  for (auto& inst : block->getInsts()) {
+    for (auto& instTerm : inst->getInstTerms()) {
+      numTerms_ = std::max(numTerms_, instTerm->getId() + 1);
     }
-    netIn->setType(net->getSigType());
-    if (is_special)
-      tmpBlock_->addSNet(std::move(uNetIn));
-    else
-      tmpBlock_->addNet(std::move(uNetIn));
+    for (auto& instBlk : inst->getInstBlockages()) {
+      numBlockages_ = std::max(numBlockages_, instBlk->getId() + 1);
+    }
+  }
+  for (auto& term : block->getTerms()) {
+    numTerms_ = std::max(numTerms_, term->getId() + 1);
+  }
+  for (auto& blk : block->getBlockages()) {
+    numBlockages_ = std::max(numBlockages_, blk->getId() + 1);
   }
+
+  for (auto inst : insts) {
+    regionQuery->addBlockObj(setInst(block, inst));
+  }
+
+  for (const auto& name : nets) {
+    frNet* netIn = block->findNet(name);
+    if (netIn != nullptr) {
+      clearNet(netIn);
+    }
+    odb::dbNet* net = db_block->findNet(name.c_str());
+    if (net == nullptr) {
+      // destroyed in odb; the now empty frNet stays as others refer to it
+      continue;
+    }
+    if (netIn == nullptr) {
+      unique_ptr<frNet> uNetIn = createNet(net);
+      netIn = uNetIn.get();
+      if (net->isSpecial())
+        block->addSNet(std::move(uNetIn));
+      else
+        block->addNet(std::move(uNetIn));
+    }
+    setNet(block, net, netIn);
+    for (auto& shape : netIn->getShapes()) {
+      regionQuery->addDRObj(shape.get());
+    }
+    for (auto& via : netIn->getVias()) {
+      regionQuery->addDRObj(via.get());
+    }
+    netIn->setNeedsDbUpdate(false);
+  }
+
+  if (VERBOSE > 0) {
+    logger_->info(DRT,
+                  137,
+                  "Updated design with {} new instances and {} changed nets.",
+                  insts.size(),
+                  nets.size());
+  }
+}
+
+// Detaches the pins of net and drops its routing.
+void io::Parser::clearNet(frNet* net)
+{
+  auto regionQuery = design_->getRegionQuery();
+  const auto instTerms = net->getInstTerms();
+  for (auto instTerm : instTerms) {
+    instTerm->addToNet(nullptr);
+    net->removeInstTerm(instTerm);
+  }
+  const auto bterms = net->getBTerms();
+  for (auto bterm : bterms) {
+    bterm->addToNet(nullptr);
+    net->removeBTerm(bterm);
+  }
+  for (auto& shape : net->getShapes()) {
+    regionQuery->removeDRObj(shape.get());
+  }
+  for (auto& via : net->getVias()) {
+    regionQuery->removeDRObj(via.get());
+  }
+  for (auto& pwire : net->getPatchWires()) {
+    regionQuery->removeDRObj(pwire.get());
+  }
+  net->clearRouting();
 }
 
+// Property of a dbMaster holding the signature of each of its pin access
+// indices, one per line, so unchanged pin access can be reused by FlexPA.
+static const char* pin_access_signatures = "drt_pin_access_signatures";
+
 void updatefrAccessPoint(odb::dbAccessPoint* db_ap,
                          frAccessPoint* ap,
                          frTechObject* tech)
@@ -964,6 +1076,19 @@ void io::Parser::setAccessPoints(odb::dbDatabase* db)
         }
       }
     }
+    auto prop = odb::dbStringProperty::find(db_master, pin_access_signatures);
+    if (prop != nullptr) {
+      std::vector<std::string> signatures;
+      std::string value = prop->getValue();
+      size_t begin = 0;
+      size_t end;
+      while ((end = value.find('\n', begin)) != std::string::npos) {
+        signatures.push_back(value.substr(begin, end - begin));
+        begin = end + 1;
+      }
+      signatures.push_back(value.substr(begin));
+      master->setPinAccessSignatures(signatures);
+    }
   }
   for (auto db_inst : db->getChip()->getBlock()->getInsts()) {
     auto inst = tmpBlock_->findInst(db_inst->getName());
@@ -1016,6 +1141,13 @@ void io::Parser::readDesign(odb::dbDatabase* db)
   setBTerms(block);
   setAccessPoints(db);
   setNets(block);
+  // the imported routing is already in odb
+  for (auto& net : tmpBlock_->getNets()) {
+    net->setNeedsDbUpdate(false);
+  }
+  for (auto& net : tmpBlock_->getSNets()) {
+    net->setNeedsDbUpdate(false);
+  }
   tmpBlock_->setId(0);
   design_->setTopBlock(std::move(tmpBlock_));
   addFakeNets();
@@ -2758,7 +2890,15 @@ void io::Writer::fillConnFigs(bool isTA)
     logger_->info(DRT, 180, "Post processing.");
   }
   for (auto& net : getDesign()->getTopBlock()->getNets()) {
+    // the routing of untouched nets is already in odb
+    if (!isTA && !net->needsDbUpdate()) {
+      continue;
+    }
     fillConnFigs_net(net.get(), isTA);
+    // a net without routing has nothing to write back
+    if (!isTA && connFigs_.find(net->getName()) == connFigs_.end()) {
+      net->setNeedsDbUpdate(false);
+    }
   }
   if (isTA) {
     for (auto& it : connFigs_) {
@@ -2909,6 +3049,10 @@ void io::Writer::updateDbConn(odb::dbBlock* block, odb::dbTech* db_tech)
         }
       }
       _wire_encoder.end();
+      frNet* fr_net = getDesign()->getTopBlock()->findNet(net->getName());
+      if (fr_net != nullptr) {
+        fr_net->setNeedsDbUpdate(false);
+      }
     }
   }
 }
@@ -3010,6 +3154,19 @@ void io::Writer::updateDbAccessPoints(odb::dbBlock* block, odb::dbTech* db_tech)
         }
       }
     }
+    auto prop = odb::dbStringProperty::find(db_master, pin_access_signatures);
+    if (prop != nullptr) {
+      odb::dbProperty::destroy(prop);
+    }
+    const auto& signatures = master->getPinAccessSignatures();
+    if (!signatures.empty()) {
+      std::string value = signatures[0];
+      for (size_t i = 1; i < signatures.size(); i++) {
+        value += '\n' + signatures[i];
+      }
+      odb::dbStringProperty::create(
+          db_master, pin_access_signatures, value.c_str());
+    }
   }
   for (auto& inst : design_->getTopBlock()->getInsts()) {
     auto db_inst = block->findInst(inst->getName().c_str());
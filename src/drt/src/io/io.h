@@ -31,6 +31,8 @@
 #include <boost/icl/interval_set.hpp>
 #include <list>
 #include <memory>
+#include <set>
+#include <string>
 
 #include "frDesign.h"
 
@@ -38,6 +40,8 @@ namespace odb {
 class dbDatabase;
 class dbTechNonDefaultRule;
 class dbBlock;
+class dbInst;
+class dbNet;
 class dbTech;
 class dbSBox;
 class dbTechLayer;
@@ -65,6 +69,10 @@ class Parser
 
   // others
   void readDb();
+  // Applies the odb changes made since the design was read: adds the new
+  // instances and reloads the pins and routing of the given nets.
+  void updateDesign(const std::set<odb::dbInst*>& insts,
+                    const std::set<std::string>& nets);
   bool readGuide();
   void postProcess();
   void postProcessGuide();
@@ -85,10 +93,14 @@ class Parser
   void setDieArea(odb::dbBlock*);
   void setTracks(odb::dbBlock*);
   void setInsts(odb::dbBlock*);
+  frInst* setInst(frBlock* block, odb::dbInst* inst);
   void setObstructions(odb::dbBlock*);
   void setBTerms(odb::dbBlock*);
   void setVias(odb::dbBlock*);
   void setNets(odb::dbBlock*);
+  std::unique_ptr<frNet> createNet(odb::dbNet* net);
+  void setNet(frBlock* block, odb::dbNet* net, frNet* netIn);
+  void clearNet(frNet* net);
   void setAccessPoints(odb::dbDatabase*);
   void getSBoxCoords(odb::dbSBox*,
                      frCoord&,
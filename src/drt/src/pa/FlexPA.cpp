@@ -72,9 +72,7 @@ void FlexPA::init()
 {
   ProfileTask profile("PA:init");
   for (auto& master : design_->getMasters())
-    for (auto& term : master->getTerms())
-      for (auto& pin : term->getPins())
-        pin->clearPinAccess();
+    initPinAccessCache(master.get());
   for (auto& term : design_->getTopBlock()->getTerms())
     for (auto& pin : term->getPins())
       pin->clearPinAccess();
@@ -123,17 +121,26 @@ int FlexPA::main()
   if (VERBOSE > 0) {
     logger_->report("#scanned instances     = {}", inst2unique_.size());
     logger_->report("#unique  instances     = {}", uniqueInstances_.size());
-    logger_->report("#stdCellGenAp          = {}", stdCellPinGenApCnt_);
-    logger_->report("#stdCellValidPlanarAp  = {}", stdCellPinValidPlanarApCnt_);
-    logger_->report("#stdCellValidViaAp     = {}", stdCellPinValidViaApCnt_);
-    logger_->report("#stdCellPinNoAp        = {}", stdCellPinNoApCnt_);
+    logger_->report("#reused  instances     = {}", cachedUniqueInsts_.size());
+    logger_->report("#stdCellGenAp          = {}", stdCellPinGenApCnt_.load());
+    logger_->report("#stdCellValidPlanarAp  = {}",
+                    stdCellPinValidPlanarApCnt_.load());
+    logger_->report("#stdCellValidViaAp     = {}",
+                    stdCellPinValidViaApCnt_.load());
+    logger_->report("#stdCellPinNoAp        = {}", stdCellPinNoApCnt_.load());
     logger_->report("#stdCellPinCnt         = {}", stdCellPinCnt);
     logger_->report("#instTermValidViaApCnt = {}", instTermValidViaApCnt_);
-    logger_->report("#macroGenAp            = {}", macroCellPinGenApCnt_);
+    logger_->report("#macroGenAp            = {}",
+                    macroCellPinGenApCnt_.load());
     logger_->report("#macroValidPlanarAp    = {}",
-                    macroCellPinValidPlanarApCnt_);
-    logger_->report("#macroValidViaAp       = {}", macroCellPinValidViaApCnt_);
-    logger_->report("#macroNoAp             = {}", macroCellPinNoApCnt_);
+                    macroCellPinValidPlanarApCnt_.load());
+    logger_->report("#macroValidViaAp       = {}",
+                    macroCellPinValidViaApCnt_.load());
+    logger_->report("#macroNoAp             = {}", macroCellPinNoApCnt_.load());
+    logger_->metric("route__pin_access__unique_instances",
+                    uniqueInstances_.size());
+    logger_->metric("route__pin_access__reused_instances",
+                    cachedUniqueInsts_.size());
   }
 
   if (VERBOSE > 0) {
@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <boost/polygon/polygon.hpp>
 
 #include "frDesign.h"
@@ -75,15 +76,15 @@ class FlexPA
   std::unique_ptr<FlexPAGraphics> graphics_;
   std::string debugPinName_;
 
-  int stdCellPinGenApCnt_;
-  int stdCellPinValidPlanarApCnt_;
-  int stdCellPinValidViaApCnt_;
-  int stdCellPinNoApCnt_;
+  std::atomic<int> stdCellPinGenApCnt_;
+  std::atomic<int> stdCellPinValidPlanarApCnt_;
+  std::atomic<int> stdCellPinValidViaApCnt_;
+  std::atomic<int> stdCellPinNoApCnt_;
   int instTermValidViaApCnt_ = 0;
-  int macroCellPinGenApCnt_;
-  int macroCellPinValidPlanarApCnt_;
-  int macroCellPinValidViaApCnt_;
-  int macroCellPinNoApCnt_;
+  std::atomic<int> macroCellPinGenApCnt_;
+  std::atomic<int> macroCellPinValidPlanarApCnt_;
+  std::atomic<int> macroCellPinValidViaApCnt_;
+  std::atomic<int> macroCellPinNoApCnt_;
 
   std::vector<frInst*> uniqueInstances_;
   std::map<frInst*, frInst*, frBlockObjectComp> inst2unique_;
@@ -91,6 +92,15 @@ class FlexPA
   std::map<frInst*, int, frBlockObjectComp>
       unique2paidx_;  // unique instance to pinaccess index
   std::map<frInst*, int, frBlockObjectComp> unique2Idx_;
+  std::map<frInst*, std::string, frBlockObjectComp> unique2Signature_;
+  // pin accesses of the previous run by master and unique instance
+  // signature, one per master pin
+  std::map<frMaster*,
+           std::map<std::string, std::vector<std::unique_ptr<frPinAccess>>>,
+           frBlockObjectComp>
+      cachedPinAccess_;
+  // unique instances whose pin accesses were reused
+  std::set<frInst*, frBlockObjectComp> cachedUniqueInsts_;
   std::vector<std::vector<std::unique_ptr<FlexPinAccessPattern>>>
       uniqueInstPatterns_;
 
@@ -123,6 +133,10 @@ class FlexPA
                      frBlockObjectComp>& master2PinLayerRange,
       const std::vector<frTrackPattern*>& prefTrackPatterns);
   bool isNDRInst(frInst& inst);
+  void initUniqueInstance_signatures(
+      const std::vector<frTrackPattern*>& prefTrackPatterns);
+  void initPinAccessCache(frMaster* master);
+  std::vector<std::unique_ptr<frPinAccess>> getCachedPinAccess(frInst* inst);
   void initPinAccess();
   void initTrackCoords();
   void initViaRawPriority();
@@ -37,6 +37,101 @@
 using namespace std;
 using namespace fr;
 
+namespace {
+// FNV-1a, which unlike std::hash is stable across runs and builds.
+class SignatureHash
+{
+ public:
+  void add(int64_t value)
+  {
+    for (int i = 0; i < 8; i++) {
+      hash_ = (hash_ ^ ((value >> (i * 8)) & 0xff)) * 1099511628211ULL;
+    }
+  }
+  void add(const std::string& value)
+  {
+    for (unsigned char c : value) {
+      hash_ = (hash_ ^ c) * 1099511628211ULL;
+    }
+    add(value.size());
+  }
+  void add(const Rect& box)
+  {
+    add(box.xMin());
+    add(box.yMin());
+    add(box.xMax());
+    add(box.yMax());
+  }
+  void add(const frPin* pin)
+  {
+    for (auto& fig : pin->getFigs()) {
+      auto shape = static_cast<frShape*>(fig.get());
+      add(shape->getLayerNum());
+      add(shape->getBBox());
+      if (shape->typeId() == frcPolygon) {
+        for (const Point& pt : static_cast<frPolygon*>(shape)->getPoints()) {
+          add(pt.x());
+          add(pt.y());
+        }
+      }
+    }
+  }
+  void add(const frShape* shape)
+  {
+    add(shape->getLayerNum());
+    add(shape->getBBox());
+  }
+  void add(frConstraint* con)
+  {
+    add((int) con->typeId());
+    switch (con->typeId()) {
+      case frConstraintTypeEnum::frcSpacingConstraint:
+        add(static_cast<frSpacingConstraint*>(con)->getMinSpacing());
+        break;
+      case frConstraintTypeEnum::frcMinWidthConstraint:
+        add(static_cast<frMinWidthConstraint*>(con)->getMinWidth());
+        break;
+      case frConstraintTypeEnum::frcAreaConstraint:
+        add(static_cast<frAreaConstraint*>(con)->getMinArea());
+        break;
+      case frConstraintTypeEnum::frcMinStepConstraint: {
+        auto minStep = static_cast<frMinStepConstraint*>(con);
+        add(minStep->getMinStepLength());
+        add(minStep->getMaxEdges());
+        break;
+      }
+      default:
+        break;
+    }
+  }
+  uint64_t get() const { return hash_; }
+
+ private:
+  uint64_t hash_ = 14695981039346656037ULL;
+};
+
+// The layer rules of the technology the access points are checked against.
+uint64_t getTechSignature(const frTechObject* tech)
+{
+  SignatureHash hash;
+  hash.add(tech->getDBUPerUU());
+  hash.add(tech->getManufacturingGrid());
+  for (auto& layer : tech->getLayers()) {
+    hash.add(layer->getName());
+    hash.add(layer->getType().getValue());
+    hash.add(layer->getDir().getValue());
+    hash.add(layer->getWidth());
+    hash.add(layer->getMinWidth());
+    hash.add(layer->getPitch());
+    hash.add(layer->isUnidirectional());
+    for (auto con : layer->getConstraints()) {
+      hash.add(con);
+    }
+  }
+  return hash.get();
+}
+}  // namespace
+
 void FlexPA::getPrefTrackPatterns(vector<frTrackPattern*>& prefTrackPatterns)
 {
   for (auto& trackPattern : design_->getTopBlock()->getTrackPatterns()) {
@@ -223,6 +318,140 @@ void FlexPA::initUniqueInstance()
   initUniqueInstance_master2PinLayerRange(master2PinLayerRange);
 
   initUniqueInstance_main(master2PinLayerRange, prefTrackPatterns);
+  initUniqueInstance_signatures(prefTrackPatterns);
+}
+
+// The access points of a unique instance depend on its master, orientation
+// and track offsets, on the technology rules, on the tracks and access vias
+// of the design and on the pin access settings. Access points of a previous
+// run are reused for a unique instance only if all of these hash to the same
+// signature.
+void FlexPA::initUniqueInstance_signatures(
+    const vector<frTrackPattern*>& prefTrackPatterns)
+{
+  SignatureHash context;
+  for (auto tp : prefTrackPatterns) {
+    context.add(tp->getLayerNum());
+    context.add(tp->isHorizontal());
+    context.add(tp->getStartCoord());
+    context.add(tp->getNumTracks());
+    context.add(tp->getTrackSpacing());
+  }
+  for (auto& [layerNum, cutNum2ViaDefs] : layerNum2ViaDefs_) {
+    for (auto& [cutNum, viaDefs] : cutNum2ViaDefs) {
+      for (auto& [priority, viaDef] : viaDefs) {
+        context.add(layerNum);
+        context.add(cutNum);
+        context.add(viaDef->getName());
+        for (auto& fig : viaDef->getLayer1Figs()) {
+          context.add(fig.get());
+        }
+        for (auto& fig : viaDef->getCutFigs()) {
+          context.add(fig.get());
+        }
+        for (auto& fig : viaDef->getLayer2Figs()) {
+          context.add(fig.get());
+        }
+      }
+    }
+  }
+  context.add(getTech()->getLayers().size());
+  context.add(VIAINPIN_BOTTOMLAYERNUM);
+  context.add(VIAINPIN_TOPLAYERNUM);
+  context.add(VIA_ACCESS_LAYERNUM);
+  context.add(MINNUMACCESSPOINT_STDCELLPIN);
+  context.add(MINNUMACCESSPOINT_MACROCELLPIN);
+
+  const uint64_t techSignature = getTechSignature(getTech());
+
+  for (auto& [master, orientMap] : masterOT2Insts) {
+    SignatureHash masterHash;
+    masterHash.add(master->getMasterType().getValue());
+    masterHash.add(master->getBBox());
+    for (auto& term : master->getTerms()) {
+      masterHash.add(term->getName());
+      for (auto& pin : term->getPins()) {
+        masterHash.add(pin.get());
+      }
+    }
+    for (auto& blk : master->getBlockages()) {
+      masterHash.add(blk->getPin());
+    }
+    for (auto& [orient, offsetMap] : orientMap) {
+      for (auto& [offsets, insts] : offsetMap) {
+        string signature = fmt::format("{:016x}{:016x}{:016x} {}",
+                                       techSignature,
+                                       context.get(),
+                                       masterHash.get(),
+                                       orient.getString());
+        for (frCoord offset : offsets) {
+          signature += fmt::format(" {}", offset);
+        }
+        unique2Signature_[*(insts.begin())] = signature;
+      }
+    }
+  }
+}
+
+// Moves the pin accesses of the previous run out of the master's pins.
+void FlexPA::initPinAccessCache(frMaster* master)
+{
+  const vector<string> signatures = master->getPinAccessSignatures();
+  master->setPinAccessSignatures({});
+  vector<vector<unique_ptr<frPinAccess>>> pinAccesses;
+  bool valid = !signatures.empty();
+  for (auto& term : master->getTerms()) {
+    for (auto& pin : term->getPins()) {
+      pinAccesses.push_back(pin->releasePinAccess());
+      valid &= pinAccesses.back().size() == signatures.size();
+    }
+  }
+  if (!valid) {
+    return;
+  }
+  auto& cache = cachedPinAccess_[master];
+  for (size_t idx = 0; idx < signatures.size(); idx++) {
+    if (signatures[idx].empty()) {
+      continue;
+    }
+    auto& pas = cache[signatures[idx]];
+    for (auto& pinAccess : pinAccesses) {
+      pas.push_back(std::move(pinAccess[idx]));
+    }
+  }
+}
+
+// Returns the cached pin accesses of the unique instance, one per master pin,
+// or nothing if they have to be computed.
+vector<unique_ptr<frPinAccess>> FlexPA::getCachedPinAccess(frInst* inst)
+{
+  auto sigIt = unique2Signature_.find(inst);
+  if (sigIt == unique2Signature_.end()) {
+    return {};
+  }
+  auto masterIt = cachedPinAccess_.find(inst->getMaster());
+  if (masterIt == cachedPinAccess_.end()) {
+    return {};
+  }
+  auto it = masterIt->second.find(sigIt->second);
+  if (it == masterIt->second.end()) {
+    return {};
+  }
+  vector<unique_ptr<frPinAccess>> pas = std::move(it->second);
+  masterIt->second.erase(it);
+  // terms skipped by the previous run may need access points now
+  size_t pinIdx = 0;
+  for (auto& instTerm : inst->getInstTerms()) {
+    int nAps = 0;
+    for (size_t i = 0; i < instTerm->getTerm()->getPins().size(); i++) {
+      nAps += pas[pinIdx++]->getNumAccessPoints();
+    }
+    if (nAps == 0 && !instTerm->getTerm()->getPins().empty()
+        && !isSkipInstTerm(instTerm.get())) {
+      return {};
+    }
+  }
+  return pas;
 }
 
 void FlexPA::checkFigsOnGrid(const frMPin* pin)
@@ -259,7 +488,10 @@ void FlexPA::checkFigsOnGrid(const frMPin* pin)
 
 void FlexPA::initPinAccess()
 {
+  map<frMaster*, vector<string>, frBlockObjectComp> signatures;
   for (auto& inst : uniqueInstances_) {
+    auto cachedPinAccess = getCachedPinAccess(inst);
+    int pinIdx = 0;
     for (auto& instTerm : inst->getInstTerms()) {
       for (auto& pin : instTerm->getTerm()->getPins()) {
         if (unique2paidx_.find(inst) == unique2paidx_.end()) {
@@ -271,12 +503,31 @@ void FlexPA::initPinAccess()
           }
         }
         checkFigsOnGrid(pin.get());
-        auto pa = make_unique<frPinAccess>();
-        pin->addPinAccess(std::move(pa));
+        if (cachedPinAccess.empty()) {
+          auto pa = make_unique<frPinAccess>();
+          pin->addPinAccess(std::move(pa));
+        } else {
+          pin->addPinAccess(std::move(cachedPinAccess[pinIdx++]));
+        }
       }
     }
+    if (pinIdx > 0) {
+      cachedUniqueInsts_.insert(inst);
+    }
     inst->setPinAccessIdx(unique2paidx_[inst]);
+    auto it = unique2paidx_.find(inst);
+    if (it != unique2paidx_.end()) {
+      auto& masterSignatures = signatures[inst->getMaster()];
+      if ((int) masterSignatures.size() <= it->second) {
+        masterSignatures.resize(it->second + 1);
+      }
+      masterSignatures[it->second] = unique2Signature_[inst];
+    }
+  }
+  for (auto& [master, masterSignatures] : signatures) {
+    master->setPinAccessSignatures(masterSignatures);
   }
+  cachedPinAccess_.clear();
   for (auto& [inst, uniqueInst] : inst2unique_) {
     inst->setPinAccessIdx(uniqueInst->getPinAccessIdx());
   }
@@ -26,10 +26,9 @@
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
-#include <omp.h>
-
 #include <chrono>
 #include <iostream>
+#include <mutex>
 #include <sstream>
 
 #include "FlexPA.h"
@@ -1188,21 +1187,17 @@ void FlexPA::prepPoint_pin_updateStat(
     if (ap->hasAccess(frDirEnum::W) || ap->hasAccess(frDirEnum::E)
         || ap->hasAccess(frDirEnum::S) || ap->hasAccess(frDirEnum::N)) {
       if (isStdCellPin) {
-#pragma omp atomic
         stdCellPinValidPlanarApCnt_++;
       }
       if (isMacroCellPin) {
-#pragma omp atomic
         macroCellPinValidPlanarApCnt_++;
       }
     }
     if (ap->hasAccess(frDirEnum::U)) {
       if (isStdCellPin) {
-#pragma omp atomic
         stdCellPinValidViaApCnt_++;
       }
       if (isMacroCellPin) {
-#pragma omp atomic
         macroCellPinValidViaApCnt_++;
       }
     }
@@ -1239,11 +1234,9 @@ bool FlexPA::prepPoint_pin_helper(
       tmpAps, apset, pin, instTerm, pinShapes, lowerType, upperType);
   prepPoint_pin_checkPoints(tmpAps, pinShapes, pin, instTerm);
   if (isStdCellPin) {
-#pragma omp atomic
     stdCellPinGenApCnt_ += tmpAps.size();
   }
   if (isMacroCellPin) {
-#pragma omp atomic
     macroCellPinGenApCnt_ += tmpAps.size();
   }
   if (graphics_) {
@@ -1399,10 +1392,9 @@ void FlexPA::prepPoint()
   ProfileTask profile("PA:point");
   int cnt = 0;
 
-  omp_set_num_threads(MAX_THREADS);
   ThreadException exception;
-#pragma omp parallel for schedule(dynamic)
-  for (int i = 0; i < (int) uniqueInstances_.size(); i++) {
+  std::mutex cnt_mutex;
+  parallelFor(0, uniqueInstances_.size(), MAX_THREADS, [&](int i) {
     try {
       auto& inst = uniqueInstances_[i];
       // only do for core and block cells
@@ -1413,7 +1405,11 @@ void FlexPA::prepPoint()
           && masterType != dbMasterType::CORE_ANTENNACELL
           && !masterType.isBlock() && !masterType.isPad()
           && masterType != dbMasterType::RING) {
-        continue;
+        return;
+      }
+      // access points reused from the previous run
+      if (cachedUniqueInsts_.find(inst) != cachedUniqueInsts_.end()) {
+        return;
       }
       ProfileTask profile("PA:uniqueInstance");
       for (auto& instTerm : inst->getInstTerms()) {
@@ -1432,8 +1428,8 @@ void FlexPA::prepPoint()
                          instTerm->getInst()->getName(),
                          instTerm->getTerm()->getName());
         }
-#pragma omp critical
         {
+          std::lock_guard<std::mutex> lock(cnt_mutex);
           cnt++;
           if (VERBOSE > 0) {
             if (cnt < 1000) {
@@ -1451,24 +1447,22 @@ void FlexPA::prepPoint()
     } catch (...) {
       exception.capture();
     }
-  }
+  });
   exception.rethrow();
 
   // cout << "PA for IO terms\n" << flush;
 
   // PA for IO terms
   if (target_insts_.empty()) {
-    omp_set_num_threads(MAX_THREADS);
-#pragma omp parallel for schedule(dynamic)
-    for (unsigned i = 0; i < getDesign()->getTopBlock()->getTerms().size();
-         i++) {
+    const int numTerms = getDesign()->getTopBlock()->getTerms().size();
+    parallelFor(0, numTerms, MAX_THREADS, [&](int i) {
       try {
         auto& term = getDesign()->getTopBlock()->getTerms()[i];
         if (term.get()->getType().isSupply()) {
-          continue;
+          return;
         }
         if (term->getNet() == nullptr) {
-          continue;
+          return;
         }
         int nAps = 0;
         for (auto& pin : term->getPins()) {
@@ -1481,7 +1475,7 @@ void FlexPA::prepPoint()
       } catch (...) {
         exception.capture();
       }
-    }
+    });
     exception.rethrow();
   }
 
@@ -1499,12 +1493,10 @@ void FlexPA::prepPattern()
 
   int cnt = 0;
 
-  omp_set_num_threads(MAX_THREADS);
   ThreadException exception;
-#pragma omp parallel for schedule(dynamic)
-  for (int currUniqueInstIdx = 0;
-       currUniqueInstIdx < (int) uniqueInstances_.size();
-       currUniqueInstIdx++) {
+  std::mutex cnt_mutex;
+  const int numUniqueInsts = uniqueInstances_.size();
+  parallelFor(0, numUniqueInsts, MAX_THREADS, [&](int currUniqueInstIdx) {
     try {
       auto& inst = uniqueInstances_[currUniqueInstIdx];
       // only do for core and block cells
@@ -1515,7 +1507,7 @@ void FlexPA::prepPattern()
           && masterType != dbMasterType::CORE_TIEHIGH
           && masterType != dbMasterType::CORE_TIELOW
           && masterType != dbMasterType::CORE_ANTENNACELL) {
-        continue;
+        return;
       }
 
       int numValidPattern = prepPattern_inst(inst, currUniqueInstIdx, 1.0);
@@ -1533,8 +1525,8 @@ void FlexPA::prepPattern()
               inst->getMaster()->getName());
         }
       }
-#pragma omp critical
       {
+        std::lock_guard<std::mutex> lock(cnt_mutex);
         cnt++;
         if (VERBOSE > 0) {
           if (cnt < 1000) {
@@ -1553,7 +1545,7 @@ void FlexPA::prepPattern()
     } catch (...) {
       exception.capture();
     }
-  }
+  });
   exception.rethrow();
   if (VERBOSE > 0) {
     logger_->info(DRT, 81, "  Complete {} unique inst patterns.", cnt);
@@ -1604,14 +1596,12 @@ void FlexPA::prepPattern()
   int rowIdx = 0;
   cnt = 0;
   // for (auto &instRow: instRows) {
-  omp_set_num_threads(MAX_THREADS);
-#pragma omp parallel for schedule(dynamic)
-  for (int i = 0; i < (int) instRows.size(); i++) {
+  parallelFor(0, instRows.size(), MAX_THREADS, [&](int i) {
     try {
       auto& instRow = instRows[i];
       genInstRowPattern(instRow);
-#pragma omp critical
       {
+        std::lock_guard<std::mutex> lock(cnt_mutex);
         rowIdx++;
         cnt++;
         if (VERBOSE > 0) {
@@ -1629,7 +1619,7 @@ void FlexPA::prepPattern()
     } catch (...) {
       exception.capture();
     }
-  }
+  });
   exception.rethrow();
   if (VERBOSE > 0) {
     logger_->info(DRT, 84, "  Complete {} groups.", cnt);
@@ -1639,6 +1629,10 @@ void FlexPA::prepPattern()
 void FlexPA::revertAccessPoints()
 {
   for (auto& inst : uniqueInstances_) {
+    // cached access points are already relative to the instance
+    if (cachedUniqueInsts_.find(inst) != cachedUniqueInsts_.end()) {
+      continue;
+    }
     dbTransform xform = inst->getTransform();
     Point offset(xform.getOffset());
     dbTransform revertXform;
@@ -28,11 +28,10 @@
 
 #include "FlexTA.h"
 
-#include <omp.h>
-
 #include <algorithm>
 #include <chrono>
 #include <iostream>
+#include <mutex>
 #include <sstream>
 
 #include "FlexTA_graphics.h"
@@ -162,25 +161,24 @@ int FlexTA::initTA_helper(int iter,
     }
   }
 
-  omp_set_num_threads(min(8, MAX_THREADS));
   // parallel execution
   // multi thread
   for (auto& workerBatch : workers) {
     ProfileTask profile("TA:batch");
     ThreadException exception;
-#pragma omp parallel for schedule(dynamic)
-    for (int i = 0; i < (int) workerBatch.size(); i++) {
+    std::mutex sol_mutex;
+    parallelFor(0, workerBatch.size(), min(8, MAX_THREADS), [&](int i) {
       try {
         workerBatch[i]->main_mt();
-#pragma omp critical
         {
+          std::lock_guard<std::mutex> lock(sol_mutex);
           sol += workerBatch[i]->getNumAssigned();
           numPanels++;
         }
       } catch (...) {
         exception.capture();
       }
-    }
+    });
     exception.rethrow();
     for (int i = 0; i < (int) workerBatch.size(); i++) {
       workerBatch[i]->end();
@@ -0,0 +1,56 @@
+# Route, make an ECO in odb and route again on the incrementally updated
+# router design.
+source "helpers.tcl"
+
+read_lef Nangate45/Nangate45_tech.lef
+read_lef Nangate45/Nangate45_stdcell.lef
+read_def gcd_nangate45_preroute.def
+read_guides gcd_nangate45.route_guide
+
+detailed_route -verbose 0
+
+set block [ord::get_db_block]
+
+# Replace a filler with a new buffer.
+odb::dbInst_destroy [$block findInst FILLER_10_145]
+set buf [odb::dbInst_create $block [[ord::get_db] findMaster BUF_X1] eco_buf]
+$buf setLocation 75240 50400
+$buf setPlacementStatus PLACED
+
+# Reconnect an instance pin.
+set iterm [[$block findInst _672_] findITerm D]
+set net [$iterm getNet]
+$iterm disconnect
+$iterm connect $net
+
+# Move a filler into the rest of the freed space.
+[$block findInst FILLER_10_153] setLocation 76760 50400
+
+detailed_route -verbose 0
+
+if { [detailed_route_num_drvs] != 0 } {
+  puts "fail: [detailed_route_num_drvs] violations after the ECO"
+  exit 1
+}
+
+# The router design, kept up to date from the odb callbacks, must check the
+# same as a fresh import of the block.
+set incremental_rpt [make_result_file incremental_eco.rpt]
+check_drc -output_file $incremental_rpt
+
+# An obstruction edit makes the router re-import the whole block.
+set layer [[ord::get_db_tech] findLayer metal10]
+odb::dbObstruction_destroy [odb::dbObstruction_create $block $layer 0 0 100 100]
+set fresh_rpt [make_result_file incremental_eco_fresh.rpt]
+check_drc -output_file $fresh_rpt
+
+if { [diff_files $incremental_rpt $fresh_rpt] } {
+  puts "fail: the routed ECO differs from a fresh import"
+  exit 1
+}
+if { [file size $fresh_rpt] != 0 } {
+  puts "fail: a fresh import of the routed ECO has violations"
+  exit 1
+}
+
+puts "pass"
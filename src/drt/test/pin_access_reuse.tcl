@@ -0,0 +1,68 @@
+# A second pin_access on an unchanged design reuses the access points of
+# the first; a third one after a tech rule change must not reuse them.
+source "helpers.tcl"
+
+read_lef Nangate45/Nangate45_tech.lef
+read_lef Nangate45/Nangate45_stdcell.lef
+read_def gcd_nangate45_preroute.def
+
+proc access_points {} {
+  set points {}
+  foreach inst [[ord::get_db_block] getInsts] {
+    foreach iterm [$inst getITerms] {
+      foreach ap [$iterm getPrefAccessPoints] {
+        lappend points [list [$iterm getName] [$ap getPoint] \
+                          [[$ap getLayer] getName]]
+      }
+    }
+  }
+  return $points
+}
+
+set metrics_file [make_result_file pin_access_reuse.json]
+utl::open_metrics $metrics_file
+
+utl::set_metrics_stage "first__{}"
+pin_access
+set first_points [access_points]
+
+utl::set_metrics_stage "second__{}"
+pin_access
+set second_points [access_points]
+
+set metal1 [[ord::get_db_tech] findLayer metal1]
+$metal1 setWidth [expr [$metal1 getWidth] + 10]
+utl::set_metrics_stage "third__{}"
+pin_access
+
+utl::clear_metrics_stage
+utl::close_metrics $metrics_file
+
+set stream [open $metrics_file r]
+set metrics [read $stream]
+close $stream
+foreach run {first second third} {
+  foreach count {unique reused} {
+    regexp "\"${run}__route__pin_access__${count}_instances\": (\\d+)" \
+      $metrics match ${run}_${count}
+  }
+}
+
+if { $first_reused != 0 } {
+  puts "fail: the first run reused $first_reused instances"
+  exit 1
+}
+if { $second_reused != $second_unique } {
+  puts "fail: reused $second_reused of $second_unique unique instances"
+  exit 1
+}
+if { $third_reused != 0 } {
+  puts "fail: reused $third_reused instances after the metal1 width changed"
+  exit 1
+}
+if { [llength $first_points] == 0 || $first_points != $second_points } {
+  puts "fail: the reused access points differ"
+  exit 1
+}
+
+puts "pass"
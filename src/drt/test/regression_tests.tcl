@@ -6,4 +6,6 @@ record_tests {
 }
 record_pass_fail_tests {
   gc_test
+  incremental_eco
+  pin_access_reuse
 }
@@ -36,6 +36,7 @@
 #include "odb/db.h"
 
 namespace utl {
+class Executor;
 class Logger;
 }
 
@@ -50,7 +51,7 @@ class Finale
  public:
   Finale();
 
-  void init(odb::dbDatabase* db, Logger* logger);
+  void init(odb::dbDatabase* db, Logger* logger, utl::Executor* executor);
 
   void densityFill(const char* rules_filename, const odb::Rect& fill_area);
 
@@ -59,6 +60,7 @@ class Finale
  private:
   odb::dbDatabase* db_;
   Logger* logger_;
+  utl::Executor* executor_;
   bool debug_;
 };
 
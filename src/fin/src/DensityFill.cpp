@@ -38,6 +38,7 @@
 
 #include "graphics.h"
 #include "odb/dbShape.h"
+#include "utl/Executor.h"
 
 namespace fin {
 
@@ -69,6 +70,22 @@ struct DensityFillLayerConfig
   DensityFillShapesConfig non_opc;
 };
 
+// A fill shape computed by a tile before it is added to the block
+struct FillShape
+{
+  Rect rect;
+  int mask;
+};
+
+// The fills of one tile on one layer
+struct TileFills
+{
+  int non_opc_areas = 0;
+  int opc_areas = 0;
+  std::vector<FillShape> non_opc;
+  std::vector<FillShape> opc;
+};
+
 // Make a boost polygon representing a rectangle
 static Polygon90 makeRect(int x_lo, int y_lo, int x_hi, int y_hi)
 {
@@ -105,6 +122,11 @@ DensityFill::~DensityFill()  // must be in the .cpp due to forward decl
 {
 }
 
+void DensityFill::setExecutor(utl::Executor* executor)
+{
+  executor_ = executor;
+}
+
 // Converts the user's JSON configuration file in per layer
 // DensityFillLayerConfig objects.
 //
@@ -204,10 +226,10 @@ void DensityFill::loadConfig(const char* cfg_filename, dbTech* tech)
   readAndExpandLayers(tech, tree);
 }
 
-// Insert into polygon_set any part of given shape on the given layer (shape may
+// Insert into shapes any part of given shape on the given layer (shape may
 // be a via)
 static void insertShape(const dbShape& shape,
-                        Polygon90Set& polygon_set,
+                        std::vector<Rect>& shapes,
                         dbTechLayer* layer)
 {
   auto type = shape.getType();
@@ -233,34 +255,31 @@ static void insertShape(const dbShape& shape,
       dbShape::getViaBoxes(shape, boxes);
       for (auto& box : boxes) {
         if (box.getTechLayer() == layer) {
-          polygon_set.insert(
-              makeRect(box.xMin(), box.yMin(), box.xMax(), box.yMax()));
+          shapes.push_back(box.getBox());
         }
       }
       break;
     }
     case dbShape::SEGMENT:
       if (shape.getTechLayer() == layer) {
-        polygon_set.insert(
-            makeRect(shape.xMin(), shape.yMin(), shape.xMax(), shape.yMax()));
+        shapes.push_back(shape.getBox());
       }
       break;
     case dbShape::TECH_VIA_BOX:
     case dbShape::VIA_BOX:
       if (shape.getTechLayer() == layer) {
-        polygon_set.insert(
-            makeRect(shape.xMin(), shape.yMin(), shape.xMax(), shape.yMax()));
+        shapes.push_back(shape.getBox());
       }
       break;
   }
 }
 
-// Build a polygon set out of all the non-fill shape on the given layer
-// including wires, special wires, and instances' pins & OBS
-static Polygon90Set orNonFills(dbBlock* block, dbTechLayer* layer)
+// Collect all the non-fill shapes on the given layer including wires,
+// special wires, and instances' pins & OBS
+static std::vector<Rect> getNonFills(dbBlock* block, dbTechLayer* layer)
 {
-  Polygon90Set non_fill;  // The result
-  dbShape shape;          // Shared temp
+  std::vector<Rect> non_fill;  // The result
+  dbShape shape;               // Shared temp
 
   // Get shapes from regular wires
   dbWireShapeItr shapes;
@@ -288,8 +307,7 @@ static Polygon90Set orNonFills(dbBlock* block, dbTechLayer* layer)
             insertShape(via_shape, non_fill, layer);
           }
         } else if (sbox->getTechLayer() == layer) {
-          non_fill.insert(
-              makeRect(sbox->xMin(), sbox->yMin(), sbox->xMax(), sbox->yMax()));
+          non_fill.push_back(sbox->getBox());
         }
       }
     }
@@ -343,15 +361,14 @@ static void prune(Polygon90Set& fill_area,
 }
 
 // Fill a polygon (area) on the given layer using the given configuration.
-// Num_masks is used to color the generated fills.
+// Num_masks is used to color the generated fills, which are appended to fills.
 // filled_area, if given, is an OR of the generated fills without bloating
 static void fillPolygon(const Polygon90& area,
                         dbTechLayer* layer,
-                        dbBlock* block,
                         const DensityFillShapesConfig& cfg,
                         int num_masks,
-                        bool needs_opc,
                         Graphics* graphics,
+                        std::vector<FillShape>& fills,
                         Polygon90Set* filled_area = nullptr)
 {
   // Convert the area polygon to a polygon set as we will remove areas
@@ -410,15 +427,15 @@ static void fillPolygon(const Polygon90& area,
       }
 
       // Intersect fills with the sub area and keep only whole fill shapes
-      Polygon90Set fills = all_fills & sub_fill_area;
-      keep(fills, w * h, w * h, w - 1, w, h - 1, h);
+      Polygon90Set sub_fills = all_fills & sub_fill_area;
+      keep(sub_fills, w * h, w * h, w - 1, w, h - 1, h);
 
-      Polygon90Set tmp_fills(fills);
+      Polygon90Set tmp_fills(sub_fills);
       all_iter_fills += bloat(tmp_fills, space_x, space_x, space_y, space_y);
 
-      // Insert fills into the db
+      // Collect the fills; they are inserted into the db by the caller
       std::vector<Rectangle> polygons;
-      fills.get_rectangles(polygons);
+      sub_fills.get_rectangles(polygons);
       const int num_mask = std::max(num_masks, 1);
       int cnt = 0;
       for (auto& f : polygons) {
@@ -427,7 +444,7 @@ static void fillPolygon(const Polygon90& area,
         auto y_lo = yl(f);
         auto x_hi = xh(f);
         auto y_hi = yh(f);
-        dbFill::create(block, needs_opc, mask, layer, x_lo, y_lo, x_hi, y_hi);
+        fills.push_back({Rect(x_lo, y_lo, x_hi, y_hi), mask});
         if (filled_area) {
           *filled_area += makeRect(x_lo, y_lo, x_hi, y_hi);
         }
@@ -438,50 +455,64 @@ static void fillPolygon(const Polygon90& area,
   }
 }
 
-// Fill the given layer
-void DensityFill::fillLayer(dbBlock* block,
-                            dbTechLayer* layer,
-                            const odb::Rect& fill_bounds_rect)
+// Integer division rounding down
+static int floorDiv(int num, int den)
 {
-  logger_->info(FIN, 3, "Filling layer {}.", layer->getConstName());
+  return num >= 0 ? num / den : -((-num + den - 1) / den);
+}
 
-  Polygon90Set non_fill = orNonFills(block, layer);
+// Integer division rounding up for a non-negative num
+static int ceilDiv(int num, int den)
+{
+  return (num + den - 1) / den;
+}
+
+// Fill one tile of a layer.  fill_bounds is the part of the tile that
+// may be filled and non_fills are the non-fill shapes near the tile.
+static void fillTile(const Rect& fill_bounds_rect,
+                     const std::vector<Rect>& non_fills,
+                     dbTechLayer* layer,
+                     const DensityFillLayerConfig& cfg,
+                     Graphics* graphics,
+                     TileFills& tile_fills)
+{
+  Polygon90Set non_fill;
+  for (const Rect& rect : non_fills) {
+    non_fill.insert(
+        makeRect(rect.xMin(), rect.yMin(), rect.xMax(), rect.yMax()));
+  }
 
   auto fill_bounds = makeRect(fill_bounds_rect.xMin(),
                               fill_bounds_rect.yMin(),
                               fill_bounds_rect.xMax(),
                               fill_bounds_rect.yMax());
 
-  const DensityFillLayerConfig& cfg = layers_[layer];
-
   std::vector<Polygon90> polygons;
 
   // Do non-OPC fill
   Polygon90Set fill_area
       = fill_bounds - (non_fill + cfg.non_opc.space_to_non_fill);
 
-  if (graphics_) {
-    graphics_->status("Non-OPC Area");
-    graphics_->drawPolygon90Set(fill_area);
+  if (graphics) {
+    graphics->status("Non-OPC Area");
+    graphics->drawPolygon90Set(fill_area);
   }
 
-  prune(fill_area, layer, cfg.non_opc, graphics_.get());
+  prune(fill_area, layer, cfg.non_opc, graphics);
 
   fill_area.get(polygons);
-  logger_->info(FIN, 9, "Filling {} areas with non-OPC fill.", polygons.size());
+  tile_fills.non_opc_areas = polygons.size();
 
   Polygon90Set non_opc_fill_area;
   for (auto& polygon : polygons) {
     fillPolygon(polygon,
                 layer,
-                block,
                 cfg.non_opc,
                 cfg.num_masks,
-                false,
-                graphics_.get(),
+                graphics,
+                tile_fills.non_opc,
                 &non_opc_fill_area);
   }
-  logger_->info(FIN, 4, "Total fills: {}.", block->getFills().size());
 
   if (!cfg.has_opc) {
     return;
@@ -491,27 +522,174 @@ void DensityFill::fillLayer(dbBlock* block,
       = fill_bounds - (non_fill + cfg.opc.space_to_non_fill)
         - (non_opc_fill_area + cfg.non_opc.space_to_fill);
 
-  if (graphics_) {
-    graphics_->status("OPC Area");
-    graphics_->drawPolygon90Set(opc_fill_area);
+  if (graphics) {
+    graphics->status("OPC Area");
+    graphics->drawPolygon90Set(opc_fill_area);
   }
 
-  prune(opc_fill_area, layer, cfg.opc, graphics_.get());
+  prune(opc_fill_area, layer, cfg.opc, graphics);
 
   polygons.clear();
   opc_fill_area.get(polygons);
-  logger_->info(FIN, 5, "Filling {} areas with OPC fill.", polygons.size());
+  tile_fills.opc_areas = polygons.size();
   for (auto& polygon : polygons) {
     fillPolygon(
-        polygon, layer, block, cfg.opc, cfg.num_masks, true, graphics_.get());
+        polygon, layer, cfg.opc, cfg.num_masks, graphics, tile_fills.opc);
   }
 
-  logger_->info(FIN, 6, "Total fills: {}.", block->getFills().size());
+  if (graphics) {
+    graphics->status("OPC Area");
+    graphics->drawPolygon90Set(opc_fill_area);
+  }
+}
 
-  if (graphics_) {
-    graphics_->status("OPC Area");
-    graphics_->drawPolygon90Set(opc_fill_area);
+// Fill the given layer
+//
+// The fill bounds are split into tiles that are filled independently on
+// the executor.  Inside the fill bounds each tile keeps a margin of
+// half the fill spacing from its neighbors so fills from adjacent tiles
+// never violate spacing.  Tiles are processed in batches and their fills
+// are added to the block in tile order, so the result does not depend on
+// the number of threads and only a batch of tiles is held in polygon sets.
+void DensityFill::fillLayer(dbBlock* block,
+                            dbTechLayer* layer,
+                            const odb::Rect& fill_bounds)
+{
+  logger_->info(FIN, 3, "Filling layer {}.", layer->getConstName());
+
+  const DensityFillLayerConfig& cfg = layers_[layer];
+
+  // Non-fill shapes affect fills up to this distance away
+  int halo = cfg.non_opc.space_to_non_fill;
+  // Fills of adjacent tiles are at least this far apart
+  int spacing = cfg.non_opc.space_to_fill;
+  {
+    auto [space_x, space_y] = getSpacing(layer, cfg.non_opc);
+    spacing = std::max({spacing, space_x, space_y});
+  }
+  if (cfg.has_opc) {
+    halo = std::max(halo, cfg.opc.space_to_non_fill);
+    auto [space_x, space_y] = getSpacing(layer, cfg.opc);
+    spacing = std::max({spacing, space_x, space_y});
+  }
+  const int margin = (spacing + 1) / 2;
+
+  const int tile_size = tile_size_um_ * block->getDbUnitsPerMicron();
+  const int num_x = std::max(1, ceilDiv(fill_bounds.dx(), tile_size));
+  const int num_y = std::max(1, ceilDiv(fill_bounds.dy(), tile_size));
+  const int num_tiles = num_x * num_y;
+
+  auto tile_bounds = [&](int tile) {
+    const int x = tile % num_x;
+    const int y = tile / num_x;
+    const int x_lo = fill_bounds.xMin() + x * tile_size;
+    const int y_lo = fill_bounds.yMin() + y * tile_size;
+    return Rect(x_lo + (x > 0 ? margin : 0),
+                y_lo + (y > 0 ? margin : 0),
+                x < num_x - 1 ? x_lo + tile_size - margin : fill_bounds.xMax(),
+                y < num_y - 1 ? y_lo + tile_size - margin : fill_bounds.yMax());
+  };
+
+  // Bin the non-fill shapes by tile, clipped to the part that can affect it
+  std::vector<std::vector<Rect>> tile_non_fills(num_tiles);
+  for (const Rect& shape : getNonFills(block, layer)) {
+    Rect search = shape;
+    search.bloat(halo, search);
+    const int x_lo = std::max(
+        0, floorDiv(search.xMin() - fill_bounds.xMin(), tile_size));
+    const int y_lo = std::max(
+        0, floorDiv(search.yMin() - fill_bounds.yMin(), tile_size));
+    const int x_hi = std::min(
+        num_x - 1, floorDiv(search.xMax() - fill_bounds.xMin(), tile_size));
+    const int y_hi = std::min(
+        num_y - 1, floorDiv(search.yMax() - fill_bounds.yMin(), tile_size));
+    for (int y = y_lo; y <= y_hi; y++) {
+      for (int x = x_lo; x <= x_hi; x++) {
+        const int tile = y * num_x + x;
+        Rect region = tile_bounds(tile);
+        region.bloat(halo, region);
+        if (region.overlaps(shape)) {
+          tile_non_fills[tile].push_back(region.intersect(shape));
+        }
+      }
+    }
+  }
+
+  // Graphics are not thread safe
+  utl::Executor* executor = graphics_ ? nullptr : executor_;
+  const int thread_count = executor ? executor->getNumThreads() : 1;
+  const int batch_size = thread_count * tiles_per_thread_;
+  const int fill_count = block->getFills().size();
+  int non_opc_areas = 0;
+  int opc_areas = 0;
+  int non_opc_fills = 0;
+  int opc_fills = 0;
+  for (int batch_start = 0; batch_start < num_tiles;
+       batch_start += batch_size) {
+    const int batch_end = std::min(batch_start + batch_size, num_tiles);
+    std::vector<TileFills> tile_fills(batch_end - batch_start);
+
+    auto fill_tile = [&](int tile) {
+      const Rect bounds = tile_bounds(tile);
+      if (bounds.xMin() < bounds.xMax() && bounds.yMin() < bounds.yMax()) {
+        fillTile(bounds,
+                 tile_non_fills[tile],
+                 layer,
+                 cfg,
+                 graphics_.get(),
+                 tile_fills[tile - batch_start]);
+      }
+      std::vector<Rect>().swap(tile_non_fills[tile]);
+    };
+    if (executor) {
+      executor->parallelFor(batch_start, batch_end, fill_tile);
+    } else {
+      for (int tile = batch_start; tile < batch_end; tile++) {
+        fill_tile(tile);
+      }
+    }
+
+    // Insert fills into the db
+    for (const TileFills& fills : tile_fills) {
+      non_opc_areas += fills.non_opc_areas;
+      opc_areas += fills.opc_areas;
+      non_opc_fills += fills.non_opc.size();
+      opc_fills += fills.opc.size();
+      for (const FillShape& fill : fills.non_opc) {
+        const Rect& r = fill.rect;
+        dbFill::create(block,
+                       false,
+                       fill.mask,
+                       layer,
+                       r.xMin(),
+                       r.yMin(),
+                       r.xMax(),
+                       r.yMax());
+      }
+      for (const FillShape& fill : fills.opc) {
+        const Rect& r = fill.rect;
+        dbFill::create(block,
+                       true,
+                       fill.mask,
+                       layer,
+                       r.xMin(),
+                       r.yMin(),
+                       r.xMax(),
+                       r.yMax());
+      }
+    }
   }
+
+  logger_->info(FIN, 9, "Filling {} areas with non-OPC fill.", non_opc_areas);
+  logger_->info(FIN, 4, "Total fills: {}.", fill_count + non_opc_fills);
+
+  if (!cfg.has_opc) {
+    return;
+  }
+
+  logger_->info(FIN, 5, "Filling {} areas with OPC fill.", opc_areas);
+  logger_->info(
+      FIN, 6, "Total fills: {}.", fill_count + non_opc_fills + opc_fills);
 }
 
 // Fill the design according to the given cfg file
@@ -40,6 +40,10 @@
 #include "odb/db.h"
 #include "utl/Logger.h"
 
+namespace utl {
+class Executor;
+}
+
 namespace fin {
 
 struct DensityFillLayerConfig;
@@ -61,6 +65,7 @@ class DensityFill
   DensityFill& operator=(const DensityFill&&) = delete;
 
   void fill(const char* cfg_filename, const odb::Rect& fill_area);
+  void setExecutor(utl::Executor* executor);
 
  private:
   void loadConfig(const char* cfg_filename, odb::dbTech* tech);
@@ -74,6 +79,12 @@ class DensityFill
   std::map<odb::dbTechLayer*, DensityFillLayerConfig> layers_;
   std::unique_ptr<Graphics> graphics_;
   utl::Logger* logger_;
+  utl::Executor* executor_ = nullptr;  // serial if not set
+
+  // Layers are filled in independent square tiles of this size
+  static constexpr int tile_size_um_ = 500;
+  // Number of tiles per thread held in memory at once
+  static constexpr int tiles_per_thread_ = 4;
 };
 
 }  // namespace fin
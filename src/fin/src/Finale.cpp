@@ -39,14 +39,18 @@ namespace fin {
 
 ////////////////////////////////////////////////////////////////
 
-Finale::Finale() : db_(nullptr), logger_(nullptr), debug_(false)
+Finale::Finale()
+    : db_(nullptr), logger_(nullptr), executor_(nullptr), debug_(false)
 {
 }
 
-void Finale::init(odb::dbDatabase* db, Logger* logger)
+void Finale::init(odb::dbDatabase* db,
+                  Logger* logger,
+                  utl::Executor* executor)
 {
   db_ = db;
   logger_ = logger;
+  executor_ = executor;
 }
 
 void Finale::setDebug()
@@ -57,6 +61,7 @@ void Finale::setDebug()
 void Finale::densityFill(const char* rules_filename, const odb::Rect& fill_area)
 {
   DensityFill filler(db_, logger_, debug_);
+  filler.setExecutor(executor_);
   filler.fill(rules_filename, fill_area);
 }
 
@@ -68,7 +68,8 @@ void initFinale(OpenRoad* openroad)
   Fin_Init(tcl_interp);
   // Eval encoded sta TCL sources.
   sta::evalTclInit(tcl_interp, sta::fin_tcl_inits);
-  openroad->getFinale()->init(openroad->getDb(), openroad->getLogger());
+  openroad->getFinale()->init(
+      openroad->getDb(), openroad->getLogger(), openroad->getExecutor());
 }
 
 }  // namespace ord
@@ -54,6 +54,7 @@ class Gui;
 }
 
 namespace utl {
+class Executor;
 class Logger;
 }
 
@@ -148,7 +149,8 @@ class GlobalRouter
             sta::dbSta* sta,
             rsz::Resizer* resizer,
             ant::AntennaChecker* antenna_checker,
-            dpl::Opendp* opendp);
+            dpl::Opendp* opendp,
+            utl::Executor* executor);
   void clear();
 
   void setAdjustment(const float adjustment);
@@ -381,6 +383,7 @@ class GlobalRouter
   ant::AntennaChecker* antenna_checker_;
   dpl::Opendp* opendp_;
   rsz::Resizer* resizer_;
+  utl::Executor* executor_ = nullptr;  // serial if not set
   // Objects variables
   FastRouteCore* fastroute_;
   odb::Point grid_origin_;
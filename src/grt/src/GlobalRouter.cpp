@@ -117,7 +117,8 @@ void GlobalRouter::init(utl::Logger* logger,
                         sta::dbSta* sta,
                         rsz::Resizer* resizer,
                         ant::AntennaChecker* antenna_checker,
-                        dpl::Opendp* opendp)
+                        dpl::Opendp* opendp,
+                        utl::Executor* executor)
 {
   logger_ = logger;
   // Broken gui api missing openroad accessor.
@@ -130,6 +131,7 @@ void GlobalRouter::init(utl::Logger* logger,
   fastroute_ = new FastRouteCore(db_, logger_, stt_builder_, gui_);
   sta_ = sta;
   resizer_ = resizer;
+  executor_ = executor;
 
   heatmap_ = std::make_unique<RoutingCongestionDataSource>(logger_, db_);
   heatmap_->registerHeatMap();
@@ -416,14 +418,13 @@ void GlobalRouter::estimateRC()
   sta_->setParasiticAnalysisPts(true, false);
 
   MakeWireParasitics builder(logger_, resizer_, sta_, db_->getTech(), this);
+  std::vector<odb::dbNet*> nets;
   for (auto& net_route : routes_) {
-    odb::dbNet* db_net = net_route.first;
-    GRoute& route = net_route.second;
-    if (!route.empty()) {
-      Net* net = getNet(db_net);
-      builder.estimateParasitcs(db_net, net->getPins(), route);
+    if (!net_route.second.empty()) {
+      nets.push_back(net_route.first);
     }
   }
+  builder.estimateParasitcs(nets, executor_);
 }
 
 void GlobalRouter::estimateRC(odb::dbNet* db_net)
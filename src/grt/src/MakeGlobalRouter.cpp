@@ -73,7 +73,8 @@ void initGlobalRouter(OpenRoad* openroad)
                                     openroad->getSta(),
                                     openroad->getResizer(),
                                     openroad->getAntennaChecker(),
-                                    openroad->getOpendp());
+                                    openroad->getOpendp(),
+                                    openroad->getExecutor());
 }
 
 }  // namespace ord
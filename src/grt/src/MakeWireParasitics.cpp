@@ -45,6 +45,7 @@
 #include "sta/Sdc.hh"
 #include "sta/StaState.hh"
 #include "sta/Units.hh"
+#include "utl/Executor.h"
 #include "utl/Logger.h"
 
 namespace grt {
@@ -73,6 +74,60 @@ MakeWireParasitics::MakeWireParasitics(utl::Logger* logger,
 void MakeWireParasitics::estimateParasitcs(odb::dbNet* net,
                                            std::vector<Pin>& pins,
                                            GRoute& route) const
+{
+  NetRC rc;
+  makeNetRC(net, pins, route, rc);
+  installNetRC(net, rc);
+}
+
+void MakeWireParasitics::estimateParasitcs(
+    const std::vector<odb::dbNet*>& nets,
+    utl::Executor* executor) const
+{
+  // Bounds the memory of the RC networks waiting to be installed.
+  const int batch_size = 10000;
+
+  // The debug reports are not ordered across threads.
+  if (logger_->debugCheck(GRT, "est_rc", 1)) {
+    executor = nullptr;
+  }
+
+  NetRouteMap& routes = grouter_->getRoutes();
+  std::vector<std::vector<Pin>*> net_pins;
+  std::vector<GRoute*> net_routes;
+  std::vector<NetRC> rcs;
+  for (int begin = 0; begin < nets.size(); begin += batch_size) {
+    const int end = std::min(begin + batch_size, (int) nets.size());
+    net_pins.clear();
+    net_routes.clear();
+    for (int i = begin; i < end; i++) {
+      net_pins.push_back(&grouter_->getNet(nets[i])->getPins());
+      net_routes.push_back(&routes[nets[i]]);
+    }
+
+    rcs.clear();
+    rcs.resize(end - begin);
+    auto make_rc = [&](int i) {
+      makeNetRC(nets[begin + i], *net_pins[i], *net_routes[i], rcs[i]);
+    };
+    if (executor == nullptr) {
+      for (int i = 0; i < rcs.size(); i++) {
+        make_rc(i);
+      }
+    } else {
+      executor->parallelFor(0, rcs.size(), make_rc);
+    }
+
+    for (int i = 0; i < rcs.size(); i++) {
+      installNetRC(nets[begin + i], rcs[i]);
+    }
+  }
+}
+
+void MakeWireParasitics::makeNetRC(odb::dbNet* net,
+                                   std::vector<Pin>& pins,
+                                   GRoute& route,
+                                   NetRC& rc) const
 {
   debugPrint(logger_, GRT, "est_rc", 1, "net {}", net->getConstName());
   if (logger_->debugCheck(GRT, "est_rc", 2)) {
@@ -89,22 +144,55 @@ void MakeWireParasitics::estimateParasitcs(odb::dbNet* net,
     }
   }
 
+  rc.elements.resize(sta_->corners()->count());
+  NodeRoutePtMap node_map;
+  makeRouteParasitics(net, route, node_map, rc);
+  makeParasiticsToPins(net, pins, node_map, rc);
+}
+
+void MakeWireParasitics::installNetRC(odb::dbNet* net, const NetRC& rc) const
+{
   sta::Net* sta_net = network_->dbToSta(net);
 
   sta::OperatingConditions* op_cond
       = sta_->sdc()->operatingConditions(min_max_);
   sta::ReducedParasiticType reduce_to
       = sta_->arcDelayCalc()->reducedParasiticType();
+  std::vector<sta::ParasiticNode*> route_nodes(rc.route_node_count + 1);
+  std::vector<sta::ParasiticNode*> pin_nodes(rc.pins.size());
   for (sta::Corner* corner : *sta_->corners()) {
-    NodeRoutePtMap node_map;
+    for (int i = 0; i < rc.non_wire_segments; i++) {
+      logger_->warn(GRT,
+                    25,
+                    "Non wire or via route found on net {}.",
+                    net->getConstName());
+    }
+    for (const std::string& pin_name : rc.missing_pins) {
+      logger_->warn(GRT, 26, "Missing route to pin {}.", pin_name);
+    }
 
     sta::ParasiticAnalysisPt* analysis_point
         = corner->findParasiticAnalysisPt(min_max_);
     sta::Parasitic* parasitic
         = parasitics_->makeParasiticNetwork(sta_net, false, analysis_point);
-    makeRouteParasitics(
-        net, route, sta_net, corner, analysis_point, parasitic, node_map);
-    makeParasiticsToPins(pins, node_map, corner, analysis_point, parasitic);
+    for (int id = 1; id <= rc.route_node_count; id++) {
+      route_nodes[id]
+          = parasitics_->ensureParasiticNode(parasitic, sta_net, id);
+    }
+    for (int i = 0; i < rc.pins.size(); i++) {
+      pin_nodes[i] = parasitics_->ensureParasiticNode(parasitic, rc.pins[i]);
+    }
+    auto node = [&](int id) {
+      return id > 0 ? route_nodes[id] : pin_nodes[-id - 1];
+    };
+
+    for (const NetRC::Element& element : rc.elements[corner->index()]) {
+      sta::ParasiticNode* n1 = node(element.node1);
+      sta::ParasiticNode* n2 = node(element.node2);
+      parasitics_->incrCap(n1, element.cap / 2.0, analysis_point);
+      parasitics_->makeResistor(nullptr, n1, n2, element.res, analysis_point);
+      parasitics_->incrCap(n2, element.cap / 2.0, analysis_point);
+    }
 
     // Reduce
     parasitics_->reduceTo(parasitic,
@@ -127,14 +215,20 @@ sta::Pin* MakeWireParasitics::staPin(Pin& pin) const
     return network_->dbToSta(pin.getITerm());
 }
 
-void MakeWireParasitics::makeRouteParasitics(
-    odb::dbNet* net,
-    GRoute& route,
-    sta::Net* sta_net,
-    sta::Corner* corner,
-    sta::ParasiticAnalysisPt* analysis_point,
-    sta::Parasitic* parasitic,
-    NodeRoutePtMap& node_map) const
+std::string MakeWireParasitics::nodeName(odb::dbNet* net,
+                                         int node,
+                                         const NetRC& rc) const
+{
+  if (node < 0) {
+    return network_->pathName(rc.pins[-node - 1]);
+  }
+  return fmt::format("{}:{}", net->getConstName(), node);
+}
+
+void MakeWireParasitics::makeRouteParasitics(odb::dbNet* net,
+                                             GRoute& route,
+                                             NodeRoutePtMap& node_map,
+                                             NetRC& rc) const
 {
   const int min_routing_layer = grouter_->getMinRoutingLayer();
 
@@ -142,94 +236,88 @@ void MakeWireParasitics::makeRouteParasitics(
     const int wire_length_dbu = segment.length();
 
     const int init_layer = segment.init_layer;
-    sta::ParasiticNode* n1 = (init_layer >= min_routing_layer)
-                                 ? ensureParasiticNode(segment.init_x,
-                                                       segment.init_y,
-                                                       init_layer,
-                                                       node_map,
-                                                       parasitic,
-                                                       sta_net)
-                                 : nullptr;
+    const int n1 = (init_layer >= min_routing_layer)
+                       ? ensureParasiticNode(segment.init_x,
+                                             segment.init_y,
+                                             init_layer,
+                                             node_map,
+                                             rc)
+                       : 0;
 
     const int final_layer = segment.final_layer;
-    sta::ParasiticNode* n2 = (final_layer >= min_routing_layer)
-                                 ? ensureParasiticNode(segment.final_x,
-                                                       segment.final_y,
-                                                       final_layer,
-                                                       node_map,
-                                                       parasitic,
-                                                       sta_net)
-                                 : nullptr;
+    const int n2 = (final_layer >= min_routing_layer)
+                       ? ensureParasiticNode(segment.final_x,
+                                             segment.final_y,
+                                             final_layer,
+                                             node_map,
+                                             rc)
+                       : 0;
     if (!n1 || !n2) {
       continue;
     }
 
+    const bool is_wire = segment.init_layer == segment.final_layer;
+    if (wire_length_dbu != 0 && !is_wire) {
+      rc.non_wire_segments++;
+    }
+
     sta::Units* units = sta_->units();
-    float res = 0.0;
-    float cap = 0.0;
-    if (wire_length_dbu == 0) {
-      // via
-      int lower_layer = min(segment.init_layer, segment.final_layer);
-      odb::dbTechLayer* cut_layer
-          = tech_->findRoutingLayer(lower_layer)->getUpperLayer();
-      res = getCutLayerRes(cut_layer, corner);
-      debugPrint(logger_,
-                 GRT,
-                 "est_rc",
-                 1,
-                 "{} -> {} via {}-{} r={}",
-                 parasitics_->name(n1),
-                 parasitics_->name(n2),
-                 segment.init_layer,
-                 segment.final_layer,
-                 units->resistanceUnit()->asString(res));
-    } else if (segment.init_layer == segment.final_layer) {
-      layerRC(wire_length_dbu, segment.init_layer, corner, res, cap);
-      debugPrint(logger_,
-                 GRT,
-                 "est_rc",
-                 1,
-                 "{} -> {} {:.2f}u layer={} r={} c={}",
-                 parasitics_->name(n1),
-                 parasitics_->name(n2),
-                 dbuToMeters(wire_length_dbu) * 1e+6,
-                 segment.init_layer,
-                 units->resistanceUnit()->asString(res),
-                 units->capacitanceUnit()->asString(cap));
-    } else
-      logger_->warn(GRT,
-                    25,
-                    "Non wire or via route found on net {}.",
-                    net->getConstName());
-    parasitics_->incrCap(n1, cap / 2.0, analysis_point);
-    parasitics_->makeResistor(nullptr, n1, n2, res, analysis_point);
-    parasitics_->incrCap(n2, cap / 2.0, analysis_point);
+    for (sta::Corner* corner : *sta_->corners()) {
+      float res = 0.0;
+      float cap = 0.0;
+      if (wire_length_dbu == 0) {
+        // via
+        int lower_layer = min(segment.init_layer, segment.final_layer);
+        odb::dbTechLayer* cut_layer
+            = tech_->findRoutingLayer(lower_layer)->getUpperLayer();
+        res = getCutLayerRes(cut_layer, corner);
+        debugPrint(logger_,
+                   GRT,
+                   "est_rc",
+                   1,
+                   "{} -> {} via {}-{} r={}",
+                   nodeName(net, n1, rc),
+                   nodeName(net, n2, rc),
+                   segment.init_layer,
+                   segment.final_layer,
+                   units->resistanceUnit()->asString(res));
+      } else if (is_wire) {
+        layerRC(wire_length_dbu, segment.init_layer, corner, res, cap);
+        debugPrint(logger_,
+                   GRT,
+                   "est_rc",
+                   1,
+                   "{} -> {} {:.2f}u layer={} r={} c={}",
+                   nodeName(net, n1, rc),
+                   nodeName(net, n2, rc),
+                   dbuToMeters(wire_length_dbu) * 1e+6,
+                   segment.init_layer,
+                   units->resistanceUnit()->asString(res),
+                   units->capacitanceUnit()->asString(cap));
+      }
+      rc.elements[corner->index()].push_back({n1, n2, res, cap});
+    }
   }
 }
 
-void MakeWireParasitics::makeParasiticsToPins(
-    std::vector<Pin>& pins,
-    NodeRoutePtMap& node_map,
-    sta::Corner* corner,
-    sta::ParasiticAnalysisPt* analysis_point,
-    sta::Parasitic* parasitic) const
+void MakeWireParasitics::makeParasiticsToPins(odb::dbNet* net,
+                                              std::vector<Pin>& pins,
+                                              NodeRoutePtMap& node_map,
+                                              NetRC& rc) const
 {
   for (Pin& pin : pins) {
-    makeParasiticsToPin(pin, node_map, corner, analysis_point, parasitic);
+    makeParasiticsToPin(net, pin, node_map, rc);
   }
 }
 
 // Make parasitics for the wire from the pin to the grid location of the pin.
-void MakeWireParasitics::makeParasiticsToPin(
-    Pin& pin,
-    NodeRoutePtMap& node_map,
-    sta::Corner* corner,
-    sta::ParasiticAnalysisPt* analysis_point,
-    sta::Parasitic* parasitic) const
+void MakeWireParasitics::makeParasiticsToPin(odb::dbNet* net,
+                                             Pin& pin,
+                                             NodeRoutePtMap& node_map,
+                                             NetRC& rc) const
 {
-  sta::Pin* sta_pin = staPin(pin);
-  sta::ParasiticNode* pin_node
-      = parasitics_->ensureParasiticNode(parasitic, sta_pin);
+  rc.pins.push_back(staPin(pin));
+  const int pin_node = -static_cast<int>(rc.pins.size());
 
   odb::Point pt = pin.getPosition();
   odb::Point grid_pt = pin.getOnGridPosition();
@@ -245,65 +333,67 @@ void MakeWireParasitics::makeParasiticsToPin(
   // Use the route layer above the pin layer if there is a via
   // to the pin.
   int layer = pin.getConnectionLayer() + 1;
-  RoutePt grid_route(grid_pt.getX(), grid_pt.getY(), layer);
-  sta::ParasiticNode* grid_node = node_map[grid_route];
-  float via_res = 0;
+  auto grid_node
+      = node_map.find(RoutePt(grid_pt.getX(), grid_pt.getY(), layer));
+  bool via_to_pin = true;
 
   // Use the pin layer for the connection.
-  if (grid_node == nullptr) {
+  if (grid_node == node_map.end()) {
     layer--;
-    grid_route = RoutePt(grid_pt.getX(), grid_pt.getY(), layer);
-    grid_node = node_map[grid_route];
-  } else {
-    odb::dbTechLayer* cut_layer
-        = tech_->findRoutingLayer(layer)->getLowerLayer();
-    via_res = getCutLayerRes(cut_layer, corner);
+    grid_node = node_map.find(RoutePt(grid_pt.getX(), grid_pt.getY(), layer));
+    via_to_pin = false;
   }
 
-  if (grid_node) {
+  if (grid_node != node_map.end()) {
     // Make wire from pin to gcell center on pin layer.
     int wire_length_dbu
         = abs(pt.getX() - grid_pt.getX()) + abs(pt.getY() - grid_pt.getY());
-    float res, cap;
-    layerRC(wire_length_dbu, layer, corner, res, cap);
     sta::Units* units = sta_->units();
-    debugPrint(
-        logger_,
-        GRT,
-        "est_rc",
-        1,
-        "{} -> {} ({:.2f}, {:.2f}) {:.2f}u layer={} r={} via_res={} c={}",
-        parasitics_->name(grid_node),
-        parasitics_->name(pin_node),
-        grouter_->dbuToMicrons(pt.getX()),
-        grouter_->dbuToMicrons(pt.getY()),
-        grouter_->dbuToMicrons(wire_length_dbu),
-        layer,
-        units->resistanceUnit()->asString(res),
-        units->resistanceUnit()->asString(via_res),
-        units->capacitanceUnit()->asString(cap));
-
-    debugPrint(logger_,
-               GRT,
-               "est_rc",
-               1,
-               "pin {} -> to grid {}u layer={} r={} via_res={} c={}",
-               pin.getName(),
-               static_cast<int>(dbuToMeters(wire_length_dbu) * 1e+6),
-               layer,
-               units->resistanceUnit()->asString(res),
-               units->resistanceUnit()->asString(via_res),
-               units->capacitanceUnit()->asString(cap));
-
-    // We could added the via resistor before the segment pi-model
-    // but that would require an extra node and the accuracy of all
-    // this is not that high.  Instead we just lump them together.
-    parasitics_->incrCap(pin_node, cap / 2.0, analysis_point);
-    parasitics_->makeResistor(
-        nullptr, pin_node, grid_node, res + via_res, analysis_point);
-    parasitics_->incrCap(grid_node, cap / 2.0, analysis_point);
+    for (sta::Corner* corner : *sta_->corners()) {
+      float via_res = 0;
+      if (via_to_pin) {
+        odb::dbTechLayer* cut_layer
+            = tech_->findRoutingLayer(layer)->getLowerLayer();
+        via_res = getCutLayerRes(cut_layer, corner);
+      }
+      float res, cap;
+      layerRC(wire_length_dbu, layer, corner, res, cap);
+      debugPrint(
+          logger_,
+          GRT,
+          "est_rc",
+          1,
+          "{} -> {} ({:.2f}, {:.2f}) {:.2f}u layer={} r={} via_res={} c={}",
+          nodeName(net, grid_node->second, rc),
+          nodeName(net, pin_node, rc),
+          grouter_->dbuToMicrons(pt.getX()),
+          grouter_->dbuToMicrons(pt.getY()),
+          grouter_->dbuToMicrons(wire_length_dbu),
+          layer,
+          units->resistanceUnit()->asString(res),
+          units->resistanceUnit()->asString(via_res),
+          units->capacitanceUnit()->asString(cap));
+
+      debugPrint(logger_,
+                 GRT,
+                 "est_rc",
+                 1,
+                 "pin {} -> to grid {}u layer={} r={} via_res={} c={}",
+                 pin.getName(),
+                 static_cast<int>(dbuToMeters(wire_length_dbu) * 1e+6),
+                 layer,
+                 units->resistanceUnit()->asString(res),
+                 units->resistanceUnit()->asString(via_res),
+                 units->capacitanceUnit()->asString(cap));
+
+      // We could added the via resistor before the segment pi-model
+      // but that would require an extra node and the accuracy of all
+      // this is not that high.  Instead we just lump them together.
+      rc.elements[corner->index()].push_back(
+          {pin_node, grid_node->second, res + via_res, cap});
+    }
   } else {
-    logger_->warn(GRT, 26, "Missing route to pin {}.", pin.getName());
+    rc.missing_pins.push_back(pin.getName());
   }
 }
 
@@ -341,19 +431,16 @@ double MakeWireParasitics::dbuToMeters(int dbu) const
   return (double) dbu / (tech_->getDbUnitsPerMicron() * 1E+6);
 }
 
-sta::ParasiticNode* MakeWireParasitics::ensureParasiticNode(
-    int x,
-    int y,
-    int layer,
-    NodeRoutePtMap& node_map,
-    sta::Parasitic* parasitic,
-    sta::Net* net) const
+int MakeWireParasitics::ensureParasiticNode(int x,
+                                            int y,
+                                            int layer,
+                                            NodeRoutePtMap& node_map,
+                                            NetRC& rc) const
 {
   RoutePt pin_loc(x, y, layer);
-  sta::ParasiticNode* node = node_map[pin_loc];
-  if (node == nullptr) {
-    node = parasitics_->ensureParasiticNode(parasitic, net, node_map.size());
-    node_map[pin_loc] = node;
+  int& node = node_map[pin_loc];
+  if (node == 0) {
+    node = ++rc.route_node_count;
   }
   return node;
 }
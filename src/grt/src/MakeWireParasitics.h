@@ -35,6 +35,9 @@
 
 #pragma once
 
+#include <string>
+#include <vector>
+
 #include "FastRoute.h"
 #include "Grid.h"
 #include "Net.h"
@@ -59,6 +62,7 @@ class OpenRoad;
 }
 
 namespace utl {
+class Executor;
 class Logger;
 }
 
@@ -79,37 +83,64 @@ class MakeWireParasitics
   void estimateParasitcs(odb::dbNet* net,
                          std::vector<Pin>& pins,
                          GRoute& route) const;
+  // Estimate the parasitics of the routes of nets.  The RC networks of a
+  // batch of nets are computed concurrently on executor and then installed
+  // in STA one net at a time in the order of nets.
+  void estimateParasitcs(const std::vector<odb::dbNet*>& nets,
+                         utl::Executor* executor) const;
   // Return GRT layer lengths in dbu's for db_net's route indexed by routing
   // layer.
   std::vector<int> routeLayerLengths(odb::dbNet* db_net) const;
 
  private:
-  typedef std::map<RoutePt, sta::ParasiticNode*> NodeRoutePtMap;
+  // Route point nodes are numbered from 1 in order of creation.
+  typedef std::map<RoutePt, int> NodeRoutePtMap;
+
+  // RC network of a net built without touching STA so that the networks
+  // of several nets can be computed concurrently.
+  struct NetRC
+  {
+    // A wire or via with half of its capacitance on each end.  Node ids
+    // above 0 are route points and -(i + 1) is the node of pins[i].
+    struct Element
+    {
+      int node1;
+      int node2;
+      float res;
+      float cap;
+    };
+
+    std::vector<sta::Pin*> pins;
+    int route_node_count = 0;
+    std::vector<std::vector<Element>> elements;  // indexed by corner
+    int non_wire_segments = 0;
+    std::vector<std::string> missing_pins;
+  };
 
   sta::Pin* staPin(Pin& pin) const;
+  void makeNetRC(odb::dbNet* net,
+                 std::vector<Pin>& pins,
+                 GRoute& route,
+                 NetRC& rc) const;
+  void installNetRC(odb::dbNet* net, const NetRC& rc) const;
   void makeRouteParasitics(odb::dbNet* net,
                            GRoute& route,
-                           sta::Net* sta_net,
-                           sta::Corner* corner,
-                           sta::ParasiticAnalysisPt* analysis_point,
-                           sta::Parasitic* parasitic,
-                           NodeRoutePtMap& node_map) const;
-  sta::ParasiticNode* ensureParasiticNode(int x,
-                                          int y,
-                                          int layer,
-                                          NodeRoutePtMap& node_map,
-                                          sta::Parasitic* parasitic,
-                                          sta::Net* net) const;
-  void makeParasiticsToPins(std::vector<Pin>& pins,
+                           NodeRoutePtMap& node_map,
+                           NetRC& rc) const;
+  int ensureParasiticNode(int x,
+                          int y,
+                          int layer,
+                          NodeRoutePtMap& node_map,
+                          NetRC& rc) const;
+  void makeParasiticsToPins(odb::dbNet* net,
+                            std::vector<Pin>& pins,
                             NodeRoutePtMap& node_map,
-                            sta::Corner* corner,
-                            sta::ParasiticAnalysisPt* analysis_point,
-                            sta::Parasitic* parasitic) const;
-  void makeParasiticsToPin(Pin& pin,
+                            NetRC& rc) const;
+  void makeParasiticsToPin(odb::dbNet* net,
+                           Pin& pin,
                            NodeRoutePtMap& node_map,
-                           sta::Corner* corner,
-                           sta::ParasiticAnalysisPt* analysis_point,
-                           sta::Parasitic* parasitic) const;
+                           NetRC& rc) const;
+  std::string nodeName(odb::dbNet* net, int node, const NetRC& rc) const;
   void layerRC(int wire_length_dbu,
                int layer,
                sta::Corner* corner,
@@ -45,6 +45,7 @@
 #include "Net.h"
 #include "Pin.h"
 #include "grt/GlobalRouter.h"
+#include "odb/dbSpatialIndex.h"
 #include "utl/Logger.h"
 
 namespace grt {
@@ -287,7 +288,7 @@ void RepairAntennas::destroyNetWires()
 void RepairAntennas::repairAntennas(odb::dbMTerm* diode_mterm)
 {
   int site_width = -1;
-  r_tree fixed_insts;
+  std::unordered_set<odb::dbInst*> placed_diodes;
 
   illegal_diode_placement_count_ = 0;
   diode_insts_.clear();
@@ -309,7 +310,6 @@ void RepairAntennas::repairAntennas(odb::dbMTerm* diode_mterm)
   }
 
   setInstsPlacementStatus(odb::dbPlacementStatus::FIRM);
-  getFixedInstances(fixed_insts);
 
   bool repair_failures = false;
   for (auto const& net_violations : antenna_violations_) {
@@ -329,8 +329,12 @@ void RepairAntennas::repairAntennas(odb::dbMTerm* diode_mterm)
         for (odb::dbITerm* gate : violation.gates) {
           odb::dbInst* sink_inst = gate->getInst();
           for (int j = 0; j < violation.diode_count_per_gate; j++) {
-            insertDiode(
-                db_net, diode_mterm, sink_inst, gate, site_width, fixed_insts);
+            insertDiode(db_net,
+                        diode_mterm,
+                        sink_inst,
+                        gate,
+                        site_width,
+                        placed_diodes);
             inserted_diodes = true;
           }
         }
@@ -351,12 +355,24 @@ void RepairAntennas::legalizePlacedCells()
   setInstsPlacementStatus(odb::dbPlacementStatus::PLACED);
 }
 
-void RepairAntennas::insertDiode(odb::dbNet* net,
-                                 odb::dbMTerm* diode_mterm,
-                                 odb::dbInst* sink_inst,
-                                 odb::dbITerm* gate,
-                                 int site_width,
-                                 r_tree& fixed_insts)
+// Fixed instances and the diodes already inserted block a diode location.
+static bool isDiodeObstacle(
+    odb::dbInst* inst,
+    const std::unordered_set<odb::dbInst*>& placed_diodes)
+{
+  const odb::dbPlacementStatus status = inst->getPlacementStatus();
+  return status == odb::dbPlacementStatus::FIRM
+         || status == odb::dbPlacementStatus::LOCKED
+         || placed_diodes.find(inst) != placed_diodes.end();
+}
+
+void RepairAntennas::insertDiode(
+    odb::dbNet* net,
+    odb::dbMTerm* diode_mterm,
+    odb::dbInst* sink_inst,
+    odb::dbITerm* gate,
+    int site_width,
+    std::unordered_set<odb::dbInst*>& placed_diodes)
 {
   const int max_legalize_itr = 50;
   bool legally_placed = false;
@@ -385,9 +401,10 @@ void RepairAntennas::insertDiode(odb::dbNet* net,
 
   odb::Rect core_area = block_->getCoreArea();
 
-  // Use R-tree to check if diode will not overlap or cause 1-site spacing with
-  // other cells
-  std::vector<value> overlap_insts;
+  // Use the block R-tree to check if diode will not overlap or cause 1-site
+  // spacing with other cells
+  odb::dbSpatialIndex* spatial_index = odb::dbSpatialIndex::get(block_);
+  std::vector<odb::dbInst*> overlap_insts;
   int legalize_itr = 0;
   while (!legally_placed && legalize_itr < max_legalize_itr) {
     if (place_at_left) {
@@ -406,13 +423,18 @@ void RepairAntennas::insertDiode(odb::dbNet* net,
     diode_inst->setLocation(inst_loc_x + offset, inst_loc_y);
 
     odb::dbBox* instBox = diode_inst->getBBox();
-    box box(point(instBox->xMin() - ((left_pad + right_pad) * site_width) + 1,
-                  instBox->yMin() + 1),
-            point(instBox->xMax() + ((left_pad + right_pad) * site_width) - 1,
-                  instBox->yMax() - 1));
-    fixed_insts.query(bgi::intersects(box), std::back_inserter(overlap_insts));
-
-    if (overlap_insts.empty() && instBox->xMin() >= core_area.xMin()
+    const odb::Rect box(
+        instBox->xMin() - ((left_pad + right_pad) * site_width) + 1,
+        instBox->yMin() + 1,
+        instBox->xMax() + ((left_pad + right_pad) * site_width) - 1,
+        instBox->yMax() - 1);
+    spatial_index->findInsts(box, overlap_insts);
+    const bool overlap = std::any_of(
+        overlap_insts.begin(), overlap_insts.end(), [&](odb::dbInst* inst) {
+          return isDiodeObstacle(inst, placed_diodes);
+        });
+
+    if (!overlap && instBox->xMin() >= core_area.xMin()
         && instBox->xMax() <= core_area.xMax()) {
       legally_placed = true;
     }
@@ -439,30 +461,8 @@ void RepairAntennas::insertDiode(odb::dbNet* net,
   diode_iterm->connect(net);
   diode_insts_.push_back(diode_inst);
 
-  // Add diode to the R-tree of fixed instances
-  int fixed_inst_id = fixed_insts.size();
-  box b(point(inst_rect.xMin(), inst_rect.yMin()),
-        point(inst_rect.xMax(), inst_rect.yMax()));
-  value v(b, fixed_inst_id);
-  fixed_insts.insert(v);
-  fixed_inst_id++;
-}
-
-void RepairAntennas::getFixedInstances(r_tree& fixed_insts)
-{
-  int fixed_inst_id = 0;
-  for (odb::dbInst* inst : block_->getInsts()) {
-    odb::dbPlacementStatus status = inst->getPlacementStatus();
-    if (status == odb::dbPlacementStatus::FIRM
-        || status == odb::dbPlacementStatus::LOCKED) {
-      odb::dbBox* instBox = inst->getBBox();
-      box b(point(instBox->xMin(), instBox->yMin()),
-            point(instBox->xMax(), instBox->yMax()));
-      value v(b, fixed_inst_id);
-      fixed_insts.insert(v);
-      fixed_inst_id++;
-    }
-  }
+  // Later diodes must not overlap this one even if it was left movable
+  placed_diodes.insert(diode_inst);
 }
 
 void RepairAntennas::setInstsPlacementStatus(
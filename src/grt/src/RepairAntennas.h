@@ -35,10 +35,8 @@
 
 #pragma once
 
-#include <boost/geometry.hpp>
-#include <boost/geometry/index/rtree.hpp>
-#include <boost/iterator/function_output_iterator.hpp>
 #include <string>
+#include <unordered_set>
 
 #include "ant/AntennaChecker.hh"
 #include "dpl/Opendp.h"
@@ -62,9 +60,6 @@ namespace utl {
 class Logger;
 }  // namespace utl
 
-namespace bg = boost::geometry;
-namespace bgi = boost::geometry::index;
-
 namespace grt {
 
 class GlobalRouter;
@@ -107,20 +102,12 @@ class RepairAntennas
   double diffArea(odb::dbMTerm* mterm);
 
  private:
-  typedef int coord_type;
-  typedef bg::cs::cartesian coord_sys_type;
-  typedef bg::model::point<coord_type, 2, coord_sys_type> point;
-  typedef bg::model::box<point> box;
-  typedef std::pair<box, int> value;
-  typedef bgi::rtree<value, bgi::quadratic<8, 4>> r_tree;
-
   void insertDiode(odb::dbNet* net,
                    odb::dbMTerm* diode_mterm,
                    odb::dbInst* sink_inst,
                    odb::dbITerm* sink_iterm,
                    int site_width,
-                   r_tree& fixed_insts);
-  void getFixedInstances(r_tree& fixed_insts);
+                   std::unordered_set<odb::dbInst*>& placed_diodes);
   void setInstsPlacementStatus(odb::dbPlacementStatus placement_status);
   odb::Rect getInstRect(odb::dbInst* inst, odb::dbITerm* iterm);
   bool diodeInRow(odb::Rect diode_rect);
@@ -44,6 +44,7 @@
 #include <vector>
 
 #include "DataType.h"
+#include "MazeHeap.h"
 #include "grt/GRoute.h"
 #include "odb/geom.h"
 #include "stt/SteinerTreeBuilder.h"
@@ -249,7 +250,7 @@ class FastRouteCore
   void convertToMazerouteNet(const int netID);
   void setupHeap(const int netID,
                  const int edgeID,
-                 std::vector<float*>& src_heap,
+                 MazeHeap<float>& src_heap,
                  std::vector<float*>& dest_heap,
                  multi_array<float, 2>& d1,
                  multi_array<float, 2>& d2,
@@ -296,7 +297,7 @@ class FastRouteCore
                             int layerOrientation);
   void setupHeap3D(int netID,
                    int edgeID,
-                   std::vector<int*>& src_heap_3D,
+                   MazeHeap<int>& src_heap_3D,
                    std::vector<int*>& dest_heap_3D,
                    multi_array<Direction, 3>& directions_3D,
                    multi_array<int, 3>& corr_edge_3D,
@@ -550,6 +551,11 @@ class FastRouteCore
   multi_array<bool, 2> hyper_v_;
   multi_array<bool, 2> hyper_h_;
   multi_array<bool, 2> in_region_;
+  // 2D maze search buffers, reset only inside each search window
+  multi_array<float, 2> d1_;
+  multi_array<float, 2> d2_;
+  std::vector<bool> pop_heap2_;
+  MazeHeap<float> src_heap_;
 
   std::vector<StTree> sttrees_;  // the Steiner trees
   std::vector<StTree> sttrees_bk_;
@@ -0,0 +1,138 @@
+////////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <vector>
+
+namespace grt {
+
+// Binary min-heap of pointers into a maze distance buffer.  The heap index
+// of every queued cell is kept in a buffer parallel to the distances so a
+// cell whose distance decreased is re-sifted without searching the heap.
+// Both buffers are sized once for the grid and reused by every search;
+// only the cells queued by a search are ever touched.
+template <typename T>
+class MazeHeap
+{
+ public:
+  // base is the first cell of the distance buffer holding size cells.
+  void init(const T* base, const int size)
+  {
+    base_ = base;
+    if (static_cast<int>(index_.size()) < size) {
+      index_.resize(size);
+    }
+    heap_.clear();
+  }
+
+  void clear() { heap_.clear(); }
+  bool empty() const { return heap_.empty(); }
+  int size() const { return heap_.size(); }
+  T* top() const { return heap_.front(); }
+
+  void push(T* cell)
+  {
+    heap_.push_back(cell);
+    siftUp(heap_.size() - 1);
+  }
+
+  // Restore the heap order after the distance of a queued cell decreased.
+  void decrease(const T* cell) { siftUp(index_[cell - base_]); }
+
+  // Remove the cell with the minimum distance.
+  void pop()
+  {
+    T* last = heap_.back();
+    heap_.pop_back();
+    if (!heap_.empty()) {
+      heap_[0] = last;
+      siftDown(0);
+    }
+  }
+
+ private:
+  void place(T* cell, const int i)
+  {
+    heap_[i] = cell;
+    index_[cell - base_] = i;
+  }
+
+  void siftUp(int i)
+  {
+    T* cell = heap_[i];
+    while (i > 0) {
+      const int parent = (i - 1) / 2;
+      if (!(*heap_[parent] > *cell)) {
+        break;
+      }
+      place(heap_[parent], i);
+      i = parent;
+    }
+    place(cell, i);
+  }
+
+  void siftDown(int i)
+  {
+    const int heap_size = heap_.size();
+    T* cell = heap_[i];
+    while (true) {
+      const int l = 2 * i + 1;
+      const int r = 2 * i + 2;
+      int smallest;
+      if (l < heap_size && *heap_[l] < *cell) {
+        smallest = l;
+        if (r < heap_size && *heap_[r] < *heap_[l]) {
+          smallest = r;
+        }
+      } else {
+        smallest = i;
+        if (r < heap_size && *heap_[r] < *cell) {
+          smallest = r;
+        }
+      }
+      if (smallest == i) {
+        break;
+      }
+      place(heap_[smallest], i);
+      i = smallest;
+    }
+    place(cell, i);
+  }
+
+  const T* base_ = nullptr;
+  std::vector<T*> heap_;
+  std::vector<int> index_;
+};
+
+}  // namespace grt
@@ -132,6 +132,9 @@ void FastRouteCore::clear()
   corr_edge_.resize(boost::extents[0][0]);
 
   in_region_.resize(boost::extents[0][0]);
+  d1_.resize(boost::extents[0][0]);
+  d2_.resize(boost::extents[0][0]);
+  pop_heap2_.clear();
 
   v_capacity_3D_.clear();
   h_capacity_3D_.clear();
@@ -197,6 +200,9 @@ void FastRouteCore::setGridsAndLayers(int x, int y, int nLayers)
   corr_edge_.resize(boost::extents[y_range_][x_range_]);
 
   in_region_.resize(boost::extents[y_range_][x_range_]);
+  d1_.resize(boost::extents[y_range_][x_range_]);
+  d2_.resize(boost::extents[y_range_][x_range_]);
+  pop_heap2_.assign(y_range_ * x_range_, false);
 
   cost_hvh_.resize(x_range_);  // Horizontal first Z
   cost_vhv_.resize(y_range_);  // Vertical first Z
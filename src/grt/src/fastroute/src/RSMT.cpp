@@ -31,6 +31,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <algorithm>
+#include <vector>
 
 #include "DataType.h"
 #include "FastRoute.h"
@@ -649,6 +650,26 @@ void FastRouteCore::gen_brk_RSMT(const bool congestionDriven,
 
   const int flute_accuracy = 2;
 
+  // The trees of nets with an alpha only depend on their pins, so they are
+  // built in one batch up front.
+  std::vector<int> alpha_tree_idx(netCount(), -1);
+  std::vector<odb::dbNet*> alpha_nets;
+  std::vector<std::vector<int>> alpha_xs;
+  std::vector<std::vector<int>> alpha_ys;
+  std::vector<int> alpha_drvr_indices;
+  for (int i = 0; i < netCount(); i++) {
+    FrNet* net = nets_[i];
+    if (!net->isRouted() && stt_builder_->getAlpha(net->getDbNet()) > 0.0) {
+      alpha_tree_idx[i] = alpha_nets.size();
+      alpha_nets.push_back(net->getDbNet());
+      alpha_xs.push_back(net->getPinX());
+      alpha_ys.push_back(net->getPinY());
+      alpha_drvr_indices.push_back(net->getDriverIdx());
+    }
+  }
+  std::vector<Tree> alpha_trees = stt_builder_->makeSteinerTrees(
+      alpha_nets, alpha_xs, alpha_ys, alpha_drvr_indices);
+
   for (int i = 0; i < netCount(); i++) {
     FrNet* net = nets_[i];
 
@@ -699,10 +720,8 @@ void FastRouteCore::gen_brk_RSMT(const bool congestionDriven,
 
     // check net alpha because FastRoute has a special implementation of flute
     // TODO: move this flute implementation to SteinerTreeBuilder
-    const float net_alpha = stt_builder_->getAlpha(net->getDbNet());
-    if (net_alpha > 0.0) {
-      rsmt = stt_builder_->makeSteinerTree(
-          net->getDbNet(), net->getPinX(), net->getPinY(), net->getDriverIdx());
+    if (alpha_tree_idx[i] >= 0) {
+      rsmt = std::move(alpha_trees[alpha_tree_idx[i]]);
     } else {
       if (congestionDriven) {
         // call congestion driven flute to generate RSMT
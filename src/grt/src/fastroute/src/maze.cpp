@@ -40,21 +40,6 @@ namespace grt {
 
 using utl::GRT;
 
-static int parent_index(int i)
-{
-  return (i - 1) / 2;
-}
-
-static int left_index(int i)
-{
-  return 2 * i + 1;
-}
-
-static int right_index(int i)
-{
-  return 2 * i + 2;
-}
-
 void FastRouteCore::fixEmbeddedTrees()
 {
   // check embedded trees only when maze router is called
@@ -519,57 +504,6 @@ void FastRouteCore::convertToMazeroute()
   check2DEdgesUsage();
 }
 
-// non recursive version of heapify
-static void heapify(std::vector<float*>& array)
-{
-  bool stop = false;
-  const int heapSize = array.size();
-  int i = 0;
-
-  float* tmp = array[i];
-  do {
-    const int l = left_index(i);
-    const int r = right_index(i);
-
-    int smallest;
-    if (l < heapSize && *(array[l]) < *tmp) {
-      smallest = l;
-      if (r < heapSize && *(array[r]) < *(array[l]))
-        smallest = r;
-    } else {
-      smallest = i;
-      if (r < heapSize && *(array[r]) < *tmp)
-        smallest = r;
-    }
-    if (smallest != i) {
-      array[i] = array[smallest];
-      i = smallest;
-    } else {
-      array[i] = tmp;
-      stop = true;
-    }
-  } while (!stop);
-}
-
-static void updateHeap(std::vector<float*>& array, int i)
-{
-  float* tmpi = array[i];
-  while (i > 0 && *(array[parent_index(i)]) > *tmpi) {
-    const int parent = parent_index(i);
-    array[i] = array[parent];
-    i = parent;
-  }
-  array[i] = tmpi;
-}
-
-// remove the entry with minimum distance from Priority queue
-static void removeMin(std::vector<float*>& array)
-{
-  array[0] = array.back();
-  heapify(array);
-  array.pop_back();
-}
-
 /*
  * num_iteration : the total number of iterations for maze route to run
  * round : the number of maze route stages runned
@@ -746,7 +680,7 @@ void FastRouteCore::updateCongestionHistory(const int upType,
 // dest_heap - the heap storing the addresses for d2
 void FastRouteCore::setupHeap(const int netID,
                               const int edgeID,
-                              std::vector<float*>& src_heap,
+                              MazeHeap<float>& src_heap,
                               std::vector<float*>& dest_heap,
                               multi_array<float, 2>& d1,
                               multi_array<float, 2>& d2,
@@ -771,13 +705,13 @@ void FastRouteCore::setupHeap(const int netID,
   const int x2 = treenodes[n2].x;
   const int y2 = treenodes[n2].y;
 
-  src_heap.clear();
+  src_heap.init(&d1[0][0], d1.num_elements());
   dest_heap.clear();
 
   if (num_terminals == 2)  // 2-pin net
   {
     d1[y1][x1] = 0;
-    src_heap.push_back(&d1[y1][x1]);
+    src_heap.push(&d1[y1][x1]);
     d2[y2][x2] = 0;
     dest_heap.push_back(&d2[y2][x2]);
   } else {  // net with more than 2 pins
@@ -791,7 +725,7 @@ void FastRouteCore::setupHeap(const int netID,
     if (n1 < num_terminals) {  // n1 is a Pin node
       // just need to put n1 itself into src_heap
       d1[y1][x1] = 0;
-      src_heap.push_back(&d1[y1][x1]);
+      src_heap.push(&d1[y1][x1]);
       visited[n1] = true;
     } else {  // n1 is a Steiner node
       int queuehead = 0;
@@ -799,7 +733,7 @@ void FastRouteCore::setupHeap(const int netID,
 
       // add n1 into src_heap
       d1[y1][x1] = 0;
-      src_heap.push_back(&d1[y1][x1]);
+      src_heap.push(&d1[y1][x1]);
       visited[n1] = true;
 
       // add n1 into the queue
@@ -835,7 +769,7 @@ void FastRouteCore::setupHeap(const int netID,
               const int nbrX = nbr_node.x;
               const int nbrY = nbr_node.y;
               d1[nbrY][nbrX] = 0;
-              src_heap.push_back(&d1[nbrY][nbrX]);
+              src_heap.push(&d1[nbrY][nbrX]);
               corr_edge_[nbrY][nbrX] = edge;
             }
 
@@ -851,7 +785,7 @@ void FastRouteCore::setupHeap(const int netID,
 
               if (in_region_[y_grid][x_grid]) {
                 d1[y_grid][x_grid] = 0;
-                src_heap.push_back(&d1[y_grid][x_grid]);
+                src_heap.push(&d1[y_grid][x_grid]);
                 corr_edge_[y_grid][x_grid] = edge;
               }
             }
@@ -1359,24 +1293,19 @@ void FastRouteCore::mazeRouteMSMD(const int iter,
         = getCost(i, logis_cof, cost_height, slope, v_capacity_, cost_type);
   }
 
-  for (int i = 0; i < y_grid_; i++) {
-    for (int j = 0; j < x_grid_; j++)
-      in_region_[i][j] = false;
-  }
-
   if (ordering) {
     StNetOrder();
   }
 
-  std::vector<float*> src_heap;
+  // The distance buffers, heap and pop flags persist across calls.  Each
+  // edge resets d1 only inside its search window and clears the pop flags
+  // it set, so the setup cost of an edge follows its window, not the grid.
+  // d2 only marks the destination cells and is never read as a distance.
+  MazeHeap<float>& src_heap = src_heap_;
   std::vector<float*> dest_heap;
-  src_heap.reserve(y_grid_ * x_grid_);
-  dest_heap.reserve(y_grid_ * x_grid_);
-
-  multi_array<float, 2> d1(boost::extents[y_range_][x_range_]);
-  multi_array<float, 2> d2(boost::extents[y_range_][x_range_]);
-
-  std::vector<bool> pop_heap2(y_grid_ * x_range_, false);
+  multi_array<float, 2>& d1 = d1_;
+  multi_array<float, 2>& d2 = d2_;
+  std::vector<bool>& pop_heap2 = pop_heap2_;
 
   for (int nidRPC = 0; nidRPC < netCount(); nidRPC++) {
     const int netID = ordering ? tree_order_cong_[nidRPC].treeIndex : nidRPC;
@@ -1432,11 +1361,10 @@ void FastRouteCore::mazeRouteMSMD(const int iter,
       const int regionY1 = std::max(ymin - enlarge_, 0);
       const int regionY2 = std::min(ymax + enlarge_, y_grid_ - 1);
 
-      // initialize d1[][] and d2[][] as BIG_INT
+      // initialize d1[][] as BIG_INT
       for (int i = regionY1; i <= regionY2; i++) {
         for (int j = regionX1; j <= regionX2; j++) {
           d1[i][j] = BIG_INT;
-          d2[i][j] = BIG_INT;
           hyper_h_[i][j] = false;
           hyper_v_[i][j] = false;
         }
@@ -1456,7 +1384,7 @@ void FastRouteCore::mazeRouteMSMD(const int iter,
                 regionY2);
 
       // while loop to find shortest path
-      int ind1 = (src_heap[0] - &d1[0][0]);
+      int ind1 = (src_heap.top() - &d1[0][0]);
       for (int i = 0; i < dest_heap.size(); i++)
         pop_heap2[(dest_heap[i] - &d2[0][0])] = true;
 
@@ -1481,7 +1409,7 @@ void FastRouteCore::mazeRouteMSMD(const int iter,
           preY = curY;
         }
 
-        removeMin(src_heap);
+        src_heap.pop();
 
         // left
         if (curX > regionX1) {
@@ -1529,8 +1457,7 @@ void FastRouteCore::mazeRouteMSMD(const int iter,
             parent_x3_[curY][tmpX] = curX;
             parent_y3_[curY][tmpX] = curY;
             hv_[curY][tmpX] = false;
-            src_heap.push_back(&d1[curY][tmpX]);
-            updateHeap(src_heap, src_heap.size() - 1);
+            src_heap.push(&d1[curY][tmpX]);
           } else if (d1[curY][tmpX] > tmp)  // left neighbor been put into
                                             // src_heap but needs update
           {
@@ -1538,11 +1465,7 @@ void FastRouteCore::mazeRouteMSMD(const int iter,
             parent_x3_[curY][tmpX] = curX;
             parent_y3_[curY][tmpX] = curY;
             hv_[curY][tmpX] = false;
-            float* dtmp = &d1[curY][tmpX];
-            int ind = 0;
-            while (src_heap[ind] != dtmp)
-              ind++;
-            updateHeap(src_heap, ind);
+            src_heap.decrease(&d1[curY][tmpX]);
           }
         }
         // right
@@ -1590,8 +1513,7 @@ void FastRouteCore::mazeRouteMSMD(const int iter,
             parent_x3_[curY][tmpX] = curX;
             parent_y3_[curY][tmpX] = curY;
             hv_[curY][tmpX] = false;
-            src_heap.push_back(&d1[curY][tmpX]);
-            updateHeap(src_heap, src_heap.size() - 1);
+            src_heap.push(&d1[curY][tmpX]);
           } else if (d1[curY][tmpX] > tmp)  // right neighbor been put into
                                             // src_heap but needs update
           {
@@ -1599,11 +1521,7 @@ void FastRouteCore::mazeRouteMSMD(const int iter,
             parent_x3_[curY][tmpX] = curX;
             parent_y3_[curY][tmpX] = curY;
             hv_[curY][tmpX] = false;
-            float* dtmp = &d1[curY][tmpX];
-            int ind = 0;
-            while (src_heap[ind] != dtmp)
-              ind++;
-            updateHeap(src_heap, ind);
+            src_heap.decrease(&d1[curY][tmpX]);
           }
         }
         // bottom
@@ -1650,8 +1568,7 @@ void FastRouteCore::mazeRouteMSMD(const int iter,
             parent_x1_[tmpY][curX] = curX;
             parent_y1_[tmpY][curX] = curY;
             hv_[tmpY][curX] = true;
-            src_heap.push_back(&d1[tmpY][curX]);
-            updateHeap(src_heap, src_heap.size() - 1);
+            src_heap.push(&d1[tmpY][curX]);
           } else if (d1[tmpY][curX] > tmp)  // bottom neighbor been put into
                                             // src_heap but needs update
           {
@@ -1659,11 +1576,7 @@ void FastRouteCore::mazeRouteMSMD(const int iter,
             parent_x1_[tmpY][curX] = curX;
             parent_y1_[tmpY][curX] = curY;
             hv_[tmpY][curX] = true;
-            float* dtmp = &d1[tmpY][curX];
-            int ind = 0;
-            while (src_heap[ind] != dtmp)
-              ind++;
-            updateHeap(src_heap, ind);
+            src_heap.decrease(&d1[tmpY][curX]);
           }
         }
         // top
@@ -1711,8 +1624,7 @@ void FastRouteCore::mazeRouteMSMD(const int iter,
             parent_x1_[tmpY][curX] = curX;
             parent_y1_[tmpY][curX] = curY;
             hv_[tmpY][curX] = true;
-            src_heap.push_back(&d1[tmpY][curX]);
-            updateHeap(src_heap, src_heap.size() - 1);
+            src_heap.push(&d1[tmpY][curX]);
           } else if (d1[tmpY][curX] > tmp)  // top neighbor been put into
                                             // src_heap but needs update
           {
@@ -1720,16 +1632,12 @@ void FastRouteCore::mazeRouteMSMD(const int iter,
             parent_x1_[tmpY][curX] = curX;
             parent_y1_[tmpY][curX] = curY;
             hv_[tmpY][curX] = true;
-            float* dtmp = &d1[tmpY][curX];
-            int ind = 0;
-            while (src_heap[ind] != dtmp)
-              ind++;
-            updateHeap(src_heap, ind);
+            src_heap.decrease(&d1[tmpY][curX]);
           }
         }
 
         // update ind1 for next loop
-        ind1 = (src_heap[0] - &d1[0][0]);
+        ind1 = (src_heap.top() - &d1[0][0]);
 
       }  // while loop
 
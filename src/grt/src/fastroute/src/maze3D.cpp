@@ -46,75 +46,9 @@ struct parent3D
   int x, y;
 };
 
-static int parent_index(int i)
-{
-  return (i - 1) / 2;
-}
-
-static int left_index(int i)
-{
-  return 2 * i + 1;
-}
-
-static int right_index(int i)
-{
-  return 2 * i + 2;
-}
-
-// non recursive version of heapify-
-static void heapify3D(std::vector<int*>& array)
-{
-  bool stop = false;
-  const int heapSize = array.size();
-  int i = 0;
-
-  int* tmp = array[i];
-  do {
-    const int l = left_index(i);
-    const int r = right_index(i);
-
-    int smallest;
-    if (l < heapSize && *(array[l]) < *tmp) {
-      smallest = l;
-      if (r < heapSize && *(array[r]) < *(array[l]))
-        smallest = r;
-    } else {
-      smallest = i;
-      if (r < heapSize && *(array[r]) < *tmp)
-        smallest = r;
-    }
-    if (smallest != i) {
-      array[i] = array[smallest];
-      i = smallest;
-    } else {
-      array[i] = tmp;
-      stop = true;
-    }
-  } while (!stop);
-}
-
-static void updateHeap3D(std::vector<int*>& array, int i)
-{
-  int* tmpi = array[i];
-  while (i > 0 && *(array[parent_index(i)]) > *tmpi) {
-    const int parent = parent_index(i);
-    array[i] = array[parent];
-    i = parent;
-  }
-  array[i] = tmpi;
-}
-
-// extract the entry with minimum distance from Priority queue
-static void removeMin3D(std::vector<int*>& array)
-{
-  array[0] = array.back();
-  heapify3D(array);
-  array.pop_back();
-}
-
 void FastRouteCore::setupHeap3D(int netID,
                                 int edgeID,
-                                std::vector<int*>& src_heap_3D,
+                                MazeHeap<int>& src_heap_3D,
                                 std::vector<int*>& dest_heap_3D,
                                 multi_array<Direction, 3>& directions_3D,
                                 multi_array<int, 3>& corr_edge_3D,
@@ -143,7 +77,7 @@ void FastRouteCore::setupHeap3D(int netID,
   if (num_terminals == 2) {  // 2-pin net
     d1_3D[0][y1][x1] = 0;
     directions_3D[0][y1][x1] = Direction::Origin;
-    src_heap_3D.push_back(&d1_3D[0][y1][x1]);
+    src_heap_3D.push(&d1_3D[0][y1][x1]);
     d2_3D[0][y2][x2] = 0;
     directions_3D[0][y2][x2] = Direction::Origin;
     dest_heap_3D.push_back(&d2_3D[0][y2][x2]);
@@ -166,7 +100,7 @@ void FastRouteCore::setupHeap3D(int netID,
 
       for (int l = treenodes[nt].botL; l <= treenodes[nt].topL; l++) {
         d1_3D[l][y1][x1] = 0;
-        src_heap_3D.push_back(&d1_3D[l][y1][x1]);
+        src_heap_3D.push(&d1_3D[l][y1][x1]);
         directions_3D[l][y1][x1] = Direction::Origin;
         heapVisited[n1] = true;
       }
@@ -180,7 +114,7 @@ void FastRouteCore::setupHeap3D(int netID,
       for (int l = treenodes[nt].botL; l <= treenodes[nt].topL; l++) {
         d1_3D[l][y1][x1] = 0;
         directions_3D[l][y1][x1] = Direction::Origin;
-        src_heap_3D.push_back(&d1_3D[l][y1][x1]);
+        src_heap_3D.push(&d1_3D[l][y1][x1]);
         heapVisited[n1] = true;
       }
 
@@ -218,7 +152,7 @@ void FastRouteCore::setupHeap3D(int netID,
               for (int l = treenodes[nt].botL; l <= treenodes[nt].topL; l++) {
                 d1_3D[l][nbrY][nbrX] = 0;
                 directions_3D[l][nbrY][nbrX] = Direction::Origin;
-                src_heap_3D.push_back(&d1_3D[l][nbrY][nbrX]);
+                src_heap_3D.push(&d1_3D[l][nbrY][nbrX]);
                 corr_edge_3D[l][nbrY][nbrX] = edge;
               }
             }
@@ -235,7 +169,7 @@ void FastRouteCore::setupHeap3D(int netID,
 
                 if (in_region_[y_grid][x_grid]) {
                   d1_3D[l_grid][y_grid][x_grid] = 0;
-                  src_heap_3D.push_back(&d1_3D[l_grid][y_grid][x_grid]);
+                  src_heap_3D.push(&d1_3D[l_grid][y_grid][x_grid]);
                   directions_3D[l_grid][y_grid][x_grid] = Direction::Origin;
                   corr_edge_3D[l_grid][y_grid][x_grid] = edge;
                 }
@@ -862,23 +796,17 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
 
   std::vector<bool> pop_heap2_3D(num_layers_ * y_range_ * x_range_, false);
 
-  // allocate memory for priority queue
-  std::vector<int*> src_heap_3D;
-  std::vector<int*> dest_heap_3D;
-  src_heap_3D.resize(y_grid_ * x_grid_ * num_layers_);
-  dest_heap_3D.resize(y_grid_ * x_grid_ * num_layers_);
-
-  for (int i = 0; i < y_grid_; i++) {
-    for (int j = 0; j < x_grid_; j++) {
-      in_region_[i][j] = false;
-    }
-  }
-
   const int endIND = tree_order_pv_.size() * 0.9;
 
+  // d2_3D only marks the destination cells and is never read as a distance.
   multi_array<int, 3> d1_3D(boost::extents[num_layers_][y_range_][x_range_]);
   multi_array<int, 3> d2_3D(boost::extents[num_layers_][y_range_][x_range_]);
 
+  // allocate memory for priority queue
+  MazeHeap<int> src_heap_3D;
+  std::vector<int*> dest_heap_3D;
+  src_heap_3D.init(&d1_3D[0][0][0], d1_3D.num_elements());
+
   for (int orderIndex = 0; orderIndex < endIND; orderIndex++) {
     const int netID = tree_order_pv_[orderIndex].treeIndex;
     FrNet* net = nets_[netID];
@@ -935,7 +863,6 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
         for (int i = regionY1; i <= regionY2; i++) {
           for (int j = regionX1; j <= regionX2; j++) {
             d1_3D[k][i][j] = BIG_INT;
-            d2_3D[k][i][j] = BIG_INT;
           }
         }
       }
@@ -956,7 +883,7 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
                   regionY2);
 
       // while loop to find shortest path
-      int ind1 = (src_heap_3D[0] - &d1_3D[0][0][0]);
+      int ind1 = (src_heap_3D.top() - &d1_3D[0][0][0]);
 
       for (int i = 0; i < dest_heap_3D.size(); i++)
         pop_heap2_3D[dest_heap_3D[i] - &d2_3D[0][0][0]] = true;
@@ -971,7 +898,7 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
         const int remd = ind1 % (grid_hv_);
         const int curX = remd % x_range_;
         const int curY = remd / x_range_;
-        removeMin3D(src_heap_3D);
+        src_heap_3D.pop();
 
         const bool Horizontal = (((curL % 2) - layerOrientation) == 0);
 
@@ -993,8 +920,7 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
                 pr_3D_[curL][curY][tmpX].x = curX;
                 pr_3D_[curL][curY][tmpX].y = curY;
                 directions_3D[curL][curY][tmpX] = Direction::West;
-                src_heap_3D.push_back(&d1_3D[curL][curY][tmpX]);
-                updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
+                src_heap_3D.push(&d1_3D[curL][curY][tmpX]);
               } else if (d1_3D[curL][curY][tmpX]
                          > tmp)  // left neighbor been put into src_heap_3D
                                  // but needs update
@@ -1004,11 +930,7 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
                 pr_3D_[curL][curY][tmpX].x = curX;
                 pr_3D_[curL][curY][tmpX].y = curY;
                 directions_3D[curL][curY][tmpX] = Direction::West;
-                const int* dtmp = &d1_3D[curL][curY][tmpX];
-                int ind = 0;
-                while (src_heap_3D[ind] != dtmp)
-                  ind++;
-                updateHeap3D(src_heap_3D, ind);
+                src_heap_3D.decrease(&d1_3D[curL][curY][tmpX]);
               }
             }
           }
@@ -1030,8 +952,7 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
                 pr_3D_[curL][curY][tmpX].x = curX;
                 pr_3D_[curL][curY][tmpX].y = curY;
                 directions_3D[curL][curY][tmpX] = Direction::East;
-                src_heap_3D.push_back(&d1_3D[curL][curY][tmpX]);
-                updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
+                src_heap_3D.push(&d1_3D[curL][curY][tmpX]);
               } else if (d1_3D[curL][curY][tmpX]
                          > tmp)  // right neighbor been put into src_heap_3D
                                  // but needs update
@@ -1041,11 +962,7 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
                 pr_3D_[curL][curY][tmpX].x = curX;
                 pr_3D_[curL][curY][tmpX].y = curY;
                 directions_3D[curL][curY][tmpX] = Direction::East;
-                const int* dtmp = &d1_3D[curL][curY][tmpX];
-                int ind = 0;
-                while (src_heap_3D[ind] != dtmp)
-                  ind++;
-                updateHeap3D(src_heap_3D, ind);
+                src_heap_3D.decrease(&d1_3D[curL][curY][tmpX]);
               }
             }
           }
@@ -1067,8 +984,7 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
                 pr_3D_[curL][tmpY][curX].x = curX;
                 pr_3D_[curL][tmpY][curX].y = curY;
                 directions_3D[curL][tmpY][curX] = Direction::North;
-                src_heap_3D.push_back(&d1_3D[curL][tmpY][curX]);
-                updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
+                src_heap_3D.push(&d1_3D[curL][tmpY][curX]);
               } else if (d1_3D[curL][tmpY][curX]
                          > tmp)  // bottom neighbor been put into
                                  // src_heap_3D but needs update
@@ -1078,11 +994,7 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
                 pr_3D_[curL][tmpY][curX].x = curX;
                 pr_3D_[curL][tmpY][curX].y = curY;
                 directions_3D[curL][tmpY][curX] = Direction::North;
-                const int* dtmp = &d1_3D[curL][tmpY][curX];
-                int ind = 0;
-                while (src_heap_3D[ind] != dtmp)
-                  ind++;
-                updateHeap3D(src_heap_3D, ind);
+                src_heap_3D.decrease(&d1_3D[curL][tmpY][curX]);
               }
             }
           }
@@ -1102,8 +1014,7 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
                 pr_3D_[curL][tmpY][curX].x = curX;
                 pr_3D_[curL][tmpY][curX].y = curY;
                 directions_3D[curL][tmpY][curX] = Direction::South;
-                src_heap_3D.push_back(&d1_3D[curL][tmpY][curX]);
-                updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
+                src_heap_3D.push(&d1_3D[curL][tmpY][curX]);
               } else if (d1_3D[curL][tmpY][curX]
                          > tmp)  // top neighbor been put into src_heap_3D
                                  // but needs update
@@ -1113,11 +1024,7 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
                 pr_3D_[curL][tmpY][curX].x = curX;
                 pr_3D_[curL][tmpY][curX].y = curY;
                 directions_3D[curL][tmpY][curX] = Direction::South;
-                const int* dtmp = &d1_3D[curL][tmpY][curX];
-                int ind = 0;
-                while (src_heap_3D[ind] != dtmp)
-                  ind++;
-                updateHeap3D(src_heap_3D, ind);
+                src_heap_3D.decrease(&d1_3D[curL][tmpY][curX]);
               }
             }
           }
@@ -1136,8 +1043,7 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
             pr_3D_[tmpL][curY][curX].x = curX;
             pr_3D_[tmpL][curY][curX].y = curY;
             directions_3D[tmpL][curY][curX] = Direction::Down;
-            src_heap_3D.push_back(&d1_3D[tmpL][curY][curX]);
-            updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
+            src_heap_3D.push(&d1_3D[tmpL][curY][curX]);
           } else if (d1_3D[tmpL][curY][curX]
                      > tmp)  // bottom neighbor been put into src_heap_3D
                              // but needs update
@@ -1147,11 +1053,7 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
             pr_3D_[tmpL][curY][curX].x = curX;
             pr_3D_[tmpL][curY][curX].y = curY;
             directions_3D[tmpL][curY][curX] = Direction::Down;
-            const int* dtmp = &d1_3D[tmpL][curY][curX];
-            int ind = 0;
-            while (src_heap_3D[ind] != dtmp)
-              ind++;
-            updateHeap3D(src_heap_3D, ind);
+            src_heap_3D.decrease(&d1_3D[tmpL][curY][curX]);
           }
         }
 
@@ -1168,8 +1070,7 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
             pr_3D_[tmpL][curY][curX].x = curX;
             pr_3D_[tmpL][curY][curX].y = curY;
             directions_3D[tmpL][curY][curX] = Direction::Up;
-            src_heap_3D.push_back(&d1_3D[tmpL][curY][curX]);
-            updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
+            src_heap_3D.push(&d1_3D[tmpL][curY][curX]);
           } else if (d1_3D[tmpL][curY][curX]
                      > tmp)  // bottom neighbor been put into src_heap_3D
                              // but needs update
@@ -1179,11 +1080,7 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
             pr_3D_[tmpL][curY][curX].x = curX;
             pr_3D_[tmpL][curY][curX].y = curY;
             directions_3D[tmpL][curY][curX] = Direction::Up;
-            const int* dtmp = &d1_3D[tmpL][curY][curX];
-            int ind = 0;
-            while (src_heap_3D[ind] != dtmp)
-              ind++;
-            updateHeap3D(src_heap_3D, ind);
+            src_heap_3D.decrease(&d1_3D[tmpL][curY][curX]);
           }
         }
 
@@ -1194,7 +1091,7 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
                          nets_[netID]->getName());
         }
         // update ind1 for next loop
-        ind1 = (src_heap_3D[0] - &d1_3D[0][0][0]);
+        ind1 = (src_heap_3D.top() - &d1_3D[0][0][0]);
       }  // while loop
 
       for (int i = 0; i < dest_heap_3D.size(); i++)
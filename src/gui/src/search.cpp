@@ -32,6 +32,7 @@
 
 #include "search.h"
 
+#include <iterator>
 #include <tuple>
 #include <utility>
 
@@ -48,91 +49,161 @@ Search::~Search()
 
 void Search::inDbNetDestroy(odb::dbNet* net)
 {
-  clearShapes();
+  if (!shapes_init_) {
+    return;
+  }
+  modified_nets_.erase(net);
+  removeShapes(net);
+  emit modified();
 }
 
 void Search::inDbInstDestroy(odb::dbInst* inst)
 {
-  if (inst->isPlaced()) {
-    clearInsts();
+  if (insts_init_ && inst->isPlaced()) {
+    removeInst(inst);
+    emit modified();
+  }
+}
+
+void Search::inDbInstSwapMasterBefore(odb::dbInst* inst, odb::dbMaster* master)
+{
+  if (insts_init_ && inst->isPlaced()) {
+    removeInst(inst);
   }
 }
 
 void Search::inDbInstSwapMasterAfter(odb::dbInst* inst)
 {
-  if (inst->isPlaced()) {
-    clearInsts();
+  if (insts_init_ && inst->isPlaced()) {
+    addInst(inst);
+    emit modified();
   }
 }
 
 void Search::inDbInstPlacementStatusBefore(odb::dbInst* inst,
                                            const odb::dbPlacementStatus& status)
 {
-  if (inst->getPlacementStatus().isPlaced() != status.isPlaced()) {
-    clearInsts();
+  const bool is_placed = inst->getPlacementStatus().isPlaced();
+  if (!insts_init_ || is_placed == status.isPlaced()) {
+    return;
+  }
+  if (is_placed) {
+    removeInst(inst);
+  } else {
+    addInst(inst);
+  }
+  emit modified();
+}
+
+void Search::inDbPreMoveInst(odb::dbInst* inst)
+{
+  if (insts_init_ && inst->isPlaced()) {
+    removeInst(inst);
   }
 }
 
 void Search::inDbPostMoveInst(odb::dbInst* inst)
 {
-  if (inst->isPlaced()) {
-    clearInsts();
+  if (insts_init_ && inst->isPlaced()) {
+    addInst(inst);
+    emit modified();
+  }
+}
+
+void Search::inDbBPinCreate(odb::dbBPin* pin)
+{
+  odb::dbNet* net = pin->getBTerm()->getNet();
+  if (net == nullptr) {
+    // shapes of unconnected pins can't be told apart
+    clearShapes();
+  } else {
+    markNetModified(net);
   }
 }
 
 void Search::inDbBPinDestroy(odb::dbBPin* pin)
 {
-  clearShapes();
+  odb::dbNet* net = pin->getBTerm()->getNet();
+  if (net == nullptr) {
+    clearShapes();
+  } else {
+    markNetModified(net);
+  }
 }
 
 void Search::inDbFillCreate(odb::dbFill* fill)
 {
-  clearFills();
+  if (fills_init_) {
+    addFill(fill);
+    emit modified();
+  }
+}
+
+void Search::inDbFillDestroy(odb::dbFill* fill)
+{
+  if (fills_init_) {
+    removeFill(fill);
+    emit modified();
+  }
 }
 
 void Search::inDbWireCreate(odb::dbWire* wire)
 {
-  clearShapes();
+  markNetModified(wire->getNet());
 }
 
 void Search::inDbWireDestroy(odb::dbWire* wire)
 {
-  clearShapes();
+  markNetModified(wire->getNet());
+}
+
+void Search::inDbWirePostEncode(odb::dbWire* wire)
+{
+  markNetModified(wire->getNet());
 }
 
 void Search::inDbSWireCreate(odb::dbSWire* wire)
 {
-  clearShapes();
+  markNetModified(wire->getNet());
 }
 
 void Search::inDbSWireDestroy(odb::dbSWire* wire)
 {
-  clearShapes();
+  markNetModified(wire->getNet());
 }
 
 void Search::inDbSWireAddSBox(odb::dbSBox* box)
 {
-  clearShapes();
+  markNetModified(box->getSWire()->getNet());
 }
 
 void Search::inDbSWireRemoveSBox(odb::dbSBox* box)
 {
-  clearShapes();
+  markNetModified(box->getSWire()->getNet());
 }
 
 void Search::inDbBlockageCreate(odb::dbBlockage* blockage)
 {
-  clearBlockages();
+  if (blockages_init_) {
+    addBlockage(blockage);
+    emit modified();
+  }
 }
 
 void Search::inDbObstructionCreate(odb::dbObstruction* obs)
 {
-  clearObstructions();
+  if (obstructions_init_) {
+    addObstruction(obs);
+    emit modified();
+  }
 }
 
 void Search::inDbObstructionDestroy(odb::dbObstruction* obs)
 {
-  clearObstructions();
+  if (obstructions_init_) {
+    removeObstruction(obs);
+    emit modified();
+  }
 }
 
 void Search::inDbBlockSetDieArea(odb::dbBlock* block)
@@ -152,12 +223,18 @@ void Search::inDbRegionDestroy(odb::dbRegion* region)
 
 void Search::inDbRowCreate(odb::dbRow* row)
 {
-  clearRows();
+  if (rows_init_) {
+    addRow(row);
+    emit modified();
+  }
 }
 
 void Search::inDbRowDestroy(odb::dbRow* row)
 {
-  clearRows();
+  if (rows_init_) {
+    removeRow(row);
+    emit modified();
+  }
 }
 
 void Search::setBlock(odb::dbBlock* block)
@@ -228,10 +305,36 @@ void Search::clearRows()
   announceModified(rows_init_);
 }
 
+void Search::markNetModified(odb::dbNet* net)
+{
+  if (!shapes_init_ || net == nullptr) {
+    return;
+  }
+  modified_nets_.insert(net);
+  emit modified();
+}
+
+void Search::updateModifiedNets()
+{
+  for (odb::dbNet* net : modified_nets_) {
+    removeShapes(net);
+    addNet(net);
+    addSNet(net);
+    for (odb::dbBTerm* term : net->getBTerms()) {
+      addBTerm(term);
+    }
+  }
+  modified_nets_.clear();
+
+  flushShapes();
+}
+
 void Search::updateShapes()
 {
   box_shapes_.clear();
   polygon_shapes_.clear();
+  net_bboxes_.clear();
+  modified_nets_.clear();
 
   for (odb::dbNet* net : block_->getNets()) {
     addNet(net);
@@ -239,36 +342,24 @@ void Search::updateShapes()
   }
 
   for (odb::dbBTerm* term : block_->getBTerms()) {
-    for (odb::dbBPin* pin : term->getBPins()) {
-      odb::dbPlacementStatus status = pin->getPlacementStatus();
-      if (status == odb::dbPlacementStatus::NONE
-          || status == odb::dbPlacementStatus::UNPLACED) {
-        continue;
-      }
-      for (odb::dbBox* box : pin->getBoxes()) {
-        if (!box) {
-          continue;
-        }
-        Box bbox(Point(box->xMin(), box->yMin()),
-                 Point(box->xMax(), box->yMax()));
-        odb::dbTechLayer* layer = box->getTechLayer();
-        box_shapes_[layer].insert({bbox, term->getNet()});
-      }
-    }
+    addBTerm(term);
   }
 
+  flushShapes();
+
   shapes_init_ = true;
 }
 
 void Search::updateFills()
 {
-  fills_.clear();
-
+  std::map<odb::dbTechLayer*, std::vector<BoxValue<odb::dbFill*>>> fills;
   for (odb::dbFill* fill : block_->getFills()) {
-    odb::Rect rect;
-    fill->getRect(rect);
-    Box box(Point(rect.xMin(), rect.yMin()), Point(rect.xMax(), rect.yMax()));
-    fills_[fill->getTechLayer()].insert({box, fill});
+    fills[fill->getTechLayer()].push_back(fillValue(fill));
+  }
+
+  fills_.clear();
+  for (auto& [layer, values] : fills) {
+    fills_.emplace(layer, RtreeBox<odb::dbFill*>(values.begin(), values.end()));
   }
 
   fills_init_ = true;
@@ -276,34 +367,44 @@ void Search::updateFills()
 
 void Search::updateInsts()
 {
-  insts_.clear();
-
+  std::vector<BoxValue<odb::dbInst*>> insts;
+  insts.reserve(block_->getInsts().size());
   for (odb::dbInst* inst : block_->getInsts()) {
     if (inst->isPlaced()) {
-      addInst(inst);
+      insts.push_back(instValue(inst));
     }
   }
 
+  insts_ = RtreeBox<odb::dbInst*>(insts.begin(), insts.end());
+
   insts_init_ = true;
 }
 
 void Search::updateBlockages()
 {
-  blockages_.clear();
-
+  std::vector<BoxValue<odb::dbBlockage*>> blockages;
   for (odb::dbBlockage* blockage : block_->getBlockages()) {
-    addBlockage(blockage);
+    blockages.push_back(blockageValue(blockage));
   }
 
+  blockages_ = RtreeBox<odb::dbBlockage*>(blockages.begin(), blockages.end());
+
   blockages_init_ = true;
 }
 
 void Search::updateObstructions()
 {
-  obstructions_.clear();
-
+  std::map<odb::dbTechLayer*, std::vector<BoxValue<odb::dbObstruction*>>>
+      obstructions;
   for (odb::dbObstruction* obs : block_->getObstructions()) {
-    addObstruction(obs);
+    obstructions[obs->getBBox()->getTechLayer()].push_back(
+        obstructionValue(obs));
+  }
+
+  obstructions_.clear();
+  for (auto& [layer, values] : obstructions) {
+    obstructions_.emplace(
+        layer, RtreeBox<odb::dbObstruction*>(values.begin(), values.end()));
   }
 
   obstructions_init_ = true;
@@ -311,15 +412,96 @@ void Search::updateObstructions()
 
 void Search::updateRows()
 {
-  rows_.clear();
-
+  std::vector<BoxValue<odb::dbRow*>> rows;
   for (odb::dbRow* row : block_->getRows()) {
-    addRow(row);
+    rows.push_back(rowValue(row));
   }
 
+  rows_ = RtreeBox<odb::dbRow*>(rows.begin(), rows.end());
+
   rows_init_ = true;
 }
 
+void Search::addShape(odb::dbTechLayer* layer, const Box& box, odb::dbNet* net)
+{
+  pending_box_shapes_[layer].emplace_back(box, net);
+
+  auto [it, inserted] = net_bboxes_.emplace(net, box);
+  if (!inserted) {
+    bg::expand(it->second, box);
+  }
+}
+
+void Search::addShape(odb::dbTechLayer* layer,
+                      const Box& box,
+                      const Polygon& poly,
+                      odb::dbNet* net)
+{
+  pending_polygon_shapes_[layer].emplace_back(box, poly, net);
+
+  auto [it, inserted] = net_bboxes_.emplace(net, box);
+  if (!inserted) {
+    bg::expand(it->second, box);
+  }
+}
+
+void Search::flushShapes()
+{
+  // An empty tree is bulk loaded, which packs it much better than
+  // inserting one shape at a time.
+  for (auto& [layer, values] : pending_box_shapes_) {
+    auto& rtree = box_shapes_[layer];
+    if (rtree.empty()) {
+      rtree = RtreeBox<odb::dbNet*>(values.begin(), values.end());
+    } else {
+      rtree.insert(values.begin(), values.end());
+    }
+  }
+  pending_box_shapes_.clear();
+
+  for (auto& [layer, values] : pending_polygon_shapes_) {
+    auto& rtree = polygon_shapes_[layer];
+    if (rtree.empty()) {
+      rtree = RtreePolygon<odb::dbNet*>(values.begin(), values.end());
+    } else {
+      rtree.insert(values.begin(), values.end());
+    }
+  }
+  pending_polygon_shapes_.clear();
+}
+
+void Search::removeShapes(odb::dbNet* net)
+{
+  auto bbox_it = net_bboxes_.find(net);
+  if (bbox_it == net_bboxes_.end()) {
+    return;
+  }
+  const Box& bbox = bbox_it->second;
+
+  auto is_net = [net](const auto& value) { return std::get<1>(value) == net; };
+  for (auto& [layer, rtree] : box_shapes_) {
+    std::vector<BoxValue<odb::dbNet*>> values;
+    rtree.query(bgi::intersects(bbox) && bgi::satisfies(is_net),
+                std::back_inserter(values));
+    for (const auto& value : values) {
+      rtree.remove(value);
+    }
+  }
+
+  auto is_poly_net
+      = [net](const auto& value) { return std::get<2>(value) == net; };
+  for (auto& [layer, rtree] : polygon_shapes_) {
+    std::vector<PolygonValue<odb::dbNet*>> values;
+    rtree.query(bgi::intersects(bbox) && bgi::satisfies(is_poly_net),
+                std::back_inserter(values));
+    for (const auto& value : values) {
+      rtree.remove(value);
+    }
+  }
+
+  net_bboxes_.erase(bbox_it);
+}
+
 void Search::addVia(odb::dbNet* net, odb::dbShape* shape, int x, int y)
 {
   if (shape->getType() == odb::dbShape::TECH_VIA) {
@@ -328,7 +510,7 @@ void Search::addVia(odb::dbNet* net, odb::dbShape* shape, int x, int y)
       Point ll(x + box->xMin(), y + box->yMin());
       Point ur(x + box->xMax(), y + box->yMax());
       Box bbox(ll, ur);
-      box_shapes_[box->getTechLayer()].insert({bbox, net});
+      addShape(box->getTechLayer(), bbox, net);
     }
   } else {
     odb::dbVia* via = shape->getVia();
@@ -336,7 +518,7 @@ void Search::addVia(odb::dbNet* net, odb::dbShape* shape, int x, int y)
       Point ll(x + box->xMin(), y + box->yMin());
       Point ur(x + box->xMax(), y + box->yMax());
       Box bbox(ll, ur);
-      box_shapes_[box->getTechLayer()].insert({bbox, net});
+      addShape(box->getTechLayer(), bbox, net);
     }
   }
 }
@@ -351,7 +533,7 @@ void Search::addSNet(odb::dbNet* net)
         for (auto& shape : shapes) {
           Box bbox(Point(shape.xMin(), shape.yMin()),
                    Point(shape.xMax(), shape.yMax()));
-          box_shapes_[shape.getTechLayer()].insert({bbox, net});
+          addShape(shape.getTechLayer(), bbox, net);
         }
       } else {
         Box bbox(Point(box->xMin(), box->yMin()),
@@ -367,7 +549,7 @@ void Search::addSNet(odb::dbNet* net)
         for (const auto& point : points) {
           bg::append(poly.outer(), Point(point.getX(), point.getY()));
         }
-        polygon_shapes_[box->getTechLayer()].insert({bbox, poly, net});
+        addShape(box->getTechLayer(), bbox, poly, net);
       }
     }
   }
@@ -388,43 +570,108 @@ void Search::addNet(odb::dbNet* net)
       addVia(net, &s, itr._prev_x, itr._prev_y);
     } else {
       Box box(Point(s.xMin(), s.yMin()), Point(s.xMax(), s.yMax()));
-      box_shapes_[s.getTechLayer()].insert({box, net});
+      addShape(s.getTechLayer(), box, net);
+    }
+  }
+}
+
+void Search::addBTerm(odb::dbBTerm* term)
+{
+  for (odb::dbBPin* pin : term->getBPins()) {
+    odb::dbPlacementStatus status = pin->getPlacementStatus();
+    if (status == odb::dbPlacementStatus::NONE
+        || status == odb::dbPlacementStatus::UNPLACED) {
+      continue;
+    }
+    for (odb::dbBox* box : pin->getBoxes()) {
+      if (!box) {
+        continue;
+      }
+      Box bbox(Point(box->xMin(), box->yMin()),
+               Point(box->xMax(), box->yMax()));
+      addShape(box->getTechLayer(), bbox, term->getNet());
     }
   }
 }
 
+Search::BoxValue<odb::dbInst*> Search::instValue(odb::dbInst* inst) const
+{
+  return {convertRect(inst->getBBox()->getBox()), inst};
+}
+
+Search::BoxValue<odb::dbFill*> Search::fillValue(odb::dbFill* fill) const
+{
+  odb::Rect rect;
+  fill->getRect(rect);
+  return {convertRect(rect), fill};
+}
+
+Search::BoxValue<odb::dbBlockage*> Search::blockageValue(
+    odb::dbBlockage* blockage) const
+{
+  return {convertRect(blockage->getBBox()->getBox()), blockage};
+}
+
+Search::BoxValue<odb::dbObstruction*> Search::obstructionValue(
+    odb::dbObstruction* obs) const
+{
+  return {convertRect(obs->getBBox()->getBox()), obs};
+}
+
+Search::BoxValue<odb::dbRow*> Search::rowValue(odb::dbRow* row) const
+{
+  return {convertRect(row->getBBox()), row};
+}
+
 void Search::addInst(odb::dbInst* inst)
 {
-  odb::dbBox* bbox = inst->getBBox();
-  Point ll(bbox->xMin(), bbox->yMin());
-  Point ur(bbox->xMax(), bbox->yMax());
-  Box box(ll, ur);
-  insts_.insert({box, inst});
+  insts_.insert(instValue(inst));
+}
+
+void Search::removeInst(odb::dbInst* inst)
+{
+  insts_.remove(instValue(inst));
+}
+
+void Search::addFill(odb::dbFill* fill)
+{
+  fills_[fill->getTechLayer()].insert(fillValue(fill));
+}
+
+void Search::removeFill(odb::dbFill* fill)
+{
+  auto it = fills_.find(fill->getTechLayer());
+  if (it != fills_.end()) {
+    it->second.remove(fillValue(fill));
+  }
 }
 
 void Search::addBlockage(odb::dbBlockage* blockage)
 {
-  odb::dbBox* bbox = blockage->getBBox();
-  Point ll(bbox->xMin(), bbox->yMin());
-  Point ur(bbox->xMax(), bbox->yMax());
-  Box box(ll, ur);
-  blockages_.insert({box, blockage});
+  blockages_.insert(blockageValue(blockage));
 }
 
 void Search::addObstruction(odb::dbObstruction* obs)
 {
-  odb::dbBox* bbox = obs->getBBox();
-  Point ll(bbox->xMin(), bbox->yMin());
-  Point ur(bbox->xMax(), bbox->yMax());
-  Box box(ll, ur);
-  obstructions_[bbox->getTechLayer()].insert({box, obs});
+  obstructions_[obs->getBBox()->getTechLayer()].insert(obstructionValue(obs));
+}
+
+void Search::removeObstruction(odb::dbObstruction* obs)
+{
+  auto it = obstructions_.find(obs->getBBox()->getTechLayer());
+  if (it != obstructions_.end()) {
+    it->second.remove(obstructionValue(obs));
+  }
 }
 
 void Search::addRow(odb::dbRow* row)
 {
-  odb::Rect bbox = row->getBBox();
-  Box box = convertRect(bbox);
-  rows_.insert({box, row});
+  rows_.insert(rowValue(row));
+}
+
+void Search::removeRow(odb::dbRow* row)
+{
+  rows_.remove(rowValue(row));
 }
 
 Search::Box Search::convertRect(const odb::Rect& box) const
@@ -490,6 +737,8 @@ Search::BoxRange Search::searchBoxShapes(odb::dbTechLayer* layer,
 {
   if (!shapes_init_) {
     updateShapes();
+  } else if (!modified_nets_.empty()) {
+    updateModifiedNets();
   }
 
   auto it = box_shapes_.find(layer);
@@ -519,6 +768,8 @@ Search::PolygonRange Search::searchPolygonShapes(odb::dbTechLayer* layer,
 {
   if (!shapes_init_) {
     updateShapes();
+  } else if (!modified_nets_.empty()) {
+    updateModifiedNets();
   }
 
   auto it = polygon_shapes_.find(layer);
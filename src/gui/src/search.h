@@ -35,6 +35,10 @@
 #include <QObject>
 #include <boost/geometry.hpp>
 #include <boost/geometry/index/rtree.hpp>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
 
 #include "odb/db.h"
 #include "odb/dbBlockCallBackObj.h"
@@ -49,8 +53,12 @@ namespace bgi = boost::geometry::index;
 // rtree.  OpenDB also has some code for this purpose but I
 // find it confusing so just made a simpler solution for now.
 //
-// Currently this class is static once built and doesn't follow
-// db changes.  TODO: this should be into an observer of OpenDB.
+// The trees are bulk loaded (packed) the first time they are searched
+// and then kept up to date from the db callbacks.  Instances, fills,
+// blockages, obstructions and rows are inserted/removed directly.  Net
+// shapes can't be, as dbWireEncoder only reports the wire as a whole once
+// it is written, so changed nets are only marked dirty and their shapes
+// are replaced at the next search.
 class Search : public QObject, public odb::dbBlockCallBackObj
 {
   Q_OBJECT
@@ -175,15 +183,21 @@ class Search : public QObject, public odb::dbBlockCallBackObj
   // From dbBlockCallBackObj
   virtual void inDbNetDestroy(odb::dbNet* net) override;
   virtual void inDbInstDestroy(odb::dbInst* inst) override;
+  virtual void inDbInstSwapMasterBefore(odb::dbInst* inst,
+                                        odb::dbMaster* master) override;
   virtual void inDbInstSwapMasterAfter(odb::dbInst* inst) override;
   virtual void inDbInstPlacementStatusBefore(
       odb::dbInst* inst,
       const odb::dbPlacementStatus& status) override;
+  virtual void inDbPreMoveInst(odb::dbInst* inst) override;
   virtual void inDbPostMoveInst(odb::dbInst* inst) override;
+  virtual void inDbBPinCreate(odb::dbBPin* pin) override;
   virtual void inDbBPinDestroy(odb::dbBPin* pin) override;
   virtual void inDbFillCreate(odb::dbFill* fill) override;
+  virtual void inDbFillDestroy(odb::dbFill* fill) override;
   virtual void inDbWireCreate(odb::dbWire* wire) override;
   virtual void inDbWireDestroy(odb::dbWire* wire) override;
+  virtual void inDbWirePostEncode(odb::dbWire* wire) override;
   virtual void inDbSWireCreate(odb::dbSWire* wire) override;
   virtual void inDbSWireDestroy(odb::dbSWire* wire) override;
   virtual void inDbSWireAddSBox(odb::dbSBox* box) override;
@@ -202,13 +216,38 @@ class Search : public QObject, public odb::dbBlockCallBackObj
   void newBlock(odb::dbBlock* block);
 
  private:
+  // Net shapes are staged by the add* methods and moved into the trees
+  // by flushShapes().
   void addSNet(odb::dbNet* net);
   void addNet(odb::dbNet* net);
   void addVia(odb::dbNet* net, odb::dbShape* shape, int x, int y);
+  void addBTerm(odb::dbBTerm* term);
+  void addShape(odb::dbTechLayer* layer, const Box& box, odb::dbNet* net);
+  void addShape(odb::dbTechLayer* layer,
+                const Box& box,
+                const Polygon& poly,
+                odb::dbNet* net);
+  void flushShapes();
+  void removeShapes(odb::dbNet* net);
+  void markNetModified(odb::dbNet* net);
+  void updateModifiedNets();
+
   void addInst(odb::dbInst* inst);
+  void removeInst(odb::dbInst* inst);
+  void addFill(odb::dbFill* fill);
+  void removeFill(odb::dbFill* fill);
   void addBlockage(odb::dbBlockage* blockage);
   void addObstruction(odb::dbObstruction* obstruction);
+  void removeObstruction(odb::dbObstruction* obstruction);
   void addRow(odb::dbRow* row);
+  void removeRow(odb::dbRow* row);
+
+  BoxValue<odb::dbInst*> instValue(odb::dbInst* inst) const;
+  BoxValue<odb::dbFill*> fillValue(odb::dbFill* fill) const;
+  BoxValue<odb::dbBlockage*> blockageValue(odb::dbBlockage* blockage) const;
+  BoxValue<odb::dbObstruction*> obstructionValue(
+      odb::dbObstruction* obs) const;
+  BoxValue<odb::dbRow*> rowValue(odb::dbRow* row) const;
 
   void updateShapes();
   void updateFills();
@@ -229,6 +268,16 @@ class Search : public QObject, public odb::dbBlockCallBackObj
   std::map<odb::dbTechLayer*, RtreeBox<odb::dbNet*>> box_shapes_;
   std::map<odb::dbTechLayer*, RtreePolygon<odb::dbNet*>> polygon_shapes_;
   bool shapes_init_{false};
+  // Shapes waiting to be loaded into the trees
+  std::map<odb::dbTechLayer*, std::vector<BoxValue<odb::dbNet*>>>
+      pending_box_shapes_;
+  std::map<odb::dbTechLayer*, std::vector<PolygonValue<odb::dbNet*>>>
+      pending_polygon_shapes_;
+  // Bounding box of the shapes of each net in the trees, used to find
+  // them again for removal.
+  std::unordered_map<odb::dbNet*, Box> net_bboxes_;
+  // Nets whose shapes are out of date
+  std::set<odb::dbNet*> modified_nets_;
   std::map<odb::dbTechLayer*, RtreeBox<odb::dbFill*>> fills_;
   bool fills_init_{false};
   RtreeBox<odb::dbInst*> insts_;
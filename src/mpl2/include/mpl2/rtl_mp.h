@@ -45,6 +45,7 @@ class dbSta;
 }  // namespace sta
 
 namespace utl {
+class Executor;
 class Logger;
 }
 
@@ -66,7 +67,8 @@ class MacroPlacer2
             odb::dbDatabase* db,
             sta::dbSta* sta,
             utl::Logger* logger,
-            par::PartitionMgr* tritonpart);
+            par::PartitionMgr* tritonpart,
+            utl::Executor* executor);
 
   bool place(const int max_num_macro,
              const int min_num_macro,
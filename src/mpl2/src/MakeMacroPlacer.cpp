@@ -63,7 +63,8 @@ void initMacroPlacer2(OpenRoad* openroad)
                                     openroad->getDb(),
                                     openroad->getSta(),
                                     openroad->getLogger(),
-                                    openroad->getPartitionMgr());
+                                    openroad->getPartitionMgr(),
+                                    openroad->getExecutor());
 }
 
 void deleteMacroPlacer2(mpl2::MacroPlacer2* macro_placer)
@@ -218,6 +218,8 @@ void SACoreHardMacro::restore()
   wirelength_ = pre_wirelength_;
   guidance_penalty_ = pre_guidance_penalty_;
   fence_penalty_ = pre_fence_penalty_;
+
+  restoreIncrementalCost();
 }
 
 void SACoreHardMacro::initialize()
@@ -103,6 +103,12 @@ SACoreSoftMacro::SACoreSoftMacro(
   adjust_h_th_ = notch_h_th_;
   adjust_v_th_ = notch_v_th_;
   logger_ = logger;
+
+  boundary_terms_.reset(macros_.size());
+  macro_blockage_terms_.reset(macros_.size());
+  for (const auto& macro : macros_) {
+    tot_num_macros_ += macro.getNumMacro();
+  }
 }
 
 // acessors functions
@@ -268,6 +274,10 @@ void SACoreSoftMacro::restore()
   boundary_penalty_ = pre_boundary_penalty_;
   macro_blockage_penalty_ = pre_macro_blockage_penalty_;
   notch_penalty_ = pre_notch_penalty_;
+
+  restoreIncrementalCost();
+  boundary_terms_.undo();
+  macro_blockage_terms_.undo();
 }
 
 void SACoreSoftMacro::initialize()
@@ -366,19 +376,17 @@ void SACoreSoftMacro::calBoundaryPenalty()
 {
   // Initialization
   boundary_penalty_ = 0.0;
+  boundary_terms_.clearJournal();
   if (boundary_weight_ <= 0.0) {
     return;
   }
 
-  int tot_num_macros = 0;
-  for (const auto& macro : macros_) {
-    tot_num_macros += macro.getNumMacro();
-  }
-  if (tot_num_macros <= 0) {
+  if (tot_num_macros_ <= 0) {
     return;
   }
 
-  for (const auto& macro : macros_) {
+  for (const int macro_id : changed_macros_) {
+    const SoftMacro& macro = macros_[macro_id];
     if (macro.getNumMacro() > 0) {
       const float lx = macro.getX();
       const float ly = macro.getY();
@@ -386,11 +394,12 @@ void SACoreSoftMacro::calBoundaryPenalty()
       const float uy = ly + macro.getHeight();
       const float x_dist = std::min(lx, std::abs(outline_width_ - ux));
       const float y_dist = std::min(ly, std::abs(outline_height_ - uy));
-      boundary_penalty_ += std::min(x_dist, y_dist) * macro.getNumMacro();
+      boundary_terms_.set(macro_id,
+                          std::min(x_dist, y_dist) * macro.getNumMacro());
     }
   }
   // normalization
-  boundary_penalty_ = boundary_penalty_ / tot_num_macros;
+  boundary_penalty_ = boundary_terms_.sum() / tot_num_macros_;
   if (graphics_) {
     graphics_->setBoundaryPenalty(boundary_penalty_);
   }
@@ -399,46 +408,44 @@ void SACoreSoftMacro::calBoundaryPenalty()
 void SACoreSoftMacro::calMacroBlockagePenalty()
 {
   macro_blockage_penalty_ = 0.0;
+  macro_blockage_terms_.clearJournal();
   if (blockages_.size() == 0 || macro_blockage_weight_ <= 0.0) {
     return;
   }
 
-  int tot_num_macros = 0;
-  for (const auto& macro : macros_) {
-    tot_num_macros += macro.getNumMacro();
-  }
-  if (tot_num_macros <= 0) {
+  if (tot_num_macros_ <= 0) {
     return;
   }
 
-  for (auto& bbox : blockages_) {
-    for (const auto& macro : macros_) {
-      if (macro.getNumMacro() > 0) {
-        const float lx = macro.getX();
-        const float ly = macro.getY();
-        const float ux = lx + macro.getWidth();
-        const float uy = ly + macro.getHeight();
-        const float region_lx = bbox.xMin();
-        const float region_ly = bbox.yMin();
-        const float region_ux = bbox.xMax();
-        const float region_uy = bbox.yMax();
-        // check each dimension seperately
-        // center to center distance
-        const float width = ((ux - lx) + (region_ux - region_lx)) / 2.0;
-        const float height = ((uy - ly) + (region_uy - region_ly)) / 2.0;
-        float x_dist
-            = std::abs((region_ux + region_lx) / 2.0 - (ux + lx) / 2.0);
-        float y_dist
-            = std::abs((region_uy + region_ly) / 2.0 - (uy + ly) / 2.0);
-        x_dist = std::max(width - x_dist, 0.0f) / width;
-        y_dist = std::max(height - y_dist, 0.0f) / height;
-        macro_blockage_penalty_
-            += (x_dist * x_dist + y_dist * y_dist) * macro.getNumMacro();
-      }
+  for (const int macro_id : changed_macros_) {
+    const SoftMacro& macro = macros_[macro_id];
+    if (macro.getNumMacro() <= 0) {
+      continue;
+    }
+    const float lx = macro.getX();
+    const float ly = macro.getY();
+    const float ux = lx + macro.getWidth();
+    const float uy = ly + macro.getHeight();
+    float penalty = 0.0;
+    for (auto& bbox : blockages_) {
+      const float region_lx = bbox.xMin();
+      const float region_ly = bbox.yMin();
+      const float region_ux = bbox.xMax();
+      const float region_uy = bbox.yMax();
+      // check each dimension seperately
+      // center to center distance
+      const float width = ((ux - lx) + (region_ux - region_lx)) / 2.0;
+      const float height = ((uy - ly) + (region_uy - region_ly)) / 2.0;
+      float x_dist = std::abs((region_ux + region_lx) / 2.0 - (ux + lx) / 2.0);
+      float y_dist = std::abs((region_uy + region_ly) / 2.0 - (uy + ly) / 2.0);
+      x_dist = std::max(width - x_dist, 0.0f) / width;
+      y_dist = std::max(height - y_dist, 0.0f) / height;
+      penalty += (x_dist * x_dist + y_dist * y_dist) * macro.getNumMacro();
     }
+    macro_blockage_terms_.set(macro_id, penalty);
   }
   // normalization
-  macro_blockage_penalty_ = macro_blockage_penalty_ / tot_num_macros;
+  macro_blockage_penalty_ = macro_blockage_terms_.sum() / tot_num_macros_;
   if (graphics_) {
     graphics_->setMacroBlockagePenalty(macro_blockage_penalty_);
   }
@@ -98,6 +98,7 @@ class SACoreSoftMacro : public SimulatedAnnealingCore<SoftMacro>
   void setBlockages(const std::vector<Rect>& blockages)
   {
     blockages_ = blockages;
+    invalidateEvaluation();
   }
 
  private:
@@ -151,6 +152,11 @@ class SACoreSoftMacro : public SimulatedAnnealingCore<SoftMacro>
   float norm_notch_penalty_ = 0.0;
   float norm_macro_blockage_penalty_ = 0.0;
 
+  // per macro terms of the boundary and macro blockage penalties
+  IncrementalSum boundary_terms_;
+  IncrementalSum macro_blockage_terms_;
+  int tot_num_macros_ = 0;  // number of hard macros in all the clusters
+
   // action prob
   float resize_prob_ = 0.0;
 };
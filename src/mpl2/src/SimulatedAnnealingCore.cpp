@@ -35,6 +35,7 @@
 
 #include <fstream>
 #include <iostream>
+#include <limits>
 
 #include "graphics.h"
 #include "object.h"
@@ -110,6 +111,12 @@ SimulatedAnnealingCore<T>::SimulatedAnnealingCore(
     pre_pos_seq_.push_back(i);
     pre_neg_seq_.push_back(i);
   }
+
+  evaluated_macros_.resize(macros.size());
+  invalidateEvaluation();
+  macro_nets_.resize(macros.size());
+  guidance_terms_.reset(macros.size());
+  fence_terms_.reset(macros.size());
 }
 
 // access functions
@@ -117,18 +124,33 @@ template <class T>
 void SimulatedAnnealingCore<T>::setNets(const std::vector<BundledNet>& nets)
 {
   nets_ = nets;
+  tot_net_weight_ = 0.0;
+  for (auto& net_ids : macro_nets_) {
+    net_ids.clear();
+  }
+  for (int i = 0; i < nets_.size(); i++) {
+    tot_net_weight_ += nets_[i].weight;
+    macro_nets_[nets_[i].terminals.first].push_back(i);
+    if (nets_[i].terminals.second != nets_[i].terminals.first) {
+      macro_nets_[nets_[i].terminals.second].push_back(i);
+    }
+  }
+  wirelength_terms_.reset(nets_.size());
+  invalidateEvaluation();
 }
 
 template <class T>
 void SimulatedAnnealingCore<T>::setFences(const std::map<int, Rect>& fences)
 {
   fences_ = fences;
+  invalidateEvaluation();
 }
 
 template <class T>
 void SimulatedAnnealingCore<T>::setGuides(const std::map<int, Rect>& guides)
 {
   guides_ = guides;
+  invalidateEvaluation();
 }
 
 template <class T>
@@ -239,30 +261,32 @@ void SimulatedAnnealingCore<T>::calWirelength()
 {
   // Initialization
   wirelength_ = 0.0;
+  wirelength_terms_.clearJournal();
   if (wirelength_weight_ <= 0.0) {
     return;
   }
 
-  // calculate the total net weight
-  float tot_net_weight = 0.0;
-  for (const auto& net : nets_)
-    tot_net_weight += net.weight;
-
-  if (tot_net_weight <= 0.0) {
+  if (tot_net_weight_ <= 0.0) {
     return;
   }
 
-  for (const auto& net : nets_) {
-    const float x1 = macros_[net.terminals.first].getPinX();
-    const float y1 = macros_[net.terminals.first].getPinY();
-    const float x2 = macros_[net.terminals.second].getPinX();
-    const float y2 = macros_[net.terminals.second].getPinY();
-    wirelength_ += net.weight * (std::abs(x2 - x1) + std::abs(y2 - y1));
+  // only the nets of the macros moved by the last perturb change
+  for (const int macro_id : changed_macros_) {
+    for (const int net_id : macro_nets_[macro_id]) {
+      const BundledNet& net = nets_[net_id];
+      const float x1 = macros_[net.terminals.first].getPinX();
+      const float y1 = macros_[net.terminals.first].getPinY();
+      const float x2 = macros_[net.terminals.second].getPinX();
+      const float y2 = macros_[net.terminals.second].getPinY();
+      wirelength_terms_.set(
+          net_id, net.weight * (std::abs(x2 - x1) + std::abs(y2 - y1)));
+    }
   }
+  wirelength_ = wirelength_terms_.sum();
 
   // normalization
   wirelength_
-      = wirelength_ / tot_net_weight / (outline_height_ + outline_width_);
+      = wirelength_ / tot_net_weight_ / (outline_height_ + outline_width_);
 
   if (graphics_) {
     graphics_->setWirelength(wirelength_);
@@ -274,22 +298,29 @@ void SimulatedAnnealingCore<T>::calFencePenalty()
 {
   // Initialization
   fence_penalty_ = 0.0;
+  fence_terms_.clearJournal();
   if (fence_weight_ <= 0.0 || fences_.size() <= 0) {
     return;
   }
 
-  for (const auto& [id, bbox] : fences_) {
+  for (const int id : changed_macros_) {
+    auto fence_iter = fences_.find(id);
+    if (fence_iter == fences_.end()) {
+      continue;
+    }
+    const Rect& bbox = fence_iter->second;
     const float lx = macros_[id].getX();
     const float ly = macros_[id].getY();
     const float ux = lx + macros_[id].getWidth();
     const float uy = ly + macros_[id].getHeight();
     // check if the macro is valid
-    if (macros_[id].getWidth() * macros_[id].getHeight() <= 1e-4)
-      continue;
     // check if the fence is valid
-    if (macros_[id].getWidth() > (bbox.xMax() - bbox.xMin())
-        || macros_[id].getHeight() > (bbox.yMax() - bbox.yMin()))
+    if (macros_[id].getWidth() * macros_[id].getHeight() <= 1e-4
+        || macros_[id].getWidth() > (bbox.xMax() - bbox.xMin())
+        || macros_[id].getHeight() > (bbox.yMax() - bbox.yMin())) {
+      fence_terms_.set(id, 0.0);
       continue;
+    }
     // check how much the macro is far from no fence violation
     const float max_x_dist = ((bbox.xMax() - bbox.xMin()) - (ux - lx)) / 2.0;
     const float max_y_dist = ((bbox.yMax() - bbox.yMin()) - (uy - ly)) / 2.0;
@@ -302,8 +333,9 @@ void SimulatedAnnealingCore<T>::calFencePenalty()
     float height = y_dist <= max_y_dist ? 0.0 : (y_dist - max_y_dist);
     width = width / outline_width_;
     height = height / outline_height_;
-    fence_penalty_ += width * width + height * height;
+    fence_terms_.set(id, width * width + height * height);
   }
+  fence_penalty_ = fence_terms_.sum();
   // normalization
   fence_penalty_ = fence_penalty_ / fences_.size();
   if (graphics_) {
@@ -316,11 +348,17 @@ void SimulatedAnnealingCore<T>::calGuidancePenalty()
 {
   // Initialization
   guidance_penalty_ = 0.0;
+  guidance_terms_.clearJournal();
   if (guidance_weight_ <= 0.0 || guides_.size() <= 0) {
     return;
   }
 
-  for (const auto& [id, bbox] : guides_) {
+  for (const int id : changed_macros_) {
+    auto guide_iter = guides_.find(id);
+    if (guide_iter == guides_.end()) {
+      continue;
+    }
+    const Rect& bbox = guide_iter->second;
     const float macro_lx = macros_[id].getX();
     const float macro_ly = macros_[id].getY();
     const float macro_ux = macro_lx + macros_[id].getWidth();
@@ -336,15 +374,65 @@ void SimulatedAnnealingCore<T>::calGuidancePenalty()
                             - (bbox.yMax() + bbox.yMin()) / 2.0);
     x_dist = std::max(x_dist - width, 0.0f) / width;
     y_dist = std::max(y_dist - height, 0.0f) / height;
-    guidance_penalty_ += x_dist * x_dist + y_dist * y_dist;
+    guidance_terms_.set(id, x_dist * x_dist + y_dist * y_dist);
   }
-  guidance_penalty_ = guidance_penalty_ / guides_.size();
+  guidance_penalty_ = guidance_terms_.sum() / guides_.size();
   if (graphics_) {
     graphics_->setGuidancePenalty(guidance_penalty_);
   }
 }
 
-// Determine the positions of macros based on sequence pair
+template <class T>
+void SimulatedAnnealingCore<T>::invalidateEvaluation()
+{
+  // NaN never compares equal, so every macro is re-evaluated next time
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  std::fill(evaluated_macros_.begin(),
+            evaluated_macros_.end(),
+            MacroState{nan, nan, nan, nan, nan, nan});
+  evaluated_macros_journal_.clear();
+}
+
+template <class T>
+void SimulatedAnnealingCore<T>::updateChangedMacros()
+{
+  changed_macros_.clear();
+  evaluated_macros_journal_.clear();
+  for (int i = 0; i < macros_.size(); i++) {
+    const T& macro = macros_[i];
+    const MacroState state{macro.getX(),
+                           macro.getY(),
+                           macro.getWidth(),
+                           macro.getHeight(),
+                           macro.getPinX(),
+                           macro.getPinY()};
+    if (!(state == evaluated_macros_[i])) {
+      evaluated_macros_journal_.emplace_back(i, evaluated_macros_[i]);
+      evaluated_macros_[i] = state;
+      changed_macros_.push_back(i);
+    }
+  }
+}
+
+template <class T>
+void SimulatedAnnealingCore<T>::restoreIncrementalCost()
+{
+  for (auto& [macro_id, state] : evaluated_macros_journal_) {
+    evaluated_macros_[macro_id] = state;
+  }
+  evaluated_macros_journal_.clear();
+  wirelength_terms_.undo();
+  guidance_terms_.undo();
+  fence_terms_.undo();
+}
+
+// Determine the positions of macros based on sequence pair.
+// The coordinate of a macro is the longest weighted path among the macros
+// before it in both sequences (a weighted longest common subsequence).
+// Visiting the macros in pos_seq_ order, the macros before it in neg_seq_
+// are exactly a prefix of neg_seq_, so a Fenwick tree over neg_seq_
+// positions holding prefix maxima of x + width gives each coordinate in
+// O(log n), i.e. O(n log n) for the whole packing.
 template <class T>
 void SimulatedAnnealingCore<T>::packFloorplan()
 {
@@ -353,65 +441,58 @@ void SimulatedAnnealingCore<T>::packFloorplan()
     macro.setY(0.0);
   }
 
-  // calculate X position
-  // store the position of each macro in the pos_seq_ and neg_seq_
-  std::vector<std::pair<int, int>> match(macros_.size());
-  for (int i = 0; i < macros_.size(); i++) {
-    match[pos_seq_[i]].first = i;
-    match[neg_seq_[i]].second = i;
+  const int num_macros = macros_.size();
+  // the position of each macro in neg_seq_
+  neg_index_.resize(num_macros);
+  for (int i = 0; i < num_macros; i++) {
+    neg_index_[neg_seq_[i]] = i;
   }
-  // Initialize current length
-  std::vector<float> length(macros_.size(), 0.0);
-  for (int i = 0; i < pos_seq_.size(); i++) {
+  // max of the values stored at neg_seq_ positions [0, end)
+  auto query = [this](int end) {
+    float length = 0.0;
+    for (; end > 0; end -= end & -end) {
+      length = std::max(length, pack_tree_[end]);
+    }
+    return length;
+  };
+  // store length at neg_seq_ position pos
+  auto update = [this, num_macros](int pos, float length) {
+    for (pos++; pos <= num_macros; pos += pos & -pos) {
+      pack_tree_[pos] = std::max(pack_tree_[pos], length);
+    }
+  };
+
+  // calculate X position
+  pack_tree_.assign(num_macros + 1, 0.0);
+  for (int i = 0; i < num_macros; i++) {
     const int b = pos_seq_[i];  // macro_id
     // add the continue syntax to handle fixed terminals
     if (macros_[b].getWidth() <= 0 || macros_[b].getHeight() <= 0) {
       continue;
     }
-    const int p = match[b].second;  // the position of current macro in neg_seq_
-    macros_[b].setX(length[p]);
-    const float t = macros_[b].getX() + macros_[b].getWidth();
-    for (int j = p; j < neg_seq_.size(); j++) {
-      if (t > length[j]) {
-        length[j] = t;
-      } else {
-        break;
-      }
-    }
+    const int p = neg_index_[b];
+    macros_[b].setX(query(p));
+    update(p, macros_[b].getX() + macros_[b].getWidth());
   }
   // update width_ of current floorplan
-  width_ = length[macros_.size() - 1];
+  width_ = query(num_macros);
 
-  // calulate Y position
-  std::vector<int> pos_seq(pos_seq_.size());
-  for (int i = 0; i < macros_.size(); i++) {
-    pos_seq[i] = pos_seq_[macros_.size() - 1 - i];
-  }
-  // store the position of each macro in the pos_seq_ and neg_seq_
-  for (int i = 0; i < macros_.size(); i++) {
-    match[pos_seq[i]].first = i;
-    match[neg_seq_[i]].second = i;
-    length[i] = 0.0;  // initialize the length
-  }
-  for (int i = 0; i < pos_seq_.size(); i++) {
-    const int b = pos_seq[i];  // macro_id
+  // calulate Y position, visiting pos_seq_ in reverse order
+  pack_tree_.assign(num_macros + 1, 0.0);
+  for (int i = num_macros - 1; i >= 0; i--) {
+    const int b = pos_seq_[i];  // macro_id
     // add continue syntax to handle fixed terminals
     if (macros_[b].getHeight() <= 0 || macros_[b].getWidth() <= 0.0) {
       continue;
     }
-    const int p = match[b].second;  // the position of current macro in neg_seq_
-    macros_[b].setY(length[p]);
-    const float t = macros_[b].getY() + macros_[b].getHeight();
-    for (int j = p; j < neg_seq_.size(); j++) {
-      if (t > length[j]) {
-        length[j] = t;
-      } else {
-        break;
-      }
-    }
+    const int p = neg_index_[b];
+    macros_[b].setY(query(p));
+    update(p, macros_[b].getY() + macros_[b].getHeight());
   }
-  // update width_ of current floorplan
-  height_ = length[macros_.size() - 1];
+  // update height_ of current floorplan
+  height_ = query(num_macros);
+
+  updateChangedMacros();
 
   if (graphics_) {
     graphics_->saStep(macros_);
@@ -34,6 +34,7 @@
 #pragma once
 
 #include <map>
+#include <utility>
 #include <random>
 #include <vector>
 
@@ -47,6 +48,41 @@ struct BundledNet;
 struct Rect;
 class Graphics;
 
+// Sum of per-object cost terms that can be updated one term at a time.
+// Every update since the last clearJournal() can be undone, which is how
+// a rejected SA move goes back to the cost of the previous solution.
+class IncrementalSum
+{
+ public:
+  void reset(int size)
+  {
+    terms_.assign(size, 0.0);
+    sum_ = 0.0;
+    journal_.clear();
+  }
+  void set(int index, float value)
+  {
+    journal_.emplace_back(index, terms_[index]);
+    sum_ += static_cast<double>(value) - terms_[index];
+    terms_[index] = value;
+  }
+  float sum() const { return sum_; }
+  void clearJournal() { journal_.clear(); }
+  void undo()
+  {
+    for (auto it = journal_.rbegin(); it != journal_.rend(); ++it) {
+      sum_ += static_cast<double>(it->second) - terms_[it->first];
+      terms_[it->first] = it->second;
+    }
+    journal_.clear();
+  }
+
+ private:
+  std::vector<float> terms_;
+  double sum_ = 0.0;
+  std::vector<std::pair<int, float>> journal_;
+};
+
 // Class SimulatedAnnealingCore is a base class
 // It will have two derived classes:
 // 1) SACoreHardMacro : SA for hard macros.  It will be called by ShapeEngine
@@ -119,6 +155,12 @@ class SimulatedAnnealingCore
 
   // operations
   void packFloorplan();
+  // Find the macros whose location, shape or pin changed since the last
+  // cost evaluation.  Called by packFloorplan.
+  void updateChangedMacros();
+  void invalidateEvaluation();
+  // Undo the incremental cost updates of the last perturb
+  void restoreIncrementalCost();
   virtual void perturb() = 0;
   virtual void restore() = 0;
   // actions used
@@ -142,6 +184,8 @@ class SimulatedAnnealingCore
   std::vector<BundledNet> nets_;
   std::map<int, Rect> fences_;
   std::map<int, Rect> guides_;
+  std::vector<std::vector<int>> macro_nets_;  // nets connected to each macro
+  float tot_net_weight_ = 0.0;
 
   // weight for different penalty
   float area_weight_ = 0.0;
@@ -205,6 +249,29 @@ class SimulatedAnnealingCore
   float norm_fence_penalty_ = 0.0;
   float norm_area_penalty_ = 0.0;
 
+  // Incremental cost evaluation.  Only the macros changed by a move are
+  // re-evaluated; each cost keeps one term per net (wirelength) or per macro.
+  struct MacroState
+  {
+    float x, y, width, height, pin_x, pin_y;
+    bool operator==(const MacroState& other) const
+    {
+      return x == other.x && y == other.y && width == other.width
+             && height == other.height && pin_x == other.pin_x
+             && pin_y == other.pin_y;
+    }
+  };
+  std::vector<MacroState> evaluated_macros_;  // state at the last evaluation
+  std::vector<std::pair<int, MacroState>> evaluated_macros_journal_;
+  std::vector<int> changed_macros_;
+  IncrementalSum wirelength_terms_;
+  IncrementalSum guidance_terms_;
+  IncrementalSum fence_terms_;
+
+  // scratch buffers for packFloorplan
+  std::vector<int> neg_index_;
+  std::vector<float> pack_tree_;
+
   // probability of each action
   float pos_swap_prob_ = 0.0;
   float neg_swap_prob_ = 0.0;
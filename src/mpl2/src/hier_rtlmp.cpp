@@ -37,7 +37,6 @@
 #include <fstream>
 #include <iostream>
 #include <queue>
-#include <thread>
 
 #include "SACoreHardMacro.h"
 #include "SACoreSoftMacro.h"
@@ -48,6 +47,7 @@
 #include "odb/db.h"
 #include "par/PartitionMgr.h"
 #include "sta/Liberty.hh"
+#include "utl/Executor.h"
 #include "utl/Logger.h"
 
 namespace mpl2 {
@@ -58,6 +58,18 @@ using std::string;
 // Class HierRTLMP
 using utl::MPL;
 
+// SA runs and results of one HardMacroCluster
+struct HardMacroPlacementJob
+{
+  Cluster* cluster = nullptr;
+  float cluster_lx = 0.0;
+  float cluster_ly = 0.0;
+  float outline_width = 0.0;
+  float outline_height = 0.0;
+  std::vector<HardMacro*> hard_macros;
+  std::vector<std::unique_ptr<SACoreHardMacro>> sa_runs;
+};
+
 HierRTLMP::~HierRTLMP() = default;
 
 // Constructors
@@ -65,13 +77,15 @@ HierRTLMP::HierRTLMP(sta::dbNetwork* network,
                      odb::dbDatabase* db,
                      sta::dbSta* sta,
                      utl::Logger* logger,
-                     par::PartitionMgr* tritonpart)
+                     par::PartitionMgr* tritonpart,
+                     utl::Executor* executor)
 {
   network_ = network;
   db_ = db;
   sta_ = sta;
   logger_ = logger;
   tritonpart_ = tritonpart;
+  executor_ = executor;
 }
 
 ///////////////////////////////////////////////////////////////////////////
@@ -207,6 +221,18 @@ void HierRTLMP::setReportDirectory(const char* report_directory)
   report_directory_ = report_directory;
 }
 
+template <class SACore>
+void HierRTLMP::runSABatch(const std::vector<SACore*>& sa_vector)
+{
+  // The graphics are not thread safe, so SA runs are serialized when they
+  // are enabled.
+  utl::TaskGroup tasks(graphics_ ? nullptr : executor_);
+  for (SACore* sa : sa_vector) {
+    tasks.run([sa] { runSA<SACore>(sa); });
+  }
+  tasks.wait();
+}
+
 //
 // Set defaults for min/max number of instances and macros if not set by user.
 //
@@ -2363,7 +2389,7 @@ void HierRTLMP::calClusterMacroTilings(Cluster* parent)
   while (remaining_runs > 0) {
     std::vector<SACoreSoftMacro*> sa_vector;
     const int run_thread
-        = graphics_ ? 1 : std::min(remaining_runs, num_threads_);
+        = graphics_ ? 1 : std::min(remaining_runs, sa_batch_size_);
     for (int i = 0; i < run_thread; i++) {
       const float width = outline_width * vary_factor_list[run_id++];
       const float height = outline_height;
@@ -2396,18 +2422,7 @@ void HierRTLMP::calClusterMacroTilings(Cluster* parent)
           logger_);
       sa_vector.push_back(sa);
     }
-    if (sa_vector.size() == 1) {
-      runSA<SACoreSoftMacro>(sa_vector[0]);
-    } else {
-      // multi threads
-      std::vector<std::thread> threads;
-      for (auto& sa : sa_vector) {
-        threads.push_back(std::thread(runSA<SACoreSoftMacro>, sa));
-      }
-      for (auto& th : threads) {
-        th.join();
-      }
-    }
+    runSABatch(sa_vector);
     // add macro tilings
     for (auto& sa : sa_vector) {
       sa_containers.push_back(sa);
@@ -2425,7 +2440,7 @@ void HierRTLMP::calClusterMacroTilings(Cluster* parent)
   while (remaining_runs > 0) {
     std::vector<SACoreSoftMacro*> sa_vector;
     const int run_thread
-        = graphics_ ? 1 : std::min(remaining_runs, num_threads_);
+        = graphics_ ? 1 : std::min(remaining_runs, sa_batch_size_);
     for (int i = 0; i < run_thread; i++) {
       const float width = outline_width;
       const float height = outline_height * vary_factor_list[run_id++];
@@ -2458,18 +2473,7 @@ void HierRTLMP::calClusterMacroTilings(Cluster* parent)
           logger_);
       sa_vector.push_back(sa);
     }
-    if (sa_vector.size() == 1) {
-      runSA<SACoreSoftMacro>(sa_vector[0]);
-    } else {
-      // multi threads
-      std::vector<std::thread> threads;
-      for (auto& sa : sa_vector) {
-        threads.push_back(std::thread(runSA<SACoreSoftMacro>, sa));
-      }
-      for (auto& th : threads) {
-        th.join();
-      }
-    }
+    runSABatch(sa_vector);
     // add macro tilings
     for (auto& sa : sa_vector) {
       sa_containers.push_back(sa);
@@ -2594,7 +2598,7 @@ void HierRTLMP::calHardMacroClusterShape(Cluster* cluster)
   while (remaining_runs > 0) {
     std::vector<SACoreHardMacro*> sa_vector;
     const int run_thread
-        = graphics_ ? 1 : std::min(remaining_runs, num_threads_);
+        = graphics_ ? 1 : std::min(remaining_runs, sa_batch_size_);
     for (int i = 0; i < run_thread; i++) {
       const float width = outline_width * vary_factor_list[run_id++];
       const float height = outline_height;
@@ -2622,18 +2626,7 @@ void HierRTLMP::calHardMacroClusterShape(Cluster* cluster)
           logger_);
       sa_vector.push_back(sa);
     }
-    if (sa_vector.size() == 1) {
-      runSA<SACoreHardMacro>(sa_vector[0]);
-    } else {
-      // multi threads
-      std::vector<std::thread> threads;
-      for (auto& sa : sa_vector) {
-        threads.push_back(std::thread(runSA<SACoreHardMacro>, sa));
-      }
-      for (auto& th : threads) {
-        th.join();
-      }
-    }
+    runSABatch(sa_vector);
     // add macro tilings
     for (auto& sa : sa_vector) {
       sa_containers.push_back(sa);
@@ -2651,7 +2644,7 @@ void HierRTLMP::calHardMacroClusterShape(Cluster* cluster)
   while (remaining_runs > 0) {
     std::vector<SACoreHardMacro*> sa_vector;
     const int run_thread
-        = graphics_ ? 1 : std::min(remaining_runs, num_threads_);
+        = graphics_ ? 1 : std::min(remaining_runs, sa_batch_size_);
     for (int i = 0; i < run_thread; i++) {
       const float width = outline_width;
       const float height = outline_height * vary_factor_list[run_id++];
@@ -2679,18 +2672,7 @@ void HierRTLMP::calHardMacroClusterShape(Cluster* cluster)
                                 logger_);
       sa_vector.push_back(sa);
     }
-    if (sa_vector.size() == 1) {
-      runSA<SACoreHardMacro>(sa_vector[0]);
-    } else {
-      // multi threads
-      std::vector<std::thread> threads;
-      for (auto& sa : sa_vector) {
-        threads.push_back(std::thread(runSA<SACoreHardMacro>, sa));
-      }
-      for (auto& th : threads) {
-        th.join();
-      }
-    }
+    runSABatch(sa_vector);
     // add macro tilings
     for (auto& sa : sa_vector) {
       sa_containers.push_back(sa);
@@ -3358,7 +3340,7 @@ void HierRTLMP::multiLevelMacroPlacement(Cluster* parent)
   const int num_perturb_per_step = (macros.size() > num_perturb_per_step_)
                                        ? macros.size()
                                        : num_perturb_per_step_;
-  int run_thread = num_threads_;
+  int run_thread = sa_batch_size_;
   int remaining_runs = target_util_list.size();
   int run_id = 0;
   SACoreSoftMacro* best_sa = nullptr;
@@ -3373,7 +3355,7 @@ void HierRTLMP::multiLevelMacroPlacement(Cluster* parent)
   while (remaining_runs > 0) {
     std::vector<SACoreSoftMacro*> sa_vector;
     run_thread
-        = (remaining_runs > num_threads_) ? num_threads_ : remaining_runs;
+        = (remaining_runs > sa_batch_size_) ? sa_batch_size_ : remaining_runs;
     if (graphics_) {
       run_thread = 1;
     }
@@ -3452,18 +3434,7 @@ void HierRTLMP::multiLevelMacroPlacement(Cluster* parent)
       sa->setBlockages(macro_blockages);
       sa_vector.push_back(sa);
     }
-    if (sa_vector.size() == 1) {
-      runSA<SACoreSoftMacro>(sa_vector[0]);
-    } else {
-      // multi threads
-      std::vector<std::thread> threads;
-      for (auto& sa : sa_vector) {
-        threads.push_back(std::thread(runSA<SACoreSoftMacro>, sa));
-      }
-      for (auto& th : threads) {
-        th.join();
-      }
-    }
+    runSABatch(sa_vector);
     // add macro tilings
     for (auto& sa : sa_vector) {
       sa_containers.push_back(sa);  // add SA to containers
@@ -3585,7 +3556,7 @@ void HierRTLMP::multiLevelMacroPlacement(Cluster* parent)
                       nullptr);
     }
     macros = shaped_macros;
-    run_thread = num_threads_;
+    run_thread = sa_batch_size_;
     remaining_runs = target_util_list.size();
     run_id = 0;
     best_sa = nullptr;
@@ -3596,7 +3567,7 @@ void HierRTLMP::multiLevelMacroPlacement(Cluster* parent)
     while (remaining_runs > 0) {
       std::vector<SACoreSoftMacro*> sa_vector;
       run_thread
-          = (remaining_runs > num_threads_) ? num_threads_ : remaining_runs;
+          = (remaining_runs > sa_batch_size_) ? sa_batch_size_ : remaining_runs;
       if (graphics_) {
         run_thread = 1;
       }
@@ -3676,18 +3647,7 @@ void HierRTLMP::multiLevelMacroPlacement(Cluster* parent)
         sa->setBlockages(macro_blockages);
         sa_vector.push_back(sa);
       }
-      if (sa_vector.size() == 1) {
-        runSA<SACoreSoftMacro>(sa_vector[0]);
-      } else {
-        // multi threads
-        std::vector<std::thread> threads;
-        for (auto& sa : sa_vector) {
-          threads.push_back(std::thread(runSA<SACoreSoftMacro>, sa));
-        }
-        for (auto& th : threads) {
-          th.join();
-        }
-      }
+      runSABatch(sa_vector);
       // add macro tilings
       for (auto& sa : sa_vector) {
         sa_containers.push_back(sa);  // add SA to containers
@@ -3775,13 +3735,25 @@ void HierRTLMP::multiLevelMacroPlacement(Cluster* parent)
     boundary_weight_ = original_boundary_weight;
   }
 
-  // Traverse the physical hierarchy tree in a DFS manner
+  // Traverse the physical hierarchy tree in a DFS manner.
+  // The HardMacroCluster children are leaves whose SA runs only depend on
+  // the shapes fixed above, so they are prepared in order and solved
+  // together on the thread pool once the MixedCluster children are done.
+  std::vector<std::unique_ptr<HardMacroPlacementJob>> hard_macro_jobs;
   for (auto& cluster : parent->getChildren()) {
-    if (cluster->getClusterType() == MixedCluster
-        || cluster->getClusterType() == HardMacroCluster) {
+    if (cluster->getClusterType() == MixedCluster) {
       multiLevelMacroPlacement(cluster);
+    } else if (cluster->getClusterType() == HardMacroCluster) {
+      auto job = prepareHardMacroClusterPlacement(cluster);
+      if (job != nullptr) {
+        hard_macro_jobs.push_back(std::move(job));
+      }
     }
   }
+  solveHardMacroClusterPlacements(hard_macro_jobs);
+  for (auto& job : hard_macro_jobs) {
+    commitHardMacroClusterPlacement(job.get());
+  }
 
   // align macros
   alignHardMacroGlobal(parent);
@@ -4055,10 +4027,22 @@ void HierRTLMP::callBusPlanning(std::vector<SoftMacro>& shaped_macros,
 
 // place macros within the HardMacroCluster
 void HierRTLMP::hardMacroClusterMacroPlacement(Cluster* cluster)
+{
+  std::vector<std::unique_ptr<HardMacroPlacementJob>> jobs;
+  jobs.push_back(prepareHardMacroClusterPlacement(cluster));
+  if (jobs.back() == nullptr) {
+    return;
+  }
+  solveHardMacroClusterPlacements(jobs);
+  commitHardMacroClusterPlacement(jobs.back().get());
+}
+
+std::unique_ptr<HardMacroPlacementJob>
+HierRTLMP::prepareHardMacroClusterPlacement(Cluster* cluster)
 {
   // Check if the cluster is a HardMacroCluster
   if (cluster->getClusterType() != HardMacroCluster) {
-    return;
+    return nullptr;
   }
   logger_->report(
       "\n[Hier-RTLMP::HardMacroClusterMacroPlacement] Place macros in cluster: "
@@ -4077,7 +4061,14 @@ void HierRTLMP::hardMacroClusterMacroPlacement(Cluster* cluster)
   // We need this to calculate the connections with other clusters
   std::vector<Cluster*> macro_clusters;
   std::map<int, int> cluster_id_macro_id_map;
-  std::vector<HardMacro*> hard_macros = cluster->getHardMacros();
+  auto job = std::make_unique<HardMacroPlacementJob>();
+  job->cluster = cluster;
+  job->outline_width = outline_width;
+  job->outline_height = outline_height;
+  job->cluster_lx = lx;
+  job->cluster_ly = ly;
+  job->hard_macros = cluster->getHardMacros();
+  std::vector<HardMacro*>& hard_macros = job->hard_macros;
   // we define to verify that all the macros has been placed
   num_hard_macros_cluster_ += hard_macros.size();
   // calculate the fences and guides
@@ -4156,73 +4147,76 @@ void HierRTLMP::hardMacroClusterMacroPlacement(Cluster* cluster)
   const int num_perturb_per_step = (macros.size() > num_perturb_per_step_ / 10)
                                        ? macros.size()
                                        : num_perturb_per_step_ / 10;
-  int run_thread = num_threads_;
+  // All runs are independent (no early stop), so they are created up front
+  // and solved later together with the runs of sibling clusters.
+  const int batch_size = graphics_ ? 1 : sa_batch_size_;
   int remaining_runs = num_runs_;
   int run_id = 0;
-  SACoreHardMacro* best_sa = nullptr;
-  std::vector<SACoreHardMacro*> sa_containers;  // store all the SA runs
-  float best_cost = std::numeric_limits<float>::max();
   while (remaining_runs > 0) {
-    std::vector<SACoreHardMacro*> sa_vector;
-    run_thread
-        = (remaining_runs > num_threads_) ? num_threads_ : remaining_runs;
-    if (graphics_) {
-      run_thread = 1;
-    }
+    const int run_thread = std::min(remaining_runs, batch_size);
     for (int i = 0; i < run_thread; i++) {
       // change the aspect ratio
       const float width = outline_width * vary_factor_list[run_id++];
       const float height = outline_width * outline_height / width;
-      SACoreHardMacro* sa
-          = new SACoreHardMacro(width,
-                                height,
-                                macros,
-                                area_weight_,
-                                outline_weight_ * (i + 1) * 10,
-                                wirelength_weight_ / (i + 1),
-                                guidance_weight_,
-                                fence_weight_,
-                                pos_swap_prob_ * 10 / action_sum,
-                                neg_swap_prob_ * 10 / action_sum,
-                                double_swap_prob_ / action_sum,
-                                exchange_swap_prob_ / action_sum,
-                                flip_prob_ / action_sum,
-                                init_prob_,
-                                max_num_step_,
-                                num_perturb_per_step,
-                                k_,  // later will be updated to min_temperature
-                                c_,
-                                random_seed_ + run_id,
-                                graphics_.get(),
-                                logger_);
+      auto sa = std::make_unique<SACoreHardMacro>(
+          width,
+          height,
+          macros,
+          area_weight_,
+          outline_weight_ * (i + 1) * 10,
+          wirelength_weight_ / (i + 1),
+          guidance_weight_,
+          fence_weight_,
+          pos_swap_prob_ * 10 / action_sum,
+          neg_swap_prob_ * 10 / action_sum,
+          double_swap_prob_ / action_sum,
+          exchange_swap_prob_ / action_sum,
+          flip_prob_ / action_sum,
+          init_prob_,
+          max_num_step_,
+          num_perturb_per_step,
+          k_,  // later will be updated to min_temperature
+          c_,
+          random_seed_ + run_id,
+          graphics_.get(),
+          logger_);
       sa->setNets(nets);
       sa->setFences(fences);
       sa->setGuides(guides);
-      sa_vector.push_back(sa);
+      job->sa_runs.push_back(std::move(sa));
     }
-    if (sa_vector.size() == 1) {
-      runSA<SACoreHardMacro>(sa_vector[0]);
-    } else {
-      // multi threads
-      std::vector<std::thread> threads;
-      for (auto& sa : sa_vector) {
-        threads.push_back(std::thread(runSA<SACoreHardMacro>, sa));
-      }
-      for (auto& th : threads) {
-        th.join();
-      }
+    remaining_runs -= run_thread;
+  }
+  // The SA runs only need the macros and nets built above, so the
+  // cluster_id property can be restored before they are solved.
+  setInstProperty(cluster);
+  return job;
+}
+
+void HierRTLMP::solveHardMacroClusterPlacements(
+    std::vector<std::unique_ptr<HardMacroPlacementJob>>& jobs)
+{
+  std::vector<SACoreHardMacro*> sa_vector;
+  for (auto& job : jobs) {
+    for (auto& sa : job->sa_runs) {
+      sa_vector.push_back(sa.get());
     }
-    // add macro tilings
-    for (auto& sa : sa_vector) {
-      sa_containers.push_back(sa);  // add SA to containers
-      if (sa->isValid(outline_width, outline_height)
-          && sa->getNormCost() < best_cost) {
-        best_cost = sa->getNormCost();
-        best_sa = sa;
-      }
+  }
+  runSABatch(sa_vector);
+}
+
+void HierRTLMP::commitHardMacroClusterPlacement(HardMacroPlacementJob* job)
+{
+  Cluster* cluster = job->cluster;
+  std::vector<HardMacro*>& hard_macros = job->hard_macros;
+  SACoreHardMacro* best_sa = nullptr;
+  float best_cost = std::numeric_limits<float>::max();
+  for (auto& sa : job->sa_runs) {
+    if (sa->isValid(job->outline_width, job->outline_height)
+        && sa->getNormCost() < best_cost) {
+      best_cost = sa->getNormCost();
+      best_sa = sa.get();
     }
-    sa_vector.clear();
-    remaining_runs -= run_thread;
   }
   debugPrint(
       logger_,
@@ -4234,11 +4228,9 @@ void HierRTLMP::hardMacroClusterMacroPlacement(Cluster* cluster)
       cluster->getName());
   // update the hard macro
   if (best_sa == nullptr) {
-    for (auto& sa : sa_containers) {
+    for (auto& sa : job->sa_runs) {
       sa->printResults();
-      // need
     }
-    sa_containers.clear();
     logger_->error(
         MPL,
         10,
@@ -4255,13 +4247,12 @@ void HierRTLMP::hardMacroClusterMacroPlacement(Cluster* cluster)
   // update OpenDB
   for (auto& hard_macro : hard_macros) {
     num_updated_macros_++;
-    hard_macro->setX(hard_macro->getX() + lx);
-    hard_macro->setY(hard_macro->getY() + ly);
+    hard_macro->setX(hard_macro->getX() + job->cluster_lx);
+    hard_macro->setY(hard_macro->getY() + job->cluster_ly);
     // hard_macro->updateDb(pitch_x_, pitch_y_);
   }
-  // clean SA to avoid memory leakage
-  sa_containers.clear();
-  setInstProperty(cluster);
+  // free the SA runs
+  job->sa_runs.clear();
 }
 
 // Align all the macros globally to reduce the waste of standard cell space
@@ -57,6 +57,7 @@ class dbSta;
 }  // namespace sta
 
 namespace utl {
+class Executor;
 class Logger;
 }
 
@@ -72,6 +73,7 @@ class Metrics;
 struct Rect;
 class SoftMacro;
 class Graphics;
+struct HardMacroPlacementJob;
 
 // Hierarchial RTL-MP
 // Support Multi-Level Clustering.
@@ -90,7 +92,8 @@ class HierRTLMP
             odb::dbDatabase* db,
             sta::dbSta* sta,
             utl::Logger* logger,
-            par::PartitionMgr* tritonpart);
+            par::PartitionMgr* tritonpart,
+            utl::Executor* executor);
   ~HierRTLMP();
 
   // Top Level Interface Function
@@ -219,6 +222,17 @@ class HierRTLMP
   void multiLevelMacroPlacement(Cluster* parent);
   // place macros within the HardMacroCluster
   void hardMacroClusterMacroPlacement(Cluster* parent);
+  // hardMacroClusterMacroPlacement split in three steps so that the SA runs
+  // of sibling HardMacroClusters can be solved together.  Preparation and
+  // commit touch the shared netlist state and must run serially.
+  std::unique_ptr<HardMacroPlacementJob> prepareHardMacroClusterPlacement(
+      Cluster* cluster);
+  void solveHardMacroClusterPlacements(
+      std::vector<std::unique_ptr<HardMacroPlacementJob>>& jobs);
+  void commitHardMacroClusterPlacement(HardMacroPlacementJob* job);
+  // Run a batch of independent SA runs on the thread pool
+  template <class SACore>
+  void runSABatch(const std::vector<SACore*>& sa_vector);
   // Merge nets to reduce runtime
   void mergeNets(std::vector<BundledNet>& nets);
   // determine the shape for children cluster
@@ -248,6 +262,7 @@ class HierRTLMP
   sta::dbSta* sta_ = nullptr;
   utl::Logger* logger_ = nullptr;
   par::PartitionMgr* tritonpart_ = nullptr;
+  utl::Executor* executor_ = nullptr;  // serial if not set
 
   // flag variables
   const bool fd_placement_flag_ = false;
@@ -272,7 +287,9 @@ class HierRTLMP
   float halo_width_ = 0.0;
 
   const int num_runs_ = 10;     // number of runs for SA
-  const int num_threads_ = 10;  // number of threads
+  // number of SA runs evaluated together; independent of the thread count
+  // so that results do not depend on it
+  const int sa_batch_size_ = 10;
   const int random_seed_ = 0;   // random seed for deterministic
 
   float target_dead_space_ = 0.2;  // dead space for the cluster
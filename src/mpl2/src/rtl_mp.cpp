@@ -51,10 +51,11 @@ void MacroPlacer2::init(sta::dbNetwork* network,
                         odb::dbDatabase* db,
                         sta::dbSta* sta,
                         utl::Logger* logger,
-                        par::PartitionMgr* tritonpart)
+                        par::PartitionMgr* tritonpart,
+                        utl::Executor* executor)
 {
-  hier_rtlmp_
-      = std::make_unique<HierRTLMP>(network, db, sta, logger, tritonpart);
+  hier_rtlmp_ = std::make_unique<HierRTLMP>(
+      network, db, sta, logger, tritonpart, executor);
 }
 
 bool MacroPlacer2::place(const int max_num_macro,
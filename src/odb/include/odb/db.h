@@ -264,6 +264,19 @@ class dbIntProperty : public dbProperty
   /// Find the named property of type int. Returns NULL if the property does not
   /// exist.
   static dbIntProperty* find(dbObject* object, const char* name);
+
+  /// Get the value of the named int property of each object. Objects without
+  /// the property get default_value.
+  static std::vector<int> getValues(const std::vector<dbObject*>& objects,
+                                    const char* name,
+                                    int default_value = 0);
+
+  /// Set the value of the named int property of each object, creating the
+  /// property where it does not exist. objects and values must have the same
+  /// size.
+  static void setValues(const std::vector<dbObject*>& objects,
+                        const char* name,
+                        const std::vector<int>& values);
 };
 
 ///
@@ -287,6 +300,19 @@ class dbDoubleProperty : public dbProperty
   /// Find the named property of type double. Returns NULL if the property does
   /// not exist.
   static dbDoubleProperty* find(dbObject* object, const char* name);
+
+  /// Get the value of the named double property of each object. Objects
+  /// without the property get default_value.
+  static std::vector<double> getValues(const std::vector<dbObject*>& objects,
+                                       const char* name,
+                                       double default_value = 0.0);
+
+  /// Set the value of the named double property of each object, creating the
+  /// property where it does not exist. objects and values must have the same
+  /// size.
+  static void setValues(const std::vector<dbObject*>& objects,
+                        const char* name,
+                        const std::vector<double>& values);
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -954,6 +980,20 @@ class dbBlock : public dbObject
   ///
   dbInst* findInst(const char* name);
 
+  ///
+  /// Find the instances with the given names, in the same order.
+  /// Names that are not found give NULL entries.
+  ///
+  std::vector<dbInst*> findInsts(const std::vector<std::string>& names);
+
+  ///
+  /// Find the instances whose whole name matches pattern, in name order.
+  /// The pattern is a glob with * and ? wildcards, or an ECMAScript
+  /// regular expression if regexp is true.
+  ///
+  std::vector<dbInst*> findInstsMatching(const char* pattern,
+                                         bool regexp = false);
+
   ///
   /// Find a specific module in this block.
   /// Returns NULL if the object was not found.
@@ -1049,6 +1089,20 @@ class dbBlock : public dbObject
   ///
   dbNet* findNet(const char* name);
 
+  ///
+  /// Find the nets with the given names, in the same order.
+  /// Names that are not found give NULL entries.
+  ///
+  std::vector<dbNet*> findNets(const std::vector<std::string>& names);
+
+  ///
+  /// Find the nets whose whole name matches pattern, in name order.
+  /// The pattern is a glob with * and ? wildcards, or an ECMAScript
+  /// regular expression if regexp is true.
+  ///
+  std::vector<dbNet*> findNetsMatching(const char* pattern,
+                                       bool regexp = false);
+
   ///
   /// Find a set of nets. Each name can be real name, or Nxxx, or xxx,
   /// where xxx is the net oid.
@@ -9088,6 +9142,9 @@ class dbModInst : public dbObject
 
   std::string getName() const;
 
+  // Same as getName() without a copy; valid until the instance is destroyed.
+  const char* getConstName() const;
+
   std::string getHierarchicalName() const;
   // User Code End dbModInst
 };
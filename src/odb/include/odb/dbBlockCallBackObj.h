@@ -143,6 +143,7 @@ class dbBlockCallBackObj
   }  // first is src, second is dst
   virtual void inDbWirePostCopy(dbWire*, dbWire*) {
   }  // first is src, second is dst
+  virtual void inDbWirePostEncode(dbWire*) {}  // dbWireEncoder::end
   // dbWire End
 
   // dbSWire Start
@@ -156,6 +157,7 @@ class dbBlockCallBackObj
 
   // dbFill Start
   virtual void inDbFillCreate(dbFill*) {}
+  virtual void inDbFillDestroy(dbFill*) {}
   // dbFill End
 
   virtual void inDbBlockStreamOutBefore(dbBlock*) {}
@@ -0,0 +1,150 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <unordered_map>
+#include <unordered_set>
+
+#include "dbBlockCallBackObj.h"
+#include "dbTypes.h"
+#include "geom.h"
+
+namespace odb {
+
+class dbBlock;
+class dbBTerm;
+class dbITerm;
+class dbInst;
+class dbMaster;
+class dbNet;
+class dbRegion;
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// dbBlockSnapshot - A copy-on-write snapshot of the placement and netlist
+/// of a block, used to try an optimization and undo it.
+///
+/// Taking a snapshot copies nothing. The snapshot watches the block and
+/// saves the state of an instance or iterm the first time it changes, so
+/// restore() costs as much as the edits made since. It covers:
+///   - instance masters, locations, orientations and placement status
+///   - iterm connections
+///   - instances and nets created since the snapshot
+///
+/// Destroying an instance or net that was in the snapshot, or editing
+/// bterms, cannot be undone and makes the snapshot not restorable.
+/// Wires, parasitics and other fields are not saved.
+///
+/// The get functions return the state at the time of the snapshot. They
+/// only read the saved state and the block, so several threads can use
+/// them to evaluate the snapshot while the block is not being edited.
+///
+///////////////////////////////////////////////////////////////////////////////
+class dbBlockSnapshot : public dbBlockCallBackObj
+{
+ public:
+  explicit dbBlockSnapshot(dbBlock* block);
+
+  dbBlock* getBlock() const { return block_; }
+
+  ///
+  /// False after an edit that restore() cannot undo.
+  ///
+  bool isRestorable() const { return restorable_; }
+
+  ///
+  /// Undo the edits made since the snapshot and keep tracking from there.
+  /// Returns false without changing the block if it is not restorable.
+  ///
+  bool restore();
+
+  ///
+  /// Keep the edits; the current state of the block becomes the snapshot.
+  ///
+  void commit();
+
+  ///
+  /// True if inst was created after the snapshot.
+  ///
+  bool isCreated(dbInst* inst) const;
+
+  dbMaster* getMaster(dbInst* inst) const;
+  Point getLocation(dbInst* inst) const;
+  dbOrientType getOrient(dbInst* inst) const;
+  dbPlacementStatus getPlacementStatus(dbInst* inst) const;
+  dbNet* getNet(dbITerm* iterm) const;
+
+  // dbBlockCallBackObj
+  void inDbInstCreate(dbInst* inst) override;
+  void inDbInstCreate(dbInst* inst, dbRegion* region) override;
+  void inDbInstDestroy(dbInst* inst) override;
+  void inDbInstPlacementStatusBefore(dbInst* inst,
+                                     const dbPlacementStatus& status) override;
+  void inDbInstSwapMasterBefore(dbInst* inst, dbMaster* master) override;
+  void inDbPreMoveInst(dbInst* inst) override;
+  void inDbNetCreate(dbNet* net) override;
+  void inDbNetDestroy(dbNet* net) override;
+  void inDbITermDestroy(dbITerm* iterm) override;
+  void inDbITermPreDisconnect(dbITerm* iterm) override;
+  void inDbITermPreConnect(dbITerm* iterm, dbNet* net) override;
+  void inDbBTermCreate(dbBTerm* bterm) override;
+  void inDbBTermDestroy(dbBTerm* bterm) override;
+  void inDbBTermPreConnect(dbBTerm* bterm, dbNet* net) override;
+  void inDbBTermPreDisconnect(dbBTerm* bterm) override;
+
+ private:
+  struct InstState
+  {
+    dbMaster* master;
+    Point location;
+    dbOrientType orient;
+    dbPlacementStatus status;
+  };
+
+  void saveInst(dbInst* inst);
+  void saveITerm(dbITerm* iterm);
+  void clear();
+
+  dbBlock* block_;
+  bool restorable_ = true;
+  // Edits made by restore() are not saved.
+  bool restoring_ = false;
+
+  // State before the first change since the snapshot.
+  std::unordered_map<dbInst*, InstState> insts_;
+  std::unordered_map<dbITerm*, dbNet*> iterm_nets_;
+  std::unordered_set<dbInst*> created_insts_;
+  std::unordered_set<dbNet*> created_nets_;
+};
+
+}  // namespace odb
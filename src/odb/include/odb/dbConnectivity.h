@@ -0,0 +1,152 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <vector>
+
+#include "dbBlockCallBackObj.h"
+#include "geom.h"
+#include "odb.h"
+
+namespace utl {
+class Executor;
+}
+
+namespace odb {
+
+class dbBlock;
+class dbBTerm;
+class dbITerm;
+class dbInst;
+class dbMaster;
+class dbNet;
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// dbConnectivity - A read-only snapshot of the connectivity of a block.
+///
+/// The terms of every net and instance are stored in flat arrays (compressed
+/// sparse rows) indexed by the object dbId, so tools can walk the netlist
+/// without following the odb linked lists and get term counts in constant
+/// time.
+///
+/// The snapshot is owned by the block and shared by all its users.  It
+/// watches the block for netlist edits and is rebuilt by the next get()
+/// after one; the ranges returned before that must not be used anymore.
+///
+///////////////////////////////////////////////////////////////////////////////
+class dbConnectivity : public dbBlockCallBackObj
+{
+ public:
+  template <typename T>
+  class Range
+  {
+   public:
+    Range() = default;
+    Range(T* begin, T* end) : begin_(begin), end_(end) {}
+
+    T* begin() const { return begin_; }
+    T* end() const { return end_; }
+    int size() const { return end_ - begin_; }
+    bool empty() const { return begin_ == end_; }
+    T& operator[](int i) const { return begin_[i]; }
+
+   private:
+    T* begin_ = nullptr;
+    T* end_ = nullptr;
+  };
+
+  ///
+  /// Returns the snapshot of block, (re)building it if needed.  The build
+  /// runs on executor when one is given.
+  ///
+  static dbConnectivity* get(dbBlock* block,
+                             utl::Executor* executor = nullptr);
+
+  dbBlock* getBlock() const { return block_; }
+
+  Range<dbITerm* const> getITerms(dbNet* net) const;
+  Range<dbBTerm* const> getBTerms(dbNet* net) const;
+  Range<dbITerm* const> getITerms(dbInst* inst) const;
+
+  int getITermCount(dbNet* net) const { return getITerms(net).size(); }
+  int getBTermCount(dbNet* net) const { return getBTerms(net).size(); }
+
+  ///
+  /// dbMaster::getMasterId() of the instance master.
+  ///
+  int getMasterId(dbInst* inst) const;
+
+  ///
+  /// Center of the iterm master pins relative to the master origin
+  /// (before the instance orientation is applied).
+  ///
+  Point getPinOffset(dbITerm* iterm) const;
+
+  // dbBlockCallBackObj
+  void inDbInstCreate(dbInst* inst) override;
+  void inDbInstCreate(dbInst* inst, dbRegion* region) override;
+  void inDbInstDestroy(dbInst* inst) override;
+  void inDbInstSwapMasterAfter(dbInst* inst) override;
+  void inDbNetDestroy(dbNet* net) override;
+  void inDbITermPostConnect(dbITerm* iterm) override;
+  void inDbITermPostDisconnect(dbITerm* iterm, dbNet* net) override;
+  void inDbBTermCreate(dbBTerm* bterm) override;
+  void inDbBTermDestroy(dbBTerm* bterm) override;
+  void inDbBTermPostConnect(dbBTerm* bterm) override;
+  void inDbBTermPostDisConnect(dbBTerm* bterm, dbNet* net) override;
+
+ private:
+  explicit dbConnectivity(dbBlock* block);
+
+  void build(utl::Executor* executor);
+  void invalidate() { valid_ = false; }
+  void updateInst(dbInst* inst);
+
+  dbBlock* block_;
+  bool valid_ = false;
+
+  // Offsets into the term arrays, indexed by dbId (0 is never used).
+  // The terms of net id are [begin[id], begin[id + 1]).
+  std::vector<int> net_iterm_begin_;
+  std::vector<dbITerm*> net_iterms_;
+  std::vector<int> net_bterm_begin_;
+  std::vector<dbBTerm*> net_bterms_;
+  std::vector<int> inst_iterm_begin_;
+  std::vector<dbITerm*> inst_iterms_;
+
+  std::vector<int> inst_master_ids_;  // indexed by inst id
+  std::vector<Point> iterm_offsets_;  // indexed by iterm id
+};
+
+}  // namespace odb
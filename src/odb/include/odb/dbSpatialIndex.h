@@ -0,0 +1,155 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <memory>
+#include <shared_mutex>
+#include <vector>
+
+#include "dbBlockCallBackObj.h"
+#include "geom.h"
+#include "odb.h"
+
+namespace odb {
+
+class dbBlock;
+class dbFill;
+class dbInst;
+class dbNet;
+class dbObstruction;
+class dbSBox;
+class dbTechLayer;
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// dbSpatialIndex - R-trees over the placed instances and the per-layer
+/// shapes of a block: routed wires, special wires, obstructions and fills.
+///
+/// The index is owned by the block and shared by all its users.  Each kind
+/// of object gets its trees bulk loaded (packed) by the first query for it
+/// and kept current from the block callbacks afterwards.  Routed wire
+/// contents change without a callback per shape, so the nets whose wires
+/// are edited are only marked and their shapes are replaced by the next
+/// wire query.
+///
+/// The queries may run from several threads at once.  The block must not
+/// be edited while they do.
+///
+///////////////////////////////////////////////////////////////////////////////
+class dbSpatialIndex : public dbBlockCallBackObj
+{
+ public:
+  struct NetShape
+  {
+    Rect rect;
+    dbNet* net;
+  };
+
+  ~dbSpatialIndex() override;
+
+  ///
+  /// Returns the index of block, creating it if needed.
+  ///
+  static dbSpatialIndex* get(dbBlock* block);
+
+  dbBlock* getBlock() const { return block_; }
+
+  ///
+  /// The find methods append the objects whose box intersects area
+  /// (including touching) to the result.
+  ///
+  void findInsts(const Rect& area, std::vector<dbInst*>& insts);
+  void findWires(dbTechLayer* layer,
+                 const Rect& area,
+                 std::vector<NetShape>& shapes);
+  // Via sboxes are found through their cut and enclosure boxes on layer.
+  void findSpecialWires(dbTechLayer* layer,
+                        const Rect& area,
+                        std::vector<dbSBox*>& sboxes);
+  void findObstructions(dbTechLayer* layer,
+                        const Rect& area,
+                        std::vector<dbObstruction*>& obstructions);
+  void findFills(dbTechLayer* layer,
+                 const Rect& area,
+                 std::vector<dbFill*>& fills);
+
+  // dbBlockCallBackObj
+  void inDbInstDestroy(dbInst* inst) override;
+  void inDbInstPlacementStatusBefore(dbInst* inst,
+                                     const dbPlacementStatus& status) override;
+  void inDbInstSwapMasterBefore(dbInst* inst, dbMaster* master) override;
+  void inDbInstSwapMasterAfter(dbInst* inst) override;
+  void inDbPreMoveInst(dbInst* inst) override;
+  void inDbPostMoveInst(dbInst* inst) override;
+  void inDbNetDestroy(dbNet* net) override;
+  void inDbObstructionCreate(dbObstruction* obs) override;
+  void inDbObstructionDestroy(dbObstruction* obs) override;
+  void inDbWireCreate(dbWire* wire) override;
+  void inDbWireDestroy(dbWire* wire) override;
+  void inDbWirePreAttach(dbWire* wire, dbNet* net) override;
+  void inDbWirePreDetach(dbWire* wire) override;
+  void inDbWirePostAppend(dbWire* src, dbWire* dst) override;
+  void inDbWirePostCopy(dbWire* src, dbWire* dst) override;
+  void inDbWirePostEncode(dbWire* wire) override;
+  void inDbSWireAddSBox(dbSBox* box) override;
+  void inDbSWireRemoveSBox(dbSBox* box) override;
+  void inDbSWirePreDestroySBoxes(dbSWire* swire) override;
+  void inDbFillCreate(dbFill* fill) override;
+  void inDbFillDestroy(dbFill* fill) override;
+
+ private:
+  struct Trees;
+
+  explicit dbSpatialIndex(dbBlock* block);
+
+  void updateInsts();
+  void updateWires();
+  void updateSpecialWires();
+  void updateObstructions();
+  void updateFills();
+
+  void addInst(dbInst* inst);
+  void removeInst(dbInst* inst);
+  void addSBox(dbSBox* box);
+  void removeSBox(dbSBox* box);
+  void markNetModified(dbNet* net);
+  void addNetShapes(dbNet* net);
+  void removeNetShapes(dbNet* net);
+
+  dbBlock* block_;
+  std::unique_ptr<Trees> trees_;
+  // Shared by the queries; the lazy builds and the edits are exclusive.
+  std::shared_mutex mutex_;
+};
+
+}  // namespace odb
@@ -35,8 +35,10 @@
 #include <errno.h>
 #include <unistd.h>
 
+#include <cstring>
 #include <fstream>
 #include <memory>
+#include <regex>
 #include <set>
 #include <string>
 
@@ -59,6 +61,7 @@
 #include "dbCapNode.h"
 #include "dbCapNodeItr.h"
 #include "dbChip.h"
+#include "dbConnectivity.h"
 #include "dbDatabase.h"
 #include "dbDiff.h"
 #include "dbDiff.hpp"
@@ -96,6 +99,7 @@
 #include "dbPowerDomain.h"
 #include "dbPowerSwitch.h"
 #include "dbProperty.h"
+#include "dbPropertyIndex.h"
 #include "dbPropertyItr.h"
 #include "dbRSeg.h"
 #include "dbRSegItr.h"
@@ -109,6 +113,7 @@
 #include "dbSWireItr.h"
 #include "dbSearch.h"
 #include "dbShape.h"
+#include "dbSpatialIndex.h"
 #include "dbTable.h"
 #include "dbTable.hpp"
 #include "dbTech.h"
@@ -145,6 +150,112 @@ dbIStream& operator>>(dbIStream& stream, OldTransform& t)
 
 static void unlink_child_from_parent(_dbBlock* child, _dbBlock* parent);
 
+// Glob match of the whole name with * and ? wildcards.
+static bool globMatch(const char* pattern, const char* name)
+{
+  const char* star = nullptr;
+  const char* star_name = nullptr;
+  while (*name != '\0') {
+    if (*pattern == '*') {
+      star = pattern++;
+      star_name = name;
+    } else if (*pattern == '?' || *pattern == *name) {
+      pattern++;
+      name++;
+    } else if (star) {
+      // let the last * absorb one more character
+      pattern = star + 1;
+      name = ++star_name;
+    } else {
+      return false;
+    }
+  }
+  while (*pattern == '*')
+    pattern++;
+  return *pattern == '\0';
+}
+
+// Literal characters that start every name matching pattern, used to
+// narrow the search to a range of the sorted name index.
+static std::string patternPrefix(const char* pattern, bool regexp)
+{
+  std::string prefix;
+  if (!regexp) {
+    for (const char* p = pattern; *p != '\0' && *p != '*' && *p != '?'; p++)
+      prefix += *p;
+    return prefix;
+  }
+
+  // Alternatives have no common prefix.
+  if (strchr(pattern, '|'))
+    return prefix;
+  const char* p = pattern;
+  if (*p == '^')
+    p++;
+  for (; *p != '\0' && !strchr(".[]{}()\\*+?^$|", *p); p++)
+    prefix += *p;
+  // A quantifier applies to the last literal.
+  if (!prefix.empty() && *p != '\0' && strchr("*+?{", *p))
+    prefix.pop_back();
+  return prefix;
+}
+
+template <class T, class D>
+static std::vector<D*> findMatching(dbHashTable<T>& table,
+                                    const char* pattern,
+                                    bool regexp,
+                                    utl::Logger* logger)
+{
+  std::vector<T*> objects;
+  const std::string prefix = patternPrefix(pattern, regexp);
+  if (regexp) {
+    std::regex regex;
+    try {
+      regex.assign(pattern);
+    } catch (const std::regex_error& err) {
+      logger->error(utl::ODB,
+                    430,
+                    "Invalid regular expression {}: {}",
+                    pattern,
+                    err.what());
+    }
+    table.findMatching(
+        prefix,
+        [&regex](const char* name) { return std::regex_match(name, regex); },
+        objects);
+  } else {
+    table.findMatching(
+        prefix,
+        [pattern](const char* name) { return globMatch(pattern, name); },
+        objects);
+  }
+
+  std::vector<D*> result;
+  result.reserve(objects.size());
+  for (T* object : objects)
+    result.push_back((D*) object);
+  return result;
+}
+
+template <class T, class D>
+static std::vector<D*> findAll(dbHashTable<T>& table,
+                               const std::vector<std::string>& names)
+{
+  std::vector<const char*> c_names;
+  c_names.reserve(names.size());
+  for (const std::string& name : names)
+    c_names.push_back(name.c_str());
+
+  std::vector<T*> objects;
+  table.find(c_names, objects);
+
+  std::vector<D*> result;
+  result.reserve(objects.size());
+  for (T* object : objects)
+    result.push_back((D*) object);
+  return result;
+}
+
 // TODO: Bounding box updates...
 template class dbTable<_dbBlock>;
 
@@ -372,9 +483,12 @@ _dbBlock::_dbBlock(_dbDatabase* db)
   _bpin_itr = new dbBPinItr(_bpin_tbl);
 
   _prop_itr = new dbPropertyItr(_prop_tbl);
+  _prop_index = new _dbPropertyIndex(_prop_tbl);
 
   _num_ext_dbs = 1;
   _searchDb = NULL;
+  _connectivity = nullptr;
+  _spatial_index = nullptr;
   _extmi = NULL;
   _ptFile = NULL;
   _journal = NULL;
@@ -570,6 +684,7 @@ _dbBlock::_dbBlock(_dbDatabase* db, const _dbBlock& block)
   _bpin_itr = new dbBPinItr(_bpin_tbl);
 
   _prop_itr = new dbPropertyItr(_prop_tbl);
+  _prop_index = new _dbPropertyIndex(_prop_tbl);
 
   _num_ext_dbs = 0;
   _ptFile = nullptr;
@@ -577,6 +692,8 @@ _dbBlock::_dbBlock(_dbDatabase* db, const _dbBlock& block)
 
   // ??? Initialize search-db on copy?
   _searchDb = NULL;
+  _connectivity = nullptr;
+  _spatial_index = nullptr;
 
   // ??? callbacks
   // _callbacks = ???
@@ -655,6 +772,9 @@ _dbBlock::~_dbBlock()
   delete _group_ground_net_itr;
   delete _bpin_itr;
   delete _prop_itr;
+  delete _prop_index;
+  delete _connectivity;
+  delete _spatial_index;
 
   std::list<dbBlockCallBackObj*>::iterator _cbitr;
   while (_callbacks.begin() != _callbacks.end()) {
@@ -688,6 +808,13 @@ void dbBlock::clear()
 
   std::list<dbBlockCallBackObj*> callbacks;
 
+  // the connectivity snapshot and the spatial index are callbacks too and
+  // go with the block contents
+  delete block->_connectivity;
+  block->_connectivity = nullptr;
+  delete block->_spatial_index;
+  block->_spatial_index = nullptr;
+
   // save callbacks
   callbacks.swap(block->_callbacks);
 
@@ -1055,6 +1182,7 @@ dbIStream& operator>>(dbIStream& stream, _dbBlock& block)
   stream >> *block._non_default_rule_tbl;
   stream >> *block._layer_rule_tbl;
   stream >> *block._prop_tbl;
+  block._prop_index->invalidate();
   stream >> *block._name_cache;
   stream >> *block._r_val_tbl;
   stream >> *block._c_val_tbl;
@@ -1777,6 +1905,20 @@ dbInst* dbBlock::findInst(const char* name)
   return (dbInst*) block->_inst_hash.find(name);
 }
 
+std::vector<dbInst*> dbBlock::findInsts(const std::vector<std::string>& names)
+{
+  _dbBlock* block = (_dbBlock*) this;
+  return findAll<_dbInst, dbInst>(block->_inst_hash, names);
+}
+
+std::vector<dbInst*> dbBlock::findInstsMatching(const char* pattern,
+                                                bool regexp)
+{
+  _dbBlock* block = (_dbBlock*) this;
+  return findMatching<_dbInst, dbInst>(
+      block->_inst_hash, pattern, regexp, block->getLogger());
+}
+
 dbModule* dbBlock::findModule(const char* name)
 {
   _dbBlock* block = (_dbBlock*) this;
@@ -1834,22 +1976,19 @@ dbITerm* dbBlock::findITerm(const char* name)
 {
   _dbBlock* block = (_dbBlock*) this;
 
-  std::string s(name);
+  const char* delimeter = strrchr(name, block->_hier_delimeter);
 
-  std::string::size_type idx = s.rfind(block->_hier_delimeter);
-
-  if (idx == std::string::npos)  // no delimeter
+  if (delimeter == NULL)  // no delimeter
     return NULL;
 
-  std::string instName = s.substr(0, idx);
-  std::string termName = s.substr(idx + 1, s.size());
+  std::string instName(name, delimeter - name);
 
   dbInst* inst = findInst(instName.c_str());
 
   if (inst == NULL)
     return NULL;
 
-  return inst->findITerm(termName.c_str());
+  return inst->findITerm(delimeter + 1);
 }
 
 dbSet<dbObstruction> dbBlock::getObstructions()
@@ -1882,6 +2021,19 @@ dbNet* dbBlock::findNet(const char* name)
   return (dbNet*) block->_net_hash.find(name);
 }
 
+std::vector<dbNet*> dbBlock::findNets(const std::vector<std::string>& names)
+{
+  _dbBlock* block = (_dbBlock*) this;
+  return findAll<_dbNet, dbNet>(block->_net_hash, names);
+}
+
+std::vector<dbNet*> dbBlock::findNetsMatching(const char* pattern, bool regexp)
+{
+  _dbBlock* block = (_dbBlock*) this;
+  return findMatching<_dbNet, dbNet>(
+      block->_net_hash, pattern, regexp, block->getLogger());
+}
+
 bool dbBlock::findSomeMaster(const char* names, std::vector<dbMaster*>& masters)
 {
   if (!names || names[0] == '\0')
@@ -60,6 +60,7 @@ template <class T>
 class dbArrayTable;
 class _dbProperty;
 class dbPropertyItr;
+class _dbPropertyIndex;
 class _dbNameCache;
 class _dbChip;
 class _dbBox;
@@ -128,6 +129,8 @@ class dbOStream;
 class dbDiff;
 class dbBlockSearch;
 class dbBlockCallBackObj;
+class dbConnectivity;
+class dbSpatialIndex;
 class dbGuideItr;
 class dbNetTrackItr;
 
@@ -267,7 +270,10 @@ class _dbBlock : public _dbObject
   dbGroupGroundNetItr* _group_ground_net_itr;
   dbBPinItr* _bpin_itr;
   dbPropertyItr* _prop_itr;
+  _dbPropertyIndex* _prop_index;
   dbBlockSearch* _searchDb;
+  dbConnectivity* _connectivity;
+  dbSpatialIndex* _spatial_index;
 
   float _WNS[2];
   float _TNS[2];
@@ -0,0 +1,287 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "dbBlockSnapshot.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "db.h"
+
+namespace odb {
+
+namespace {
+
+// restore() replays the edits in id order so it does not depend on
+// pointer hashing.
+template <typename T>
+std::vector<T*> sortedById(std::vector<T*> objects)
+{
+  std::sort(objects.begin(), objects.end(), [](T* obj1, T* obj2) {
+    return obj1->getId() < obj2->getId();
+  });
+  return objects;
+}
+
+}  // namespace
+
+dbBlockSnapshot::dbBlockSnapshot(dbBlock* block) : block_(block)
+{
+  addOwner(block);
+}
+
+bool dbBlockSnapshot::restore()
+{
+  if (!restorable_) {
+    return false;
+  }
+  restoring_ = true;
+
+  std::vector<dbInst*> created_insts(created_insts_.begin(),
+                                     created_insts_.end());
+  for (dbInst* inst : sortedById(std::move(created_insts))) {
+    dbInst::destroy(inst);
+  }
+
+  std::vector<dbInst*> insts;
+  insts.reserve(insts_.size());
+  for (const auto& [inst, state] : insts_) {
+    insts.push_back(inst);
+  }
+  for (dbInst* inst : sortedById(std::move(insts))) {
+    const InstState& state = insts_.at(inst);
+    if (inst->getMaster() != state.master) {
+      inst->swapMaster(state.master);
+    }
+    if (inst->getLocation() != state.location
+        || inst->getOrient() != state.orient) {
+      // odb does not move fixed instances.
+      if (inst->getPlacementStatus().isFixed()) {
+        inst->setPlacementStatus(dbPlacementStatus::PLACED);
+      }
+      inst->setOrient(state.orient);
+      inst->setLocation(state.location.x(), state.location.y());
+    }
+    inst->setPlacementStatus(state.status);
+  }
+
+  // Reconnect before the created nets are destroyed so they are empty.
+  std::vector<dbITerm*> iterms;
+  iterms.reserve(iterm_nets_.size());
+  for (const auto& [iterm, net] : iterm_nets_) {
+    iterms.push_back(iterm);
+  }
+  for (dbITerm* iterm : sortedById(std::move(iterms))) {
+    dbNet* net = iterm_nets_.at(iterm);
+    if (net) {
+      iterm->connect(net);
+    } else {
+      iterm->disconnect();
+    }
+  }
+
+  std::vector<dbNet*> created_nets(created_nets_.begin(),
+                                   created_nets_.end());
+  for (dbNet* net : sortedById(std::move(created_nets))) {
+    dbNet::destroy(net);
+  }
+
+  restoring_ = false;
+  clear();
+  return true;
+}
+
+void dbBlockSnapshot::commit()
+{
+  clear();
+  restorable_ = true;
+}
+
+void dbBlockSnapshot::clear()
+{
+  insts_.clear();
+  iterm_nets_.clear();
+  created_insts_.clear();
+  created_nets_.clear();
+}
+
+bool dbBlockSnapshot::isCreated(dbInst* inst) const
+{
+  return created_insts_.find(inst) != created_insts_.end();
+}
+
+dbMaster* dbBlockSnapshot::getMaster(dbInst* inst) const
+{
+  auto state = insts_.find(inst);
+  return state == insts_.end() ? inst->getMaster() : state->second.master;
+}
+
+Point dbBlockSnapshot::getLocation(dbInst* inst) const
+{
+  auto state = insts_.find(inst);
+  return state == insts_.end() ? inst->getLocation() : state->second.location;
+}
+
+dbOrientType dbBlockSnapshot::getOrient(dbInst* inst) const
+{
+  auto state = insts_.find(inst);
+  return state == insts_.end() ? inst->getOrient() : state->second.orient;
+}
+
+dbPlacementStatus dbBlockSnapshot::getPlacementStatus(dbInst* inst) const
+{
+  auto state = insts_.find(inst);
+  return state == insts_.end() ? inst->getPlacementStatus()
+                               : state->second.status;
+}
+
+dbNet* dbBlockSnapshot::getNet(dbITerm* iterm) const
+{
+  auto net = iterm_nets_.find(iterm);
+  return net == iterm_nets_.end() ? iterm->getNet() : net->second;
+}
+
+// Only the first change of an object is saved; later ones keep the
+// state it had at the snapshot.
+void dbBlockSnapshot::saveInst(dbInst* inst)
+{
+  if (restoring_ || isCreated(inst) || insts_.find(inst) != insts_.end()) {
+    return;
+  }
+  insts_.emplace(inst,
+                 InstState{inst->getMaster(),
+                           inst->getLocation(),
+                           inst->getOrient(),
+                           inst->getPlacementStatus()});
+}
+
+void dbBlockSnapshot::saveITerm(dbITerm* iterm)
+{
+  if (restoring_ || isCreated(iterm->getInst())) {
+    return;
+  }
+  iterm_nets_.emplace(iterm, iterm->getNet());
+}
+
+////////////////////////////////////////////////////////////////////
+
+void dbBlockSnapshot::inDbInstCreate(dbInst* inst)
+{
+  if (!restoring_) {
+    created_insts_.insert(inst);
+  }
+}
+
+void dbBlockSnapshot::inDbInstCreate(dbInst* inst, dbRegion* region)
+{
+  inDbInstCreate(inst);
+}
+
+void dbBlockSnapshot::inDbInstDestroy(dbInst* inst)
+{
+  if (restoring_ || created_insts_.erase(inst)) {
+    return;
+  }
+  insts_.erase(inst);
+  restorable_ = false;
+}
+
+void dbBlockSnapshot::inDbInstPlacementStatusBefore(
+    dbInst* inst,
+    const dbPlacementStatus& status)
+{
+  saveInst(inst);
+}
+
+void dbBlockSnapshot::inDbInstSwapMasterBefore(dbInst* inst, dbMaster* master)
+{
+  saveInst(inst);
+}
+
+void dbBlockSnapshot::inDbPreMoveInst(dbInst* inst)
+{
+  saveInst(inst);
+}
+
+void dbBlockSnapshot::inDbNetCreate(dbNet* net)
+{
+  if (!restoring_) {
+    created_nets_.insert(net);
+  }
+}
+
+void dbBlockSnapshot::inDbNetDestroy(dbNet* net)
+{
+  if (restoring_ || created_nets_.erase(net)) {
+    return;
+  }
+  restorable_ = false;
+}
+
+void dbBlockSnapshot::inDbITermDestroy(dbITerm* iterm)
+{
+  iterm_nets_.erase(iterm);
+}
+
+void dbBlockSnapshot::inDbITermPreDisconnect(dbITerm* iterm)
+{
+  saveITerm(iterm);
+}
+
+void dbBlockSnapshot::inDbITermPreConnect(dbITerm* iterm, dbNet* net)
+{
+  saveITerm(iterm);
+}
+
+void dbBlockSnapshot::inDbBTermCreate(dbBTerm* bterm)
+{
+  restorable_ = false;
+}
+
+void dbBlockSnapshot::inDbBTermDestroy(dbBTerm* bterm)
+{
+  if (!restoring_) {
+    restorable_ = false;
+  }
+}
+
+void dbBlockSnapshot::inDbBTermPreConnect(dbBTerm* bterm, dbNet* net)
+{
+  restorable_ = false;
+}
+
+void dbBlockSnapshot::inDbBTermPreDisconnect(dbBTerm* bterm)
+{
+  restorable_ = false;
+}
+
+}  // namespace odb
@@ -38,6 +38,7 @@
 #include "dbDatabase.h"
 #include "dbNameCache.h"
 #include "dbProperty.h"
+#include "dbPropertyIndex.h"
 #include "dbPropertyItr.h"
 #include "dbTable.h"
 #include "dbTable.hpp"
@@ -106,6 +107,7 @@ _dbChip::_dbChip(_dbDatabase* db)
   _block_itr = new dbBlockItr(_block_tbl);
 
   _prop_itr = new dbPropertyItr(_prop_tbl);
+  _prop_index = new _dbPropertyIndex(_prop_tbl);
 }
 
 _dbChip::_dbChip(_dbDatabase* db, const _dbChip& c) : _top(c._top)
@@ -119,6 +121,7 @@ _dbChip::_dbChip(_dbDatabase* db, const _dbChip& c) : _top(c._top)
   _block_itr = new dbBlockItr(_block_tbl);
 
   _prop_itr = new dbPropertyItr(_prop_tbl);
+  _prop_index = new _dbPropertyIndex(_prop_tbl);
 }
 
 _dbChip::~_dbChip()
@@ -128,6 +131,7 @@ _dbChip::~_dbChip()
   delete _name_cache;
   delete _block_itr;
   delete _prop_itr;
+  delete _prop_index;
 }
 
 dbOStream& operator<<(dbOStream& stream, const _dbChip& chip)
@@ -144,6 +148,7 @@ dbIStream& operator>>(dbIStream& stream, _dbChip& chip)
   stream >> chip._top;
   stream >> *chip._block_tbl;
   stream >> *chip._prop_tbl;
+  chip._prop_index->invalidate();
   stream >> *chip._name_cache;
 
   return stream;
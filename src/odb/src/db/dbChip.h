@@ -41,6 +41,7 @@ template <class T>
 class dbTable;
 class _dbProperty;
 class dbPropertyItr;
+class _dbPropertyIndex;
 class _dbNameCache;
 class _dbTech;
 class _dbBlock;
@@ -62,6 +63,7 @@ class _dbChip : public _dbObject
   _dbNameCache* _name_cache;
   dbBlockItr* _block_itr;
   dbPropertyItr* _prop_itr;
+  _dbPropertyIndex* _prop_index;
 
   _dbChip(_dbDatabase* db);
   _dbChip(_dbDatabase* db, const _dbChip& c);
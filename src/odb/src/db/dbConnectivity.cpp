@@ -0,0 +1,317 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "dbConnectivity.h"
+
+#include <functional>
+#include <numeric>
+#include <unordered_map>
+
+#include "db.h"
+#include "dbBlock.h"
+#include "dbInst.h"
+#include "dbNet.h"
+#include "dbTable.h"
+#include "utl/Executor.h"
+
+namespace odb {
+
+namespace {
+
+void forEachId(utl::Executor* executor,
+               int begin,
+               int end,
+               const std::function<void(int)>& func)
+{
+  if (executor) {
+    executor->parallelFor(begin, end, func);
+  } else {
+    for (int i = begin; i < end; i++) {
+      func(i);
+    }
+  }
+}
+
+Point pinOffset(dbMTerm* mterm)
+{
+  const Rect bbox = mterm->getBBox();
+  return Point((bbox.xMin() + bbox.xMax()) / 2,
+               (bbox.yMin() + bbox.yMax()) / 2);
+}
+
+// Turn the counts stored at [id + 1] into the offsets of each id.
+void countsToOffsets(std::vector<int>& begin)
+{
+  std::partial_sum(begin.begin(), begin.end(), begin.begin());
+}
+
+}  // namespace
+
+dbConnectivity::dbConnectivity(dbBlock* block) : block_(block)
+{
+  addOwner(block);
+}
+
+dbConnectivity* dbConnectivity::get(dbBlock* block, utl::Executor* executor)
+{
+  _dbBlock* _block = (_dbBlock*) block;
+  if (_block->_connectivity == nullptr) {
+    _block->_connectivity = new dbConnectivity(block);
+  }
+  dbConnectivity* connectivity = _block->_connectivity;
+  if (!connectivity->valid_) {
+    connectivity->build(executor);
+  }
+  return connectivity;
+}
+
+void dbConnectivity::build(utl::Executor* executor)
+{
+  _dbBlock* block = (_dbBlock*) block_;
+  dbTable<_dbNet>* net_tbl = block->_net_tbl;
+  dbTable<_dbInst>* inst_tbl = block->_inst_tbl;
+
+  // The master pin offsets are shared by all the instances of a master.
+  std::unordered_map<dbMTerm*, Point> mterm_offsets;
+  for (dbLib* lib : block_->getDataBase()->getLibs()) {
+    for (dbMaster* master : lib->getMasters()) {
+      for (dbMTerm* mterm : master->getMTerms()) {
+        mterm_offsets[mterm] = pinOffset(mterm);
+      }
+    }
+  }
+
+  // Count the terms of each object, then fill them in at their offsets.
+  // Each id only writes its own slots so the passes run in parallel.
+  const int net_end = net_tbl->_top_idx + 1;
+  net_iterm_begin_.assign(net_end + 1, 0);
+  net_bterm_begin_.assign(net_end + 1, 0);
+  forEachId(executor, 1, net_end, [&](int id) {
+    if (!net_tbl->validId(id)) {
+      return;
+    }
+    dbNet* net = (dbNet*) net_tbl->getPtr(id);
+    int iterm_count = 0;
+    for (dbITerm* iterm : net->getITerms()) {
+      (void) iterm;
+      iterm_count++;
+    }
+    int bterm_count = 0;
+    for (dbBTerm* bterm : net->getBTerms()) {
+      (void) bterm;
+      bterm_count++;
+    }
+    net_iterm_begin_[id + 1] = iterm_count;
+    net_bterm_begin_[id + 1] = bterm_count;
+  });
+  countsToOffsets(net_iterm_begin_);
+  countsToOffsets(net_bterm_begin_);
+
+  net_iterms_.resize(net_iterm_begin_.back());
+  net_bterms_.resize(net_bterm_begin_.back());
+  forEachId(executor, 1, net_end, [&](int id) {
+    if (!net_tbl->validId(id)) {
+      return;
+    }
+    dbNet* net = (dbNet*) net_tbl->getPtr(id);
+    int i = net_iterm_begin_[id];
+    for (dbITerm* iterm : net->getITerms()) {
+      net_iterms_[i++] = iterm;
+    }
+    i = net_bterm_begin_[id];
+    for (dbBTerm* bterm : net->getBTerms()) {
+      net_bterms_[i++] = bterm;
+    }
+  });
+
+  const int inst_end = inst_tbl->_top_idx + 1;
+  inst_iterm_begin_.assign(inst_end + 1, 0);
+  inst_master_ids_.assign(inst_end, 0);
+  for (int id = 1; id < inst_end; id++) {
+    if (inst_tbl->validId(id)) {
+      inst_iterm_begin_[id + 1] = inst_tbl->getPtr(id)->_iterms.size();
+    }
+  }
+  countsToOffsets(inst_iterm_begin_);
+
+  inst_iterms_.resize(inst_iterm_begin_.back());
+  iterm_offsets_.assign(block->_iterm_tbl->_top_idx + 1, Point());
+  forEachId(executor, 1, inst_end, [&](int id) {
+    if (!inst_tbl->validId(id)) {
+      return;
+    }
+    dbInst* inst = (dbInst*) inst_tbl->getPtr(id);
+    inst_master_ids_[id] = inst->getMaster()->getMasterId();
+    int i = inst_iterm_begin_[id];
+    for (dbITerm* iterm : inst->getITerms()) {
+      inst_iterms_[i++] = iterm;
+      iterm_offsets_[iterm->getId()] = mterm_offsets.at(iterm->getMTerm());
+    }
+  });
+
+  valid_ = true;
+}
+
+void dbConnectivity::updateInst(dbInst* inst)
+{
+  const uint id = inst->getId();
+  if (id >= inst_master_ids_.size()) {
+    invalidate();
+    return;
+  }
+  inst_master_ids_[id] = inst->getMaster()->getMasterId();
+  // swapMaster keeps the iterms but reorders them to the new mterms.
+  int i = inst_iterm_begin_[id];
+  for (dbITerm* iterm : inst->getITerms()) {
+    inst_iterms_[i++] = iterm;
+    iterm_offsets_[iterm->getId()] = pinOffset(iterm->getMTerm());
+  }
+}
+
+dbConnectivity::Range<dbITerm* const> dbConnectivity::getITerms(
+    dbNet* net) const
+{
+  const uint id = net->getId();
+  if (id + 1 >= net_iterm_begin_.size()) {
+    return {};
+  }
+  return {net_iterms_.data() + net_iterm_begin_[id],
+          net_iterms_.data() + net_iterm_begin_[id + 1]};
+}
+
+dbConnectivity::Range<dbBTerm* const> dbConnectivity::getBTerms(
+    dbNet* net) const
+{
+  const uint id = net->getId();
+  if (id + 1 >= net_bterm_begin_.size()) {
+    return {};
+  }
+  return {net_bterms_.data() + net_bterm_begin_[id],
+          net_bterms_.data() + net_bterm_begin_[id + 1]};
+}
+
+dbConnectivity::Range<dbITerm* const> dbConnectivity::getITerms(
+    dbInst* inst) const
+{
+  const uint id = inst->getId();
+  if (id + 1 >= inst_iterm_begin_.size()) {
+    return {};
+  }
+  return {inst_iterms_.data() + inst_iterm_begin_[id],
+          inst_iterms_.data() + inst_iterm_begin_[id + 1]};
+}
+
+int dbConnectivity::getMasterId(dbInst* inst) const
+{
+  const uint id = inst->getId();
+  if (id >= inst_master_ids_.size()) {
+    return inst->getMaster()->getMasterId();
+  }
+  return inst_master_ids_[id];
+}
+
+Point dbConnectivity::getPinOffset(dbITerm* iterm) const
+{
+  const uint id = iterm->getId();
+  if (id >= iterm_offsets_.size()) {
+    return pinOffset(iterm->getMTerm());
+  }
+  return iterm_offsets_[id];
+}
+
+////////////////////////////////////////////////////////////////////
+//
+// dbConnectivity - Callbacks
+//
+////////////////////////////////////////////////////////////////////
+
+// Nets created after the build have no terms yet and read as empty, so
+// only edits to existing connectivity invalidate the snapshot.
+
+void dbConnectivity::inDbInstCreate(dbInst* inst)
+{
+  invalidate();
+}
+
+void dbConnectivity::inDbInstCreate(dbInst* inst, dbRegion* region)
+{
+  invalidate();
+}
+
+void dbConnectivity::inDbInstDestroy(dbInst* inst)
+{
+  invalidate();
+}
+
+void dbConnectivity::inDbInstSwapMasterAfter(dbInst* inst)
+{
+  if (valid_) {
+    updateInst(inst);
+  }
+}
+
+void dbConnectivity::inDbNetDestroy(dbNet* net)
+{
+  invalidate();
+}
+
+void dbConnectivity::inDbITermPostConnect(dbITerm* iterm)
+{
+  invalidate();
+}
+
+void dbConnectivity::inDbITermPostDisconnect(dbITerm* iterm, dbNet* net)
+{
+  invalidate();
+}
+
+void dbConnectivity::inDbBTermCreate(dbBTerm* bterm)
+{
+  invalidate();
+}
+
+void dbConnectivity::inDbBTermDestroy(dbBTerm* bterm)
+{
+  invalidate();
+}
+
+void dbConnectivity::inDbBTermPostConnect(dbBTerm* bterm)
+{
+  invalidate();
+}
+
+void dbConnectivity::inDbBTermPostDisConnect(dbBTerm* bterm, dbNet* net)
+{
+  invalidate();
+}
+
+}  // namespace odb
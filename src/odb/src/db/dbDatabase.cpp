@@ -51,6 +51,7 @@
 #include "dbNameCache.h"
 #include "dbNet.h"
 #include "dbProperty.h"
+#include "dbPropertyIndex.h"
 #include "dbPropertyItr.h"
 #include "dbRSeg.h"
 #include "dbStream.h"
@@ -195,6 +196,7 @@ _dbDatabase::_dbDatabase(_dbDatabase* /* unused: db */)
       this, this, (GetObjTbl_t) &_dbDatabase::getObjectTable);
 
   _prop_itr = new dbPropertyItr(_prop_tbl);
+  _prop_index = new _dbPropertyIndex(_prop_tbl);
 }
 
 //
@@ -228,6 +230,7 @@ _dbDatabase::_dbDatabase(_dbDatabase* /* unused: db */, int id)
       this, this, (GetObjTbl_t) &_dbDatabase::getObjectTable);
 
   _prop_itr = new dbPropertyItr(_prop_tbl);
+  _prop_index = new _dbPropertyIndex(_prop_tbl);
 }
 
 _dbDatabase::_dbDatabase(_dbDatabase* /* unused: db */, const _dbDatabase& d)
@@ -258,6 +261,7 @@ _dbDatabase::_dbDatabase(_dbDatabase* /* unused: db */, const _dbDatabase& d)
   _name_cache = new _dbNameCache(this, this, *d._name_cache);
 
   _prop_itr = new dbPropertyItr(_prop_tbl);
+  _prop_index = new _dbPropertyIndex(_prop_tbl);
 }
 
 _dbDatabase::~_dbDatabase()
@@ -266,6 +270,7 @@ _dbDatabase::~_dbDatabase()
   delete _lib_tbl;
   delete _chip_tbl;
   delete _prop_tbl;
+  delete _prop_index;
   delete _name_cache;
   // dimitri_fix
   // delete _prop_itr;
@@ -321,6 +326,7 @@ dbIStream& operator>>(dbIStream& stream, _dbDatabase& db)
   stream >> *db._lib_tbl;
   stream >> *db._chip_tbl;
   stream >> *db._prop_tbl;
+  db._prop_index->invalidate();
   stream >> *db._name_cache;
 
   // Fix up the owner id of properties of this db, this value changes.
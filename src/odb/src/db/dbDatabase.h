@@ -80,6 +80,7 @@ template <class T>
 class dbTable;
 class _dbProperty;
 class dbPropertyItr;
+class _dbPropertyIndex;
 class _dbNameCache;
 class _dbTech;
 class _dbChip;
@@ -107,6 +108,7 @@ class _dbDatabase : public _dbObject
   dbTable<_dbProperty>* _prop_tbl;
   _dbNameCache* _name_cache;
   dbPropertyItr* _prop_itr;
+  _dbPropertyIndex* _prop_index;
   int _unique_id;
 
   char* _file;
@@ -32,6 +32,11 @@
 
 #pragma once
 
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
 #include "dbPagedVector.h"
 #include "odb.h"
 
@@ -52,6 +57,13 @@ class dbTable;
 ///     char *        _name
 ///     dbId<T>       _next_entry
 ///
+/// The chained table is what gets streamed.  Lookups go through an
+/// open-addressed index built from it on first use, where each slot keeps
+/// the full hash of the name so a probe only touches the object (and
+/// compares the name) on a hash match.  A second index of the ids sorted
+/// by name serves prefix and pattern queries.  Both indices are built
+/// under a lock so concurrent lookups are safe; edits are not.
+///
 //////////////////////////////////////////////////////////
 template <class T>
 class dbHashTable
@@ -62,16 +74,36 @@ class dbHashTable
     CHAIN_LENGTH = 4
   };
 
+  struct Slot
+  {
+    uint _hash;
+    uint _id;  // 0 if empty
+  };
+
   // PERSISTANT-MEMBERS
   dbPagedVector<dbId<T>, 256, 8> _hash_tbl;
   uint _num_entries;
 
   // NON-PERSISTANT-MEMBERS
   dbTable<T>* _obj_tbl;
+  std::vector<Slot> _slots;       // linear probing, at most 3/4 full
+  std::vector<uint> _sorted_ids;  // ids sorted by name
+  std::atomic<bool> _slots_valid;
+  std::atomic<bool> _sorted_valid;
+  std::mutex _index_mutex;
 
   void growTable();
   void shrinkTable();
 
+  template <typename Func>
+  void forEachEntry(Func func) const;
+  void buildSlots();
+  void buildSorted();
+  void insertSlot(uint hash, uint id);
+  void removeSlot(T* object);
+  T* findSlot(const char* name, uint hash) const;
+  void invalidateIndex();
+
   dbHashTable();
   dbHashTable(const dbHashTable<T>& table);
   ~dbHashTable();
@@ -87,6 +119,15 @@ class dbHashTable
   int hasMember(const char* name);
   void insert(T* object);
   void remove(T* object);
+
+  // Find each of names, nullptr for the missing ones.
+  void find(const std::vector<const char*>& names, std::vector<T*>& objects);
+  // Objects whose name starts with prefix and satisfies match(name),
+  // in name order.
+  template <typename Match>
+  void findMatching(const std::string& prefix,
+                    Match match,
+                    std::vector<T*>& objects);
 };
 
 template <class T>
@@ -32,6 +32,9 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstring>
+
 #include "dbCore.h"
 #include "dbHashTable.h"
 
@@ -50,6 +53,7 @@ inline unsigned int hash_string(const char* str)
 
 template <class T>
 dbHashTable<T>::dbHashTable()
+    : _slots_valid(false), _sorted_valid(false)
 {
   _obj_tbl = NULL;
   _num_entries = 0;
@@ -57,7 +61,11 @@ dbHashTable<T>::dbHashTable()
 
 template <class T>
 dbHashTable<T>::dbHashTable(const dbHashTable<T>& t)
-    : _hash_tbl(t._hash_tbl), _num_entries(t._num_entries), _obj_tbl(t._obj_tbl)
+    : _hash_tbl(t._hash_tbl),
+      _num_entries(t._num_entries),
+      _obj_tbl(t._obj_tbl),
+      _slots_valid(false),
+      _sorted_valid(false)
 {
 }
 
@@ -183,61 +191,224 @@ void dbHashTable<T>::insert(T* object)
     }
   }
 
-  uint hid = hash_string(object->_name) & (sz - 1);
+  uint hash = hash_string(object->_name);
+  uint hid = hash & (sz - 1);
   dbId<T>& e = _hash_tbl[hid];
   object->_next_entry = e;
   e = object->getOID();
+
+  _sorted_valid = false;
+  if (_slots_valid) {
+    if (_num_entries * 4 > _slots.size() * 3) {
+      _slots_valid = false;
+      buildSlots();
+    } else {
+      insertSlot(hash, object->getOID());
+    }
+  }
 }
 
 template <class T>
-T* dbHashTable<T>::find(const char* name)
+template <typename Func>
+void dbHashTable<T>::forEachEntry(Func func) const
 {
   uint sz = _hash_tbl.size();
 
-  if (sz == 0)
-    return 0;
+  for (uint i = 0; i < sz; ++i) {
+    dbId<T> cur = _hash_tbl[i];
 
-  uint hid = hash_string(name) & (sz - 1);
-  dbId<T> cur = _hash_tbl[hid];
+    while (cur != 0) {
+      T* entry = _obj_tbl->getPtr(cur);
+      func(entry);
+      cur = entry->_next_entry;
+    }
+  }
+}
 
-  while (cur != 0) {
-    T* entry = _obj_tbl->getPtr(cur);
+template <class T>
+void dbHashTable<T>::buildSlots()
+{
+  std::lock_guard<std::mutex> lock(_index_mutex);
+  if (_slots_valid) {
+    return;
+  }
 
-    if (strcmp(entry->_name, name) == 0)
-      return entry;
+  uint sz = 16;
+  while (sz * 3 < _num_entries * 4) {
+    sz <<= 1;
+  }
+  _slots.assign(sz, Slot{0, 0});
 
-    cur = entry->_next_entry;
+  forEachEntry([this](T* entry) {
+    insertSlot(hash_string(entry->_name), entry->getOID());
+  });
+
+  _slots_valid = true;
+}
+
+template <class T>
+void dbHashTable<T>::buildSorted()
+{
+  std::lock_guard<std::mutex> lock(_index_mutex);
+  if (_sorted_valid) {
+    return;
   }
 
-  return NULL;
+  _sorted_ids.clear();
+  _sorted_ids.reserve(_num_entries);
+  forEachEntry([this](T* entry) { _sorted_ids.push_back(entry->getOID()); });
+
+  std::sort(_sorted_ids.begin(), _sorted_ids.end(), [this](uint a, uint b) {
+    return strcmp(_obj_tbl->getPtr(a)->_name, _obj_tbl->getPtr(b)->_name) < 0;
+  });
+
+  _sorted_valid = true;
 }
 
 template <class T>
-int dbHashTable<T>::hasMember(const char* name)
+void dbHashTable<T>::insertSlot(uint hash, uint id)
 {
-  uint sz = _hash_tbl.size();
+  uint mask = _slots.size() - 1;
+  uint i = hash & mask;
 
-  if (sz == 0)
-    return false;
+  while (_slots[i]._id != 0)
+    i = (i + 1) & mask;
 
-  uint hid = hash_string(name) & (sz - 1);
-  dbId<T> cur = _hash_tbl[hid];
+  _slots[i] = Slot{hash, id};
+}
 
-  while (cur != 0) {
-    T* entry = _obj_tbl->getPtr(cur);
+template <class T>
+void dbHashTable<T>::removeSlot(T* object)
+{
+  uint mask = _slots.size() - 1;
+  uint id = object->getOID();
+  uint i = hash_string(object->_name) & mask;
 
-    if (strcmp(entry->_name, name) == 0)
-      return true;
+  while (_slots[i]._id != id) {
+    if (_slots[i]._id == 0)
+      return;
+    i = (i + 1) & mask;
+  }
 
-    cur = entry->_next_entry;
+  // Shift the following entries of the cluster back so no probe sequence
+  // is cut by the hole.
+  uint j = i;
+  while (true) {
+    j = (j + 1) & mask;
+    if (_slots[j]._id == 0)
+      break;
+    uint home = _slots[j]._hash & mask;
+    bool movable = (i <= j) ? (home <= i || home > j) : (home <= i && home > j);
+    if (movable) {
+      _slots[i] = _slots[j];
+      i = j;
+    }
   }
 
-  return false;
+  _slots[i] = Slot{0, 0};
+}
+
+template <class T>
+T* dbHashTable<T>::findSlot(const char* name, uint hash) const
+{
+  uint mask = _slots.size() - 1;
+
+  for (uint i = hash & mask;; i = (i + 1) & mask) {
+    const Slot& slot = _slots[i];
+
+    if (slot._id == 0)
+      return NULL;
+
+    if (slot._hash == hash) {
+      T* entry = _obj_tbl->getPtr(slot._id);
+      if (strcmp(entry->_name, name) == 0)
+        return entry;
+    }
+  }
+}
+
+template <class T>
+void dbHashTable<T>::invalidateIndex()
+{
+  _slots_valid = false;
+  _sorted_valid = false;
+}
+
+template <class T>
+T* dbHashTable<T>::find(const char* name)
+{
+  if (!_slots_valid)
+    buildSlots();
+
+  return findSlot(name, hash_string(name));
+}
+
+template <class T>
+void dbHashTable<T>::find(const std::vector<const char*>& names,
+                          std::vector<T*>& objects)
+{
+  if (!_slots_valid)
+    buildSlots();
+
+  objects.resize(names.size());
+
+  // Hash a batch of names and prefetch their slots before probing so
+  // the cache misses of the batch overlap.
+  const uint mask = _slots.size() - 1;
+  constexpr size_t batch_size = 16;
+  uint hashes[batch_size];
+  for (size_t begin = 0; begin < names.size(); begin += batch_size) {
+    const size_t count = std::min(batch_size, names.size() - begin);
+    for (size_t i = 0; i < count; ++i) {
+      hashes[i] = hash_string(names[begin + i]);
+      __builtin_prefetch(&_slots[hashes[i] & mask]);
+    }
+    for (size_t i = 0; i < count; ++i)
+      objects[begin + i] = findSlot(names[begin + i], hashes[i]);
+  }
+}
+
+template <class T>
+template <typename Match>
+void dbHashTable<T>::findMatching(const std::string& prefix,
+                                  Match match,
+                                  std::vector<T*>& objects)
+{
+  if (!_sorted_valid)
+    buildSorted();
+
+  auto itr = std::lower_bound(
+      _sorted_ids.begin(),
+      _sorted_ids.end(),
+      prefix,
+      [this](uint id, const std::string& name) {
+        return strcmp(_obj_tbl->getPtr(id)->_name, name.c_str()) < 0;
+      });
+
+  for (; itr != _sorted_ids.end(); ++itr) {
+    T* entry = _obj_tbl->getPtr(*itr);
+
+    if (strncmp(entry->_name, prefix.c_str(), prefix.size()) != 0)
+      break;
+
+    if (match(entry->_name))
+      objects.push_back(entry);
+  }
+}
+
+template <class T>
+int dbHashTable<T>::hasMember(const char* name)
+{
+  return find(name) != NULL;
 }
 
 template <class T>
 void dbHashTable<T>::remove(T* object)
 {
+  _sorted_valid = false;
+  if (_slots_valid)
+    removeSlot(object);
+
   uint sz = _hash_tbl.size();
   uint hid = hash_string(object->_name) & (sz - 1);
   dbId<T> cur = _hash_tbl[hid];
@@ -282,6 +453,7 @@ dbIStream& operator>>(dbIStream& stream, dbHashTable<T>& table)
 {
   stream >> table._hash_tbl;
   stream >> table._num_entries;
+  table.invalidateIndex();
   return stream;
 }
 
@@ -38,6 +38,7 @@
 #include "dbMaster.h"
 #include "dbNameCache.h"
 #include "dbProperty.h"
+#include "dbPropertyIndex.h"
 #include "dbPropertyItr.h"
 #include "dbSite.h"
 #include "dbTable.h"
@@ -166,6 +167,7 @@ _dbLib::_dbLib(_dbDatabase* db)
       = new _dbNameCache(db, this, (GetObjTbl_t) &_dbLib::getObjectTable);
 
   _prop_itr = new dbPropertyItr(_prop_tbl);
+  _prop_index = new _dbPropertyIndex(_prop_tbl);
 
   _master_hash.setTable(_master_tbl);
   _site_hash.setTable(_site_tbl);
@@ -196,6 +198,7 @@ _dbLib::_dbLib(_dbDatabase* db, const _dbLib& l)
   _name_cache = new _dbNameCache(db, this, *l._name_cache);
 
   _prop_itr = new dbPropertyItr(_prop_tbl);
+  _prop_index = new _dbPropertyIndex(_prop_tbl);
 
   _master_hash.setTable(_master_tbl);
   _site_hash.setTable(_site_tbl);
@@ -208,6 +211,7 @@ _dbLib::~_dbLib()
   delete _prop_tbl;
   delete _name_cache;
   delete _prop_itr;
+  delete _prop_index;
 
   if (_name)
     free((void*) _name);
@@ -245,6 +249,7 @@ dbIStream& operator>>(dbIStream& stream, _dbLib& lib)
   stream >> *lib._master_tbl;
   stream >> *lib._site_tbl;
   stream >> *lib._prop_tbl;
+  lib._prop_index->invalidate();
   stream >> *lib._name_cache;
 
   return stream;
@@ -42,6 +42,7 @@ template <class T>
 class dbTable;
 class _dbProperty;
 class dbPropertyItr;
+class _dbPropertyIndex;
 class _dbNameCache;
 class _dbTech;
 class _dbMaster;
@@ -72,6 +73,7 @@ class _dbLib : public _dbObject
   _dbNameCache* _name_cache;
 
   dbPropertyItr* _prop_itr;
+  _dbPropertyIndex* _prop_index;
 
   _dbLib(_dbDatabase* db);
   _dbLib(_dbDatabase* db, const _dbLib& l);
@@ -42,6 +42,8 @@
 #include "dbTable.h"
 #include "dbTable.hpp"
 // User Code Begin Includes
+#include <cstring>
+
 #include "dbGroup.h"
 // User Code End Includes
 namespace odb {
@@ -290,6 +292,13 @@ std::string dbModInst::getName() const
   return h_name.substr(idx + 1);
 }
 
+const char* dbModInst::getConstName() const
+{
+  _dbModInst* obj = (_dbModInst*) this;
+  const char* name = strrchr(obj->_name, '/');
+  return name ? name + 1 : obj->_name;
+}
+
 std::string dbModInst::getHierarchicalName() const
 {
   _dbModInst* _obj = (_dbModInst*) this;
@@ -39,10 +39,12 @@
 #include "dbLib.h"
 #include "dbName.h"
 #include "dbNameCache.h"
+#include "dbPropertyIndex.h"
 #include "dbPropertyItr.h"
 #include "dbTable.h"
 #include "dbTable.hpp"
 #include "dbTech.h"
+#include "utl/Logger.h"
 
 namespace odb {
 
@@ -322,6 +324,126 @@ next_object:
   return NULL;
 }
 
+_dbPropertyIndex* _dbProperty::getPropIndex(dbObject* object)
+{
+next_object:
+  switch (object->getObjectType()) {
+    case dbDatabaseObj: {
+      _dbDatabase* db = (_dbDatabase*) object;
+      return db->_prop_index;
+    }
+
+    case dbChipObj: {
+      _dbChip* chip = (_dbChip*) object;
+      return chip->_prop_index;
+    }
+
+    case dbBlockObj: {
+      _dbBlock* blk = (_dbBlock*) object;
+      return blk->_prop_index;
+    }
+
+    case dbLibObj: {
+      _dbLib* lib = (_dbLib*) object;
+      return lib->_prop_index;
+    }
+
+    case dbTechObj: {
+      _dbTech* tech = (_dbTech*) object;
+      return tech->_prop_index;
+    }
+
+    default:
+      object = object->getImpl()->getOwner();
+      goto next_object;
+  }
+
+  assert(0);
+  return NULL;
+}
+
+// Walks the property list of the object; used for owners the index does not
+// cover.  A negative type matches any type.
+static _dbProperty* findListProperty(dbObject* object, uint name_id, int type)
+{
+  dbSet<dbProperty> props = dbProperty::getProperties(object);
+  dbSet<dbProperty>::iterator itr;
+
+  for (itr = props.begin(); itr != props.end(); ++itr) {
+    _dbProperty* p = (_dbProperty*) *itr;
+
+    if (p->_name == name_id && (type < 0 || p->_flags._type == (uint) type))
+      return p;
+  }
+
+  return NULL;
+}
+
+_dbProperty* _dbProperty::findProperty(dbObject* object_,
+                                       const char* name,
+                                       _PropTypeEnum type)
+{
+  _dbObject* object = object_->getImpl();
+  _dbNameCache* cache = getNameCache(object);
+
+  uint name_id = cache->findName(name);
+
+  if (name_id == 0)
+    return NULL;
+
+  _dbPropertyIndex* index = getPropIndex(object);
+
+  if (!index->isIndexed(object))
+    return findListProperty(object_, name_id, type);
+
+  uint id = index->find(name_id, object->getType(), object->getOID(), type);
+
+  if (id == 0)
+    return NULL;
+
+  return getPropTable(object)->getPtr(id);
+}
+
+void _dbProperty::findProperties(const std::vector<dbObject*>& objects,
+                                 const char* name,
+                                 _PropTypeEnum type,
+                                 std::vector<_dbProperty*>& props)
+{
+  props.assign(objects.size(), nullptr);
+
+  // Objects are usually from the same block so the name and its column
+  // are only resolved when the property table changes.
+  dbTable<_dbProperty>* table = NULL;
+  _dbPropertyIndex* index = NULL;
+  uint name_id = 0;
+  const _dbPropertyIndex::Column* column = NULL;
+
+  for (size_t i = 0; i < objects.size(); ++i) {
+    _dbObject* object = objects[i]->getImpl();
+    dbTable<_dbProperty>* object_table = getPropTable(object);
+
+    if (object_table != table) {
+      table = object_table;
+      index = getPropIndex(object);
+      name_id = getNameCache(object)->findName(name);
+      column = name_id ? index->getColumn(name_id) : NULL;
+    }
+
+    if (!index->isIndexed(object)) {
+      if (name_id)
+        props[i] = findListProperty(objects[i], name_id, type);
+      continue;
+    }
+
+    uint id = index->find(column, object->getType(), object->getOID(), type);
+
+    if (id == 0)
+      continue;
+
+    props[i] = table->getPtr(id);
+  }
+}
+
 _dbProperty* _dbProperty::createProperty(dbObject* object_,
                                          const char* name,
                                          _PropTypeEnum type)
@@ -347,6 +469,8 @@ _dbProperty* _dbProperty::createProperty(dbObject* object_,
   prop->_next = propList;
   propList = prop->getImpl()->getOID();
   table->setPropList(oid, propList);
+
+  getPropIndex(object)->insert(prop);
   return prop;
 }
 
@@ -378,6 +502,7 @@ dbObject* dbProperty::getPropOwner()
 
 dbProperty* dbProperty::find(dbObject* object, const char* name)
 {
+  _dbObject* impl = object->getImpl();
   _dbNameCache* cache = _dbProperty::getNameCache(object);
 
   uint name_id = cache->findName(name);
@@ -385,41 +510,40 @@ dbProperty* dbProperty::find(dbObject* object, const char* name)
   if (name_id == 0)
     return NULL;
 
-  dbSet<dbProperty> props = getProperties(object);
+  // The typed creates allow one property of each type under the same name.
+  _dbPropertyIndex* index = _dbProperty::getPropIndex(object);
 
-  dbSet<dbProperty>::iterator itr;
+  if (!index->isIndexed(impl))
+    return (dbProperty*) findListProperty(object, name_id, -1);
 
-  for (itr = props.begin(); itr != props.end(); ++itr) {
-    _dbProperty* p = (_dbProperty*) *itr;
-
-    if (p->_name == name_id)
-      return (dbProperty*) p;
-  }
+  const _dbPropertyIndex::Column* column = index->getColumn(name_id);
+  uint found = 0;
+  int count = 0;
 
-  return NULL;
-}
+  for (int type = DB_STRING_PROP; type <= DB_DOUBLE_PROP; ++type) {
+    uint id = index->find(column, impl->getType(), impl->getOID(), type);
 
-dbProperty* dbProperty::find(dbObject* object, const char* name, Type type)
-{
-  _dbNameCache* cache = _dbProperty::getNameCache(object);
-
-  uint name_id = cache->findName(name);
+    if (id) {
+      found = id;
+      ++count;
+    }
+  }
 
-  if (name_id == 0)
+  if (count == 0)
     return NULL;
 
-  dbSet<dbProperty> props = getProperties(object);
-
-  dbSet<dbProperty>::iterator itr;
-
-  for (itr = props.begin(); itr != props.end(); ++itr) {
-    _dbProperty* p = (_dbProperty*) *itr;
+  if (count == 1)
+    return (dbProperty*) _dbProperty::getPropTable(object)->getPtr(found);
 
-    if ((p->_name == name_id) && (p->_flags._type == (_PropTypeEnum) type))
-      return (dbProperty*) p;
-  }
+  // Several types share the name; return the first one in the object's
+  // property list as before.
+  return (dbProperty*) findListProperty(object, name_id, -1);
+}
 
-  return NULL;
+dbProperty* dbProperty::find(dbObject* object, const char* name, Type type)
+{
+  return (dbProperty*) _dbProperty::findProperty(
+      object, name, (_PropTypeEnum) type);
 }
 
 dbSet<dbProperty> dbProperty::getProperties(dbObject* object)
@@ -456,6 +580,8 @@ void dbProperty::destroy(dbProperty* prop_)
     cur = p->_next;
   }
 
+  _dbProperty::getPropIndex(prop)->remove(prop);
+
   // Remove reference to name
   _dbNameCache* cache = _dbProperty::getNameCache(prop);
   cache->removeName(prop->_name);
@@ -478,8 +604,10 @@ void dbProperty::destroyProperties(dbObject* obj)
 
   _dbNameCache* cache = _dbProperty::getNameCache(obj);
   dbTable<_dbProperty>* propTable = _dbProperty::getPropTable(obj);
+  _dbPropertyIndex* propIndex = _dbProperty::getPropIndex(obj);
   while (cur) {
     _dbProperty* p = propTable->getPtr(cur);
+    propIndex->remove(p);
     cache->removeName(p->_name);
     cur = p->_next;
     dbProperty::destroyProperties(p);
@@ -582,6 +710,22 @@ dbStringProperty* dbStringProperty::find(dbObject* object, const char* name)
 // int property
 /////////////////////////////////////////////
 
+// The typed creates allow one property of each type under the same name,
+// which is rarely what a bulk setter caller intends.
+static void reportTypeClash(dbObject* object,
+                            const char* name,
+                            const char* type)
+{
+  object->getImpl()->getLogger()->warn(
+      utl::ODB,
+      432,
+      "Property {} of {} {} has another type; adding a {} property.",
+      name,
+      object->getObjName(),
+      object->getId(),
+      type);
+}
+
 int dbIntProperty::getValue()
 {
   _dbProperty* prop = (_dbProperty*) this;
@@ -611,6 +755,55 @@ dbIntProperty* dbIntProperty::find(dbObject* object, const char* name)
   return (dbIntProperty*) dbProperty::find(object, name, dbProperty::INT_PROP);
 }
 
+std::vector<int> dbIntProperty::getValues(const std::vector<dbObject*>& objects,
+                                          const char* name,
+                                          int default_value)
+{
+  std::vector<_dbProperty*> props;
+  _dbProperty::findProperties(objects, name, DB_INT_PROP, props);
+
+  std::vector<int> values(props.size(), default_value);
+  for (size_t i = 0; i < props.size(); ++i) {
+    if (props[i])
+      values[i] = props[i]->_value._int_val;
+  }
+  return values;
+}
+
+void dbIntProperty::setValues(const std::vector<dbObject*>& objects,
+                              const char* name,
+                              const std::vector<int>& values)
+{
+  if (objects.empty())
+    return;
+
+  if (objects.size() != values.size()) {
+    objects[0]->getImpl()->getLogger()->error(
+        utl::ODB,
+        431,
+        "Property {} has {} objects but {} values.",
+        name,
+        objects.size(),
+        values.size());
+  }
+
+  std::vector<_dbProperty*> props;
+  _dbProperty::findProperties(objects, name, DB_INT_PROP, props);
+
+  for (size_t i = 0; i < objects.size(); ++i) {
+    if (props[i]) {
+      props[i]->_value._int_val = values[i];
+    } else if (dbIntProperty* prop = find(objects[i], name)) {
+      // The object appears more than once in the list.
+      prop->setValue(values[i]);
+    } else {
+      if (dbProperty::find(objects[i], name))
+        reportTypeClash(objects[i], name, "int");
+      create(objects[i], name, values[i]);
+    }
+  }
+}
+
 /////////////////////////////////////////////
 // double property
 /////////////////////////////////////////////
@@ -645,6 +838,56 @@ dbDoubleProperty* dbDoubleProperty::find(dbObject* object, const char* name)
       object, name, dbProperty::DOUBLE_PROP);
 }
 
+std::vector<double> dbDoubleProperty::getValues(
+    const std::vector<dbObject*>& objects,
+    const char* name,
+    double default_value)
+{
+  std::vector<_dbProperty*> props;
+  _dbProperty::findProperties(objects, name, DB_DOUBLE_PROP, props);
+
+  std::vector<double> values(props.size(), default_value);
+  for (size_t i = 0; i < props.size(); ++i) {
+    if (props[i])
+      values[i] = props[i]->_value._double_val;
+  }
+  return values;
+}
+
+void dbDoubleProperty::setValues(const std::vector<dbObject*>& objects,
+                                 const char* name,
+                                 const std::vector<double>& values)
+{
+  if (objects.empty())
+    return;
+
+  if (objects.size() != values.size()) {
+    objects[0]->getImpl()->getLogger()->error(
+        utl::ODB,
+        431,
+        "Property {} has {} objects but {} values.",
+        name,
+        objects.size(),
+        values.size());
+  }
+
+  std::vector<_dbProperty*> props;
+  _dbProperty::findProperties(objects, name, DB_DOUBLE_PROP, props);
+
+  for (size_t i = 0; i < objects.size(); ++i) {
+    if (props[i]) {
+      props[i]->_value._double_val = values[i];
+    } else if (dbDoubleProperty* prop = find(objects[i], name)) {
+      // The object appears more than once in the list.
+      prop->setValue(values[i]);
+    } else {
+      if (dbProperty::find(objects[i], name))
+        reportTypeClash(objects[i], name, "double");
+      create(objects[i], name, values[i]);
+    }
+  }
+}
+
 void dbProperty::writePropValue(dbProperty* prop, FILE* out)
 {
   switch (prop->getType()) {
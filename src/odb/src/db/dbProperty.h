@@ -32,6 +32,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "dbCore.h"
 #include "dbId.h"
 #include "dbTypes.h"
@@ -48,6 +50,7 @@ class dbIStream;
 class dbOStream;
 class dbDiff;
 class _dbNameCache;
+class _dbPropertyIndex;
 
 enum _PropTypeEnum
 {
@@ -96,6 +99,15 @@ class _dbProperty : public _dbObject
   static dbTable<_dbProperty>* getPropTable(dbObject* object);
   static _dbNameCache* getNameCache(dbObject* object);
   static dbPropertyItr* getItr(dbObject* object);
+  static _dbPropertyIndex* getPropIndex(dbObject* object);
+  static _dbProperty* findProperty(dbObject* object,
+                                   const char* name,
+                                   _PropTypeEnum type);
+  // props[i] is the property name of type on objects[i], nullptr if none.
+  static void findProperties(const std::vector<dbObject*>& objects,
+                             const char* name,
+                             _PropTypeEnum type,
+                             std::vector<_dbProperty*>& props);
   static _dbProperty* createProperty(dbObject* object,
                                      const char* name,
                                      _PropTypeEnum type);
@@ -0,0 +1,172 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "dbPropertyIndex.h"
+
+#include "dbProperty.h"
+#include "dbTable.h"
+#include "dbTable.hpp"
+
+namespace odb {
+
+_dbPropertyIndex::_dbPropertyIndex(dbTable<_dbProperty>* prop_tbl)
+    : _prop_tbl(prop_tbl), _valid(false)
+{
+}
+
+uint64_t _dbPropertyIndex::key(uint owner_type, uint owner, uint type)
+{
+  // The database owner id is reassigned on read and there is only one
+  // database per table, so it does not take part in the key.
+  if (owner_type == dbDatabaseObj) {
+    owner = 0;
+  }
+  return (static_cast<uint64_t>(type) << 40)
+         | (static_cast<uint64_t>(owner_type) << 32) | owner;
+}
+
+uint64_t _dbPropertyIndex::key(_dbProperty* prop)
+{
+  return key(prop->_flags._owner_type, prop->_owner, prop->_flags._type);
+}
+
+bool _dbPropertyIndex::isIndexed(_dbObject* owner) const
+{
+  dbObject* holder = _prop_tbl->_owner;
+  if (owner->getType() == holder->getObjectType()) {
+    return true;
+  }
+  return owner->getOwner() == holder;
+}
+
+bool _dbPropertyIndex::isIndexed(_dbProperty* prop) const
+{
+  dbObject* holder = _prop_tbl->_owner;
+  const uint owner_type = prop->_flags._owner_type;
+  if (owner_type == holder->getObjectType()) {
+    return true;
+  }
+  dbObjectTable* table
+      = _prop_tbl->getObjectTable(static_cast<dbObjectType>(owner_type));
+  return table != nullptr && table->_owner == holder;
+}
+
+void _dbPropertyIndex::build()
+{
+  _columns.clear();
+  for (uint id = 1; id <= _prop_tbl->_top_idx; ++id) {
+    if (!_prop_tbl->validId(id)) {
+      continue;
+    }
+    _dbProperty* prop = _prop_tbl->getPtr(id);
+    if (!isIndexed(prop)) {
+      continue;
+    }
+    _columns[prop->_name][key(prop)] = id;
+  }
+}
+
+const _dbPropertyIndex::Column* _dbPropertyIndex::getColumn(uint name_id)
+{
+  if (!_valid.load(std::memory_order_acquire)) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_valid.load(std::memory_order_relaxed)) {
+      build();
+      _valid.store(true, std::memory_order_release);
+    }
+  }
+
+  auto it = _columns.find(name_id);
+  if (it == _columns.end()) {
+    return nullptr;
+  }
+  return &it->second;
+}
+
+uint _dbPropertyIndex::find(const Column* column,
+                            uint owner_type,
+                            uint owner,
+                            uint type) const
+{
+  if (column == nullptr) {
+    return 0;
+  }
+  auto it = column->find(key(owner_type, owner, type));
+  if (it == column->end()) {
+    return 0;
+  }
+  return it->second;
+}
+
+uint _dbPropertyIndex::find(uint name_id,
+                            uint owner_type,
+                            uint owner,
+                            uint type)
+{
+  return find(getColumn(name_id), owner_type, owner, type);
+}
+
+void _dbPropertyIndex::insert(_dbProperty* prop)
+{
+  if (!_valid.load(std::memory_order_acquire) || !isIndexed(prop)) {
+    return;
+  }
+  _columns[prop->_name][key(prop)] = prop->getOID();
+}
+
+void _dbPropertyIndex::remove(_dbProperty* prop)
+{
+  if (!_valid.load(std::memory_order_acquire) || !isIndexed(prop)) {
+    return;
+  }
+  auto it = _columns.find(prop->_name);
+  if (it == _columns.end()) {
+    return;
+  }
+  Column& column = it->second;
+  auto entry = column.find(key(prop));
+  if (entry != column.end() && entry->second == prop->getOID()) {
+    column.erase(entry);
+    if (column.empty()) {
+      _columns.erase(it);
+    }
+  }
+}
+
+void _dbPropertyIndex::invalidate()
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  _columns.clear();
+  _valid.store(false, std::memory_order_release);
+}
+
+}  // namespace odb
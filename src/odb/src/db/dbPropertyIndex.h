@@ -0,0 +1,96 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+#include "odb.h"
+
+namespace odb {
+
+class _dbObject;
+class _dbProperty;
+template <class T>
+class dbTable;
+
+//
+// Lookup of the properties in one property table by (name-id, owner, type).
+// Each property name gets a column mapping the owner (object type and id)
+// and property type to the id of its property. The properties themselves
+// stay in the persisted dbTable<_dbProperty>; the index is transient, built
+// on the first lookup and maintained by property create/destroy afterwards.
+//
+class _dbPropertyIndex
+{
+ public:
+  using Column = std::unordered_map<uint64_t, uint>;
+
+  _dbPropertyIndex(dbTable<_dbProperty>* prop_tbl);
+
+  // Returns the column of name_id or nullptr if no property has that name.
+  const Column* getColumn(uint name_id);
+
+  // Returns the id of the property name_id of type of the owner or 0 if
+  // none.
+  uint find(uint name_id, uint owner_type, uint owner, uint type);
+  uint find(const Column* column, uint owner_type, uint owner, uint type)
+      const;
+
+  // Objects in tables nested under another object (e.g. the mterms of a
+  // master) reuse ids across their parents, so the (type, id) key does not
+  // identify them.  Their properties are not indexed; callers walk the
+  // owner's property list instead.
+  bool isIndexed(_dbObject* owner) const;
+
+  void insert(_dbProperty* prop);
+  void remove(_dbProperty* prop);
+
+  // Drop the index; the next lookup rebuilds it from the table.
+  void invalidate();
+
+ private:
+  static uint64_t key(uint owner_type, uint owner, uint type);
+  static uint64_t key(_dbProperty* prop);
+  bool isIndexed(_dbProperty* prop) const;
+  void build();
+
+  dbTable<_dbProperty>* _prop_tbl;
+  std::unordered_map<uint, Column> _columns;
+  std::atomic<bool> _valid;
+  std::mutex _mutex;
+};
+
+}  // namespace odb
@@ -0,0 +1,616 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "dbSpatialIndex.h"
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+
+#include "db.h"
+#include "dbBlock.h"
+#include "dbShape.h"
+#include "dbWireCodec.h"
+
+namespace odb {
+
+namespace bg = boost::geometry;
+namespace bgi = boost::geometry::index;
+
+namespace {
+
+using BoxPoint = bg::model::d2::point_xy<int, bg::cs::cartesian>;
+using Box = bg::model::box<BoxPoint>;
+template <typename T>
+using Value = std::pair<Box, T>;
+template <typename T>
+using Tree = bgi::rtree<Value<T>, bgi::quadratic<16>>;
+template <typename T>
+using LayerTrees = std::map<dbTechLayer*, Tree<T>>;
+template <typename T>
+using LayerValues = std::map<dbTechLayer*, std::vector<Value<T>>>;
+
+Box toBox(const Rect& rect)
+{
+  return Box(BoxPoint(rect.xMin(), rect.yMin()),
+             BoxPoint(rect.xMax(), rect.yMax()));
+}
+
+// Packs the values into new trees, or inserts them into the existing
+// ones if there are any.
+template <typename T>
+void load(LayerValues<T>& values, LayerTrees<T>& trees)
+{
+  for (auto& [layer, layer_values] : values) {
+    Tree<T>& tree = trees[layer];
+    if (tree.empty()) {
+      tree = Tree<T>(layer_values.begin(), layer_values.end());
+    } else {
+      tree.insert(layer_values.begin(), layer_values.end());
+    }
+  }
+}
+
+template <typename T>
+void query(const Tree<T>& tree, const Rect& area, std::vector<T>& result)
+{
+  for (auto it = tree.qbegin(bgi::intersects(toBox(area))); it != tree.qend();
+       ++it) {
+    result.push_back(it->second);
+  }
+}
+
+template <typename T>
+void query(const LayerTrees<T>& trees,
+           dbTechLayer* layer,
+           const Rect& area,
+           std::vector<T>& result)
+{
+  auto it = trees.find(layer);
+  if (it != trees.end()) {
+    query(it->second, area, result);
+  }
+}
+
+Value<dbInst*> instValue(dbInst* inst)
+{
+  return {toBox(inst->getBBox()->getBox()), inst};
+}
+
+Value<dbObstruction*> obstructionValue(dbObstruction* obs)
+{
+  return {toBox(obs->getBBox()->getBox()), obs};
+}
+
+Value<dbFill*> fillValue(dbFill* fill)
+{
+  Rect rect;
+  fill->getRect(rect);
+  return {toBox(rect), fill};
+}
+
+// A via sbox is stored once per layer of its via.
+void sboxValues(dbSBox* box, LayerValues<dbSBox*>& values)
+{
+  if (box->isVia()) {
+    std::vector<dbShape> shapes;
+    box->getViaBoxes(shapes);
+    for (const dbShape& shape : shapes) {
+      values[shape.getTechLayer()].push_back({toBox(shape.getBox()), box});
+    }
+  } else {
+    values[box->getTechLayer()].push_back({toBox(box->getBox()), box});
+  }
+}
+
+// Returns the bounding box of the routed wire shapes of net added to
+// values, or an empty rect if it has none.
+Rect netValues(dbNet* net, LayerValues<dbNet*>& values)
+{
+  Rect bbox;
+  bbox.mergeInit();
+  dbWire* wire = net->getWire();
+  if (wire == nullptr) {
+    return bbox;
+  }
+  auto add = [&](dbTechLayer* layer, const Rect& rect) {
+    values[layer].push_back({toBox(rect), net});
+    bbox.merge(rect);
+  };
+  std::vector<dbShape> via_shapes;
+  dbWireShapeItr itr;
+  dbShape shape;
+  for (itr.begin(wire); itr.next(shape);) {
+    if (shape.isVia()) {
+      dbShape::getViaBoxes(shape, via_shapes);
+      for (const dbShape& via_shape : via_shapes) {
+        add(via_shape.getTechLayer(), via_shape.getBox());
+      }
+    } else {
+      add(shape.getTechLayer(), shape.getBox());
+    }
+  }
+  return bbox;
+}
+
+// Returns a shared lock on mutex after running update under an exclusive
+// one if is_current says the trees are out of date.
+template <typename IsCurrent, typename Update>
+std::shared_lock<std::shared_mutex> lockCurrent(std::shared_mutex& mutex,
+                                                IsCurrent is_current,
+                                                Update update)
+{
+  std::shared_lock<std::shared_mutex> lock(mutex);
+  if (!is_current()) {
+    lock.unlock();
+    {
+      std::unique_lock<std::shared_mutex> update_lock(mutex);
+      if (!is_current()) {
+        update();
+      }
+    }
+    lock.lock();
+  }
+  return lock;
+}
+
+}  // namespace
+
+struct dbSpatialIndex::Trees
+{
+  // Placed instances only.
+  Tree<dbInst*> insts;
+  bool insts_valid = false;
+
+  LayerTrees<dbNet*> wires;
+  bool wires_valid = false;
+  // Bounding box of the shapes of each net in the trees, used to find
+  // them again for removal.
+  std::unordered_map<dbNet*, Rect> net_bboxes;
+  // Nets whose shapes are out of date
+  std::set<dbNet*> modified_nets;
+
+  LayerTrees<dbSBox*> swires;
+  bool swires_valid = false;
+
+  LayerTrees<dbObstruction*> obstructions;
+  bool obstructions_valid = false;
+
+  LayerTrees<dbFill*> fills;
+  bool fills_valid = false;
+};
+
+dbSpatialIndex::dbSpatialIndex(dbBlock* block)
+    : block_(block), trees_(std::make_unique<Trees>())
+{
+  addOwner(block);
+}
+
+dbSpatialIndex::~dbSpatialIndex() = default;
+
+dbSpatialIndex* dbSpatialIndex::get(dbBlock* block)
+{
+  _dbBlock* _block = (_dbBlock*) block;
+  if (_block->_spatial_index == nullptr) {
+    _block->_spatial_index = new dbSpatialIndex(block);
+  }
+  return _block->_spatial_index;
+}
+
+////////////////////////////////////////////////////////////////////
+//
+// dbSpatialIndex - Queries
+//
+////////////////////////////////////////////////////////////////////
+
+void dbSpatialIndex::findInsts(const Rect& area, std::vector<dbInst*>& insts)
+{
+  auto lock = lockCurrent(
+      mutex_,
+      [this] { return trees_->insts_valid; },
+      [this] { updateInsts(); });
+  query(trees_->insts, area, insts);
+}
+
+void dbSpatialIndex::findWires(dbTechLayer* layer,
+                               const Rect& area,
+                               std::vector<NetShape>& shapes)
+{
+  auto lock = lockCurrent(
+      mutex_,
+      [this] { return trees_->wires_valid && trees_->modified_nets.empty(); },
+      [this] { updateWires(); });
+  auto it = trees_->wires.find(layer);
+  if (it == trees_->wires.end()) {
+    return;
+  }
+  const Tree<dbNet*>& tree = it->second;
+  for (auto value = tree.qbegin(bgi::intersects(toBox(area)));
+       value != tree.qend();
+       ++value) {
+    const Box& box = value->first;
+    shapes.push_back({Rect(box.min_corner().x(),
+                           box.min_corner().y(),
+                           box.max_corner().x(),
+                           box.max_corner().y()),
+                      value->second});
+  }
+}
+
+void dbSpatialIndex::findSpecialWires(dbTechLayer* layer,
+                                      const Rect& area,
+                                      std::vector<dbSBox*>& sboxes)
+{
+  auto lock = lockCurrent(
+      mutex_,
+      [this] { return trees_->swires_valid; },
+      [this] { updateSpecialWires(); });
+  query(trees_->swires, layer, area, sboxes);
+}
+
+void dbSpatialIndex::findObstructions(dbTechLayer* layer,
+                                      const Rect& area,
+                                      std::vector<dbObstruction*>& obstructions)
+{
+  auto lock = lockCurrent(
+      mutex_,
+      [this] { return trees_->obstructions_valid; },
+      [this] { updateObstructions(); });
+  query(trees_->obstructions, layer, area, obstructions);
+}
+
+void dbSpatialIndex::findFills(dbTechLayer* layer,
+                               const Rect& area,
+                               std::vector<dbFill*>& fills)
+{
+  auto lock = lockCurrent(
+      mutex_,
+      [this] { return trees_->fills_valid; },
+      [this] { updateFills(); });
+  query(trees_->fills, layer, area, fills);
+}
+
+////////////////////////////////////////////////////////////////////
+//
+// dbSpatialIndex - Builds
+//
+////////////////////////////////////////////////////////////////////
+
+void dbSpatialIndex::updateInsts()
+{
+  std::vector<Value<dbInst*>> values;
+  for (dbInst* inst : block_->getInsts()) {
+    if (inst->isPlaced()) {
+      values.push_back(instValue(inst));
+    }
+  }
+  trees_->insts = Tree<dbInst*>(values.begin(), values.end());
+  trees_->insts_valid = true;
+}
+
+void dbSpatialIndex::updateWires()
+{
+  LayerValues<dbNet*> values;
+  if (!trees_->wires_valid) {
+    trees_->wires.clear();
+    trees_->net_bboxes.clear();
+    for (dbNet* net : block_->getNets()) {
+      const Rect bbox = netValues(net, values);
+      if (!bbox.isInverted()) {
+        trees_->net_bboxes[net] = bbox;
+      }
+    }
+  } else {
+    for (dbNet* net : trees_->modified_nets) {
+      removeNetShapes(net);
+      const Rect bbox = netValues(net, values);
+      if (!bbox.isInverted()) {
+        trees_->net_bboxes[net] = bbox;
+      }
+    }
+  }
+  trees_->modified_nets.clear();
+  load(values, trees_->wires);
+  trees_->wires_valid = true;
+}
+
+void dbSpatialIndex::updateSpecialWires()
+{
+  LayerValues<dbSBox*> values;
+  for (dbNet* net : block_->getNets()) {
+    for (dbSWire* swire : net->getSWires()) {
+      for (dbSBox* box : swire->getWires()) {
+        sboxValues(box, values);
+      }
+    }
+  }
+  trees_->swires.clear();
+  load(values, trees_->swires);
+  trees_->swires_valid = true;
+}
+
+void dbSpatialIndex::updateObstructions()
+{
+  LayerValues<dbObstruction*> values;
+  for (dbObstruction* obs : block_->getObstructions()) {
+    values[obs->getBBox()->getTechLayer()].push_back(obstructionValue(obs));
+  }
+  trees_->obstructions.clear();
+  load(values, trees_->obstructions);
+  trees_->obstructions_valid = true;
+}
+
+void dbSpatialIndex::updateFills()
+{
+  LayerValues<dbFill*> values;
+  for (dbFill* fill : block_->getFills()) {
+    values[fill->getTechLayer()].push_back(fillValue(fill));
+  }
+  trees_->fills.clear();
+  load(values, trees_->fills);
+  trees_->fills_valid = true;
+}
+
+////////////////////////////////////////////////////////////////////
+//
+// dbSpatialIndex - Edits
+//
+////////////////////////////////////////////////////////////////////
+
+void dbSpatialIndex::addInst(dbInst* inst)
+{
+  trees_->insts.insert(instValue(inst));
+}
+
+void dbSpatialIndex::removeInst(dbInst* inst)
+{
+  trees_->insts.remove(instValue(inst));
+}
+
+void dbSpatialIndex::addSBox(dbSBox* box)
+{
+  LayerValues<dbSBox*> values;
+  sboxValues(box, values);
+  load(values, trees_->swires);
+}
+
+void dbSpatialIndex::removeSBox(dbSBox* box)
+{
+  LayerValues<dbSBox*> values;
+  sboxValues(box, values);
+  for (auto& [layer, layer_values] : values) {
+    auto it = trees_->swires.find(layer);
+    if (it != trees_->swires.end()) {
+      it->second.remove(layer_values.begin(), layer_values.end());
+    }
+  }
+}
+
+void dbSpatialIndex::markNetModified(dbNet* net)
+{
+  if (trees_->wires_valid && net != nullptr) {
+    trees_->modified_nets.insert(net);
+  }
+}
+
+void dbSpatialIndex::removeNetShapes(dbNet* net)
+{
+  auto bbox_it = trees_->net_bboxes.find(net);
+  if (bbox_it == trees_->net_bboxes.end()) {
+    return;
+  }
+  const Box bbox = toBox(bbox_it->second);
+  auto is_net = [net](const Value<dbNet*>& value) {
+    return value.second == net;
+  };
+  for (auto& [layer, tree] : trees_->wires) {
+    std::vector<Value<dbNet*>> values;
+    tree.query(bgi::intersects(bbox) && bgi::satisfies(is_net),
+               std::back_inserter(values));
+    tree.remove(values.begin(), values.end());
+  }
+  trees_->net_bboxes.erase(bbox_it);
+}
+
+////////////////////////////////////////////////////////////////////
+//
+// dbSpatialIndex - Callbacks
+//
+////////////////////////////////////////////////////////////////////
+
+void dbSpatialIndex::inDbInstDestroy(dbInst* inst)
+{
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  if (trees_->insts_valid && inst->isPlaced()) {
+    removeInst(inst);
+  }
+}
+
+void dbSpatialIndex::inDbInstPlacementStatusBefore(
+    dbInst* inst,
+    const dbPlacementStatus& status)
+{
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  const bool is_placed = inst->isPlaced();
+  if (!trees_->insts_valid || is_placed == status.isPlaced()) {
+    return;
+  }
+  if (is_placed) {
+    removeInst(inst);
+  } else {
+    addInst(inst);
+  }
+}
+
+void dbSpatialIndex::inDbInstSwapMasterBefore(dbInst* inst, dbMaster* master)
+{
+  inDbPreMoveInst(inst);
+}
+
+void dbSpatialIndex::inDbInstSwapMasterAfter(dbInst* inst)
+{
+  inDbPostMoveInst(inst);
+}
+
+void dbSpatialIndex::inDbPreMoveInst(dbInst* inst)
+{
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  if (trees_->insts_valid && inst->isPlaced()) {
+    removeInst(inst);
+  }
+}
+
+void dbSpatialIndex::inDbPostMoveInst(dbInst* inst)
+{
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  if (trees_->insts_valid && inst->isPlaced()) {
+    addInst(inst);
+  }
+}
+
+void dbSpatialIndex::inDbNetDestroy(dbNet* net)
+{
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  if (trees_->wires_valid) {
+    trees_->modified_nets.erase(net);
+    removeNetShapes(net);
+  }
+}
+
+void dbSpatialIndex::inDbObstructionCreate(dbObstruction* obs)
+{
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  if (trees_->obstructions_valid) {
+    trees_->obstructions[obs->getBBox()->getTechLayer()].insert(
+        obstructionValue(obs));
+  }
+}
+
+void dbSpatialIndex::inDbObstructionDestroy(dbObstruction* obs)
+{
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  if (trees_->obstructions_valid) {
+    trees_->obstructions[obs->getBBox()->getTechLayer()].remove(
+        obstructionValue(obs));
+  }
+}
+
+void dbSpatialIndex::inDbWireCreate(dbWire* wire)
+{
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  markNetModified(wire->getNet());
+}
+
+void dbSpatialIndex::inDbWireDestroy(dbWire* wire)
+{
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  markNetModified(wire->getNet());
+}
+
+void dbSpatialIndex::inDbWirePreAttach(dbWire* wire, dbNet* net)
+{
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  markNetModified(wire->getNet());
+  markNetModified(net);
+}
+
+void dbSpatialIndex::inDbWirePreDetach(dbWire* wire)
+{
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  markNetModified(wire->getNet());
+}
+
+void dbSpatialIndex::inDbWirePostAppend(dbWire* src, dbWire* dst)
+{
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  markNetModified(dst->getNet());
+}
+
+void dbSpatialIndex::inDbWirePostCopy(dbWire* src, dbWire* dst)
+{
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  markNetModified(dst->getNet());
+}
+
+void dbSpatialIndex::inDbWirePostEncode(dbWire* wire)
+{
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  markNetModified(wire->getNet());
+}
+
+void dbSpatialIndex::inDbSWireAddSBox(dbSBox* box)
+{
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  if (trees_->swires_valid) {
+    addSBox(box);
+  }
+}
+
+void dbSpatialIndex::inDbSWireRemoveSBox(dbSBox* box)
+{
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  if (trees_->swires_valid) {
+    removeSBox(box);
+  }
+}
+
+void dbSpatialIndex::inDbSWirePreDestroySBoxes(dbSWire* swire)
+{
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  if (trees_->swires_valid) {
+    for (dbSBox* box : swire->getWires()) {
+      removeSBox(box);
+    }
+  }
+}
+
+void dbSpatialIndex::inDbFillCreate(dbFill* fill)
+{
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  if (trees_->fills_valid) {
+    trees_->fills[fill->getTechLayer()].insert(fillValue(fill));
+  }
+}
+
+void dbSpatialIndex::inDbFillDestroy(dbFill* fill)
+{
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  if (trees_->fills_valid) {
+    trees_->fills[fill->getTechLayer()].remove(fillValue(fill));
+  }
+}
+
+}  // namespace odb
@@ -39,6 +39,7 @@
 #include "dbMetalWidthViaMap.h"
 #include "dbNameCache.h"
 #include "dbProperty.h"
+#include "dbPropertyIndex.h"
 #include "dbPropertyItr.h"
 #include "dbTable.h"
 #include "dbTable.hpp"
@@ -369,6 +370,7 @@ _dbTech::_dbTech(_dbDatabase* db)
   _box_itr = new dbBoxItr(_box_tbl);
 
   _prop_itr = new dbPropertyItr(_prop_tbl);
+  _prop_index = new _dbPropertyIndex(_prop_tbl);
 }
 
 _dbTech::_dbTech(_dbDatabase* db, const _dbTech& t)
@@ -428,6 +430,7 @@ _dbTech::_dbTech(_dbDatabase* db, const _dbTech& t)
   _box_itr = new dbBoxItr(_box_tbl);
 
   _prop_itr = new dbPropertyItr(_prop_tbl);
+  _prop_index = new _dbPropertyIndex(_prop_tbl);
 }
 
 _dbTech::~_dbTech()
@@ -448,6 +451,7 @@ _dbTech::~_dbTech()
   delete _layer_itr;
   delete _box_itr;
   delete _prop_itr;
+  delete _prop_index;
 }
 
 dbOStream& operator<<(dbOStream& stream, const _dbTech& tech)
@@ -517,6 +521,7 @@ dbIStream& operator>>(dbIStream& stream, _dbTech& tech)
   stream >> *tech._via_layer_rule_tbl;
   stream >> *tech._via_generate_rule_tbl;
   stream >> *tech._prop_tbl;
+  tech._prop_index->invalidate();
   stream >> *tech._metal_width_via_map_tbl;
   stream >> *tech._name_cache;
   stream >> tech._via_hash;
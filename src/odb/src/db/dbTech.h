@@ -46,6 +46,7 @@ class dbTable;
 
 class _dbProperty;
 class dbPropertyItr;
+class _dbPropertyIndex;
 class _dbNameCache;
 class _dbTechLayer;
 class _dbTechLayerRule;
@@ -119,6 +120,7 @@ class _dbTech : public _dbObject
   dbTechLayerItr* _layer_itr;
   dbBoxItr* _box_itr;
   dbPropertyItr* _prop_itr;
+  _dbPropertyIndex* _prop_index;
 
   double _getLefVersion() const;
   const char* _getLefVersionStr() const;
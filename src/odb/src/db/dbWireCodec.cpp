@@ -36,6 +36,7 @@
 
 #include "db.h"
 #include "dbBlock.h"
+#include "dbBlockCallBackObj.h"
 #include "dbDatabase.h"
 #include "dbNet.h"
 #include "dbTable.h"
@@ -612,8 +613,13 @@ void dbWireEncoder::end()
   _wire->_opcodes = _opcodes;
 
   // Should we calculate the bbox???
-  ((_dbBlock*) _block)->_flags._valid_bbox = 0;
+  _dbBlock* block = (_dbBlock*) _block;
+  block->_flags._valid_bbox = 0;
   _point_cnt = 0;
+
+  for (auto callback : block->_callbacks) {
+    callback->inDbWirePostEncode((dbWire*) _wire);
+  }
 }
 
 void dbWireEncoder::setColor(uint8_t mask_color)
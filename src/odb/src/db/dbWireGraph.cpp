@@ -54,6 +54,7 @@ dbWireGraph::dbWireGraph()
 
 dbWireGraph::~dbWireGraph()
 {
+  clear();
 }
 
 void dbWireGraph::clear()
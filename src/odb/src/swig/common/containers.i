@@ -21,6 +21,7 @@ WRAP_DB_CONTAINER(odb::dbMaster)
 WRAP_DB_CONTAINER(odb::dbModInst)
 WRAP_DB_CONTAINER(odb::dbModule)
 WRAP_DB_CONTAINER(odb::dbNet)
+WRAP_DB_CONTAINER(odb::dbObject)
 WRAP_DB_CONTAINER(odb::dbObstruction)
 WRAP_DB_CONTAINER(odb::dbProperty)
 WRAP_DB_CONTAINER(odb::dbRSeg)
@@ -4,6 +4,8 @@
 %rename(post_inc) *::operator++(int);
 
 %template(vector_str) std::vector<std::string>;
+%template(vector_int) std::vector<int>;
+%template(vector_double) std::vector<double>;
 
 %typemap(typecheck,precedence=SWIG_TYPECHECK_INTEGER) uint {
    $1 = PyInt_Check($input) ? 1 : 0;
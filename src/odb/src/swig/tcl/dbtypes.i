@@ -1,4 +1,6 @@
 %template(vector_str) std::vector<std::string>;
+%template(vector_int) std::vector<int>;
+%template(vector_double) std::vector<double>;
 
 
 // DB specital types
@@ -0,0 +1,151 @@
+#define BOOST_TEST_MODULE TestBlockSnapshot
+#include <boost/test/included/unit_test.hpp>
+#include <vector>
+
+#include "db.h"
+#include "dbBlockSnapshot.h"
+#include "helper.cpp"
+#include "utl/Executor.h"
+
+using namespace odb;
+using namespace std;
+
+struct F_SNAPSHOT
+{
+  F_SNAPSHOT()
+  {
+    db = create2LevetDbNoBTerms();
+    block = db->getChip()->getBlock();
+    and2 = db->findLib("lib1")->findMaster("and2");
+    or2 = db->findLib("lib1")->findMaster("or2");
+    int x = 0;
+    for (dbInst* inst : block->getInsts()) {
+      inst->setLocation(x, 0);
+      inst->setPlacementStatus(dbPlacementStatus::PLACED);
+      x += 2000;
+    }
+  }
+  ~F_SNAPSHOT() { dbDatabase::destroy(db); }
+
+  dbDatabase* db;
+  dbBlock* block;
+  dbMaster* and2;
+  dbMaster* or2;
+};
+
+BOOST_FIXTURE_TEST_SUITE(test_suite, F_SNAPSHOT)
+
+BOOST_AUTO_TEST_CASE(test_restore)
+{
+  dbInst* i1 = block->findInst("i1");
+  dbInst* i2 = block->findInst("i2");
+  dbInst* i3 = block->findInst("i3");
+  dbNet* n5 = block->findNet("n5");
+  dbBlockSnapshot snapshot(block);
+
+  i1->setLocation(500, 3000);
+  i1->setOrient(dbOrientType::MX);
+  i1->setLocation(700, 3000);
+  i2->swapMaster(or2);
+  i3->setPlacementStatus(dbPlacementStatus::FIRM);
+  dbNet* n8 = dbNet::create(block, "n8");
+  i3->findITerm("a")->connect(n8);
+  dbInst* i4 = dbInst::create(block, or2, "i4");
+  i4->findITerm("a")->connect(n5);
+  i4->findITerm("o")->connect(n8);
+
+  // The snapshot still reads the state it was taken with.
+  BOOST_TEST((snapshot.getLocation(i1) == Point(0, 0)));
+  BOOST_TEST((snapshot.getOrient(i1) == dbOrientType::R0));
+  BOOST_TEST(snapshot.getMaster(i2) == and2);
+  BOOST_TEST((snapshot.getPlacementStatus(i3) == dbPlacementStatus::PLACED));
+  BOOST_TEST(snapshot.getNet(i3->findITerm("a")) == n5);
+  BOOST_TEST(snapshot.isCreated(i4));
+
+  BOOST_TEST(snapshot.restore());
+  BOOST_TEST((i1->getLocation() == Point(0, 0)));
+  BOOST_TEST((i1->getOrient() == dbOrientType::R0));
+  BOOST_TEST(i2->getMaster() == and2);
+  BOOST_TEST((i3->getPlacementStatus() == dbPlacementStatus::PLACED));
+  BOOST_TEST(i3->findITerm("a")->getNet() == n5);
+  BOOST_TEST(block->findInst("i4") == nullptr);
+  BOOST_TEST(block->findNet("n8") == nullptr);
+  BOOST_TEST(n5->getITerms().size() == 2);
+
+  // The snapshot keeps tracking after a restore.
+  i1->setLocation(100, 100);
+  BOOST_TEST(snapshot.restore());
+  BOOST_TEST((i1->getLocation() == Point(0, 0)));
+}
+
+BOOST_AUTO_TEST_CASE(test_fixed_move)
+{
+  dbInst* i1 = block->findInst("i1");
+  i1->setPlacementStatus(dbPlacementStatus::FIRM);
+  dbBlockSnapshot snapshot(block);
+
+  i1->setPlacementStatus(dbPlacementStatus::PLACED);
+  i1->setLocation(4000, 4000);
+  i1->setPlacementStatus(dbPlacementStatus::LOCKED);
+  BOOST_TEST(snapshot.restore());
+  BOOST_TEST((i1->getLocation() == Point(0, 0)));
+  BOOST_TEST((i1->getPlacementStatus() == dbPlacementStatus::FIRM));
+}
+
+BOOST_AUTO_TEST_CASE(test_commit)
+{
+  dbInst* i1 = block->findInst("i1");
+  dbBlockSnapshot snapshot(block);
+
+  i1->setLocation(100, 100);
+  snapshot.commit();
+  BOOST_TEST((snapshot.getLocation(i1) == Point(100, 100)));
+  BOOST_TEST(snapshot.restore());
+  BOOST_TEST((i1->getLocation() == Point(100, 100)));
+}
+
+BOOST_AUTO_TEST_CASE(test_not_restorable)
+{
+  dbBlockSnapshot snapshot(block);
+
+  // Created objects can be destroyed again.
+  dbInst::destroy(dbInst::create(block, or2, "i4"));
+  dbNet::destroy(dbNet::create(block, "n8"));
+  BOOST_TEST(snapshot.isRestorable());
+
+  dbInst* i1 = block->findInst("i1");
+  i1->setLocation(100, 100);
+  dbInst::destroy(block->findInst("i2"));
+  BOOST_TEST(!snapshot.isRestorable());
+  BOOST_TEST(!snapshot.restore());
+  BOOST_TEST((i1->getLocation() == Point(100, 100)));
+
+  snapshot.commit();
+  BOOST_TEST(snapshot.isRestorable());
+}
+
+BOOST_AUTO_TEST_CASE(test_parallel_reads)
+{
+  vector<dbInst*> insts;
+  for (dbInst* inst : block->getInsts()) {
+    insts.push_back(inst);
+    inst->setPlacementStatus(dbPlacementStatus::FIRM);
+  }
+  dbBlockSnapshot snapshot(block);
+  for (dbInst* inst : insts) {
+    inst->setPlacementStatus(dbPlacementStatus::PLACED);
+    inst->setLocation(inst->getLocation().x() + 10, 10);
+  }
+
+  vector<int> moved(insts.size());
+  utl::Executor executor(4);
+  executor.parallelFor(0, insts.size(), [&](int i) {
+    moved[i] = snapshot.getLocation(insts[i]) != insts[i]->getLocation()
+               && snapshot.getPlacementStatus(insts[i]).isFixed();
+  });
+  for (int m : moved) {
+    BOOST_TEST(m);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
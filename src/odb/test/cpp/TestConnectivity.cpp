@@ -0,0 +1,94 @@
+#define BOOST_TEST_MODULE TestConnectivity
+#include <boost/test/included/unit_test.hpp>
+#include <set>
+
+#include "db.h"
+#include "dbConnectivity.h"
+#include "helper.cpp"
+#include "utl/Executor.h"
+
+using namespace odb;
+using namespace std;
+
+struct F_CONNECTIVITY
+{
+  F_CONNECTIVITY()
+  {
+    db = create2LevetDbWithBTerms();
+    block = db->getChip()->getBlock();
+  }
+  ~F_CONNECTIVITY() { dbDatabase::destroy(db); }
+
+  // Check the snapshot against the odb linked lists.
+  void check(dbConnectivity* connectivity)
+  {
+    for (dbNet* net : block->getNets()) {
+      set<dbITerm*> iterms(connectivity->getITerms(net).begin(),
+                           connectivity->getITerms(net).end());
+      set<dbITerm*> db_iterms;
+      for (dbITerm* iterm : net->getITerms()) {
+        db_iterms.insert(iterm);
+      }
+      BOOST_TEST((iterms == db_iterms));
+      BOOST_TEST(connectivity->getITermCount(net)
+                 == (int) net->getITerms().size());
+      BOOST_TEST(connectivity->getBTermCount(net)
+                 == (int) net->getBTerms().size());
+    }
+    for (dbInst* inst : block->getInsts()) {
+      auto iterms = connectivity->getITerms(inst);
+      BOOST_TEST(iterms.size() == (int) inst->getITerms().size());
+      int i = 0;
+      for (dbITerm* iterm : inst->getITerms()) {
+        BOOST_TEST(iterms[i++] == iterm);
+      }
+      BOOST_TEST(connectivity->getMasterId(inst)
+                 == inst->getMaster()->getMasterId());
+    }
+  }
+
+  dbDatabase* db;
+  dbBlock* block;
+};
+
+BOOST_FIXTURE_TEST_SUITE(test_suite, F_CONNECTIVITY)
+
+BOOST_AUTO_TEST_CASE(test_build)
+{
+  dbConnectivity* connectivity = dbConnectivity::get(block);
+  check(connectivity);
+  BOOST_TEST(connectivity->getITermCount(block->findNet("n5")) == 2);
+  BOOST_TEST(connectivity->getBTermCount(block->findNet("n1")) == 1);
+  BOOST_TEST(dbConnectivity::get(block) == connectivity);
+}
+
+BOOST_AUTO_TEST_CASE(test_parallel_build)
+{
+  utl::Executor executor(4);
+  check(dbConnectivity::get(block, &executor));
+}
+
+BOOST_AUTO_TEST_CASE(test_netlist_edit)
+{
+  dbConnectivity* connectivity = dbConnectivity::get(block);
+  dbNet* n5 = block->findNet("n5");
+  dbNet* n8 = dbNet::create(block, "n8");
+  BOOST_TEST(connectivity->getITerms(n8).empty());
+
+  block->findInst("i3")->findITerm("a")->disconnect();
+  block->findInst("i3")->findITerm("a")->connect(n8);
+  dbMaster* or2 = db->findLib("lib1")->findMaster("or2");
+  dbInst* i4 = dbInst::create(block, or2, "i4");
+  i4->findITerm("a")->connect(n5);
+
+  connectivity = dbConnectivity::get(block);
+  check(connectivity);
+  BOOST_TEST(connectivity->getITermCount(n8) == 1);
+  BOOST_TEST(connectivity->getITermCount(n5) == 2);
+
+  dbNet::destroy(n8);
+  dbInst::destroy(block->findInst("i1"));
+  check(dbConnectivity::get(block));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
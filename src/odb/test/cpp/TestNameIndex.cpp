@@ -0,0 +1,99 @@
+#define BOOST_TEST_MODULE TestNameIndex
+#include <boost/test/included/unit_test.hpp>
+#include <string>
+#include <vector>
+
+#include "db.h"
+#include "helper.cpp"
+
+using namespace odb;
+using namespace std;
+
+struct F_NAME_INDEX
+{
+  F_NAME_INDEX()
+  {
+    db = createSimpleDB();
+    block = db->getChip()->getBlock();
+    and2 = db->findLib("lib1")->findMaster("and2");
+  }
+  ~F_NAME_INDEX() { dbDatabase::destroy(db); }
+
+  dbDatabase* db;
+  dbBlock* block;
+  dbMaster* and2;
+};
+
+BOOST_FIXTURE_TEST_SUITE(test_suite, F_NAME_INDEX)
+
+BOOST_AUTO_TEST_CASE(test_insert_remove)
+{
+  const int count = 5000;
+  for (int i = 0; i < count; i++) {
+    dbInst::create(block, and2, ("inst" + to_string(i)).c_str());
+  }
+  // Remove every third instance so clusters in the index get holes.
+  for (int i = 0; i < count; i += 3) {
+    dbInst::destroy(block->findInst(("inst" + to_string(i)).c_str()));
+  }
+  for (int i = 0; i < count; i++) {
+    dbInst* inst = block->findInst(("inst" + to_string(i)).c_str());
+    if (i % 3 == 0) {
+      BOOST_TEST(inst == nullptr);
+    } else {
+      BOOST_TEST(inst != nullptr);
+      BOOST_TEST(inst->getName() == "inst" + to_string(i));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_batch_find)
+{
+  vector<string> names;
+  for (int i = 0; i < 40; i++) {
+    dbNet::create(block, ("net" + to_string(i)).c_str());
+    names.push_back("net" + to_string(i));
+  }
+  names.push_back("missing");
+
+  vector<dbNet*> nets = block->findNets(names);
+  BOOST_TEST(nets.size() == names.size());
+  for (int i = 0; i < 40; i++) {
+    BOOST_TEST(nets[i] == block->findNet(names[i].c_str()));
+  }
+  BOOST_TEST(nets.back() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(test_matching)
+{
+  for (const char* name : {"a1", "a2", "a10", "b1", "ab"}) {
+    dbInst::create(block, and2, name);
+  }
+
+  auto names = [](const vector<dbInst*>& insts) {
+    vector<string> names;
+    for (dbInst* inst : insts) {
+      names.push_back(inst->getName());
+    }
+    return names;
+  };
+
+  BOOST_TEST(names(block->findInstsMatching("a?"))
+             == vector<string>({"a1", "a2", "ab"}));
+  BOOST_TEST(names(block->findInstsMatching("a*"))
+             == vector<string>({"a1", "a10", "a2", "ab"}));
+  BOOST_TEST(names(block->findInstsMatching("*1"))
+             == vector<string>({"a1", "b1"}));
+  BOOST_TEST(names(block->findInstsMatching("a[0-9]+", true))
+             == vector<string>({"a1", "a10", "a2"}));
+  BOOST_TEST(names(block->findInstsMatching("ab?1", true))
+             == vector<string>({"a1"}));
+  BOOST_TEST(names(block->findInstsMatching("a1|b1", true))
+             == vector<string>({"a1", "b1"}));
+
+  dbInst::create(block, and2, "a3");
+  BOOST_TEST(names(block->findInstsMatching("a?"))
+             == vector<string>({"a1", "a2", "a3", "ab"}));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,149 @@
+#define BOOST_TEST_MODULE TestProperty
+#include <boost/test/included/unit_test.hpp>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "db.h"
+#include "helper.cpp"
+
+using namespace odb;
+using namespace std;
+
+struct F_PROPERTY
+{
+  F_PROPERTY()
+  {
+    db = createSimpleDB();
+    block = db->getChip()->getBlock();
+    dbMaster* and2 = db->findLib("lib1")->findMaster("and2");
+    for (int i = 0; i < 100; i++) {
+      insts.push_back(
+          dbInst::create(block, and2, ("inst" + to_string(i)).c_str()));
+    }
+  }
+  ~F_PROPERTY() { dbDatabase::destroy(db); }
+
+  dbDatabase* db;
+  dbBlock* block;
+  vector<dbObject*> insts;
+};
+
+BOOST_FIXTURE_TEST_SUITE(test_suite, F_PROPERTY)
+
+BOOST_AUTO_TEST_CASE(test_find_destroy)
+{
+  for (int i = 0; i < 100; i += 2) {
+    dbIntProperty::create(insts[i], "weight", i);
+  }
+  dbStringProperty::create(insts[1], "weight", "heavy");
+  BOOST_TEST(dbIntProperty::create(insts[0], "weight", 7) == nullptr);
+
+  for (int i = 0; i < 100; i += 2) {
+    dbIntProperty* prop = dbIntProperty::find(insts[i], "weight");
+    BOOST_TEST(prop != nullptr);
+    BOOST_TEST(prop->getValue() == i);
+    BOOST_TEST(prop->getPropOwner() == insts[i]);
+  }
+  BOOST_TEST(dbIntProperty::find(insts[1], "weight") == nullptr);
+  BOOST_TEST(dbProperty::find(insts[1], "weight") != nullptr);
+  BOOST_TEST(dbProperty::find(insts[3], "weight") == nullptr);
+  BOOST_TEST(dbProperty::find(insts[0], "missing") == nullptr);
+
+  dbProperty::destroy(dbProperty::find(insts[0], "weight"));
+  BOOST_TEST(dbProperty::find(insts[0], "weight") == nullptr);
+  dbIntProperty::create(insts[0], "weight", 42);
+  BOOST_TEST(dbIntProperty::find(insts[0], "weight")->getValue() == 42);
+
+  dbInst::destroy((dbInst*) insts[2]);
+  dbMaster* and2 = db->findLib("lib1")->findMaster("and2");
+  dbInst* inst = dbInst::create(block, and2, "reused");
+  BOOST_TEST(dbProperty::find(inst, "weight") == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(test_bulk)
+{
+  vector<int> ints;
+  vector<double> doubles;
+  for (int i = 0; i < 100; i++) {
+    ints.push_back(i * 3);
+    doubles.push_back(i * 0.5);
+  }
+  dbIntProperty::create(insts[5], "slack", 0);
+  dbIntProperty::setValues(insts, "count", ints);
+  dbDoubleProperty::setValues(insts, "slack", doubles);
+
+  vector<int> count = dbIntProperty::getValues(insts, "count");
+  BOOST_TEST(count == ints);
+
+  vector<double> slack = dbDoubleProperty::getValues(insts, "slack", -1.0);
+  BOOST_TEST(slack == doubles);
+  // Properties of different types may share a name.
+  BOOST_TEST(dbIntProperty::find(insts[5], "slack")->getValue() == 0);
+  BOOST_TEST(dbProperty::find(insts[5], "slack")->getType()
+             == dbProperty::DOUBLE_PROP);
+
+  vector<int> missing = dbIntProperty::getValues(insts, "missing", 9);
+  BOOST_TEST(missing == vector<int>(100, 9));
+}
+
+BOOST_AUTO_TEST_CASE(test_bulk_errors)
+{
+  vector<dbObject*> repeated = {insts[0], insts[1], insts[0]};
+  dbIntProperty::setValues(repeated, "count", {1, 2, 3});
+  BOOST_TEST(dbIntProperty::find(insts[0], "count")->getValue() == 3);
+  BOOST_TEST(dbIntProperty::find(insts[1], "count")->getValue() == 2);
+
+  BOOST_CHECK_THROW(dbIntProperty::setValues(insts, "count", {1, 2}),
+                    std::runtime_error);
+  BOOST_CHECK_THROW(dbDoubleProperty::setValues(repeated, "slack", {}),
+                    std::runtime_error);
+  BOOST_TEST(dbIntProperty::find(insts[2], "count") == nullptr);
+  BOOST_TEST(dbDoubleProperty::find(insts[0], "slack") == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(test_master_objects)
+{
+  // The mterms of each master are numbered from 1, so the "a" pins of and2
+  // and or2 share an id in the lib's property table.
+  dbLib* lib = db->findLib("lib1");
+  dbMTerm* and2_a = lib->findMaster("and2")->findMTerm("a");
+  dbMTerm* or2_a = lib->findMaster("or2")->findMTerm("a");
+  BOOST_TEST(and2_a->getId() == or2_a->getId());
+
+  dbIntProperty::create(and2_a, "cap", 3);
+  BOOST_TEST(dbIntProperty::find(and2_a, "cap")->getValue() == 3);
+  BOOST_TEST(dbIntProperty::find(or2_a, "cap") == nullptr);
+  BOOST_TEST(dbProperty::find(or2_a, "cap") == nullptr);
+
+  dbIntProperty::create(or2_a, "cap", 5);
+  vector<dbObject*> mterms = {and2_a, or2_a};
+  vector<int> caps = dbIntProperty::getValues(mterms, "cap");
+  BOOST_TEST(caps == vector<int>({3, 5}));
+  BOOST_TEST(dbIntProperty::find(and2_a, "cap")->getValue() == 3);
+  BOOST_TEST(dbIntProperty::find(or2_a, "cap")->getValue() == 5);
+}
+
+BOOST_AUTO_TEST_CASE(test_read_write)
+{
+  dbIntProperty::create(insts[7], "weight", 7);
+  dbStringProperty::create(block, "tag", "top");
+  dbBoolProperty::create(db, "flag", true);
+
+  FILE* file = tmpfile();
+  db->write(file);
+  rewind(file);
+  dbDatabase* db2 = dbDatabase::create();
+  db2->read(file);
+  fclose(file);
+
+  dbBlock* block2 = db2->getChip()->getBlock();
+  dbInst* inst2 = block2->findInst("inst7");
+  BOOST_TEST(dbIntProperty::find(inst2, "weight")->getValue() == 7);
+  BOOST_TEST(dbProperty::find(block2->findInst("inst8"), "weight") == nullptr);
+  BOOST_TEST(dbStringProperty::find(block2, "tag")->getValue() == "top");
+  BOOST_TEST(dbBoolProperty::find(db2, "flag")->getValue() == true);
+  dbDatabase::destroy(db2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
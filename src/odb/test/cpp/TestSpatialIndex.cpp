@@ -0,0 +1,144 @@
+#define BOOST_TEST_MODULE TestSpatialIndex
+#include <boost/test/included/unit_test.hpp>
+#include <string>
+#include <vector>
+
+#include "db.h"
+#include "dbSpatialIndex.h"
+#include "dbWireCodec.h"
+#include "helper.cpp"
+
+using namespace odb;
+using namespace std;
+
+struct F_SPATIAL_INDEX
+{
+  F_SPATIAL_INDEX()
+  {
+    db = createSimpleDB();
+    block = db->getChip()->getBlock();
+    layer = dbTechLayer::create(
+        db->getTech(), "M1", dbTechLayerType::ROUTING);
+    layer->setWidth(100);
+    and2 = db->findLib("lib1")->findMaster("and2");
+    for (int i = 0; i < 10; i++) {
+      dbInst* inst
+          = dbInst::create(block, and2, ("inst" + to_string(i)).c_str());
+      inst->setLocation(i * 2000, 0);
+      inst->setPlacementStatus(dbPlacementStatus::PLACED);
+      insts.push_back(inst);
+    }
+    index = dbSpatialIndex::get(block);
+  }
+  ~F_SPATIAL_INDEX() { dbDatabase::destroy(db); }
+
+  vector<dbInst*> findInsts(const Rect& area)
+  {
+    vector<dbInst*> found;
+    index->findInsts(area, found);
+    return found;
+  }
+
+  dbDatabase* db;
+  dbBlock* block;
+  dbTechLayer* layer;
+  dbMaster* and2;
+  vector<dbInst*> insts;
+  dbSpatialIndex* index;
+};
+
+BOOST_FIXTURE_TEST_SUITE(test_suite, F_SPATIAL_INDEX)
+
+BOOST_AUTO_TEST_CASE(test_insts)
+{
+  BOOST_TEST(index == dbSpatialIndex::get(block));
+  BOOST_TEST(findInsts(Rect(0, 0, 20000, 1000)).size() == 10);
+  BOOST_TEST(findInsts(Rect(4500, 100, 4600, 200))
+             == vector<dbInst*>{insts[2]});
+  BOOST_TEST(findInsts(Rect(5100, 0, 5900, 1000)).empty());
+
+  insts[2]->setLocation(50000, 50000);
+  BOOST_TEST(findInsts(Rect(4500, 100, 4600, 200)).empty());
+  BOOST_TEST(findInsts(Rect(50500, 50500, 50600, 50600))
+             == vector<dbInst*>{insts[2]});
+
+  insts[3]->setPlacementStatus(dbPlacementStatus::UNPLACED);
+  BOOST_TEST(findInsts(Rect(6500, 100, 6600, 200)).empty());
+  insts[3]->setPlacementStatus(dbPlacementStatus::FIRM);
+  BOOST_TEST(findInsts(Rect(6500, 100, 6600, 200))
+             == vector<dbInst*>{insts[3]});
+
+  dbInst::destroy(insts[4]);
+  BOOST_TEST(findInsts(Rect(8500, 100, 8600, 200)).empty());
+
+  dbInst* inst = dbInst::create(block, and2, "new");
+  BOOST_TEST(findInsts(Rect(0, 0, 100000, 100000)).size() == 9);
+  inst->setLocation(8000, 0);
+  inst->setPlacementStatus(dbPlacementStatus::PLACED);
+  BOOST_TEST(findInsts(Rect(8500, 100, 8600, 200)) == vector<dbInst*>{inst});
+}
+
+BOOST_AUTO_TEST_CASE(test_shapes)
+{
+  dbNet* net = dbNet::create(block, "net");
+  dbWire* wire = dbWire::create(net);
+  dbWireEncoder encoder;
+  encoder.begin(wire);
+  encoder.newPath(layer, dbWireType::ROUTED);
+  encoder.addPoint(0, 0);
+  encoder.addPoint(10000, 0);
+  encoder.end();
+
+  dbSWire* swire = dbSWire::create(net, dbWireType::ROUTED);
+  dbSBox* sbox = dbSBox::create(
+      swire, layer, 0, 5000, 10000, 5200, dbWireShapeType::STRIPE);
+  dbObstruction* obs = dbObstruction::create(block, layer, 0, 8000, 100, 8100);
+  dbFill::create(block, false, 0, layer, 0, 9000, 100, 9100);
+
+  vector<dbSpatialIndex::NetShape> wires;
+  index->findWires(layer, Rect(5000, -10, 5010, 10), wires);
+  BOOST_TEST(wires.size() == 1);
+  BOOST_TEST(wires[0].net == net);
+  BOOST_TEST(wires[0].rect.yMin() == -50);
+  vector<dbSBox*> sboxes;
+  index->findSpecialWires(layer, Rect(5000, 5100, 5000, 5100), sboxes);
+  BOOST_TEST(sboxes == vector<dbSBox*>{sbox});
+  vector<dbObstruction*> obstructions;
+  index->findObstructions(layer, Rect(50, 8050, 60, 8060), obstructions);
+  BOOST_TEST(obstructions == vector<dbObstruction*>{obs});
+  vector<dbFill*> fills;
+  index->findFills(layer, Rect(50, 9050, 60, 9060), fills);
+  BOOST_TEST(fills.size() == 1);
+
+  // Rewrite the wire; the old shape must be gone.
+  encoder.begin(wire);
+  encoder.newPath(layer, dbWireType::ROUTED);
+  encoder.addPoint(0, 20000);
+  encoder.addPoint(10000, 20000);
+  encoder.end();
+  wires.clear();
+  index->findWires(layer, Rect(5000, -10, 5010, 10), wires);
+  BOOST_TEST(wires.empty());
+  index->findWires(layer, Rect(5000, 20000, 5010, 20000), wires);
+  BOOST_TEST(wires.size() == 1);
+
+  dbSBox::destroy(sbox);
+  dbObstruction::destroy(obs);
+  dbFill::destroy(fills[0]);
+  sboxes.clear();
+  obstructions.clear();
+  fills.clear();
+  index->findSpecialWires(layer, Rect(5000, 5100, 5000, 5100), sboxes);
+  index->findObstructions(layer, Rect(50, 8050, 60, 8060), obstructions);
+  index->findFills(layer, Rect(50, 9050, 60, 9060), fills);
+  BOOST_TEST(sboxes.empty());
+  BOOST_TEST(obstructions.empty());
+  BOOST_TEST(fills.empty());
+
+  dbNet::destroy(net);
+  wires.clear();
+  index->findWires(layer, Rect(0, -100000, 100000, 100000), wires);
+  BOOST_TEST(wires.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,30 @@
+import opendbpy as odb
+import helper
+import odbUnitTest
+
+class TestProperty(odbUnitTest.TestCase):
+    def setUp(self):
+        self.db, self.lib = helper.createSimpleDB()
+        self.block = helper.create2LevelBlock(self.db, self.lib, self.db.getChip())
+        self.insts = [self.block.findInst(name) for name in ['i1', 'i2', 'i3']]
+        
+    def tearDown(self):
+        self.db.destroy(self.db)
+    def test_bulk_int(self):
+        odb.dbIntProperty.create(self.insts[1], 'count', 7)
+        self.assertEqual(list(odb.dbIntProperty.getValues(self.insts, 'count', -1)), [-1, 7, -1])
+        odb.dbIntProperty.setValues(self.insts, 'count', [1, 2, 3])
+        self.assertEqual(list(odb.dbIntProperty.getValues(self.insts, 'count')), [1, 2, 3])
+        self.assertEqual(odb.dbIntProperty.find(self.insts[2], 'count').getValue(), 3)
+    def test_bulk_double(self):
+        odb.dbDoubleProperty.setValues(self.insts, 'slack', [0.5, -1.5, 2.0])
+        self.assertEqual(list(odb.dbDoubleProperty.getValues(self.insts, 'slack')), [0.5, -1.5, 2.0])
+        self.assertEqual(list(odb.dbIntProperty.getValues(self.insts, 'slack', 4)), [4, 4, 4])
+    def test_bulk_repeated(self):
+        objects = [self.insts[0], self.insts[1], self.insts[0]]
+        odb.dbIntProperty.setValues(objects, 'count', [1, 2, 3])
+        self.assertEqual(list(odb.dbIntProperty.getValues(self.insts, 'count')), [3, 2, 0])
+        
+if __name__=='__main__':
+    odbUnitTest.mainParallel(TestProperty)
+#     odbUnitTest.main()
@@ -61,6 +61,7 @@ class dbSta;
 }  // namespace sta
 
 namespace utl {
+class Executor;
 class Logger;
 }
 
@@ -74,7 +75,8 @@ class PartitionMgr
   void init(odb::dbDatabase* db,
             sta::dbNetwork* db_network,
             sta::dbSta* sta,
-            Logger* logger);
+            Logger* logger,
+            utl::Executor* executor);
 
   // The TritonPart Interface
   // TritonPart is a state-of-the-art hypergraph and netlist partitioner that
@@ -130,6 +132,7 @@ class PartitionMgr
   sta::dbNetwork* db_network_ = nullptr;
   sta::dbSta* sta_ = nullptr;
   Logger* logger_ = nullptr;
+  utl::Executor* executor_ = nullptr;
 };
 
 }  // namespace par
@@ -67,7 +67,8 @@ void initPartitionMgr(OpenRoad* openroad)
   kernel->init(openroad->getDb(),
                openroad->getDbNetwork(),
                openroad->getSta(),
-               openroad->getLogger());
+               openroad->getLogger(),
+               openroad->getExecutor());
 };
 
 void deletePartitionMgr(par::PartitionMgr* partitionmgr)
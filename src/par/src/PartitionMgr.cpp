@@ -81,12 +81,14 @@ namespace par {
 void PartitionMgr::init(odb::dbDatabase* db,
                         sta::dbNetwork* db_network,
                         sta::dbSta* sta,
-                        utl::Logger* logger)
+                        utl::Logger* logger,
+                        utl::Executor* executor)
 {
   db_ = db;
   db_network_ = db_network;
   sta_ = sta;
   logger_ = logger;
+  executor_ = executor;
 }
 
 void PartitionMgr::tritonPartHypergraph(const char* hypergraph_file,
@@ -102,6 +104,7 @@ void PartitionMgr::tritonPartHypergraph(const char* hypergraph_file,
   // Thus users can use this function to partition the input hypergraph
   auto triton_part
       = std::make_unique<TritonPart>(db_network_, db_, sta_, logger_);
+  triton_part->SetExecutor(executor_);
   triton_part->PartitionHypergraph(hypergraph_file,
                                    fixed_file,
                                    num_parts,
@@ -120,6 +123,7 @@ void PartitionMgr::tritonPartDesign(unsigned int num_parts,
 {
   auto triton_part
       = std::make_unique<TritonPart>(db_network_, db_, sta_, logger_);
+  triton_part->SetExecutor(executor_);
   triton_part->PartitionDesign(num_parts,
                                balance_constraint,
                                seed,
@@ -138,6 +142,7 @@ std::vector<int> PartitionMgr::TritonPart2Way(
 {
   auto triton_part
       = std::make_unique<TritonPart>(db_network_, db_, sta_, logger_);
+  triton_part->SetExecutor(executor_);
   return triton_part->Partition2Way(num_vertices,
                                     num_hyperedges,
                                     hyperedges,
@@ -39,6 +39,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include "TPCoarsener.h"
 
+#include <algorithm>
 #include <cassert>
 #include <set>
 
@@ -184,15 +185,18 @@ void TPcoarsener::VertexMatching(
   }
   OrderVertices(hgraph, unvisited);
   // thr_cluster_weight_ = AverageClusterWt(hgraph);
-  for (auto v_itr = unvisited.begin(); v_itr != unvisited.end(); ++v_itr) {
-    const int v = *v_itr;
-    if (vertex_c_attr[v] != -1) {
-      continue;
-    }
+
+  // The connectivity score between v and each neighbor only depends on the
+  // hypergraph, so it is computed in parallel for a block of vertices.  The
+  // matching itself, which depends on the clusters formed so far, stays
+  // serial in the original vertex order, so the result does not depend on
+  // the number of threads.
+  // Candidates of v are (neighbor, score) pairs sorted by neighbor id.
+  using Candidates = std::vector<std::pair<int, float>>;
+  auto compute_candidates = [&](const int v, Candidates& candidates) {
     std::map<int, float> score_map;
     const int first_valid_entry_v = hgraph->vptr_[v];
     const int first_invalid_entry_v = hgraph->vptr_[v + 1];
-    int he_reduction_count = 0;
     for (int i = first_valid_entry_v; i < first_invalid_entry_v; ++i) {
       const int he = hgraph->vind_[i];
       const int first_valid_entry_he = hgraph->eptr_[he];
@@ -201,55 +205,29 @@ void TPcoarsener::VertexMatching(
       if (he_size <= 1 || he_size > thr_coarsen_hyperedge_size_) {
         continue;
       }
-      // Count how many 2 pin hyperedges get removed by this cluster
-      if (he_size == 2) {
-        ++he_reduction_count;
-      }
       const float he_score = GetClusterScore(he, hgraph, algebraic_weights);
       for (int j = first_valid_entry_he; j < first_invalid_entry_he; ++j) {
         const int nbr_v = hgraph->eind_[j];
         if (nbr_v == v) {
           continue;
         }
-        if (score_map.find(nbr_v) == score_map.end()) {
-          if ((hgraph->fixed_vertex_flag_ == true
-               && hgraph->fixed_attr_[nbr_v] > -1)
-              || (hgraph->community_flag_ == true
-                  && hgraph->community_attr_[nbr_v]
-                         != hgraph->community_attr_[v])) {
-            continue;
-          }
-          const std::vector<float>& nbvr_v_weight
-              = vertex_c_attr[nbr_v] > -1
-                    ? vertex_weights_c[vertex_c_attr[nbr_v]]
-                    : hgraph->vertex_weights_[nbr_v];
-          if (hgraph->vertex_weights_[v] + nbvr_v_weight
-              > thr_cluster_weight_) {
-            continue;
-          }
+        if ((hgraph->fixed_vertex_flag_ == true
+             && hgraph->fixed_attr_[nbr_v] > -1)
+            || (hgraph->community_flag_ == true
+                && hgraph->community_attr_[nbr_v]
+                       != hgraph->community_attr_[v])) {
+          continue;
+        }
+        auto score_iter = score_map.find(nbr_v);
+        if (score_iter == score_map.end()) {
           score_map[nbr_v] = he_score;
         } else {
-          score_map[nbr_v] += he_score;
+          score_iter->second += he_score;
         }
-        // score_map[nbr_v] += 0.25 * he_reduction_count;
       }
     }
-
-    if (score_map.size() == 0) {
-      vertex_c_attr[v] = cluster_id++;
-      vertex_weights_c.push_back(hgraph->vertex_weights_[v]);
-      if (hgraph->placement_flag_ == true) {
-        placement_attr_c.push_back(hgraph->placement_attr_[v]);
-      }
-      if (hgraph->community_flag_ == true) {
-        community_attr_c.push_back(hgraph->community_attr_[v]);
-      }
-      if (hgraph->fixed_vertex_flag_ == true) {
-        fixed_attr_c.push_back(-1);
-      }
-      continue;
-    }
-    if (hgraph->num_timing_paths_ > 0 && path_traverse_step_ > 0) {
+    if (!score_map.empty() && hgraph->num_timing_paths_ > 0
+        && path_traverse_step_ > 0) {
       const int first_valid_entry_pv = hgraph->pptr_v_[v];
       const int first_invalid_entry_pv = hgraph->pptr_v_[v + 1];
       std::map<int, float> timing_neighbors;
@@ -293,6 +271,67 @@ void TPcoarsener::VertexMatching(
         }
       }
     }
+    candidates.assign(score_map.begin(), score_map.end());
+  };
+
+  const int num_tasks
+      = executor_ == nullptr ? 1 : executor_->getNumThreads();
+  const int block_size = 1024 * num_tasks;
+  std::vector<Candidates> block_candidates;
+  int block_start = 0;
+  for (auto v_itr = unvisited.begin(); v_itr != unvisited.end(); ++v_itr) {
+    const int v_idx = v_itr - unvisited.begin();
+    if (v_idx == block_start + static_cast<int>(block_candidates.size())) {
+      // compute the candidates of the next block
+      block_start = v_idx;
+      const int block_end = std::min(block_start + block_size,
+                                     static_cast<int>(unvisited.size()));
+      block_candidates.resize(block_end - block_start);
+      TPparallelFor(executor_, num_tasks, [&](int task) {
+        for (int i = block_start + task; i < block_end; i += num_tasks) {
+          auto& candidates = block_candidates[i - block_start];
+          candidates.clear();
+          // vertices already matched are skipped below
+          if (vertex_c_attr[unvisited[i]] == -1) {
+            compute_candidates(unvisited[i], candidates);
+          }
+        }
+      });
+    }
+    const int v = *v_itr;
+    if (vertex_c_attr[v] != -1) {
+      continue;
+    }
+    // drop the neighbors whose cluster would become too heavy
+    Candidates& score_map = block_candidates[v_idx - block_start];
+    score_map.erase(
+        std::remove_if(score_map.begin(),
+                       score_map.end(),
+                       [&](const std::pair<int, float>& candidate) {
+                         const int nbr_v = candidate.first;
+                         const std::vector<float>& nbvr_v_weight
+                             = vertex_c_attr[nbr_v] > -1
+                                   ? vertex_weights_c[vertex_c_attr[nbr_v]]
+                                   : hgraph->vertex_weights_[nbr_v];
+                         return hgraph->vertex_weights_[v] + nbvr_v_weight
+                                > thr_cluster_weight_;
+                       }),
+        score_map.end());
+
+    if (score_map.size() == 0) {
+      vertex_c_attr[v] = cluster_id++;
+      vertex_weights_c.push_back(hgraph->vertex_weights_[v]);
+      if (hgraph->placement_flag_ == true) {
+        placement_attr_c.push_back(hgraph->placement_attr_[v]);
+      }
+      if (hgraph->community_flag_ == true) {
+        community_attr_c.push_back(hgraph->community_attr_[v]);
+      }
+      if (hgraph->fixed_vertex_flag_ == true) {
+        fixed_attr_c.push_back(-1);
+      }
+      continue;
+    }
     float best_score = -std::numeric_limits<float>::max();
     int best_candidate = -1;
     for (auto& [u, score] : score_map) {
@@ -379,17 +418,31 @@ HGraph TPcoarsener::Contraction(HGraph hgraph,
   TP_matrix<float> hyperedges_weights_c;
   TP_matrix<float> nonscaled_hyperedges_weights_c;
   std::map<long long int, int> hash_map;
-  for (int i = 0; i < hgraph->num_hyperedges_; ++i) {
-    const int first_valid_entry = hgraph->eptr_[i];
-    const int first_invalid_entry = hgraph->eptr_[i + 1];
-    const int he_size = first_invalid_entry - first_valid_entry;
-    if (he_size <= 1 || he_size > thr_match_hyperedge_size_) {
-      continue;
-    }
-    std::set<int> hyperedge_c;
-    for (int j = first_valid_entry; j < first_invalid_entry; ++j) {
-      hyperedge_c.insert(vertex_c_attr[hgraph->eind_[j]]);
+  // Map every hyperedge to its (sorted, unique) clusters in parallel.
+  // Merging the parallel hyperedges is done serially in hyperedge order.
+  TP_matrix<int> mapped_hyperedges(hgraph->num_hyperedges_);
+  const int num_tasks
+      = executor_ == nullptr ? 1 : executor_->getNumThreads();
+  TPparallelFor(executor_, num_tasks, [&](int task) {
+    for (int i = task; i < hgraph->num_hyperedges_; i += num_tasks) {
+      const int first_valid_entry = hgraph->eptr_[i];
+      const int first_invalid_entry = hgraph->eptr_[i + 1];
+      const int he_size = first_invalid_entry - first_valid_entry;
+      if (he_size <= 1 || he_size > thr_match_hyperedge_size_) {
+        continue;
+      }
+      std::vector<int>& hyperedge_c = mapped_hyperedges[i];
+      hyperedge_c.reserve(he_size);
+      for (int j = first_valid_entry; j < first_invalid_entry; ++j) {
+        hyperedge_c.push_back(vertex_c_attr[hgraph->eind_[j]]);
+      }
+      std::sort(hyperedge_c.begin(), hyperedge_c.end());
+      hyperedge_c.erase(std::unique(hyperedge_c.begin(), hyperedge_c.end()),
+                        hyperedge_c.end());
     }
+  });
+  for (int i = 0; i < hgraph->num_hyperedges_; ++i) {
+    std::vector<int>& hyperedge_c = mapped_hyperedges[i];
     if (hyperedge_c.size() <= 1) {
       continue;
     }
@@ -405,12 +458,10 @@ HGraph TPcoarsener::Contraction(HGraph hgraph,
         nonscaled_hyperedges_weights_c.push_back(
             hgraph->nonscaled_hyperedge_weights_[i]);
       }
-      hyperedges_c.push_back(
-          std::vector<int>(hyperedge_c.begin(), hyperedge_c.end()));
+      hyperedges_c.push_back(std::move(hyperedge_c));
     } else {
       const int hash_id = hash_map[hash_value];
-      std::vector<int> hyperedge_vec(hyperedge_c.begin(), hyperedge_c.end());
-      if (hyperedges_c[hash_id] == hyperedge_vec) {
+      if (hyperedges_c[hash_id] == hyperedge_c) {
         hyperedges_weights_c[hash_id]
             = hyperedges_weights_c[hash_id] + hgraph->hyperedge_weights_[i];
         if (hgraph->num_timing_paths_ > 0) {
@@ -424,10 +475,11 @@ HGraph TPcoarsener::Contraction(HGraph hgraph,
           nonscaled_hyperedges_weights_c.push_back(
               hgraph->nonscaled_hyperedge_weights_[i]);
         }
-        hyperedges_c.push_back(hyperedge_vec);
+        hyperedges_c.push_back(std::move(hyperedge_c));
       }
     }
   }
+  mapped_hyperedges.clear();
 
   TP_matrix<int> paths_c;
   std::vector<float> timing_attr_c;
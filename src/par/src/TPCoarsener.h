@@ -100,6 +100,7 @@ class TPcoarsener
     vertex_order_choice_ = choice;
   }
   Order GetVertexOrderChoice() const { return vertex_order_choice_; }
+  void SetExecutor(utl::Executor* executor) { executor_ = executor; }
   std::vector<int> PathBasedCommunity(HGraph hgraph);
   TP_coarse_graphs LazyFirstChoice(HGraph hgraph);
 
@@ -137,6 +138,7 @@ class TPcoarsener
   float adj_diff_ratio_;
   int seed_;
   Order vertex_order_choice_;
+  utl::Executor* executor_ = nullptr;  // serial if not set
   utl::Logger* logger_ = nullptr;
 };
 
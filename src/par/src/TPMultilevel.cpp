@@ -43,6 +43,20 @@ using utl::PAR;
 
 namespace par {
 
+void TPmultilevelPartitioner::SetExecutor(utl::Executor* executor)
+{
+  executor_ = executor;
+  if (coarsener_ != nullptr) {
+    coarsener_->SetExecutor(executor);
+  }
+  if (two_way_refiner_ != nullptr) {
+    two_way_refiner_->SetExecutor(executor);
+  }
+  if (k_way_refiner_ != nullptr) {
+    k_way_refiner_->SetExecutor(executor);
+  }
+}
+
 TP_partition TPmultilevelPartitioner::PartitionTwoWay(
     HGraph hgraph,
     HGraph hgraph_processed,
@@ -379,7 +393,6 @@ void TPmultilevelPartitioner::MultilevelPartTwoWay(
     two_way_refiner_->SetHeSizeSkip(10000);
   }
 
-  std::vector<std::thread> threads;
   matrix<HGraph> hg_threads(GetBestInitSolns());
   std::vector<TP_two_way_refining_ptr> refiner_threads;
   std::vector<TP_ilp_refiner_ptr> i_refiner_threads;
@@ -415,23 +428,18 @@ void TPmultilevelPartitioner::MultilevelPartTwoWay(
       refiner_thread->SetHeSizeSkip(50);
       ilp_thread->SetHeSizeSkip(50);
     }
+    refiner_thread->SetExecutor(executor_);
     refiner_threads.push_back(refiner_thread);
     i_refiner_threads.push_back(ilp_thread);
   }
-  for (int i = 0; i < GetBestInitSolns(); ++i) {
-    threads.push_back(std::thread(&par::TPmultilevelPartitioner::VcycleTwoWay,
-                                  this,
-                                  std::ref(hg_threads[i]),
-                                  std::ref(max_vertex_balance),
-                                  std::ref(partitions_vec[partition_ids[i]]),
-                                  refiner_threads[i],
-                                  i_refiner_threads[i],
-                                  false));
-  }
-  for (auto& th : threads) {
-    th.join();
-  }
-  threads.clear();
+  TPparallelFor(executor_, GetBestInitSolns(), [&](int i) {
+    VcycleTwoWay(hg_threads[i],
+                 max_vertex_balance,
+                 partitions_vec[partition_ids[i]],
+                 refiner_threads[i],
+                 i_refiner_threads[i],
+                 false);
+  });
   float best_cut = std::numeric_limits<float>::max();
   int best_partition_id = 0;
   for (int i = 0; i < GetBestInitSolns(); ++i) {
@@ -672,7 +680,6 @@ void TPmultilevelPartitioner::MultilevelPartKWay(
   logger_->report("[STATUS] Running V-cycle refinement on {} partitions ",
                   GetBestInitSolns());
   logger_->report("====================================================");
-  std::vector<std::thread> threads;
   matrix<HGraph> hg_threads(GetBestInitSolns());
   std::vector<TP_k_way_refining_ptr> refiner_threads;
   for (int i = 0; i < GetBestInitSolns(); ++i) {
@@ -695,21 +702,16 @@ void TPmultilevelPartitioner::MultilevelPartKWay(
     } else {
       refiner_thread->SetHeSizeSkip(50);
     }
+    refiner_thread->SetExecutor(executor_);
     refiner_threads.push_back(refiner_thread);
   }
-  for (int i = 0; i < GetBestInitSolns(); ++i) {
-    threads.push_back(std::thread(&par::TPmultilevelPartitioner::VcycleKWay,
-                                  this,
-                                  std::ref(hg_threads[i]),
-                                  std::ref(max_vertex_balance),
-                                  std::ref(partitions_vec[partition_ids[i]]),
-                                  refiner_threads[i],
-                                  false));
-  }
-  for (auto& th : threads) {
-    th.join();
-  }
-  threads.clear();
+  TPparallelFor(executor_, GetBestInitSolns(), [&](int i) {
+    VcycleKWay(hg_threads[i],
+               max_vertex_balance,
+               partitions_vec[partition_ids[i]],
+               refiner_threads[i],
+               false);
+  });
   float best_cut = std::numeric_limits<float>::max();
   int best_partition_id = 0;
   logger_->report("=============================");
@@ -122,6 +122,9 @@ class TPmultilevelPartitioner
   }
 
   int GetBestInitSolns() const { return num_best_initial_solutions_; }
+  // Shares the pool with the coarsener and the refiners.
+  // V-cycles on the best initial solutions run as tasks of the same pool.
+  void SetExecutor(utl::Executor* executor);
   TP_partition PartitionTwoWay(HGraph hgraph,
                                HGraph hgraph_processed,
                                matrix<float> max_vertex_balance,
@@ -185,6 +188,7 @@ class TPmultilevelPartitioner
   TP_k_way_refining_ptr k_way_refiner_ = nullptr;
   TP_greedy_refiner_ptr greedy_refiner_ = nullptr;
   TP_ilp_refiner_ptr ilp_refiner_ = nullptr;
+  utl::Executor* executor_ = nullptr;
   utl::Logger* logger_ = nullptr;
   int num_parts_;
   int num_initial_solutions_;
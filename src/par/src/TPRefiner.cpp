@@ -1273,12 +1273,6 @@ void TPkWayFM::InitializeSingleGainBucket(
   buckets[to_pid]->SetActive();
   assert(buckets[to_pid]->GetStatus());
   for (const int& v : boundary_vertices) {
-    if (GetBoundaryStatus(v) == false) {
-      MarkBoundary(v);
-    }
-    if (GetVisitStatus(v) == true) {
-      ResetVisited(v);
-    }
     const int from_part = solution[v];
     auto gain_cell = CalculateGain(
         v, from_part, to_pid, hgraph, solution, cur_path_cost, net_degs);
@@ -1297,21 +1291,27 @@ void TPkWayFM::InitializeGainBucketsKWay(
     const std::vector<float>& cur_path_cost,
     TP_gain_buckets& buckets)
 {
-  std::vector<std::thread> threads;  // for parallel updating
+  // The flags are shared by all the buckets, so they are set before the
+  // buckets are filled in parallel
+  for (const int& v : boundary_vertices) {
+    if (GetBoundaryStatus(v) == false) {
+      MarkBoundary(v);
+    }
+    if (GetVisitStatus(v) == true) {
+      ResetVisited(v);
+    }
+  }
   // parallel initialize the num_parts gain_buckets
-  for (int to_pid = 0; to_pid < num_parts_; to_pid++)
-    threads.push_back(std::thread(&TPkWayFM::InitializeSingleGainBucket,
-                                  this,
-                                  std::ref(buckets),
-                                  to_pid,
-                                  boundary_vertices,
-                                  hgraph,
-                                  solution,
-                                  cur_path_cost,
-                                  net_degs));
-  for (auto& t : threads)
-    t.join();  // wait for all threads to finish
-  threads.clear();
+  // each task only touches its own bucket
+  TPparallelFor(executor_, num_parts_, [&](int to_pid) {
+    InitializeSingleGainBucket(buckets,
+                               to_pid,
+                               boundary_vertices,
+                               hgraph,
+                               solution,
+                               cur_path_cost,
+                               net_degs);
+  });
 }
 
 void TPkWayFM::Refine(const HGraph hgraph,
@@ -1389,7 +1389,8 @@ void TPkWayFM::UpdateSingleGainBucket(int part,
                                       const HGraph hgraph,
                                       const TP_partition& solution,
                                       const std::vector<float>& cur_path_cost,
-                                      const matrix<int>& net_degs)
+                                      const matrix<int>& net_degs,
+                                      std::vector<int>& new_boundary)
 {
   std::set<int> neighboring_hyperedges;
   for (const int& v : neighbors) {
@@ -1417,7 +1418,7 @@ void TPkWayFM::UpdateSingleGainBucket(int part,
       buckets[part]->ChangePriority(nbr_index_in_heap, new_gain);
     } else if (CheckBoundaryVertex(hgraph, v, partition_pair, net_degs) == true
                && buckets[part]->CheckIfVertexExists(v) == false) {
-      MarkBoundary(v);
+      new_boundary.push_back(v);
       auto gain_cell = CalculateGain(
           v, from_part, part, hgraph, solution, cur_path_cost, net_degs);
       buckets[part]->InsertIntoPQ(gain_cell);
@@ -1618,17 +1619,10 @@ void TPkWayFM::AcceptKWayMove(std::shared_ptr<VertexGain> gain_cell,
     --net_degs[he][prev_part_id];
     ++net_degs[he][new_part_id];
   }
-  // Remove vertex from all buckets where vertex is present
-  std::vector<std::thread> deletion_threads;
+  // Remove vertex from all buckets where vertex is present.
+  // Each deletion is O(log n), far cheaper than handing it to a thread.
   for (int i = 0; i < num_parts_; ++i) {
-    deletion_threads.push_back(std::thread(&par::TPkWayFM::HeapEleDeletion,
-                                           this,
-                                           vertex_id,
-                                           i,
-                                           std::ref(gain_buckets)));
-  }
-  for (auto& th : deletion_threads) {
-    th.join();
+    HeapEleDeletion(vertex_id, i, gain_buckets);
   }
   /*int heap_loc = gain_buckets[new_part_id]->GetLocationOfVertex(vertex_id);
   gain_buckets[new_part_id]->RemoveAt(heap_loc);
@@ -1689,6 +1683,8 @@ float TPkWayFM::Pass(const HGraph hgraph,
   float min_cut = cutsize;
   float total_delta_gain = 0.0;
   int best_move = -1;
+  // vertices which became boundary vertices, per bucket
+  matrix<int> new_boundary(num_parts_);
   // Main loop of FM pass
   for (int i = 0; i < GetMaxMoves(); ++i) {
     auto candidate
@@ -1717,22 +1713,31 @@ float TPkWayFM::Pass(const HGraph hgraph,
     FindNeighbors(hgraph, vertex, partition_pair, solution, neighbors, true);
     UpdateNeighboringPaths(
         partition_pair, neighbors, hgraph, solution, paths_cost);
-    // update the neighbors of v for all gain buckets in parallel
-    std::vector<std::thread> threads;
-    for (int to_pid = 0; to_pid < num_parts_; to_pid++) {
-      threads.push_back(std::thread(&TPkWayFM::UpdateSingleGainBucket,
-                                    this,
-                                    to_pid,
-                                    neighbors,
-                                    std::ref(buckets),
-                                    hgraph,
-                                    solution,
-                                    paths_cost,
-                                    net_degs));
-    }
-    for (auto& t : threads)
-      t.join();  // wait for all threads to finish
-    threads.clear();
+    // update the neighbors of v for all gain buckets, in parallel when
+    // there is enough work to amortize the hand-off to the pool
+    auto update_bucket = [&](int to_pid) {
+      UpdateSingleGainBucket(to_pid,
+                             neighbors,
+                             buckets,
+                             hgraph,
+                             solution,
+                             paths_cost,
+                             net_degs,
+                             new_boundary[to_pid]);
+    };
+    if (neighbors.size() >= min_parallel_neighbors_) {
+      TPparallelFor(executor_, num_parts_, update_bucket);
+    } else {
+      for (int to_pid = 0; to_pid < num_parts_; to_pid++) {
+        update_bucket(to_pid);
+      }
+    }
+    for (auto& part_boundary : new_boundary) {
+      for (const int v : part_boundary) {
+        MarkBoundary(v);
+      }
+      part_boundary.clear();
+    }
 
     if (cutsize < min_cut) {
       min_cut = cutsize;
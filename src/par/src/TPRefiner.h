@@ -287,6 +287,7 @@ class TPrefiner
                  std::vector<float>& path_cost,
                  std::vector<int>& solution);
   utl::Logger* GetLogger() const { return logger_; }
+  void SetExecutor(utl::Executor* executor) { executor_ = executor; }
 
  protected:
   int num_parts_;
@@ -303,6 +304,7 @@ class TPrefiner
   float snaking_wt_factor_;
   float tolerance_;
   utl::Logger* logger_ = nullptr;
+  utl::Executor* executor_ = nullptr;  // serial if not set
 };
 
 // Priority queue implementation
@@ -515,13 +517,16 @@ class TPkWayFM : public TPrefiner
                                   const TP_partition& solution,
                                   const std::vector<float>& cur_path_cost,
                                   const matrix<int>& net_degs);
+  // Vertices that become boundary vertices are appended to new_boundary;
+  // the caller marks them, so the buckets can be updated concurrently.
   void UpdateSingleGainBucket(int part,
                               const std::set<int>& neighbors,
                               TP_gain_buckets& buckets,
                               const HGraph hgraph,
                               const TP_partition& solution,
                               const std::vector<float>& cur_path_cost,
-                              const matrix<int>& net_degs);
+                              const matrix<int>& net_degs,
+                              std::vector<int>& new_boundary);
   void InitializeGainBucketsKWay(const HGraph hgraph,
                                  const TP_partition& solution,
                                  const matrix<int>& net_degs,
@@ -564,6 +569,8 @@ class TPkWayFM : public TPrefiner
       const matrix<float>& curr_block_balance,
       const matrix<float>& max_block_balance);
   int max_moves_;
+  // smaller neighborhoods are updated serially after a move
+  static constexpr size_t min_parallel_neighbors_ = 64;
 };
 
 using TP_k_way_refining_ptr = std::shared_ptr<TPkWayFM>;
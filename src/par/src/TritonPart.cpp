@@ -984,6 +984,7 @@ std::vector<int> TritonPart::HypergraphPartTwoWay(
                                                   ub_factor_,
                                                   refine_type,
                                                   logger_);
+  tritonpart_mlevel_partitioner->SetExecutor(executor_);
   bool vcycle = true;
   matrix<float> vertex_balance
       = hypergraph_->GetVertexBalance(num_parts_, ub_factor_);
@@ -1118,6 +1119,7 @@ std::vector<int> TritonPart::DesignPartTwoWay(unsigned int num_parts_,
                                                   ub_factor_,
                                                   refine_type,
                                                   logger_);
+  tritonpart_mlevel_partitioner->SetExecutor(executor_);
   bool vcycle = true;
   matrix<float> vertex_balance
       = hypergraph_->GetVertexBalance(num_parts_, ub_factor_);
@@ -1250,6 +1252,7 @@ std::vector<int> TritonPart::HypergraphPartKWay(const char* hypergraph_file_arg,
                                                   ub_factor_,
                                                   refine_type,
                                                   logger_);
+  tritonpart_mlevel_partitioner->SetExecutor(executor_);
   bool vcycle = true;
   matrix<float> vertex_balance
       = hypergraph_->GetVertexBalance(num_parts_, ub_factor_);
@@ -1365,6 +1368,7 @@ std::vector<int> TritonPart::DesignPartKWay(unsigned int num_parts_,
                                                   ub_factor_,
                                                   refine_type,
                                                   logger_);
+  tritonpart_mlevel_partitioner->SetExecutor(executor_);
   bool vcycle = true;
   matrix<float> vertex_balance
       = hypergraph_->GetVertexBalance(num_parts_, ub_factor_);
@@ -1581,6 +1585,7 @@ std::vector<int> TritonPart::Partition2Way(
                                                   ub_factor_,
                                                   refine_type,
                                                   logger_);
+  tritonpart_mlevel_partitioner->SetExecutor(executor_);
   bool vcycle = true;
   matrix<float> vertex_balance
       = hypergraph_->GetVertexBalance(num_parts_, ub_factor_);
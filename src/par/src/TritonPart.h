@@ -77,6 +77,9 @@ class TritonPart
   {
   }
 
+  // Coarsening, V-cycles and FM refinement run on executor
+  void SetExecutor(utl::Executor* executor) { executor_ = executor; }
+
   // Top level interface
   void PartitionDesign(unsigned int num_parts,
                        float balance_constraint,
@@ -209,6 +212,8 @@ class TritonPart
   bool timing_aware_flag_ = true;  // Enable timing aware
   int top_n_ = 1000;               // top_n timing paths
 
+  utl::Executor* executor_ = nullptr;  // serial if not set
+
   // logger
   utl::Logger* logger_ = nullptr;
 };
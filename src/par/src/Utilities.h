@@ -57,6 +57,8 @@
 #include <thread>
 #include <vector>
 
+#include "utl/Executor.h"
+
 namespace par {
 
 class TimingCuts
@@ -141,4 +143,19 @@ std::vector<float> abs(const std::vector<float>& a);
 float norm2(const std::vector<float>& a);
 
 float norm2(const std::vector<float>& a, const std::vector<float>& factor);
+
+// Run func(i) for i in [0, num_tasks) on the executor, or serially if there
+// is no executor.
+inline void TPparallelFor(utl::Executor* executor,
+                          int num_tasks,
+                          const std::function<void(int)>& func)
+{
+  if (executor == nullptr) {
+    for (int i = 0; i < num_tasks; ++i) {
+      func(i);
+    }
+    return;
+  }
+  executor->parallelFor(0, num_tasks, func);
+}
 }  // namespace par
@@ -42,6 +42,10 @@
 #include "odb/db.h"
 #include "utl/Logger.h"
 
+namespace utl {
+class Executor;
+}
+
 namespace pdn {
 
 using odb::dbBlock;
@@ -82,7 +86,9 @@ class PdnGen
   PdnGen();
   ~PdnGen();
 
-  void init(dbDatabase* db, Logger* logger);
+  void init(dbDatabase* db, Logger* logger, utl::Executor* executor);
+
+  utl::Executor* getExecutor() const { return executor_; }
 
   void reset();
   void resetShapes();
@@ -205,6 +211,7 @@ class PdnGen
 
   odb::dbDatabase* db_;
   utl::Logger* logger_;
+  utl::Executor* executor_ = nullptr;  // serial if not set
 
   std::unique_ptr<PDNRenderer> debug_renderer_;
 
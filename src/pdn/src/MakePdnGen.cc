@@ -67,7 +67,8 @@ void initPdnGen(OpenRoad* openroad)
   // Eval encoded sta TCL sources.
   sta::evalTclInit(interp, sta::pdn_tcl_inits);
 
-  openroad->getPdnGen()->init(openroad->getDb(), openroad->getLogger());
+  openroad->getPdnGen()->init(
+      openroad->getDb(), openroad->getLogger(), openroad->getExecutor());
 }
 
 pdn::PdnGen* makePdnGen()
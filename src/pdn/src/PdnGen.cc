@@ -71,10 +71,11 @@ PdnGen::PdnGen() : db_(nullptr), logger_(nullptr)
 
 PdnGen::~PdnGen() = default;
 
-void PdnGen::init(dbDatabase* db, Logger* logger)
+void PdnGen::init(dbDatabase* db, Logger* logger, utl::Executor* executor)
 {
   db_ = db;
   logger_ = logger;
+  executor_ = executor;
 }
 
 void PdnGen::reset()
@@ -93,6 +93,11 @@ VoltageDomain::VoltageDomain(PdnGen* pdngen,
   }
 }
 
+utl::Executor* VoltageDomain::getExecutor() const
+{
+  return pdngen_->getExecutor();
+}
+
 std::vector<odb::dbNet*> VoltageDomain::getNets(bool start_with_power) const
 {
   std::vector<odb::dbNet*> nets;
@@ -47,6 +47,7 @@ class Rect;
 }  // namespace odb
 
 namespace utl {
+class Executor;
 class Logger;
 }
 
@@ -77,6 +78,7 @@ class VoltageDomain
 
   odb::dbBlock* getBlock() const { return block_; }
   utl::Logger* getLogger() const { return logger_; }
+  utl::Executor* getExecutor() const;
 
   odb::dbNet* getPower() const;
   odb::dbNet* getGround() const { return ground_; }
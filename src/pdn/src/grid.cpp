@@ -42,6 +42,7 @@
 #include "rings.h"
 #include "straps.h"
 #include "techlayer.h"
+#include "utl/Executor.h"
 #include "utl/Logger.h"
 
 namespace pdn {
@@ -74,6 +75,11 @@ utl::Logger* Grid::getLogger() const
   return domain_->getLogger();
 }
 
+utl::Executor* Grid::getExecutor() const
+{
+  return domain_->getExecutor();
+}
+
 std::vector<odb::dbNet*> Grid::getNets(bool starts_with_power) const
 {
   return domain_->getNets(starts_with_power);
@@ -478,6 +484,17 @@ void Grid::getIntersections(std::vector<ViaPtr>& shape_intersections,
     comp->getConnectableShapes(shapes);
   }
 
+  // Every lower layer shape is searched on its own.  The intersections are
+  // gathered per shape and appended in order, so the vias do not depend on
+  // the number of threads.
+  struct LowerShapeSearch
+  {
+    Connect* connect;
+    const ShapeValue* lower;
+    const ShapeTree* upper_shapes;
+  };
+  std::vector<LowerShapeSearch> searches;
+
   // loop over connect statements
   for (const auto& connect : connect_) {
     odb::dbTechLayer* lower_layer = connect->getLowerLayer();
@@ -506,34 +523,46 @@ void Grid::getIntersections(std::vector<ViaPtr>& shape_intersections,
                upper_layer->getName(),
                upper_shapes.size());
 
-    // loop over lower layer shapes
-    for (const auto& [lower_box, lower_shape] : lower_shapes) {
-      auto* lower_net = lower_shape->getNet();
-      // check for intersections in higher layer shapes
-      for (auto it = upper_shapes.qbegin(
-               bgi::intersects(lower_box)
-               && bgi::satisfies([lower_net](const auto& other) {
-                    // not the same net, so ignore
-                    return lower_net == other.second->getNet();
-                  }));
-           it != upper_shapes.qend();
-           it++) {
-        const auto& upper_shape = it->second;
-        const odb::Rect via_rect
-            = lower_shape->getRect().intersect(upper_shape->getRect());
-        if (via_rect.area() == 0) {
-          // intersection did not overlap, so ignore
-          continue;
-        }
+    for (const auto& lower : lower_shapes) {
+      searches.push_back({connect.get(), &lower, &upper_shapes});
+    }
+  }
 
-        auto* via = new Via(connect.get(),
-                            lower_shape->getNet(),
-                            via_rect,
-                            lower_shape,
-                            upper_shape);
-        shape_intersections.push_back(ViaPtr(via));
+  std::vector<std::vector<ViaPtr>> intersections(searches.size());
+  auto find_intersections = [&searches, &intersections](int i) {
+    const LowerShapeSearch& search = searches[i];
+    const auto& [lower_box, lower_shape] = *search.lower;
+    auto* lower_net = lower_shape->getNet();
+    // check for intersections in higher layer shapes
+    for (auto it = search.upper_shapes->qbegin(
+             bgi::intersects(lower_box)
+             && bgi::satisfies([lower_net](const auto& other) {
+                  // not the same net, so ignore
+                  return lower_net == other.second->getNet();
+                }));
+         it != search.upper_shapes->qend();
+         it++) {
+      const auto& upper_shape = it->second;
+      const odb::Rect via_rect
+          = lower_shape->getRect().intersect(upper_shape->getRect());
+      if (via_rect.area() == 0) {
+        // intersection did not overlap, so ignore
+        continue;
       }
+
+      auto* via = new Via(search.connect,
+                          lower_shape->getNet(),
+                          via_rect,
+                          lower_shape,
+                          upper_shape);
+      intersections[i].push_back(ViaPtr(via));
     }
+  };
+  parallelFor(searches.size(), find_intersections);
+
+  for (const auto& shape_vias : intersections) {
+    shape_intersections.insert(
+        shape_intersections.end(), shape_vias.begin(), shape_vias.end());
   }
   debugPrint(getLogger(),
              utl::PDN,
@@ -543,6 +572,20 @@ void Grid::getIntersections(std::vector<ViaPtr>& shape_intersections,
              name_);
 }
 
+void Grid::parallelFor(const int count,
+                       const std::function<void(int)>& func) const
+{
+  utl::Executor* executor = getExecutor();
+  if (executor == nullptr) {
+    for (int i = 0; i < count; i++) {
+      func(i);
+    }
+    return;
+  }
+
+  executor->parallelFor(0, count, func);
+}
+
 void Grid::resetShapes()
 {
   vias_.clear();
@@ -707,16 +750,26 @@ void Grid::makeVias(const ShapeTreeMap& global_shapes,
 
   std::set<ViaPtr> remove_vias;
   // remove vias with obstructions in their stack
-  for (const auto& via : vias) {
+  std::vector<char> obstructed(vias.size(), false);
+  parallelFor(vias.size(), [&](int i) {
+    const ViaPtr& via = vias[i];
     for (auto* layer : via->getConnect()->getIntermediteLayers()) {
-      auto& search_obs = search_obstructions[layer];
-      if (search_obs.qbegin(bgi::intersects(via->getBox()))
-          != search_obs.qend()) {
-        remove_vias.insert(via);
-        via->markFailed(failedViaReason::OBSTRUCTED);
+      auto search_obs = search_obstructions.find(layer);
+      if (search_obs == search_obstructions.end()) {
+        continue;
+      }
+      if (search_obs->second.qbegin(bgi::intersects(via->getBox()))
+          != search_obs->second.qend()) {
+        obstructed[i] = true;
         break;
       }
     }
+  });
+  for (int i = 0; i < vias.size(); i++) {
+    if (obstructed[i]) {
+      remove_vias.insert(vias[i]);
+      vias[i]->markFailed(failedViaReason::OBSTRUCTED);
+    }
   }
   debugPrint(getLogger(),
              utl::PDN,
@@ -727,10 +780,13 @@ void Grid::makeVias(const ShapeTreeMap& global_shapes,
   remove_set_of_vias(remove_vias);
 
   // Remove overlapping vias and keep largest
-  ViaTree overlapping_via_tree;
+  std::vector<ViaValue> via_values;
+  via_values.reserve(vias.size());
   for (const auto& via : vias) {
-    overlapping_via_tree.insert({via->getBox(), via});
+    via_values.emplace_back(via->getBox(), via);
   }
+  // bulk load the tree, it is only used for existence queries
+  const ViaTree overlapping_via_tree(via_values);
   for (const auto& via : vias) {
     if (via->isFailed()) {
       continue;
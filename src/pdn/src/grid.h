@@ -33,6 +33,7 @@
 #pragma once
 
 #include <array>
+#include <functional>
 #include <map>
 #include <memory>
 #include <set>
@@ -54,6 +55,7 @@ class Rect;
 }  // namespace odb
 
 namespace utl {
+class Executor;
 class Logger;
 }  // namespace utl
 
@@ -96,6 +98,7 @@ class Grid
 
   odb::dbBlock* getBlock() const;
   utl::Logger* getLogger() const;
+  utl::Executor* getExecutor() const;
 
   virtual void addRing(std::unique_ptr<Rings> ring);
   virtual void addStrap(std::unique_ptr<Straps> strap);
@@ -202,6 +205,9 @@ class Grid
   virtual void getIntersections(std::vector<ViaPtr>& intersections,
                                 const ShapeTreeMap& shapes) const;
 
+  // run func(i) for i in [0, count) on the executor, serially if none
+  void parallelFor(int count, const std::function<void(int)>& func) const;
+
  private:
   VoltageDomain* domain_;
   std::string name_;
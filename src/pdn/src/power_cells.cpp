@@ -35,6 +35,7 @@
 #include "domain.h"
 #include "grid.h"
 #include "odb/db.h"
+#include "odb/dbSpatialIndex.h"
 #include "straps.h"
 #include "utl/Logger.h"
 
@@ -164,22 +165,6 @@ void GridSwitchedPower::report() const
   logger->report("  Network type: {}", toString(network_));
 }
 
-GridSwitchedPower::InstTree GridSwitchedPower::buildInstanceSearchTree() const
-{
-  InstTree exisiting_insts;
-  for (auto* inst : grid_->getBlock()->getInsts()) {
-    if (!inst->getPlacementStatus().isFixed()) {
-      continue;
-    }
-
-    odb::Rect bbox = inst->getBBox()->getBox();
-
-    exisiting_insts.insert({Shape::rectToBox(bbox), inst});
-  }
-
-  return exisiting_insts;
-}
-
 ShapeTree GridSwitchedPower::buildStrapTargetList(Straps* target) const
 {
   const odb::dbNet* alwayson = grid_->getDomain()->getAlwaysOnPower();
@@ -250,8 +235,6 @@ void GridSwitchedPower::build()
         utl::PDN, 220, "Unable to find a strap to connect power switched to.");
   }
 
-  const InstTree exisiting_insts = buildInstanceSearchTree();
-
   odb::dbNet* switched = grid_->getDomain()->getSwitchedPower();
   odb::dbNet* alwayson = grid_->getDomain()->getAlwaysOnPower();
   odb::dbNet* ground = grid_->getDomain()->getGround();
@@ -348,7 +331,7 @@ void GridSwitchedPower::build()
 
   updateControlNetwork();
 
-  checkAndFixOverlappingInsts(exisiting_insts);
+  checkAndFixOverlappingInsts();
 
   for (const auto& [inst, inst_info] : insts_) {
     inst->setPlacementStatus(odb::dbPlacementStatus::FIRM);
@@ -448,11 +431,11 @@ void GridSwitchedPower::updateControlNetworkDAISY(const bool order_by_x)
   }
 }
 
-void GridSwitchedPower::checkAndFixOverlappingInsts(const InstTree& insts)
+void GridSwitchedPower::checkAndFixOverlappingInsts()
 {
   // needs to check for bounds of the rows
   for (const auto& [inst, inst_info] : insts_) {
-    auto* overlapping = checkOverlappingInst(inst, insts);
+    auto* overlapping = checkOverlappingInst(inst);
     if (overlapping == nullptr) {
       continue;
     }
@@ -553,16 +536,18 @@ bool GridSwitchedPower::checkInstanceOverlap(odb::dbInst* inst0,
   return overlap.area() == 0;
 }
 
-odb::dbInst* GridSwitchedPower::checkOverlappingInst(
-    odb::dbInst* cell,
-    const InstTree& insts) const
+odb::dbInst* GridSwitchedPower::checkOverlappingInst(odb::dbInst* cell) const
 {
   odb::Rect bbox = cell->getBBox()->getBox();
 
-  for (auto itr = insts.qbegin(bgi::intersects(Shape::rectToBox(bbox)));
-       itr != insts.qend();
-       itr++) {
-    auto* other_inst = itr->second;
+  std::vector<odb::dbInst*> insts;
+  odb::dbSpatialIndex::get(grid_->getBlock())->findInsts(bbox, insts);
+  for (auto* other_inst : insts) {
+    // only fixed cells other than the power switches are obstacles
+    if (insts_.find(other_inst) != insts_.end()
+        || !other_inst->getPlacementStatus().isFixed()) {
+      continue;
+    }
     if (!checkInstanceOverlap(cell, other_inst)) {
       return other_inst;
     }
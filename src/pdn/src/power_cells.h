@@ -154,12 +154,8 @@ class GridSwitchedPower
                                  int site_width,
                                  const odb::Rect& corearea) const;
 
-  using InstValue = std::pair<Box, odb::dbInst*>;
-  using InstTree = bgi::rtree<InstValue, bgi::quadratic<16>>;
-  InstTree buildInstanceSearchTree() const;
-  odb::dbInst* checkOverlappingInst(odb::dbInst* cell,
-                                    const InstTree& insts) const;
-  void checkAndFixOverlappingInsts(const InstTree& insts);
+  odb::dbInst* checkOverlappingInst(odb::dbInst* cell) const;
+  void checkAndFixOverlappingInsts();
 
   ShapeTree buildStrapTargetList(Straps* target) const;
 
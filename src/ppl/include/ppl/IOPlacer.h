@@ -35,6 +35,7 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <set>
 #include <unordered_map>
@@ -44,6 +45,7 @@
 #include "ppl/Parameters.h"
 
 namespace utl {
+class Executor;
 class Logger;
 }
 
@@ -57,6 +59,7 @@ class dbTechLayer;
 
 namespace ppl {
 class Core;
+class HungarianMatching;
 class Interval;
 class IOPin;
 class Netlist;
@@ -110,7 +113,7 @@ class IOPlacer
  public:
   IOPlacer();
   ~IOPlacer();
-  void init(odb::dbDatabase* db, Logger* logger);
+  void init(odb::dbDatabase* db, Logger* logger, utl::Executor* executor);
   void clear();
   void clearConstraints();
   void run(bool random_mode);
@@ -200,6 +203,8 @@ class IOPlacer
                                          bool mirrored_only);
   int computeIONetsHPWL(Netlist* netlist);
   void findPinAssignment(std::vector<Section>& sections);
+  void forEachSection(std::vector<HungarianMatching>& hg_vec,
+                      const std::function<void(HungarianMatching&)>& func);
   void updateSlots();
   void excludeInterval(Interval interval);
 
@@ -243,6 +248,7 @@ class IOPlacer
   MirroredPins mirrored_pins_;
 
   Logger* logger_ = nullptr;
+  utl::Executor* executor_ = nullptr;  // serial if not set
   std::unique_ptr<Parameters> parms_;
   std::unique_ptr<Netlist> netlist_io_pins_;
   std::vector<Slot> slots_;
@@ -35,6 +35,7 @@
 
 #include "HungarianMatching.h"
 
+#include "SparseAssignment.h"
 #include "utl/Logger.h"
 
 namespace ppl {
@@ -66,15 +67,162 @@ HungarianMatching::HungarianMatching(const Section& section,
 
 void HungarianMatching::findAssignment()
 {
+  if (useSparseAssignment()) {
+    // Widen the candidate slots until every pin is assigned.
+    int candidate_count = sparse_candidate_count_;
+    while (candidate_count < non_blocked_slots_) {
+      if (findSparseAssignment(candidate_count)) {
+        return;
+      }
+      candidate_count *= 2;
+    }
+  }
   createMatrix();
   if (!hungarian_matrix_.empty()) {
     hungarian_solver_.solve(hungarian_matrix_, assignment_);
   }
 }
 
+bool HungarianMatching::useSparseAssignment() const
+{
+  return static_cast<int64_t>(non_blocked_slots_) * num_io_pins_
+             > sparse_matrix_size_
+         && non_blocked_slots_ > sparse_candidate_count_;
+}
+
+// Assign pins considering only the candidate_count cheapest slots of
+// each pin. Returns false if the candidates do not admit a complete
+// assignment.
+bool HungarianMatching::findSparseAssignment(int candidate_count)
+{
+  slot_rows_.clear();
+  for (int i = begin_slot_; i <= end_slot_; ++i) {
+    if (!slots_[i].blocked) {
+      slot_rows_.push_back(i);
+    }
+  }
+  const int num_rows = slot_rows_.size();
+
+  std::vector<int> pin_cols;
+  for (int idx : pin_indices_) {
+    if (!netlist_->getIoPin(idx).isInGroup()) {
+      pin_cols.push_back(idx);
+    }
+  }
+  const int num_cols = pin_cols.size();
+  if (num_cols > num_rows) {
+    return false;
+  }
+
+  SparseAssignment sparse(num_cols, num_rows);
+  std::vector<std::pair<int, int>> costs;
+  const int count = std::min(candidate_count, num_rows);
+  const bool on_line = slotsOnLine();
+  for (int col = 0; col < num_cols; col++) {
+    findCandidateSlots(pin_cols[col], count, on_line, costs);
+    for (const auto& [cost, row] : costs) {
+      sparse.addCandidate(col, row, cost);
+    }
+  }
+  if (!sparse.solve()) {
+    return false;
+  }
+
+  hungarian_matrix_.clear();
+  assignment_.assign(num_rows, -1);
+  assignment_costs_.resize(num_cols);
+  for (int col = 0; col < num_cols; col++) {
+    const int row = sparse.getSlot(col);
+    assignment_[row] = col;
+    assignment_costs_[col] = netlist_->computeIONetHPWL(
+        pin_cols[col], slots_[slot_rows_[row]].pos);
+  }
+  return true;
+}
+
+// True if the slot rows lie on a horizontal or vertical line in
+// monotone order, as they do for the slots of a section.
+bool HungarianMatching::slotsOnLine() const
+{
+  if (slot_rows_.size() < 2) {
+    return true;
+  }
+  const Point& first = slots_[slot_rows_.front()].pos;
+  const Point& last = slots_[slot_rows_.back()].pos;
+  const bool vertical = first.x() == last.x();
+  int prev = vertical ? first.y() : first.x();
+  const bool increasing
+      = vertical ? first.y() < last.y() : first.x() < last.x();
+  for (int row : slot_rows_) {
+    const Point& pos = slots_[row].pos;
+    const int curr = vertical ? pos.y() : pos.x();
+    if ((vertical ? pos.x() != first.x() : pos.y() != first.y())
+        || (increasing ? curr < prev : curr > prev)) {
+      return false;
+    }
+    prev = curr;
+  }
+  return true;
+}
+
+// Find the count cheapest slot rows of a pin as (cost, row) pairs.
+// Along a line of slots the net HPWL is convex, so the cheapest
+// slots are a window around the minimum, which is found with a
+// binary search. Slots off a line are all scanned.
+void HungarianMatching::findCandidateSlots(
+    int pin_idx,
+    int count,
+    bool on_line,
+    std::vector<std::pair<int, int>>& costs) const
+{
+  auto rowCost = [&](int row) {
+    return netlist_->computeIONetHPWL(pin_idx, slots_[slot_rows_[row]].pos);
+  };
+  const int num_rows = slot_rows_.size();
+  costs.clear();
+  if (!on_line) {
+    for (int row = 0; row < num_rows; row++) {
+      costs.emplace_back(rowCost(row), row);
+    }
+    std::nth_element(costs.begin(), costs.begin() + count - 1, costs.end());
+    costs.resize(count);
+    return;
+  }
+
+  // First row where the cost stops decreasing.
+  int lo = 0;
+  int hi = num_rows - 1;
+  while (lo < hi) {
+    const int mid = lo + (hi - lo) / 2;
+    if (rowCost(mid + 1) < rowCost(mid)) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+
+  costs.emplace_back(rowCost(lo), lo);
+  int left = lo - 1;
+  int right = lo + 1;
+  int left_cost = left >= 0 ? rowCost(left) : hungarian_fail;
+  int right_cost = right < num_rows ? rowCost(right) : hungarian_fail;
+  while (static_cast<int>(costs.size()) < count) {
+    if (right >= num_rows || (left >= 0 && left_cost <= right_cost)) {
+      costs.emplace_back(left_cost, left);
+      left--;
+      left_cost = left >= 0 ? rowCost(left) : hungarian_fail;
+    } else {
+      costs.emplace_back(right_cost, right);
+      right++;
+      right_cost = right < num_rows ? rowCost(right) : hungarian_fail;
+    }
+  }
+}
+
 void HungarianMatching::createMatrix()
 {
   hungarian_matrix_.resize(non_blocked_slots_);
+  slot_rows_.clear();
   int slot_index = 0;
   for (int i = begin_slot_; i <= end_slot_; ++i) {
     int pinIndex = 0;
@@ -82,6 +230,7 @@ void HungarianMatching::createMatrix()
     if (slots_[i].blocked) {
       continue;
     }
+    slot_rows_.push_back(i);
     hungarian_matrix_[slot_index].resize(num_io_pins_,
                                          std::numeric_limits<int>::max());
     for (int idx : pin_indices_) {
@@ -105,49 +254,53 @@ void HungarianMatching::getFinalAssignment(std::vector<IOPin>& assignment,
                                            MirroredPins& mirrored_pins,
                                            bool assign_mirrored)
 {
-  size_t rows = non_blocked_slots_;
+  // pin column -> slot row
+  std::vector<int> col_rows(num_io_pins_, -1);
+  for (int row = 0; row < assignment_.size(); row++) {
+    const int col = assignment_[row];
+    if (col >= 0 && col < num_io_pins_) {
+      col_rows[col] = row;
+    }
+  }
+
   size_t col = 0;
-  int slot_index = 0;
   for (int idx : pin_indices_) {
     IOPin& io_pin = netlist_->getIoPin(idx);
 
     if (!io_pin.isInGroup()) {
-      slot_index = begin_slot_;
-      for (size_t row = 0; row < rows; row++) {
-        while (slots_[slot_index].blocked && slot_index < slots_.size()) {
-          slot_index++;
-        }
-        if (assignment_[row] != col) {
-          slot_index++;
-          continue;
-        }
-        if (hungarian_matrix_[row][col] == hungarian_fail) {
-          logger_->warn(utl::PPL,
-                        33,
-                        "I/O pin {} cannot be placed in the specified region. "
-                        "Not enough space.",
-                        io_pin.getName().c_str());
-        }
+      const int row = col_rows[col];
+      col++;
+      if (row < 0) {
+        continue;
+      }
+      const int cost = hungarian_matrix_.empty()
+                           ? assignment_costs_[col - 1]
+                           : hungarian_matrix_[row][col - 1];
+      if (cost == hungarian_fail) {
+        logger_->warn(utl::PPL,
+                      33,
+                      "I/O pin {} cannot be placed in the specified region. "
+                      "Not enough space.",
+                      io_pin.getName().c_str());
+      }
 
-        // Make this check here to avoid messing up the correlation between the
-        // pin sorting and the hungarian matrix values
-        if ((assign_mirrored
-             && mirrored_pins.find(io_pin.getBTerm()) == mirrored_pins.end())
-            || io_pin.isPlaced()) {
-          continue;
-        }
-        io_pin.setPos(slots_[slot_index].pos);
-        io_pin.setLayer(slots_[slot_index].layer);
-        io_pin.setPlaced();
-        assignment.push_back(io_pin);
-        slots_[slot_index].used = true;
+      // Make this check here to avoid messing up the correlation between the
+      // pin sorting and the hungarian matrix values
+      if ((assign_mirrored
+           && mirrored_pins.find(io_pin.getBTerm()) == mirrored_pins.end())
+          || io_pin.isPlaced()) {
+        continue;
+      }
+      const int slot_index = slot_rows_[row];
+      io_pin.setPos(slots_[slot_index].pos);
+      io_pin.setLayer(slots_[slot_index].layer);
+      io_pin.setPlaced();
+      assignment.push_back(io_pin);
+      slots_[slot_index].used = true;
 
-        if (assign_mirrored) {
-          assignMirroredPins(io_pin, mirrored_pins, assignment);
-        }
-        break;
+      if (assign_mirrored) {
+        assignMirroredPins(io_pin, mirrored_pins, assignment);
       }
-      col++;
     } else if (assign_mirrored
                && mirrored_pins.find(io_pin.getBTerm())
                       != mirrored_pins.end()) {
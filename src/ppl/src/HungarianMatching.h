@@ -74,10 +74,18 @@ class HungarianMatching
                           MirroredPins& mirrored_pins,
                           bool assign_mirrored);
   void getAssignmentForGroups(std::vector<IOPin>& assignment);
+  // Sections with more slot/pin pairs than size use the sparse
+  // assignment instead of the dense munkres matrix.
+  void setSparseMatrixSize(int64_t size) { sparse_matrix_size_ = size; }
 
  private:
   std::vector<std::vector<int>> hungarian_matrix_;
+  // slot row -> pin column, -1 if the slot is unused
   std::vector<int> assignment_;
+  // slot row -> index in slots_
+  std::vector<int> slot_rows_;
+  // pin column -> cost of its slot for the sparse assignment
+  std::vector<int> assignment_costs_;
   HungarianAlgorithm hungarian_solver_;
   Netlist* netlist_;
   Core* core_;
@@ -94,10 +102,20 @@ class HungarianMatching
   int group_size_;
   Edge edge_;
   const int hungarian_fail = std::numeric_limits<int>::max();
+  int64_t sparse_matrix_size_ = 1000000;
+  // Initial number of candidate slots per pin for the sparse assignment.
+  static constexpr int sparse_candidate_count_ = 32;
   Logger* logger_;
   odb::dbDatabase* db_;
 
   void createMatrix();
+  bool useSparseAssignment() const;
+  bool findSparseAssignment(int candidate_count);
+  bool slotsOnLine() const;
+  void findCandidateSlots(int pin_idx,
+                          int count,
+                          bool on_line,
+                          std::vector<std::pair<int, int>>& costs) const;
   void createMatrixForGroups();
   void assignMirroredPins(IOPin& io_pin,
                           MirroredPins& mirrored_pins,
@@ -45,6 +45,7 @@
 #include "Slots.h"
 #include "odb/db.h"
 #include "ord/OpenRoad.hh"
+#include "utl/Executor.h"
 #include "utl/Logger.h"
 #include "utl/algorithms.h"
 
@@ -63,10 +64,13 @@ IOPlacer::IOPlacer()
 
 IOPlacer::~IOPlacer() = default;
 
-void IOPlacer::init(odb::dbDatabase* db, Logger* logger)
+void IOPlacer::init(odb::dbDatabase* db,
+                    Logger* logger,
+                    utl::Executor* executor)
 {
   db_ = db;
   logger_ = logger;
+  executor_ = executor;
   parms_ = std::make_unique<Parameters>();
 }
 
@@ -1336,17 +1340,19 @@ void IOPlacer::findPinAssignment(std::vector<Section>& sections)
     }
   }
 
-  for (auto& match : hg_vec) {
+  // The matchings of different sections only read the shared slots and
+  // netlist, so they are solved concurrently. Committing the results
+  // updates the slots and stays serial and in section order.
+  forEachSection(hg_vec, [](HungarianMatching& match) {
     match.findAssignmentForGroups();
-  }
+  });
 
   for (auto& match : hg_vec) {
     match.getAssignmentForGroups(assignment_);
   }
 
-  for (auto& match : hg_vec) {
-    match.findAssignment();
-  }
+  forEachSection(hg_vec,
+                 [](HungarianMatching& match) { match.findAssignment(); });
 
   if (!mirrored_pins_.empty()) {
     for (auto& match : hg_vec) {
@@ -1359,6 +1365,20 @@ void IOPlacer::findPinAssignment(std::vector<Section>& sections)
   }
 }
 
+void IOPlacer::forEachSection(
+    std::vector<HungarianMatching>& hg_vec,
+    const std::function<void(HungarianMatching&)>& func)
+{
+  if (executor_ == nullptr) {
+    for (auto& match : hg_vec) {
+      func(match);
+    }
+    return;
+  }
+
+  executor_->parallelFor(0, hg_vec.size(), [&](int i) { func(hg_vec[i]); });
+}
+
 void IOPlacer::updateSlots()
 {
   for (Slot& slot : slots_) {
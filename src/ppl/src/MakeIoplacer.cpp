@@ -67,7 +67,8 @@ void initIoplacer(OpenRoad* openroad)
   Ppl_Init(tcl_interp);
   sta::evalTclInit(tcl_interp, sta::ppl_tcl_inits);
 
-  openroad->getIOPlacer()->init(openroad->getDb(), openroad->getLogger());
+  openroad->getIOPlacer()->init(
+      openroad->getDb(), openroad->getLogger(), openroad->getExecutor());
 }
 
 }  // namespace ord
@@ -0,0 +1,163 @@
+/////////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "SparseAssignment.h"
+
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+
+namespace ppl {
+
+SparseAssignment::SparseAssignment(int num_pins, int num_slots)
+    : num_pins_(num_pins),
+      num_slots_(num_slots),
+      candidates_(num_pins),
+      pin_slot_(num_pins, -1),
+      slot_pin_(num_slots, -1),
+      pin_potential_(num_pins, 0),
+      slot_potential_(num_slots, 0),
+      dist_(num_slots, 0),
+      prev_pin_(num_slots, -1),
+      reached_(num_slots, 0),
+      finalized_(num_slots, 0)
+{
+}
+
+void SparseAssignment::addCandidate(int pin, int slot, int64_t cost)
+{
+  candidates_[pin].push_back({slot, cost});
+}
+
+bool SparseAssignment::solve()
+{
+  for (int pin = 0; pin < num_pins_; pin++) {
+    if (!augment(pin)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SparseAssignment::augment(int pin)
+{
+  const std::vector<Candidate>& root_candidates = candidates_[pin];
+  if (root_candidates.empty()) {
+    return false;
+  }
+  search_id_++;
+
+  // Make the reduced costs of the new pin's edges non-negative.
+  int64_t min_cost = std::numeric_limits<int64_t>::max();
+  for (const Candidate& cand : root_candidates) {
+    min_cost = std::min(min_cost, cand.cost - slot_potential_[cand.slot]);
+  }
+  pin_potential_[pin] = min_cost;
+
+  using DistSlot = std::pair<int64_t, int>;
+  std::priority_queue<DistSlot, std::vector<DistSlot>, std::greater<>> queue;
+  auto relax = [&](int from_pin, int slot, int64_t dist) {
+    if (finalized_[slot] == search_id_) {
+      return;
+    }
+    if (reached_[slot] != search_id_ || dist < dist_[slot]) {
+      reached_[slot] = search_id_;
+      dist_[slot] = dist;
+      prev_pin_[slot] = from_pin;
+      queue.emplace(dist, slot);
+    }
+  };
+
+  for (const Candidate& cand : root_candidates) {
+    relax(pin,
+          cand.slot,
+          cand.cost - pin_potential_[pin] - slot_potential_[cand.slot]);
+  }
+
+  std::vector<int> finalized_slots;
+  int free_slot = -1;
+  while (!queue.empty()) {
+    const auto [dist, slot] = queue.top();
+    queue.pop();
+    if (finalized_[slot] == search_id_ || dist > dist_[slot]) {
+      continue;
+    }
+    finalized_[slot] = search_id_;
+    finalized_slots.push_back(slot);
+    const int owner = slot_pin_[slot];
+    if (owner == -1) {
+      free_slot = slot;
+      break;
+    }
+    for (const Candidate& cand : candidates_[owner]) {
+      relax(owner,
+            cand.slot,
+            dist + cand.cost - pin_potential_[owner]
+                - slot_potential_[cand.slot]);
+    }
+  }
+  if (free_slot == -1) {
+    return false;
+  }
+
+  // Update potentials so the reduced costs stay non-negative and are
+  // zero along the augmenting path.
+  const int64_t path_dist = dist_[free_slot];
+  for (int slot : finalized_slots) {
+    const int64_t delta = path_dist - dist_[slot];
+    if (delta > 0) {
+      slot_potential_[slot] -= delta;
+      pin_potential_[slot_pin_[slot]] += delta;
+    }
+  }
+  pin_potential_[pin] += path_dist;
+
+  // Flip the matching along the path.
+  int slot = free_slot;
+  while (true) {
+    const int path_pin = prev_pin_[slot];
+    const int prev_slot = pin_slot_[path_pin];
+    pin_slot_[path_pin] = slot;
+    slot_pin_[slot] = path_pin;
+    if (path_pin == pin) {
+      break;
+    }
+    slot = prev_slot;
+  }
+  return true;
+}
+
+}  // namespace ppl
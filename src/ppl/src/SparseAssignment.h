@@ -0,0 +1,84 @@
+/////////////////////////////////////////////////////////////////////////////
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace ppl {
+
+// Min-cost assignment of pins to slots on a sparse cost graph where
+// each pin only has edges to a set of candidate slots (usually its k
+// cheapest). Pins are added one at a time along shortest augmenting
+// paths (Dijkstra on reduced costs), so the result is optimal for the
+// candidate graph. Memory is O(candidates) instead of O(pins * slots).
+class SparseAssignment
+{
+ public:
+  SparseAssignment(int num_pins, int num_slots);
+  void addCandidate(int pin, int slot, int64_t cost);
+  // Returns false if some pin cannot be assigned to one of its
+  // candidate slots.
+  bool solve();
+  // Slot assigned to pin or -1.
+  int getSlot(int pin) const { return pin_slot_[pin]; }
+
+ private:
+  struct Candidate
+  {
+    int slot;
+    int64_t cost;
+  };
+
+  bool augment(int pin);
+
+  int num_pins_;
+  int num_slots_;
+  std::vector<std::vector<Candidate>> candidates_;
+  std::vector<int> pin_slot_;
+  std::vector<int> slot_pin_;
+  // Dual potentials.
+  std::vector<int64_t> pin_potential_;
+  std::vector<int64_t> slot_potential_;
+  // Per search state, reset lazily with search_id_.
+  std::vector<int64_t> dist_;
+  std::vector<int> prev_pin_;
+  std::vector<int> reached_;
+  std::vector<int> finalized_;
+  int search_id_ = 0;
+};
+
+}  // namespace ppl
@@ -0,0 +1,114 @@
+#define BOOST_TEST_MODULE TestHungarianMatching
+
+#include <boost/test/included/unit_test.hpp>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "HungarianMatching.h"
+#include "Netlist.h"
+#include "Slots.h"
+#include "utl/Logger.h"
+
+namespace ppl {
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+constexpr int pin_count = 24;
+constexpr int slot_count = 400;
+
+// Nets of pin_count pins with 1-3 sinks each at random locations.
+void makeNetlist(Netlist& netlist)
+{
+  std::mt19937 rand(17);
+  std::uniform_int_distribution<int> rand_loc(0, 100000);
+  for (int i = 0; i < pin_count; i++) {
+    IOPin io_pin(nullptr,
+                 odb::Point(0, 0),
+                 Direction::input,
+                 odb::Point(0, 0),
+                 odb::Point(0, 0),
+                 odb::dbPlacementStatus::NONE);
+    std::vector<InstancePin> inst_pins;
+    for (int j = 0; j <= i % 3; j++) {
+      const odb::Point pos(rand_loc(rand), rand_loc(rand));
+      inst_pins.emplace_back("sink", pos);
+    }
+    netlist.addIONet(io_pin, inst_pins);
+  }
+}
+
+// Slots along the bottom edge with every 7th slot blocked.
+std::vector<Slot> makeSlots()
+{
+  std::vector<Slot> slots;
+  for (int i = 0; i < slot_count; i++) {
+    slots.push_back(
+        {i % 7 == 0, false, odb::Point(100 + i * 250, 0), 0, Edge::bottom});
+  }
+  return slots;
+}
+
+// Assign the pins with the given sparse matrix size and return the
+// pin positions.
+std::vector<odb::Point> assignPins(int64_t sparse_matrix_size)
+{
+  utl::Logger logger;
+  Netlist netlist;
+  makeNetlist(netlist);
+  std::vector<Slot> slots = makeSlots();
+
+  Section section;
+  for (int i = 0; i < pin_count; i++) {
+    section.pin_indices.push_back(i);
+  }
+  section.begin_slot = 0;
+  section.end_slot = slot_count - 1;
+  section.num_slots = 0;
+  for (const Slot& slot : slots) {
+    section.num_slots += slot.blocked ? 0 : 1;
+  }
+  section.edge = Edge::bottom;
+
+  HungarianMatching match(section, &netlist, nullptr, slots, &logger, nullptr);
+  match.setSparseMatrixSize(sparse_matrix_size);
+  match.findAssignment();
+  std::vector<IOPin> assignment;
+  MirroredPins mirrored_pins;
+  match.getFinalAssignment(assignment, mirrored_pins, false);
+  BOOST_TEST(assignment.size() == pin_count);
+
+  std::vector<odb::Point> positions;
+  for (int i = 0; i < pin_count; i++) {
+    positions.push_back(netlist.getIoPin(i).getPos());
+  }
+  return positions;
+}
+
+int totalHpwl(const std::vector<odb::Point>& positions)
+{
+  Netlist netlist;
+  makeNetlist(netlist);
+  int hpwl = 0;
+  for (int i = 0; i < pin_count; i++) {
+    hpwl += netlist.computeIONetHPWL(i, positions[i]);
+  }
+  return hpwl;
+}
+
+BOOST_AUTO_TEST_CASE(test_sparse_matches_dense)
+{
+  const std::vector<odb::Point> dense = assignPins(1000000);
+  // Force the sparse assignment.
+  const std::vector<odb::Point> sparse = assignPins(0);
+
+  std::set<odb::Point> slots_used(sparse.begin(), sparse.end());
+  BOOST_TEST(slots_used.size() == pin_count);
+  // Both are optimal; with fewer pins than candidates per pin the
+  // sparse assignment is optimal over all slots.
+  BOOST_TEST(totalHpwl(sparse) == totalHpwl(dense));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace ppl
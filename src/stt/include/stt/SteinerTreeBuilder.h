@@ -55,6 +55,10 @@ namespace gui {
 class Gui;
 }
 
+namespace utl {
+class Executor;
+}
+
 namespace stt {
 
 using utl::Logger;
@@ -83,7 +87,7 @@ class SteinerTreeBuilder
   SteinerTreeBuilder();
   ~SteinerTreeBuilder() = default;
 
-  void init(odb::dbDatabase* db, Logger* logger);
+  void init(odb::dbDatabase* db, Logger* logger, utl::Executor* executor);
 
   Tree makeSteinerTree(const std::vector<int>& x,
                        const std::vector<int>& y,
@@ -96,6 +100,16 @@ class SteinerTreeBuilder
                        const std::vector<int>& x,
                        const std::vector<int>& y,
                        int drvr_index);
+  // Build the trees of a batch of nets on the executor.
+  // Net i has pins xs[i], ys[i] and driver drvr_indices[i]. If nets is
+  // not empty the alpha of nets[i] is used as in
+  // makeSteinerTree(net, x, y, drvr_index). Trees are returned in the
+  // same order and do not depend on the thread count.
+  std::vector<Tree> makeSteinerTrees(
+      const std::vector<odb::dbNet*>& nets,
+      const std::vector<std::vector<int>>& xs,
+      const std::vector<std::vector<int>>& ys,
+      const std::vector<int>& drvr_indices);
   // API only for FastRoute, that requires the use of flutes in its
   // internal flute implementation
   Tree makeSteinerTree(const std::vector<int>& x,
@@ -112,6 +126,7 @@ class SteinerTreeBuilder
 
  private:
   int computeHPWL(odb::dbNet* net);
+  float netAlpha(odb::dbNet* net);
 
   const int flute_accuracy = 3;
   float alpha_;
@@ -121,6 +136,7 @@ class SteinerTreeBuilder
 
   Logger* logger_;
   odb::dbDatabase* db_;
+  utl::Executor* executor_;  // serial if not set
 };
 
 // Used by regressions.
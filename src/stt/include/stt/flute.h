@@ -58,6 +58,9 @@ using stt::Tree;
 #define FLUTE_D 9  // LUT is used for d <= FLUTE_D, FLUTE_D <= 9
 
 // User-Callable Functions
+// Build the LUT tables up to degree 8. Degree 9 is built on first use.
+// The tables are read only once built, so trees can be built concurrently.
+void readLUT();
 // Delete LUT tables for exit so they are not leaked.
 void deleteLUT();
 DTYPE flute_wl(int d,
@@ -35,6 +35,7 @@
 
 #include "stt/SteinerTreeBuilder.h"
 
+#include <algorithm>
 #include <map>
 #include <vector>
 
@@ -43,6 +44,7 @@
 #include "stt/LinesRenderer.h"
 #include "stt/flute.h"
 #include "stt/pd.h"
+#include "utl/Executor.h"
 
 namespace stt {
 
@@ -53,14 +55,19 @@ SteinerTreeBuilder::SteinerTreeBuilder()
       min_fanout_alpha_({0, -1}),
       min_hpwl_alpha_({0, -1}),
       logger_(nullptr),
-      db_(nullptr)
+      db_(nullptr),
+      executor_(nullptr)
 {
 }
 
-void SteinerTreeBuilder::init(odb::dbDatabase* db, Logger* logger)
+void SteinerTreeBuilder::init(odb::dbDatabase* db,
+                              Logger* logger,
+                              utl::Executor* executor)
 {
   db_ = db;
   logger_ = logger;
+  executor_ = executor;
+  flt::readLUT();
 }
 
 Tree SteinerTreeBuilder::makeSteinerTree(const std::vector<int>& x,
@@ -76,13 +83,19 @@ Tree SteinerTreeBuilder::makeSteinerTree(odb::dbNet* net,
                                          const std::vector<int>& x,
                                          const std::vector<int>& y,
                                          const int drvr_index)
+{
+  return makeSteinerTree(x, y, drvr_index, netAlpha(net));
+}
+
+float SteinerTreeBuilder::netAlpha(odb::dbNet* net)
 {
   float net_alpha = alpha_;
   int min_fanout = min_fanout_alpha_.first;
   int min_hpwl = min_hpwl_alpha_.first;
 
-  if (net_alpha_map_.find(net) != net_alpha_map_.end()) {
-    net_alpha = net_alpha_map_[net];
+  auto net_alpha_itr = net_alpha_map_.find(net);
+  if (net_alpha_itr != net_alpha_map_.end()) {
+    net_alpha = net_alpha_itr->second;
   } else if (min_hpwl > 0) {
     if (computeHPWL(net) >= min_hpwl) {
       net_alpha = min_hpwl_alpha_.second;
@@ -92,8 +105,30 @@ Tree SteinerTreeBuilder::makeSteinerTree(odb::dbNet* net,
       net_alpha = min_fanout_alpha_.second;
     }
   }
+  return net_alpha;
+}
 
-  return makeSteinerTree(x, y, drvr_index, net_alpha);
+std::vector<Tree> SteinerTreeBuilder::makeSteinerTrees(
+    const std::vector<odb::dbNet*>& nets,
+    const std::vector<std::vector<int>>& xs,
+    const std::vector<std::vector<int>>& ys,
+    const std::vector<int>& drvr_indices)
+{
+  const int net_count = xs.size();
+  std::vector<Tree> trees(net_count);
+
+  auto build_tree = [&](int i) {
+    const float alpha = nets.empty() ? alpha_ : netAlpha(nets[i]);
+    trees[i] = makeSteinerTree(xs[i], ys[i], drvr_indices[i], alpha);
+  };
+  if (executor_) {
+    executor_->parallelFor(0, net_count, build_tree);
+  } else {
+    for (int i = 0; i < net_count; i++) {
+      build_tree(i);
+    }
+  }
+  return trees;
 }
 
 Tree SteinerTreeBuilder::makeSteinerTree(const std::vector<int>& x,
@@ -51,6 +51,24 @@ utl::Logger* getLogger();
 
 using ord::getSteinerTreeBuilder;
 using odb::dbNet;
+
+static bool
+sameTree(const stt::Tree& tree1, const stt::Tree& tree2)
+{
+  if (tree1.deg != tree2.deg || tree1.length != tree2.length
+      || tree1.branchCount() != tree2.branchCount()) {
+    return false;
+  }
+  for (int i = 0; i < tree1.branchCount(); i++) {
+    const stt::Branch& branch1 = tree1.branch[i];
+    const stt::Branch& branch2 = tree2.branch[i];
+    if (branch1.x != branch2.x || branch1.y != branch2.y
+        || branch1.n != branch2.n) {
+      return false;
+    }
+  }
+  return true;
+}
 %}
 
 %include "../../Exception.i"
@@ -122,6 +140,38 @@ report_stt_tree(std::vector<int> x,
   stt::reportSteinerTree(tree, x[drvr_index], y[drvr_index], logger);
 }
 
+// Net i has pin_counts[i] consecutive pins in x and y.  Returns the
+// number of nets whose tree from makeSteinerTrees differs from the one
+// built by makeSteinerTree.
+int
+check_stt_trees(std::vector<int> x,
+                std::vector<int> y,
+                std::vector<int> pin_counts,
+                std::vector<int> drvr_indices)
+{
+  auto builder = getSteinerTreeBuilder();
+
+  std::vector<std::vector<int>> xs;
+  std::vector<std::vector<int>> ys;
+  int pin = 0;
+  for (int pin_count : pin_counts) {
+    xs.emplace_back(x.begin() + pin, x.begin() + pin + pin_count);
+    ys.emplace_back(y.begin() + pin, y.begin() + pin + pin_count);
+    pin += pin_count;
+  }
+
+  std::vector<stt::Tree> trees
+    = builder->makeSteinerTrees({}, xs, ys, drvr_indices);
+  int diff_count = 0;
+  for (size_t i = 0; i < trees.size(); i++) {
+    auto tree = builder->makeSteinerTree(xs[i], ys[i], drvr_indices[i]);
+    if (!sameTree(trees[i], tree)) {
+      diff_count++;
+    }
+  }
+  return diff_count;
+}
+
 void
 highlight_stt_tree(std::vector<int> x,
                    std::vector<int> y,
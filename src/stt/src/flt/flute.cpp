@@ -39,21 +39,9 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <mutex>
 #include <string>
 
-// Use flute LUT file reader.
-#define LUT_FILE 1
-// Init LUTs from base64 encoded string variables.
-#define LUT_VAR 2
-// Init LUTs from base64 encoded string variables
-// and check against LUTs from file reader.
-#define LUT_VAR_CHECK 3
-
-// Set this to LUT_FILE, LUT_VAR, or LUT_VAR_CHECK.
-//#define LUT_SOURCE LUT_FILE
-//#define LUT_SOURCE LUT_VAR_CHECK
-#define LUT_SOURCE LUT_VAR
-
 namespace stt {
 
 namespace flt {
@@ -68,7 +56,7 @@ namespace flt {
 #define MGROUP 362880 / 4  // Max. # of groups, 9! = 362880
 #define MPOWV 79           // Max. # of POWVs per group
 #endif
-int numgrp[10] = {0, 0, 0, 0, 6, 30, 180, 1260, 10080, 90720};
+static const int numgrp[10] = {0, 0, 0, 0, 6, 30, 180, 1260, 10080, 90720};
 
 struct csoln
 {
@@ -78,15 +66,18 @@ struct csoln
   unsigned char neighbor[2 * FLUTE_D - 2];
 };
 
-// struct csoln *LUT[FLUTE_D + 1][MGROUP];  // storing 4 .. FLUTE_D
-// int numsoln[FLUTE_D + 1][MGROUP];
-
-using LUT_TYPE = struct csoln***;
-using NUMSOLN_TYPE = int**;
+// LUT of one degree. The solutions of all groups are stored contiguously;
+// groups that are the same as a previous group share its solutions.
+// The tables are built once and are read only afterwards, so any number
+// of threads can build trees concurrently.
+struct DegreeLUT
+{
+  std::vector<struct csoln> solns;
+  std::vector<int> group_soln;  // group -> index of its first solution
+  std::vector<int> numsoln;     // group -> solution count
+};
 
-// Dynamically allocate LUTs.
-LUT_TYPE LUT = nullptr;
-NUMSOLN_TYPE numsoln;
+static DegreeLUT LUT[FLUTE_D + 1];  // storing 4 .. FLUTE_D
 
 struct point
 {
@@ -110,163 +101,45 @@ inline T ADIFF(T x, T y)
 
 ////////////////////////////////////////////////////////////////
 
-#if LUT_SOURCE == LUT_FILE || LUT_SOURCE == LUT_VAR_CHECK
-static void readLUTfiles(LUT_TYPE LUT, NUMSOLN_TYPE numsoln)
-{
-  unsigned char charnum[256], line[32], *linep, c;
-  FILE *fpwv, *fprt;
-  struct csoln* p;
-  int d, i, j, k, kk, ns, nn;
-
-  for (i = 0; i <= 255; i++) {
-    if ('0' <= i && i <= '9')
-      charnum[i] = i - '0';
-    else if (i >= 'A')
-      charnum[i] = i - 'A' + 10;
-    else  // if (i=='$' || i=='\n' || ... )
-      charnum[i] = 0;
-  }
-
-  fpwv = fopen(FLUTE_POWVFILE, "r");
-  if (fpwv == NULL) {
-    printf("Error in opening %s\n", FLUTE_POWVFILE);
-    exit(1);
-  }
-
-#if FLUTE_ROUTING == 1
-  fprt = fopen(FLUTE_POSTFILE, "r");
-  if (fprt == NULL) {
-    printf("Error in opening %s\n", FLUTE_POSTFILE);
-    exit(1);
-  }
-#endif
-
-  for (d = 4; d <= FLUTE_D; d++) {
-    fscanf(fpwv, "d=%d", &d);
-    fgetc(fpwv);  // '/n'
-#if FLUTE_ROUTING == 1
-    fscanf(fprt, "d=%d", &d);
-    fgetc(fprt);  // '/n'
-#endif
-    for (k = 0; k < numgrp[d]; k++) {
-      ns = (int) charnum[fgetc(fpwv)];
-
-      if (ns == 0) {  // same as some previous group
-        fscanf(fpwv, "%d", &kk);
-        fgetc(fpwv);  // '/n'
-        numsoln[d][k] = numsoln[d][kk];
-        LUT[d][k] = LUT[d][kk];
-      } else {
-        fgetc(fpwv);  // '\n'
-        numsoln[d][k] = ns;
-        p = (struct csoln*) malloc(ns * sizeof(struct csoln));
-        LUT[d][k] = p;
-        for (i = 1; i <= ns; i++) {
-          linep = (unsigned char*) fgets((char*) line, 32, fpwv);
-          p->parent = charnum[*(linep++)];
-          j = 0;
-          while ((p->seg[j++] = charnum[*(linep++)]) != 0)
-            ;
-          j = 10;
-          while ((p->seg[j--] = charnum[*(linep++)]) != 0)
-            ;
-#if FLUTE_ROUTING == 1
-          nn = 2 * d - 2;
-          fread(line, 1, d - 2, fprt);
-          linep = line;
-          for (j = d; j < nn; j++) {
-            c = charnum[*(linep++)];
-            p->rowcol[j - d] = c;
-          }
-          fread(line, 1, nn / 2 + 1, fprt);
-          linep = line;  // last char \n
-          for (j = 0; j < nn;) {
-            c = *(linep++);
-            p->neighbor[j++] = c / 16;
-            p->neighbor[j++] = c % 16;
-          }
-#endif
-          p++;
-        }
-      }
-    }
-  }
-  fclose(fpwv);
-#if FLUTE_ROUTING == 1
-  fclose(fprt);
-#endif
-}
-#endif
-
-////////////////////////////////////////////////////////////////
-
-static void readLUT();
-static void makeLUT(LUT_TYPE& LUT, NUMSOLN_TYPE& numsoln);
-static void deleteLUT(LUT_TYPE& LUT, NUMSOLN_TYPE& numsoln);
-static void initLUT(int to_d, LUT_TYPE LUT, NUMSOLN_TYPE numsoln);
+static void initLUT(int from_d, int to_d);
 static void ensureLUT(int d);
 static std::string base64_decode(std::string const& encoded_string);
-#if LUT_SOURCE == LUT_VAR_CHECK
-static void checkLUT(LUT_TYPE LUT1,
-                     NUMSOLN_TYPE numsoln1,
-                     LUT_TYPE LUT2,
-                     NUMSOLN_TYPE numsoln2);
-#endif
 
-// LUTs are initialized to this order at startup.
+// LUTs are initialized to this order at startup because d=9 is big and
+// slow. Each stage is built exactly once.
 static constexpr int lut_initial_d = 8;
-static int lut_valid_d = 0;
+static std::once_flag lut_initial_once;
+static std::once_flag lut_full_once;
 
 extern std::string post9;
 extern std::string powv9;
 
-static void readLUT()
+void readLUT()
 {
-  makeLUT(LUT, numsoln);
-
-#if LUT_SOURCE == LUT_FILE
-  readLUTfiles(LUT, numsoln);
-  lut_valid_d = FLUTE_D;
-
-#elif LUT_SOURCE == LUT_VAR
-  // Only init to d=8 on startup because d=9 is big and slow.
-  initLUT(lut_initial_d, LUT, numsoln);
-
-#elif LUT_SOURCE == LUT_VAR_CHECK
-  readLUTfiles(LUT, numsoln);
-  // Temporaries to compare to file results.
-  LUT_TYPE LUT_;
-  NUMSOLN_TYPE numsoln_;
-  makeLUT(LUT_, numsoln_);
-  initLUT(FLUTE_D, LUT_, numsoln_);
-  checkLUT(LUT, numsoln, LUT_, numsoln_);
-#endif
+  std::call_once(lut_initial_once, initLUT, 4, lut_initial_d);
 }
 
-static void makeLUT(LUT_TYPE& LUT, NUMSOLN_TYPE& numsoln)
+static void ensureLUT(int d)
 {
-  LUT = new struct csoln**[FLUTE_D + 1];
-  numsoln = new int*[FLUTE_D + 1];
-  for (int d = 4; d <= FLUTE_D; d++) {
-    LUT[d] = new struct csoln*[MGROUP];
-    numsoln[d] = new int[MGROUP];
+  if (d <= lut_initial_d) {
+    readLUT();
+  } else if (d <= FLUTE_D) {
+    std::call_once(lut_full_once, initLUT, lut_initial_d + 1, FLUTE_D);
   }
 }
 
-void deleteLUT()
+// Solutions of group k of degree d.
+static const struct csoln* lutSolutions(int d, int k, int& numsoln)
 {
-  deleteLUT(LUT, numsoln);
+  const DegreeLUT& lut = LUT[d];
+  numsoln = lut.numsoln[k];
+  return &lut.solns[lut.group_soln[k]];
 }
 
-static void deleteLUT(LUT_TYPE& LUT, NUMSOLN_TYPE& numsoln)
+void deleteLUT()
 {
-  if (LUT) {
-    for (int d = 4; d <= FLUTE_D; d++) {
-      delete[] LUT[d];
-      delete[] numsoln[d];
-    }
-    delete[] numsoln;
-    delete[] LUT;
+  for (DegreeLUT& lut : LUT) {
+    lut = DegreeLUT();
   }
 }
 
@@ -281,8 +154,9 @@ static unsigned char charNum(unsigned char c)
   return 0;
 }
 
-// Init LUTs from base64 encoded string variables.
-static void initLUT(int to_d, LUT_TYPE LUT, NUMSOLN_TYPE numsoln)
+// Init the LUTs of degrees from_d..to_d from the base64 encoded string
+// variables. Lower degrees are parsed and skipped.
+static void initLUT(int from_d, int to_d)
 {
   std::string pwv_string = base64_decode(powv9);
   const char* pwv = pwv_string.c_str();
@@ -300,20 +174,31 @@ static void initLUT(int to_d, LUT_TYPE LUT, NUMSOLN_TYPE numsoln)
     sscanf(prt, "d=%d%n", &d, &char_cnt);
     prt += char_cnt + 1;
 #endif
+    const bool keep = d >= from_d;
+    DegreeLUT& lut = LUT[d];
+    if (keep) {
+      lut.group_soln.resize(numgrp[d]);
+      lut.numsoln.resize(numgrp[d]);
+    }
     for (int k = 0; k < numgrp[d]; k++) {
       int ns = charNum(*pwv++);
       if (ns == 0) {  // same as some previous group
         int kk;
         sscanf(pwv, "%d%n", &kk, &char_cnt);
         pwv += char_cnt + 1;
-        numsoln[d][k] = numsoln[d][kk];
-        LUT[d][k] = LUT[d][kk];
+        if (keep) {
+          lut.numsoln[k] = lut.numsoln[kk];
+          lut.group_soln[k] = lut.group_soln[kk];
+        }
       } else {
         pwv++;  // '\n'
-        numsoln[d][k] = ns;
-        struct csoln* p = new struct csoln[ns];
-        LUT[d][k] = p;
+        if (keep) {
+          lut.numsoln[k] = ns;
+          lut.group_soln[k] = lut.solns.size();
+        }
         for (int i = 1; i <= ns; i++) {
+          struct csoln soln = {};
+          struct csoln* p = &soln;
           p->parent = charNum(*pwv++);
 
           int j = 0;
@@ -348,61 +233,17 @@ static void initLUT(int to_d, LUT_TYPE LUT, NUMSOLN_TYPE numsoln)
           }
           prt++;  // \n
 #endif
-          p++;
+          if (keep) {
+            lut.solns.push_back(soln);
+          }
         }
       }
     }
-  }
-  lut_valid_d = to_d;
-}
-
-static void ensureLUT(int d)
-{
-  if (LUT == nullptr) {
-    readLUT();
-  }
-  if (d > lut_valid_d && d <= FLUTE_D) {
-    initLUT(FLUTE_D, LUT, numsoln);
-  }
-}
-
-#if LUT_SOURCE == LUT_VAR_CHECK
-static void checkLUT(LUT_TYPE LUT1,
-                     NUMSOLN_TYPE numsoln1,
-                     LUT_TYPE LUT2,
-                     NUMSOLN_TYPE numsoln2)
-{
-  for (int d = 4; d <= FLUTE_D; d++) {
-    for (int k = 0; k < numgrp[d]; k++) {
-      int ns1 = numsoln1[d][k];
-      int ns2 = numsoln2[d][k];
-      if (ns1 != ns2)
-        printf("numsoln[%d][%d] mismatch\n", d, k);
-      struct csoln* soln1 = LUT1[d][k];
-      struct csoln* soln2 = LUT2[d][k];
-      if (soln1->parent != soln2->parent)
-        printf("LUT[%d][%d]->parent mismatch\n", d, k);
-      for (int j = 0; soln1->seg[j] != 0; j++) {
-        if (soln1->seg[j] != soln2->seg[j])
-          printf("LUT[%d][%d]->seg[%d] mismatch\n", d, k, j);
-      }
-      for (int j = 10; soln1->seg[j] != 0; j--) {
-        if (soln1->seg[j] != soln2->seg[j])
-          printf("LUT[%d][%d]->seg[%d] mismatch\n", d, k, j);
-      }
-      int nn = 2 * d - 2;
-      for (int j = d; j < nn; j++) {
-        if (soln1->rowcol[j - d] != soln2->rowcol[j - d])
-          printf("LUT[%d][%d]->rowcol[%d] mismatch\n", d, k, j);
-      }
-      for (int j = 0; j < nn; j++) {
-        if (soln1->neighbor[j] != soln2->neighbor[j])
-          printf("LUT[%d][%d]->neighbor[%d] mismatch\n", d, k, j);
-      }
+    if (keep) {
+      lut.solns.shrink_to_fit();
     }
   }
 }
-#endif
 
 /*
    base64.cpp and base64.h
@@ -652,7 +493,8 @@ DTYPE flutes_wl_LD(int d,
                    const std::vector<int>& s)
 {
   int k, pi, i, j;
-  struct csoln* rlist;
+  const struct csoln* rlist;
+  int numsoln;
   DTYPE dd[2 * FLUTE_D - 2];  // 0..FLUTE_D-2 for v, FLUTE_D-1..2*D-3 for h
   DTYPE minl, sum, l[MPOWV + 1];
 
@@ -693,14 +535,14 @@ DTYPE flutes_wl_LD(int d,
     }
 
     minl = l[0] = xs[d - 1] - xs[0] + ys[d - 1] - ys[0];
-    rlist = LUT[d][k];
+    rlist = lutSolutions(d, k, numsoln);
     for (i = 0; rlist->seg[i] > 0; i++) {
       minl += dd[rlist->seg[i]];
     }
 
     l[1] = minl;
     j = 2;
-    while (j <= numsoln[d][k]) {
+    while (j <= numsoln) {
       rlist++;
       sum = l[rlist->parent];
       for (i = 0; rlist->seg[i] > 0; i++) {
@@ -1188,7 +1030,8 @@ Tree flutes_LD(int d,
                const std::vector<int>& s)
 {
   int k, pi, i, j;
-  struct csoln *rlist, *bestrlist;
+  const struct csoln *rlist, *bestrlist;
+  int numsoln;
   DTYPE dd[2 * FLUTE_D - 2];  // 0..D-2 for v, D-1..2*D-3 for h
   DTYPE minl, sum, l[MPOWV + 1];
   int hflip;
@@ -1255,14 +1098,14 @@ Tree flutes_LD(int d,
     }
 
     minl = l[0] = xs[d - 1] - xs[0] + ys[d - 1] - ys[0];
-    rlist = LUT[d][k];
+    rlist = lutSolutions(d, k, numsoln);
     for (i = 0; rlist->seg[i] > 0; i++) {
       minl += dd[rlist->seg[i]];
     }
     bestrlist = rlist;
     l[1] = minl;
     j = 2;
-    while (j <= numsoln[d][k]) {
+    while (j <= numsoln) {
       rlist++;
       sum = l[rlist->parent];
       for (i = 0; rlist->seg[i] > 0; i++) {
@@ -7,3 +7,7 @@ record_tests {
   pd2
   pd_gcd
 }
+
+record_pass_fail_tests {
+  stt_batch_gcd
+}
@@ -0,0 +1,30 @@
+# batched trees match per-net trees for gcd
+source "stt_helpers.tcl"
+
+set_thread_count 4
+
+set xs {}
+set ys {}
+set pin_counts {}
+set drvr_indices {}
+foreach net [read_nets "gcd.nets"] {
+  set pins [lassign $net net_name drvr_index]
+  lappend pin_counts [llength $pins]
+  lappend drvr_indices $drvr_index
+  foreach pin $pins {
+    lassign $pin pin_name x y
+    lappend xs $x
+    lappend ys $y
+  }
+}
+
+foreach alpha {0.0 0.8} {
+  set_routing_alpha $alpha
+  set diff_count [stt::check_stt_trees $xs $ys $pin_counts $drvr_indices]
+  if { $diff_count != 0 } {
+    puts "fail: $diff_count trees differ for alpha $alpha"
+    exit 1
+  }
+}
+
+puts "pass"
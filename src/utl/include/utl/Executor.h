@@ -0,0 +1,163 @@
+/////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// BSD 3-Clause License
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace utl {
+
+class TaskGroup;
+
+// Process wide pool of worker threads shared by all the tools.  It is owned
+// by ord::OpenRoad and sized by set_thread_count so that nested parallel
+// regions of different tools never oversubscribe the machine.
+//
+// Work is submitted through a TaskGroup (or parallelFor, which uses one).
+// Each worker has its own task deque: tasks spawned by a worker go to the
+// back of its deque and it takes them back newest first, while idle
+// workers steal the oldest tasks from the front of the other deques.
+// Tasks from other threads go to one more deque that every worker steals
+// from.  A thread waiting for a group runs the queued tasks of that group
+// itself, so a task may start and wait for nested groups without
+// deadlocking the pool.
+class Executor
+{
+ public:
+  // num_threads counts the calling thread, i.e. num_threads - 1 workers
+  // are spawned.
+  explicit Executor(int num_threads = 1);
+  ~Executor();
+
+  Executor(const Executor&) = delete;
+  Executor& operator=(const Executor&) = delete;
+
+  // Must not be called while tasks are running.
+  void setNumThreads(int num_threads);
+  int getNumThreads() const;
+
+  // Run func(i) for every i in [begin, end) and wait for all of them.
+  // Threads take the next index as they finish the previous one, so uneven
+  // iterations balance out.  At most max_threads threads take part if it
+  // is positive.  The first exception thrown by func is rethrown once
+  // every started iteration has finished.
+  void parallelFor(int begin,
+                   int end,
+                   const std::function<void(int)>& func,
+                   int max_threads = 0);
+
+ private:
+  struct Group
+  {
+    std::atomic<int> pending{0};  // not finished yet
+    std::atomic<int> queued{0};   // not started yet
+    std::atomic<bool> canceled{false};
+    std::atomic<bool> waiting{false};
+    std::exception_ptr error;  // guarded by mutex_
+  };
+
+  struct Task
+  {
+    Group* group = nullptr;
+    std::function<void()> func;
+  };
+
+  struct Queue
+  {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  void startWorkers(int num_workers);
+  void stopWorkers();
+  // Queue of the calling thread.
+  int queueIndex() const;
+  void submit(Group* group, std::function<void()> func);
+  void wait(Group* group);
+  // Take a queued task, only of group if it is not null.  Returns false if
+  // there is none.
+  bool popTask(Group* group, Task& task);
+  void runTask(Task& task);
+  void workerLoop(int index);
+
+  std::vector<std::thread> workers_;
+  // One queue per worker and a last one for the other threads.
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::atomic<int> queued_{0};
+  // Guards sleeping and waking up; the queues have their own locks.
+  std::mutex mutex_;
+  std::condition_variable work_cv_;
+  std::condition_variable done_cv_;
+  bool stop_ = false;
+
+  friend class TaskGroup;
+};
+// A set of tasks run on an Executor that can be waited for and canceled.
+// With a null executor, or one with a single thread, run() executes the
+// task immediately on the calling thread.
+class TaskGroup
+{
+ public:
+  explicit TaskGroup(Executor* executor);
+  // Waits for the tasks still running; exceptions are dropped.
+  ~TaskGroup();
+
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+
+  void run(std::function<void()> task);
+  // Wait for all the tasks.  The first exception thrown by a task cancels
+  // the group and is rethrown here.
+  void wait();
+
+  // Tasks that have not started yet are skipped.  Running tasks can poll
+  // isCanceled() to stop early.
+  void cancel();
+  bool isCanceled() const;
+
+ private:
+  Executor* executor_;
+  Executor::Group group_;
+};
+
+}  // namespace utl
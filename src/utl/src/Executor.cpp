@@ -0,0 +1,319 @@
+/////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// BSD 3-Clause License
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "utl/Executor.h"
+
+#include <algorithm>
+
+namespace utl {
+
+namespace {
+
+// The executor whose worker runs on this thread and the worker's queue.
+struct WorkerSlot
+{
+  const Executor* executor = nullptr;
+  int index = -1;
+};
+
+thread_local WorkerSlot current_worker;
+
+}  // namespace
+
+Executor::Executor(int num_threads)
+{
+  startWorkers(std::max(num_threads, 1) - 1);
+}
+
+Executor::~Executor()
+{
+  stopWorkers();
+}
+
+void Executor::setNumThreads(int num_threads)
+{
+  const int num_workers = std::max(num_threads, 1) - 1;
+  if (num_workers == static_cast<int>(workers_.size())) {
+    return;
+  }
+  stopWorkers();
+  startWorkers(num_workers);
+}
+
+int Executor::getNumThreads() const
+{
+  return static_cast<int>(workers_.size()) + 1;
+}
+
+void Executor::startWorkers(int num_workers)
+{
+  stop_ = false;
+  queues_.clear();
+  for (int i = 0; i <= num_workers; i++) {
+    queues_.push_back(std::make_unique<Queue>());
+  }
+  workers_.reserve(num_workers);
+  for (int i = 0; i < num_workers; i++) {
+    workers_.emplace_back(&Executor::workerLoop, this, i);
+  }
+}
+
+void Executor::stopWorkers()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  work_cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+  workers_.clear();
+}
+
+void Executor::parallelFor(int begin,
+                           int end,
+                           const std::function<void(int)>& func,
+                           int max_threads)
+{
+  const int count = end - begin;
+  if (count <= 0) {
+    return;
+  }
+  int num_threads = getNumThreads();
+  if (max_threads > 0) {
+    num_threads = std::min(num_threads, max_threads);
+  }
+  if (num_threads == 1 || count == 1) {
+    for (int i = begin; i < end; i++) {
+      func(i);
+    }
+    return;
+  }
+
+  // One task per thread; each takes the next index until none are left.
+  std::atomic<int> next = begin;
+  TaskGroup group(this);
+  for (int t = std::min(count, num_threads); t > 0; t--) {
+    group.run([&func, &group, &next, end] {
+      for (int i = next++; i < end && !group.isCanceled(); i = next++) {
+        func(i);
+      }
+    });
+  }
+  group.wait();
+}
+
+int Executor::queueIndex() const
+{
+  if (current_worker.executor == this) {
+    return current_worker.index;
+  }
+  return static_cast<int>(queues_.size()) - 1;
+}
+
+void Executor::submit(Group* group, std::function<void()> func)
+{
+  // Counted before the task is visible so that it is never finished
+  // before it is counted.
+  group->pending++;
+  group->queued++;
+  queued_++;
+  {
+    Queue& queue = *queues_[queueIndex()];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back({group, std::move(func)});
+  }
+  {
+    // Pairs with the predicate checks of the sleeping threads.
+    std::lock_guard<std::mutex> lock(mutex_);
+  }
+  work_cv_.notify_one();
+  if (group->waiting) {
+    done_cv_.notify_all();
+  }
+}
+
+bool Executor::popTask(Group* group, Task& task)
+{
+  auto matches
+      = [group](const Task& t) { return group == nullptr || t.group == group; };
+  const int num_queues = static_cast<int>(queues_.size());
+  const int self = queueIndex();
+
+  // Our own queue newest first: those tasks were spawned last by this
+  // thread and their data is likely still in its cache.
+  {
+    Queue& queue = *queues_[self];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    auto it = std::find_if(queue.tasks.rbegin(), queue.tasks.rend(), matches);
+    if (it != queue.tasks.rend()) {
+      task = std::move(*it);
+      queue.tasks.erase(std::next(it).base());
+      task.group->queued--;
+      queued_--;
+      return true;
+    }
+  }
+
+  // Steal the oldest task of another queue.  Start after our own so that
+  // the thieves spread over the victims.
+  for (int i = 1; i < num_queues; i++) {
+    Queue& queue = *queues_[(self + i) % num_queues];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    auto it = std::find_if(queue.tasks.begin(), queue.tasks.end(), matches);
+    if (it != queue.tasks.end()) {
+      task = std::move(*it);
+      queue.tasks.erase(it);
+      task.group->queued--;
+      queued_--;
+      return true;
+    }
+  }
+  return false;
+}
+
+void Executor::runTask(Task& task)
+{
+  Group* group = task.group;
+  if (!group->canceled) {
+    try {
+      task.func();
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!group->error) {
+        group->error = std::current_exception();
+      }
+      group->canceled = true;
+    }
+  }
+  // Release what the task captured before its group may go away.
+  task.func = nullptr;
+  if (--group->pending == 0) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    done_cv_.notify_all();
+  }
+}
+
+void Executor::wait(Group* group)
+{
+  Task task;
+  while (group->pending > 0) {
+    // Help with our own tasks instead of blocking a thread of the pool.
+    if (popTask(group, task)) {
+      runTask(task);
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    group->waiting = true;
+    done_cv_.wait(lock, [group] {
+      return group->pending == 0 || group->queued > 0;
+    });
+    group->waiting = false;
+  }
+}
+
+void Executor::workerLoop(int index)
+{
+  current_worker = {this, index};
+  Task task;
+  while (true) {
+    if (popTask(nullptr, task)) {
+      runTask(task);
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    work_cv_.wait(lock, [this] { return stop_ || queued_ > 0; });
+    if (stop_) {
+      return;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////
+
+TaskGroup::TaskGroup(Executor* executor) : executor_(executor)
+{
+}
+
+TaskGroup::~TaskGroup()
+{
+  if (executor_ != nullptr) {
+    cancel();
+    executor_->wait(&group_);
+  }
+}
+
+void TaskGroup::run(std::function<void()> task)
+{
+  if (executor_ == nullptr || executor_->getNumThreads() == 1) {
+    if (!group_.canceled) {
+      try {
+        task();
+      } catch (...) {
+        if (!group_.error) {
+          group_.error = std::current_exception();
+        }
+        group_.canceled = true;
+      }
+    }
+    return;
+  }
+  executor_->submit(&group_, std::move(task));
+}
+
+void TaskGroup::wait()
+{
+  if (executor_ != nullptr) {
+    executor_->wait(&group_);
+  }
+  if (group_.error) {
+    std::exception_ptr error = group_.error;
+    group_.error = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+void TaskGroup::cancel()
+{
+  group_.canceled = true;
+}
+
+bool TaskGroup::isCanceled() const
+{
+  return group_.canceled;
+}
+
+}  // namespace utl
@@ -0,0 +1,171 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#define BOOST_TEST_MODULE ExecutorTest
+
+#ifdef HAS_BOOST_UNIT_TEST_LIBRARY
+// Shared library version
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#else
+// Header only version
+#include <boost/test/included/unit_test.hpp>
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "utl/Executor.h"
+
+namespace utl {
+
+BOOST_AUTO_TEST_CASE(parallel_for_visits_every_index_once)
+{
+  for (int num_threads : {1, 4}) {
+    Executor executor(num_threads);
+    std::vector<int> visits(1000, 0);
+    executor.parallelFor(0, visits.size(), [&](int i) { visits[i]++; });
+    for (int count : visits) {
+      BOOST_TEST(count == 1);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(nested_parallel_for)
+{
+  Executor executor(4);
+  std::vector<std::vector<int>> sums(16, std::vector<int>(100, 0));
+  executor.parallelFor(0, sums.size(), [&](int i) {
+    executor.parallelFor(0, sums[i].size(), [&](int j) { sums[i][j] = i + j; });
+  });
+  for (int i = 0; i < sums.size(); i++) {
+    BOOST_TEST(std::accumulate(sums[i].begin(), sums[i].end(), 0)
+               == 100 * i + 4950);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(spawned_tasks_are_stolen)
+{
+  Executor executor(4);
+  std::mutex mutex;
+  std::set<std::thread::id> threads;
+  TaskGroup outer(&executor);
+  outer.run([&] {
+    // Spawned from a worker, so these go to its own queue and the idle
+    // workers have to steal them.
+    TaskGroup inner(&executor);
+    for (int i = 0; i < 8; i++) {
+      inner.run([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        std::lock_guard<std::mutex> lock(mutex);
+        threads.insert(std::this_thread::get_id());
+      });
+    }
+    inner.wait();
+  });
+  outer.wait();
+  BOOST_TEST(threads.size() > 1);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_for_max_threads)
+{
+  Executor executor(4);
+  std::atomic<int> running = 0;
+  std::atomic<int> most = 0;
+  executor.parallelFor(
+      0,
+      16,
+      [&](int) {
+        const int now = ++running;
+        int seen = most;
+        while (now > seen && !most.compare_exchange_weak(seen, now)) {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        running--;
+      },
+      2);
+  BOOST_TEST(most <= 2);
+}
+
+BOOST_AUTO_TEST_CASE(task_group_rethrows_first_error)
+{
+  Executor executor(4);
+  TaskGroup group(&executor);
+  std::atomic<int> ran = 0;
+  for (int i = 0; i < 100; i++) {
+    group.run([&ran, i] {
+      ran++;
+      if (i == 10) {
+        throw std::runtime_error("task failed");
+      }
+    });
+  }
+  BOOST_CHECK_THROW(group.wait(), std::runtime_error);
+  BOOST_TEST(group.isCanceled());
+  BOOST_TEST(ran <= 100);
+}
+
+BOOST_AUTO_TEST_CASE(canceled_group_skips_tasks)
+{
+  for (int num_threads : {1, 4}) {
+    Executor executor(num_threads);
+    TaskGroup group(&executor);
+    group.cancel();
+    std::atomic<int> ran = 0;
+    for (int i = 0; i < 100; i++) {
+      group.run([&ran] { ran++; });
+    }
+    group.wait();
+    BOOST_TEST(ran == 0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(resize)
+{
+  Executor executor;
+  BOOST_TEST(executor.getNumThreads() == 1);
+  executor.setNumThreads(3);
+  BOOST_TEST(executor.getNumThreads() == 3);
+  std::atomic<int> sum = 0;
+  executor.parallelFor(0, 100, [&](int i) { sum += i; });
+  BOOST_TEST(sum == 4950);
+  executor.setNumThreads(1);
+  BOOST_TEST(executor.getNumThreads() == 1);
+}
+
+}  // namespace utl